@@ -0,0 +1,144 @@
+#version 330 core
+out vec4 fragColor;
+
+struct Material
+{
+	sampler2D diffuse;
+	sampler2D specular;
+	float     shininess;
+};
+
+// NOTE(doyle): Light structs are in the std140 "Lights" block, the member order packs
+// scalars after vec3's and must match the LOGL*Light structs on the CPU.
+struct SpotLight {
+	vec3  position;
+	float cutOff;
+	vec3  direction;
+	float outerCutOff;
+
+	vec3  ambient;
+	float constant;
+	vec3  diffuse;
+	float linear;
+	vec3  specular;
+	float quadratic;
+};
+
+struct DirLight {
+	vec3 direction;
+
+	vec3 ambient;
+	vec3 diffuse;
+	vec3 specular;
+};
+
+struct PointLight {
+	vec3  position;
+	float constant;
+
+	vec3  ambient;
+	float linear;
+	vec3  diffuse;
+	float quadratic;
+	vec3  specular;
+};
+
+in vec2 ioTexCoord;
+in vec3 ioNormal;
+in vec3 ioFragPos;
+
+#define NUM_POINT_LIGHTS 4 // LOGL_NUM_POINT_LIGHTS
+layout(std140) uniform Lights
+{
+	PointLight pointLights[NUM_POINT_LIGHTS];
+	DirLight   dirLight;
+	SpotLight  spotLight;
+};
+
+uniform Material material;
+uniform vec3     viewPos;
+
+vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir, vec2 texCoord)
+{
+	vec3 lightDir     = normalize(light.position - fragPos);
+	float diffuseVal  = max(dot(normal, lightDir), 0);
+
+	vec3 reflectDir   = reflect(-lightDir, normal);
+	float specularVal = pow(max(dot(reflectDir,  viewDir), 0), material.shininess);
+
+	// Attentuate the light to diminish over a quadratic
+	float distance    = length(light.position - fragPos);
+	float attenuation = 1.0f / (light.constant + (light.linear * distance) + (light.quadratic * distance * distance));
+
+	vec3 ambient  = light.ambient  * vec3(texture(material.diffuse, texCoord));
+	vec3 diffuse  = light.diffuse  * diffuseVal  * vec3(texture(material.diffuse , texCoord));
+	vec3 specular = light.specular * specularVal * vec3(texture(material.specular, texCoord));
+	ambient  *= attenuation;
+	diffuse  *= attenuation;
+	specular *= attenuation;
+
+	return (ambient + diffuse + specular);
+}
+
+vec3 CalcDirLight(DirLight light, vec3 normal, vec3 viewDir, vec2 texCoord)
+{
+	// Diffuse, the angle between the light direction and surface normal
+	vec3 lightDir     = normalize(light.direction);
+	float diffuseVal  = max(dot(normal, lightDir), 0);
+
+	// Specular, the angle between the view and the reflection of the light vector
+	// NOTE(doyle): Reflect first arg expects the vector to point from the light src to fragment, so reverse it
+	vec3 reflectDir    = reflect(normal, -lightDir);
+	float specularVal  = pow(max(dot(reflectDir,  viewDir), 0), material.shininess);
+
+	vec3 ambient  = light.ambient  * vec3(texture(material.diffuse, texCoord));
+	vec3 diffuse  = light.diffuse  * diffuseVal  * vec3(texture(material.diffuse , texCoord));
+	vec3 specular = light.specular * specularVal * vec3(texture(material.specular, texCoord));
+
+	return (ambient + diffuse + specular);
+}
+
+vec3 CalcSpotLight(SpotLight spotLight, vec3 normal, vec3 fragPos, vec3 viewDir, vec2 texCoord)
+{
+	// Diffuse, the angle between the light direction and surface normal
+	vec3 lightDir    = normalize(spotLight.position - fragPos);
+	float diffuseVal = (max(dot(normal, lightDir), 0));
+
+	// Specular, the angle between the view and the reflection of the light vector
+	// NOTE(doyle): Reflect first arg expects the vector to point from the light src to fragment, so reverse it
+	vec3  reflectDir  = reflect(-lightDir, normal);
+	float specularVal = pow(max(dot(viewDir, reflectDir), 0), material.shininess);
+
+	vec3 ambient  = spotLight.ambient  * vec3(texture(material.diffuse, texCoord));
+	vec3 diffuse  = spotLight.diffuse  * diffuseVal  * vec3(texture(material.diffuse , texCoord));
+	vec3 specular = spotLight.specular * specularVal * vec3(texture(material.specular, texCoord));
+
+	// spotlight w/ soft edges
+	float theta     = dot(lightDir, normalize(spotLight.direction));
+	float epsilon   = spotLight.cutOff - spotLight.outerCutOff;
+	float intensity = clamp((theta - spotLight.outerCutOff) / epsilon, 0.0, 1.0);
+	diffuse  *= intensity;
+	specular *= intensity;
+
+	// Calculate attenuation
+	float distance    = length(spotLight.position - fragPos);
+	float attenuation = 1.0f / (spotLight.constant + (spotLight.linear * distance) + (spotLight.quadratic * distance * distance));
+	ambient  *= attenuation;
+	diffuse  *= attenuation;
+	specular *= attenuation;
+
+	return (ambient + diffuse + specular);
+}
+
+void main()
+{
+	vec3 normal  = normalize(ioNormal);
+	vec3 viewDir = normalize(viewPos - ioFragPos);
+
+	vec3 result = CalcDirLight(dirLight, normal, viewDir, ioTexCoord);
+	for (int i = 0; i < NUM_POINT_LIGHTS; i++)
+		result += CalcPointLight(pointLights[i], normal, ioFragPos, viewDir, ioTexCoord);
+
+	result += CalcSpotLight(spotLight, normal, ioFragPos, viewDir, ioTexCoord);
+	fragColor = vec4(result, 1.0f);
+}
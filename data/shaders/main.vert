@@ -0,0 +1,21 @@
+#version 330 core
+layout(location = 0) in vec3 aPos;
+layout(location = 2) in vec2 aTexCoord;
+layout(location = 3) in vec3 aNormal;
+layout(location = 4) in mat4 aModel;        // Per instance, takes locations 4-7
+layout(location = 8) in mat3 aNormalMatrix; // Per instance, takes locations 8-10
+
+uniform mat4 view;
+uniform mat4 projection;
+
+out vec3 ioFragPos;
+out vec3 ioNormal;
+out vec2 ioTexCoord;
+
+void main()
+{
+	ioFragPos     = vec3(aModel * vec4(aPos, 1.0));
+    gl_Position = projection * view * vec4(ioFragPos, 1.0f);
+    ioTexCoord    = aTexCoord;
+	ioNormal      = aNormalMatrix * aNormal;
+}
@@ -1,20 +1,28 @@
 #include "LOGL.h"
+#include "LOGLCull.h"
 #include "LOGLPlatform.h"
+#include "LOGLRenderQueue.h"
+#include "LOGLShader.h"
+#include "LOGLStateCache.h"
 #include "OpenGL.h"
 
 #define DQN_PLATFORM_HEADER
 #include "dqn.h"
 
+// NOTE: stb_image allocates from memory stacks instead of the heap, see LOGL_DecodeBitmap()
+FILE_SCOPE void *LOGL_StbMalloc (size_t size);
+FILE_SCOPE void *LOGL_StbRealloc(void *ptr, size_t newSize);
+FILE_SCOPE void  LOGL_StbFree   (void *ptr);
+#define STBI_MALLOC(size)          LOGL_StbMalloc(size)
+#define STBI_REALLOC(ptr, newSize) LOGL_StbRealloc(ptr, newSize)
+#define STBI_FREE(ptr)             LOGL_StbFree(ptr)
 #define STB_IMAGE_IMPLEMENTATION
 #include "external/stb_image.h"
 
 #include <math.h>
-enum ShaderTypeInternal
-{
-	ShaderTypeInternal_Invalid,
-	ShaderTypeInternal_Vertex,
-	ShaderTypeInternal_Fragment,
-};
+#include <stddef.h> // For offsetof()
+#include <stdio.h>  // For printf()
+#include <string.h> // For memcpy()
 
 #define OGL_ASSERT(func) func; OpenGL_AssertError()
 FILE_SCOPE inline GLenum OpenGL_AssertError()
@@ -37,380 +45,970 @@ FILE_SCOPE inline GLenum OpenGL_AssertError()
 	return errorCode;
 }
 
-FILE_SCOPE bool OpenGL_CompileShader(char *srcCode, u32 *const mainShaderId, enum ShaderTypeInternal shaderType)
+// Diff the light block against the copy last uploaded to the light UBO and upload the smallest range
+// that covers every changed byte, so static lights cost nothing after the first frame.
+FILE_SCOPE void LOGL_UploadLightBlock(LOGLContext *const glContext, const LOGLLightBlock *const lightBlock)
 {
-	if (!DQN_ASSERT_MSG(shaderType != ShaderTypeInternal_Invalid, "shaderType: Is the invalid enum value") ||
-	    !DQN_ASSERT_MSG(srcCode && mainShaderId, "Null argument(s): srcCode: %p, mainShaderId: %p", mainShaderId, srcCode))
+	const u8 *newBytes = (const u8 *)lightBlock;
+	u8 *oldBytes       = (u8 *)&glContext->lightBlock;
+
+	size_t dirtyStart = sizeof(*lightBlock);
+	size_t dirtyEnd   = 0;
+	for (size_t i = 0; i < sizeof(*lightBlock); i++)
 	{
-		return false;
+		if (newBytes[i] != oldBytes[i])
+		{
+			dirtyStart = DQN_MIN(dirtyStart, i);
+			dirtyEnd   = i + 1;
+		}
 	}
 
-	if (shaderType == ShaderTypeInternal_Vertex)
-		*mainShaderId = glCreateShader(GL_VERTEX_SHADER);
-	else
-		*mainShaderId = glCreateShader(GL_FRAGMENT_SHADER);
+	if (dirtyStart >= dirtyEnd) return;
+
+	size_t dirtySize = dirtyEnd - dirtyStart;
+	memcpy(oldBytes + dirtyStart, newBytes + dirtyStart, dirtySize);
 
-	glShaderSource(*mainShaderId, 1, &srcCode, NULL);
-	glCompileShader(*mainShaderId);
+	LOGLStateCache_BindBuffer(&glContext->stateCache, GL_UNIFORM_BUFFER, glContext->lightUbo);
+	glBufferSubData(GL_UNIFORM_BUFFER, dirtyStart, dirtySize, newBytes + dirtyStart);
+}
+
+// Generate a repeating 2D texture and leave it bound.
+FILE_SCOPE u32 LOGL_GenTexture(const GLint minFilter)
+{
+	u32 result;
+	glGenTextures(1, &result);
+	glBindTexture(GL_TEXTURE_2D, result);
+
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	return result;
+}
 
-	i32 success;
-	glGetShaderiv(*mainShaderId, GL_COMPILE_STATUS, &success);
-	if (!success)
+// Create a 2D texture from a full mip chain, levels[0] is the base level.
+// return: The texture id, 0 if the pixel format is not handled.
+FILE_SCOPE u32 LOGL_CreateTexture(const LOGLBitmap *const levels, const u32 numLevels, const GLint minFilter)
+{
+	GLenum format;
+	GLint internalFormat;
+	switch (levels[0].bytesPerPixel)
 	{
-		char infoLog[2048] = {};
-		glGetShaderInfoLog(*mainShaderId, DQN_ARRAY_COUNT(infoLog), NULL, infoLog);
-		glDeleteShader(*mainShaderId);
-		DQN_ASSERT_MSG(DQN_INVALID_CODE_PATH, "glCompileShader() failed: %s", infoLog);
+		case 1: format = GL_RED;  internalFormat = GL_R8;    break;
+		case 2: format = GL_RG;   internalFormat = GL_RG8;   break;
+		case 3: format = GL_RGB;  internalFormat = GL_RGB8;  break;
+		case 4: format = GL_RGBA; internalFormat = GL_RGBA8; break;
+		default:
+		{
+			DQN_ASSERT_MSG(DQN_INVALID_CODE_PATH, "Unhandled bytes per pixel: %d", levels[0].bytesPerPixel);
+			return 0;
+		}
 	}
 
-	return success;
+	u32 result = LOGL_GenTexture(minFilter);
+
+	// NOTE: 1 and 2 byte images are grey and grey + alpha, spread the grey over RGB when sampled
+	if (levels[0].bytesPerPixel <= 2)
+	{
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_G, GL_RED);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
+		if (levels[0].bytesPerPixel == 2) glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_A, GL_GREEN);
+	}
+
+	// NOTE: Rows are tightly packed, only 4 byte pixels keep every level's rows 4 byte aligned
+	bool rowsAligned = (levels[0].bytesPerPixel == 4);
+	if (!rowsAligned) glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+	for (u32 levelIndex = 0; levelIndex < numLevels; levelIndex++)
+	{
+		const LOGLBitmap *level = &levels[levelIndex];
+		glTexImage2D(GL_TEXTURE_2D, levelIndex, internalFormat, level->dim.w, level->dim.h, 0, format,
+		             GL_UNSIGNED_BYTE, level->memory);
+	}
+
+	if (!rowsAligned) glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	return result;
 }
 
-bool OpenGL_LinkShaderProgram(u32 *const shaderId, const u32 vertexShader, const u32 fragmentShader)
+// Create a 2D texture from a full chain of block compressed mips, levels[0] is the base level.
+// return: The texture id, 0 if the format is not handled.
+FILE_SCOPE u32 LOGL_CreateCompressedTexture(const LOGLBCImage *const levels, const u32 numLevels,
+                                            const GLint minFilter)
 {
-	*shaderId = glCreateProgram();
-	glAttachShader(*shaderId, vertexShader);
-	glAttachShader(*shaderId, fragmentShader);
-	glLinkProgram(*shaderId);
+	GLenum internalFormat;
+	switch (levels[0].format)
+	{
+		case LOGLBCFormat_BC1: internalFormat = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;  break;
+		case LOGLBCFormat_BC3: internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT; break;
+		case LOGLBCFormat_BC4: internalFormat = GL_COMPRESSED_RED_RGTC1;         break;
+		case LOGLBCFormat_BC5: internalFormat = GL_COMPRESSED_RG_RGTC2;          break;
+		default:
+		{
+			DQN_ASSERT_MSG(DQN_INVALID_CODE_PATH, "Unhandled block compression format: %d", levels[0].format);
+			return 0;
+		}
+	}
+
+	u32 result = LOGL_GenTexture(minFilter);
 
-	i32 success;
-	char infoLog[512] = {};
-	glGetProgramiv(*shaderId, GL_LINK_STATUS, &success);
-	if (!success)
+	// NOTE: BC4 is grey and BC5 is only picked for grey + alpha, sample them like the uncompressed 1
+	// and 2 byte textures
+	if (levels[0].format == LOGLBCFormat_BC4 || levels[0].format == LOGLBCFormat_BC5)
 	{
-		glGetProgramInfoLog(*shaderId, DQN_ARRAY_COUNT(infoLog), NULL, infoLog);
-		DQN_ASSERT_MSG(DQN_INVALID_CODE_PATH, "glLinkProgram() failed: %s", infoLog);
-		return false;
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_G, GL_RED);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
+		if (levels[0].format == LOGLBCFormat_BC5) glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_A, GL_GREEN);
 	}
 
-	return true;
+	for (u32 levelIndex = 0; levelIndex < numLevels; levelIndex++)
+	{
+		const LOGLBCImage *level = &levels[levelIndex];
+		glCompressedTexImage2D(GL_TEXTURE_2D, levelIndex, internalFormat, level->dim.w, level->dim.h, 0,
+		                       (GLsizei)level->size, level->blocks);
+	}
+
+	return result;
 }
 
-void LOGL_Update(struct PlatformInput *const input, struct PlatformMemory *const memory)
+// Create a texture from the mips of a cooked texture, they're read straight from the pack.
+// return: The texture id, 0 if the format is not handled.
+FILE_SCOPE u32 LOGL_CreatePackTexture(const LOGLPack *const pack, const LOGLPackTexture *const texture,
+                                      const GLint minFilter)
 {
-	DqnMemStack *const mainStack = &memory->mainStack;
-	DqnMemStack *const tempStack = &memory->tempStack;
-	auto tempRegion              = tempStack->TempRegionGuard();
+	enum LOGLBCFormat bcFormat = LOGLPack_BCFormat((enum LOGLPackFormat)texture->format);
+	if (bcFormat != LOGLBCFormat_None)
+	{
+		LOGLBCImage levels[LOGL_PACK_MAX_MIPS];
+		for (u32 mipIndex = 0; mipIndex < texture->numMips; mipIndex++)
+		{
+			const LOGLPackMip *mip = &texture->mips[mipIndex];
+			LOGLBCImage *level     = &levels[mipIndex];
+			level->blocks          = pack->data + mip->offset;
+			level->size            = (size_t)mip->size;
+			level->dim             = DqnV2i_2i(mip->width, mip->height);
+			level->format          = bcFormat;
+		}
 
-	if (!memory->state)
+		u32 result = LOGL_CreateCompressedTexture(levels, texture->numMips, minFilter);
+		return result;
+	}
+
+	i32 bytesPerPixel = (i32)LOGLPack_BytesPerPixel((enum LOGLPackFormat)texture->format);
+	if (!DQN_ASSERT_MSG(bytesPerPixel != 0, "Unhandled pack format: %d, %s", texture->format, texture->name))
+		return 0;
+
+	LOGLBitmap levels[LOGL_PACK_MAX_MIPS];
+	for (u32 mipIndex = 0; mipIndex < texture->numMips; mipIndex++)
 	{
-		memory->state = (LOGLState *)memory->mainStack.Push(sizeof(*memory->state));
-		if (!memory->state) return;
+		const LOGLPackMip *mip = &texture->mips[mipIndex];
+		LOGLBitmap *level      = &levels[mipIndex];
+		level->memory          = (u8 *)pack->data + mip->offset;
+		level->dim             = DqnV2i_2i(mip->width, mip->height);
+		level->bytesPerPixel   = bytesPerPixel;
+	}
 
-		LOGLState *const state       = memory->state;
-		LOGLContext *const glContext = &state->glContext;
+	u32 result = LOGL_CreateTexture(levels, texture->numMips, minFilter);
+	return result;
+}
 
-		// Compile Shaders
-		u32 vertexShader;
-		u32 fragmentShader;
-		u32 lightFragmentShader;
+// return: The bytes of every mip of a cooked texture.
+FILE_SCOPE u64 LOGL_PackTextureSize(const LOGLPackTexture *const texture)
+{
+	u64 result = 0;
+	for (u32 mipIndex = 0; mipIndex < texture->numMips; mipIndex++)
+		result += texture->mips[mipIndex].size;
+	return result;
+}
+
+// NOTE: A single grey texel, so lit surfaces still shade sensibly while their textures load
+FILE_SCOPE u32 LOGL_CreatePlaceholderTexture()
+{
+	const u8 pixel[4] = {128, 128, 128, 255};
+
+	u32 result;
+	glGenTextures(1, &result);
+	glBindTexture(GL_TEXTURE_2D, result);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+	return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Asset Loading
+////////////////////////////////////////////////////////////////////////////////
+// Textures are loaded through the texture cache, see LOGLTextureCache. Texture loads are one job
+// each, the file read, decode and mip chain of every texture run in parallel across the job queue.
+// GL calls can only be made on the main thread, so it polls the loads each frame and uploads the
+// ones that are decoded, bounded by LOGL_TEXTURE_UPLOAD_BYTES_PER_FRAME so a burst of finished loads
+// doesn't stall a frame.
+
+#define LOGL_TEXTURE_UPLOAD_BYTES_PER_FRAME DQN_MEGABYTE(16)
+
+// Block compress the mips of a load if it asks for it, and size what will be uploaded.
+// return: FALSE if the load's memStack ran out of memory.
+FILE_SCOPE bool LOGL_CompressTextureLoad(DqnJobQueue *const queue, LOGLTextureLoad *const load)
+{
+	load->uploadSize           = 0;
+	enum LOGLBCFormat bcFormat = LOGLBCFormat_None;
+	if (load->bcQuality != LOGLBCQuality_None) bcFormat = LOGLBC_PickFormat(&load->mips[0]);
+
+	for (u32 mipIndex = 0; mipIndex < load->numMips; mipIndex++)
+	{
+		const LOGLBitmap *mip = &load->mips[mipIndex];
+		if (bcFormat == LOGLBCFormat_None)
 		{
-			char *vertexShaderSrc = R"DQN(
-			#version 330 core
-			layout(location = 0) in vec3 aPos;
-			layout(location = 1) in vec3 aColor;
-			layout(location = 2) in vec2 aTexCoord;
-			layout(location = 3) in vec3 aNormal;
+			load->uploadSize += (size_t)mip->dim.w * mip->dim.h * mip->bytesPerPixel;
+			continue;
+		}
 
-			uniform mat4 model;
-			uniform mat4 view;
-			uniform mat4 projection;
+		LOGLBCImage *compressed = &load->compressedMips[mipIndex];
+		compressed->size        = LOGLBC_EncodedSize(bcFormat, mip->dim.w, mip->dim.h);
+		compressed->dim         = mip->dim;
+		compressed->format      = bcFormat;
 
-			out vec3 ioFragPos;
-			out vec3 ioNormal;
-			out vec2 ioTexCoord;
+		u8 *blocks = (u8 *)load->memStack.Push(compressed->size);
+		if (!blocks || !LOGLBC_Encode(queue, mip, bcFormat, (enum LOGLBCQuality)load->bcQuality, blocks))
+			return false;
 
-			void main()
+		compressed->blocks  = blocks;
+		load->uploadSize   += compressed->size;
+	}
+
+	return true;
+}
+
+// return: Bytes the load's memStack needs for the mips of file and, if it compresses them, the
+//         largest blocks they could encode to.
+FILE_SCOPE size_t LOGL_TextureLoadSize(const LOGLTextureLoad *const load, const LOGLBitmapFile *const file)
+{
+	size_t result = 0;
+	DqnV2i dim    = file->dim;
+	u32 numLevels = DQN_MIN(LOGL_MIP_MAX_LEVELS, LOGLMip_NumLevels(dim.w, dim.h));
+	for (u32 levelIndex = 0; levelIndex < numLevels; levelIndex++)
+	{
+		// NOTE: Another 4 for the alignment of each of the level's two pushes
+		result += (levelIndex == 0) ? file->decodeSize : ((size_t)dim.w * dim.h * file->bytesPerPixel);
+		if (load->bcQuality != LOGLBCQuality_None) result += LOGLBC_EncodedSize(LOGLBCFormat_BC3, dim.w, dim.h);
+		result += 8;
+		dim = LOGLMip_NextLevelDim(dim);
+	}
+
+	return result;
+}
+
+FILE_SCOPE void LOGL_TextureLoadJob(DqnJobQueue *const queue, void *const userData)
+{
+	LOGLTextureLoad *load = (LOGLTextureLoad *)userData;
+	i32 state             = LOGLTextureLoadState_Failed;
+
+	// NOTE: The file and stb_image's scratch go in the thread's scratch stack and are released when
+	// the job returns. Only the mips that are uploaded go in the load's memStack, sized to fit them
+	// once the header is read. Without a queue the load runs here with a stack of its own.
+	DqnMemStack ownScratch = {};
+	DqnMemStack *scratch   = DqnJobQueue_GetScratch(queue);
+	if (!scratch && ownScratch.Init(DQN_KILOBYTE(256), false, 4)) scratch = &ownScratch;
+
+	if (scratch)
+	{
+		auto scratchRegion  = scratch->TempRegionGuard();
+		LOGLBitmapFile file = {};
+		if (LOGL_OpenBitmap(scratch, &file, load->path) &&
+		    load->memStack.Init(LOGL_TextureLoadSize(load, &file), false, 4))
+		{
+			LOGLBitmap *level0    = &load->mips[0];
+			level0->memory        = (u8 *)load->memStack.Push(file.decodeSize);
+			level0->dim           = file.dim;
+			level0->bytesPerPixel = file.bytesPerPixel;
+			if (level0->memory && LOGL_DecodeBitmap(scratch, &file, level0->memory))
 			{
-				ioFragPos     = vec3(model * vec4(aPos, 1.0));
-			    gl_Position = projection * view * vec4(ioFragPos, 1.0f);
-			    ioTexCoord    = aTexCoord;
-				ioNormal      = mat3(transpose(inverse(model))) * aNormal;
+				// NOTE: The textures aren't sRGB, filter them in linear like glGenerateMipmap() would
+				load->numMips = LOGLMip_BuildChain(&load->memStack, queue, load->mips, DQN_ARRAY_COUNT(load->mips),
+				                                   LOGLMipColorSpace_Linear);
+				if (load->numMips > 0 && LOGL_CompressTextureLoad(queue, load))
+					state = LOGLTextureLoadState_Decoded;
 			}
-			)DQN";
+		}
+	}
+	ownScratch.Free();
 
-			char *fragmentShaderSrc = R"DQN(
-			#version 330 core
-			out vec4 fragColor;
+	// NOTE: Publishes the load, the main thread doesn't touch it until it sees the state change
+	DqnAtomic_CompareSwap32(&load->state, state, LOGLTextureLoadState_Queued);
+}
 
-			struct Material
-			{
-				sampler2D diffuse;
-				sampler2D specular;
-				float     shininess;
-			};
+u64 LOGL_HashFNV1a(const void *const data, const size_t size, const u64 hash)
+{
+	const u8 *bytes = (const u8 *)data;
+	u64 result      = hash;
+	for (size_t i = 0; i < size; i++)
+	{
+		result ^= bytes[i];
+		result *= LOGL_FNV1A_PRIME;
+	}
 
-			struct SpotLight {
-				vec3 position;
-				vec3 direction;
-				float cutOff;
-				float outerCutOff;
+	return result;
+}
 
-				vec3 diffuse;
-				vec3 ambient;
-				vec3 specular;
+// maxEntries: The most distinct paths the cache can hold, entries are never removed.
+// budget: Resident bytes before textures are evicted, 0 for no limit.
+// return: FALSE if memStack ran out of memory.
+FILE_SCOPE bool LOGL_InitTextureCache(DqnMemStack *const memStack, LOGLTextureCache *const cache,
+                                      const u32 maxEntries, const size_t budget)
+{
+	*cache = {};
 
-				float constant;
-				float linear;
-				float quadratic;
-			};
+	// NOTE: At most half full, so probes are short and always find an empty slot
+	cache->numSlots = 1;
+	while (cache->numSlots < maxEntries * 2)
+		cache->numSlots <<= 1;
 
-			struct DirLight {
-				vec3 direction;
+	cache->entries    = (LOGLTextureEntry *)memStack->Push(sizeof(*cache->entries) * maxEntries);
+	cache->slots      = (u32 *)memStack->Push(sizeof(*cache->slots) * cache->numSlots);
+	cache->maxEntries = maxEntries;
+	cache->budget     = budget;
+	if (!cache->entries || !cache->slots) return false;
 
-				vec3 ambient;
-				vec3 diffuse;
-				vec3 specular;
-			};
+	memset(cache->slots, 0, sizeof(*cache->slots) * cache->numSlots);
+	return true;
+}
 
-			struct PointLight {
-				vec3 position;
+// return: The slot that holds the handle of path, or the empty slot it would go in.
+FILE_SCOPE u32 *LOGL_FindTextureSlot(LOGLTextureCache *const cache, const char *const path, const u64 pathHash)
+{
+	const u32 mask = cache->numSlots - 1;
+	for (u32 slotIndex = (u32)pathHash & mask;; slotIndex = (slotIndex + 1) & mask)
+	{
+		u32 *slot = &cache->slots[slotIndex];
+		if (*slot == 0) return slot;
 
-				vec3 ambient;
-				vec3 diffuse;
-				vec3 specular;
+		const LOGLTextureEntry *entry = &cache->entries[*slot - 1];
+		if (entry->pathHash == pathHash && DqnStr_Cmp(entry->path, path) == 0) return slot;
+	}
+}
 
-				float constant;
-				float linear;
-				float quadratic;
-			};
+// Get a reference to the texture at path, requesting a load if the cache doesn't have it resident.
+// A path is loaded with the minFilter it was first acquired with.
+// return: 0 if the path is too long or the cache is full.
+FILE_SCOPE LOGLTextureHandle LOGL_AcquireTexture(LOGLTextureCache *const cache, const char *const path,
+                                                 const i32 minFilter)
+{
+	i32 pathLen = DqnStr_Len(path);
+	if (!DQN_ASSERT_MSG(pathLen < LOGL_TEXTURE_CACHE_MAX_PATH, "Texture path is too long: %s", path)) return 0;
 
-			in vec2 ioTexCoord;
-			in vec3 ioNormal;
-			in vec3 ioFragPos;
+	u64 pathHash = LOGL_HashFNV1a(path, pathLen);
+	u32 *slot    = LOGL_FindTextureSlot(cache, path, pathHash);
+	if (*slot == 0)
+	{
+		if (!DQN_ASSERT_MSG(cache->numEntries < cache->maxEntries, "Texture cache is full: %s", path)) return 0;
 
-			#define NUM_POINT_LIGHTS 4
-			uniform PointLight pointLights[NUM_POINT_LIGHTS];
-			uniform Material   material;
-			uniform SpotLight  spotLight;
-			uniform DirLight   dirLight;
-			uniform vec3       viewPos;
+		LOGLTextureEntry *entry = &cache->entries[cache->numEntries++];
+		*entry                  = {};
+		entry->pathHash         = pathHash;
+		entry->minFilter        = minFilter;
+		entry->state            = LOGLTextureState_Requested;
+		memcpy(entry->path, path, pathLen + 1);
 
-			vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir, vec2 texCoord)
-			{
-				vec3 lightDir     = normalize(light.position - fragPos);
-				float diffuseVal  = max(dot(normal, lightDir), 0);
+		*slot = cache->numEntries;
+		cache->stats.numMisses++;
+	}
+	else
+	{
+		cache->stats.numHits++;
+	}
 
-				vec3 reflectDir   = reflect(-lightDir, normal);
-				float specularVal = pow(max(dot(reflectDir,  viewDir), 0), material.shininess);
+	LOGLTextureEntry *entry = &cache->entries[*slot - 1];
+	entry->refCount++;
+	entry->lastUsedFrame = cache->frame;
+	if (entry->state == LOGLTextureState_Evicted)
+	{
+		entry->state = LOGLTextureState_Requested;
+		cache->stats.numRestreams++;
+	}
 
-				// Attentuate the light to diminish over a quadratic
-				float distance    = length(light.position - fragPos);
-				float attenuation = 1.0f / (light.constant + (light.linear * distance) + (light.quadratic * distance * distance));
+	return *slot;
+}
 
-				vec3 ambient  = light.ambient  * vec3(texture(material.diffuse, texCoord));
-				vec3 diffuse  = light.diffuse  * diffuseVal  * vec3(texture(material.diffuse , texCoord));
-				vec3 specular = light.specular * specularVal * vec3(texture(material.specular, texCoord));
-				ambient  *= attenuation;
-				diffuse  *= attenuation;
-				specular *= attenuation;
+// Drop a reference from LOGL_AcquireTexture(). The texture stays resident until it's evicted.
+FILE_SCOPE void LOGL_ReleaseTexture(LOGLTextureCache *const cache, const LOGLTextureHandle handle)
+{
+	if (handle == 0 || handle > cache->numEntries) return;
 
-				return (ambient + diffuse + specular);
-			}
+	LOGLTextureEntry *entry = &cache->entries[handle - 1];
+	if (DQN_ASSERT_MSG(entry->refCount > 0, "Texture released more than it was acquired: %s", entry->path))
+		entry->refCount--;
+}
 
-			vec3 CalcDirLight(DirLight light, vec3 normal, vec3 viewDir, vec2 texCoord)
-			{
-				// Diffuse, the angle between the light direction and surface normal
-				vec3 lightDir     = normalize(light.direction);
-				float diffuseVal  = max(dot(normal, lightDir), 0);
+// Bind a texture to GL_TEXTURE_2D of the active unit, or the placeholder if it isn't resident. An
+// evicted texture is requested again.
+FILE_SCOPE void LOGL_BindTexture(LOGLStateCache *const stateCache, const u32 unit, LOGLTextureCache *const cache,
+                                 const LOGLTextureHandle handle)
+{
+	u32 texId = cache->texIdPlaceholder;
+	if (handle > 0 && handle <= cache->numEntries)
+	{
+		LOGLTextureEntry *entry = &cache->entries[handle - 1];
+		entry->lastUsedFrame    = cache->frame;
+		if (entry->state == LOGLTextureState_Resident)
+		{
+			texId = entry->texId;
+		}
+		else if (entry->state == LOGLTextureState_Evicted)
+		{
+			entry->state = LOGLTextureState_Requested;
+			cache->stats.numRestreams++;
+		}
+	}
 
-				// Specular, the angle between the view and the reflection of the light vector
-				// NOTE(doyle): Reflect first arg expects the vector to point from the light src to fragment, so reverse it
-				vec3 reflectDir    = reflect(normal, -lightDir);
-				float specularVal  = pow(max(dot(reflectDir,  viewDir), 0), material.shininess);
+	LOGLStateCache_BindTexture(stateCache, unit, texId);
+}
 
-				vec3 ambient  = light.ambient  * vec3(texture(material.diffuse, texCoord));
-				vec3 diffuse  = light.diffuse  * diffuseVal  * vec3(texture(material.diffuse , texCoord));
-				vec3 specular = light.specular * specularVal * vec3(texture(material.specular, texCoord));
+FILE_SCOPE void LOGL_MakeTextureResident(LOGLTextureCache *const cache, LOGLTextureEntry *const entry,
+                                         const u32 texId, const size_t size)
+{
+	// NOTE: Counts as used so it isn't evicted before it's had a frame to be bound
+	entry->state         = LOGLTextureState_Resident;
+	entry->texId         = texId;
+	entry->residentSize  = size;
+	entry->lastUsedFrame = cache->frame;
+
+	cache->stats.numResident++;
+	cache->stats.residentBytes    += size;
+	cache->stats.peakResidentBytes = DQN_MAX(cache->stats.peakResidentBytes, cache->stats.residentBytes);
+}
 
-				return (ambient + diffuse + specular);
-			}
+// Delete the textures that weren't bound last frame until the cache is in budget, unreferenced ones
+// first and then least recently used. The cache holds few textures so each victim is found by a scan.
+FILE_SCOPE void LOGL_EvictTextures(LOGLStateCache *const stateCache, LOGLTextureCache *const cache)
+{
+	if (cache->budget == 0) return;
 
-			vec3 CalcSpotLight(SpotLight spotLight, vec3 normal, vec3 fragPos, vec3 viewDir, vec2 texCoord)
-			{
-				// Diffuse, the angle between the light direction and surface normal
-				vec3 lightDir    = normalize(spotLight.position - fragPos);
-				float diffuseVal = (max(dot(normal, lightDir), 0));
-
-				// Specular, the angle between the view and the reflection of the light vector
-				// NOTE(doyle): Reflect first arg expects the vector to point from the light src to fragment, so reverse it
-				vec3  reflectDir  = reflect(-lightDir, normal);
-				float specularVal = pow(max(dot(viewDir, reflectDir), 0), material.shininess);
-
-				vec3 ambient  = spotLight.ambient  * vec3(texture(material.diffuse, texCoord));
-				vec3 diffuse  = spotLight.diffuse  * diffuseVal  * vec3(texture(material.diffuse , texCoord));
-				vec3 specular = spotLight.specular * specularVal * vec3(texture(material.specular, texCoord));
-
-				// spotlight w/ soft edges
-				float theta     = dot(lightDir, normalize(spotLight.direction));
-				float epsilon   = spotLight.cutOff - spotLight.outerCutOff;
-				float intensity = clamp((theta - spotLight.outerCutOff) / epsilon, 0.0, 1.0);
-				diffuse  *= intensity;
-				specular *= intensity;
-
-				// Calculate attenuation
-				float distance    = length(spotLight.position - fragPos);
-				float attenuation = 1.0f / (spotLight.constant + (spotLight.linear * distance) + (spotLight.quadratic * distance * distance));
-				ambient  *= attenuation;
-				diffuse  *= attenuation;
-				specular *= attenuation;
-
-				return (ambient + diffuse + specular);
-			}
+	while (cache->stats.residentBytes > cache->budget)
+	{
+		LOGLTextureEntry *victim = NULL;
+		for (u32 i = 0; i < cache->numEntries; i++)
+		{
+			LOGLTextureEntry *entry = &cache->entries[i];
+			if (entry->state != LOGLTextureState_Resident || entry->lastUsedFrame + 1 >= cache->frame) continue;
 
-			void main()
-			{
-				vec3 normal  = normalize(ioNormal);
-				vec3 viewDir = normalize(viewPos - ioFragPos);
+			bool isBetter = !victim;
+			if (victim && (entry->refCount == 0) != (victim->refCount == 0))
+				isBetter = (entry->refCount == 0);
+			else if (victim)
+				isBetter = (entry->lastUsedFrame < victim->lastUsedFrame);
 
-				vec3 result = CalcDirLight(dirLight, normal, viewDir, ioTexCoord);
-				for (int i = 0; i < NUM_POINT_LIGHTS; i++)
-					result += CalcPointLight(pointLights[i], normal, ioFragPos, viewDir, ioTexCoord);
+			if (isBetter) victim = entry;
+		}
 
-				result += CalcSpotLight(spotLight, normal, ioFragPos, viewDir, ioTexCoord);
-				fragColor = vec4(result, 1.0f);
-			}
-			)DQN";
+		// NOTE: Everything resident is in use, stay over budget rather than thrash
+		if (!victim) break;
 
-			char *lightFragmentShaderSrc = R"DQN(
-			#version 330 core
-			out vec4 fragColor;
+		LOGLStateCache_DeleteTexture(stateCache, victim->texId);
+		cache->stats.numResident--;
+		cache->stats.residentBytes -= victim->residentSize;
+		cache->stats.numEvictions++;
 
-			void main()
+		victim->state        = LOGLTextureState_Evicted;
+		victim->texId        = 0;
+		victim->residentSize = 0;
+	}
+}
+
+// Start the requested loads, upload the ones that finished decoding and evict textures until the
+// cache is in budget. Must be called on the main thread at the start of a frame, before any binds.
+// return: The number of textures requested or still loading.
+FILE_SCOPE u32 LOGL_UpdateTextureCache(LOGLStateCache *const stateCache, LOGLTextureCache *const cache,
+                                       LOGLAssetStats *const stats)
+{
+	cache->frame++;
+
+	u32 result           = 0;
+	u32 numCreated       = 0;
+	size_t bytesUploaded = 0;
+	for (u32 i = 0; i < cache->numEntries; i++)
+	{
+		LOGLTextureEntry *entry = &cache->entries[i];
+		if (entry->state == LOGLTextureState_Requested)
+		{
+			// NOTE: Textures in the asset pack are uploaded now as they only need copying to GL, the
+			// rest are decoded on the job queue
+			const LOGLPackTexture *packTexture = (cache->hasPack) ? LOGLPack_FindTexture(&cache->pack, entry->path) : NULL;
+			u32 texId = (packTexture) ? LOGL_CreatePackTexture(&cache->pack, packTexture, entry->minFilter) : 0;
+			if (texId)
 			{
-			    fragColor = vec4(1.0f);
+				numCreated++;
+				size_t size = (size_t)LOGL_PackTextureSize(packTexture);
+				LOGL_MakeTextureResident(cache, entry, texId, size);
+				stats->numTexturesLoaded++;
+				stats->numTexturesFromPack++;
+				stats->textureBytes += size;
+				if (LOGLPack_BCFormat((enum LOGLPackFormat)packTexture->format) != LOGLBCFormat_None)
+					stats->numTexturesCompressed++;
+				continue;
 			}
-			)DQN";
 
+			LOGLTextureLoad *load = &entry->load;
+			*load                 = {};
+			load->path            = entry->path;
+			load->minFilter       = entry->minFilter;
+			load->bcQuality       = cache->bcQuality;
+			load->state           = LOGLTextureLoadState_Queued;
+			entry->state          = LOGLTextureState_Loading;
+
+			DqnJob job = {LOGL_TextureLoadJob, load, &cache->loadCounter};
+			if (!cache->queue || !DqnJobQueue_AddJob(cache->queue, job))
+				LOGL_TextureLoadJob(cache->queue, load);
+		}
+
+		if (entry->state != LOGLTextureState_Loading) continue;
 
-			bool success = OpenGL_CompileShader(vertexShaderSrc,        &vertexShader,        ShaderTypeInternal_Vertex);
-			success     |= OpenGL_CompileShader(fragmentShaderSrc,      &fragmentShader,      ShaderTypeInternal_Fragment);
-			success     |= OpenGL_CompileShader(lightFragmentShaderSrc, &lightFragmentShader, ShaderTypeInternal_Fragment);
+		// NOTE: Always upload at least one texture a frame, however big
+		LOGLTextureLoad *load = &entry->load;
+		i32 loadState         = load->state;
+		if (loadState == LOGLTextureLoadState_Queued ||
+		    (bytesUploaded > 0 && bytesUploaded + load->uploadSize > LOGL_TEXTURE_UPLOAD_BYTES_PER_FRAME))
+		{
+			result++;
+			continue;
 		}
 
-		// Link shaders
+		// NOTE: Don't read what the job wrote before the state it published
+		DqnAtomic_MemoryBarrier();
+
+		u32 texId       = 0;
+		bool compressed = false;
+		if (loadState == LOGLTextureLoadState_Decoded)
 		{
-			DQN_ASSERT_HARD(
-			    OpenGL_LinkShaderProgram(&glContext->mainShaderId, vertexShader, fragmentShader));
+			compressed = (load->bcQuality != LOGLBCQuality_None && load->compressedMips[0].blocks);
+			if (compressed)
+				texId = LOGL_CreateCompressedTexture(load->compressedMips, load->numMips, load->minFilter);
+			else
+				texId = LOGL_CreateTexture(load->mips, load->numMips, load->minFilter);
 
-			f32 fovDegrees     = 45.0f;
-			f32 aspectRatio    = input->screenDim.w / input->screenDim.h;
-			DqnMat4 projection = DqnMat4_Perspective(fovDegrees, aspectRatio, 0.1f, 100.0f);
+			bytesUploaded += load->uploadSize;
+		}
 
-			// Setup main shader uniforms
-			{
-				glUseProgram(glContext->mainShaderId);
+		if (texId)
+		{
+			numCreated++;
+			LOGL_MakeTextureResident(cache, entry, texId, load->uploadSize);
+			stats->numTexturesLoaded++;
+			stats->textureBytes += load->uploadSize;
+			if (compressed) stats->numTexturesCompressed++;
+		}
+		else
+		{
+			DQN_ASSERT_MSG(DQN_INVALID_CODE_PATH, "Texture failed to load, keeping the placeholder: %s", load->path);
+			entry->state = LOGLTextureState_Failed;
+			stats->numTexturesFailed++;
+		}
 
-				// MVP matrix
-				{
-					glContext->uniformProjectionLoc = glGetUniformLocation(glContext->mainShaderId, "projection");
-					glContext->uniformViewLoc       = glGetUniformLocation(glContext->mainShaderId, "view");
-					glContext->uniformModelLoc      = glGetUniformLocation(glContext->mainShaderId, "model");
-					DQN_ASSERT(glContext->uniformProjectionLoc != -1);
-					DQN_ASSERT(glContext->uniformViewLoc != -1);
-					DQN_ASSERT(glContext->uniformModelLoc != -1);
-				}
+		load->memStack.Free();
+		load->numMips = 0;
+		load->state   = LOGLTextureLoadState_Done;
+	}
 
-				glContext->uniformViewPos = glGetUniformLocation(glContext->mainShaderId, "viewPos");
-				DQN_ASSERT(glContext->uniformViewPos != -1);
+	// NOTE: Textures are created bound to whichever unit is active, which the state cache didn't see
+	if (numCreated > 0) LOGLStateCache_InvalidateBindings(stateCache);
 
-				// Material uniforms
-				{
-					glContext->uniformMaterialDiffuse   = glGetUniformLocation(glContext->mainShaderId, "material.diffuse");
-					glContext->uniformMaterialSpecular  = glGetUniformLocation(glContext->mainShaderId, "material.specular");
-					glContext->uniformMaterialShininess = glGetUniformLocation(glContext->mainShaderId, "material.shininess");
-					DQN_ASSERT(glContext->uniformMaterialDiffuse != -1);
-					DQN_ASSERT(glContext->uniformMaterialSpecular != -1);
-					DQN_ASSERT(glContext->uniformMaterialShininess != -1);
-
-					// Set the uniform sampler2D to use GL_TEXTURE0 and 1
-					glUniform1i(glContext->uniformMaterialDiffuse, 0);
-					glUniform1i(glContext->uniformMaterialSpecular, 1);
-				}
+	LOGL_EvictTextures(stateCache, cache);
+	return result;
+}
 
-				// Setup point lights
-				{
-					char *uniformAttrib[] = {"position", "ambient", "diffuse", "specular", "constant", "linear", "quadratic"};
-					DQN_ASSERT(DQN_ARRAY_COUNT(uniformAttrib) == DQN_ARRAY_COUNT(glContext->uniformPointLights[0].uniforms));
-					for (i32 lightIndex = 0; lightIndex < DQN_ARRAY_COUNT(glContext->uniformPointLights); lightIndex++)
-					{
-						LOGLPointLight *light = &glContext->uniformPointLights[lightIndex];
-						for (i32 uniformIndex = 0; uniformIndex < DQN_ARRAY_COUNT(light->uniforms); uniformIndex++)
-						{
-							char uniformString[128] = {};
-							u32 numCopied           = Dqn_sprintf(uniformString, "pointLights[%d].%s", lightIndex, uniformAttrib[uniformIndex]);
-							DQN_ASSERT(numCopied < DQN_ARRAY_COUNT(uniformString));
+// Enable the per instance attributes in the currently bound VAO. Where they read from changes every
+// frame, see LOGL_PointInstanceAttribs().
+FILE_SCOPE void LOGL_InitInstanceAttribs()
+{
+	// NOTE: A mat4 attribute takes 4 consecutive locations, one per column, and a mat3 the 3 after
+	for (u32 shaderInLoc = 4; shaderInLoc < 4 + 4 + 3; shaderInLoc++)
+	{
+		glEnableVertexAttribArray(shaderInLoc);
+		glVertexAttribDivisor(shaderInLoc, 1);
+	}
+}
 
-							light->uniforms[uniformIndex] = glGetUniformLocation(glContext->mainShaderId, uniformString);
-							DQN_ASSERT(light->uniforms[uniformIndex] != -1);
-						}
-					}
-				}
+// Point the per instance attributes of the currently bound VAO at the instances starting at offset in
+// the frame arena's vbo.
+FILE_SCOPE void LOGL_PointInstanceAttribs(LOGLStateCache *const stateCache, const LOGLFrameArena *const arena,
+                                          const size_t offset)
+{
+	LOGLStateCache_BindBuffer(stateCache, GL_ARRAY_BUFFER, arena->vbo);
 
-				// Setup dir lights
-				if (1)
-				{
-					glContext->uniformDirLightDir      = glGetUniformLocation(glContext->mainShaderId, "dirLight.direction");
-					glContext->uniformDirLightAmbient  = glGetUniformLocation(glContext->mainShaderId, "dirLight.ambient");
-					glContext->uniformDirLightDiffuse  = glGetUniformLocation(glContext->mainShaderId, "dirLight.diffuse");
-					glContext->uniformDirLightSpecular = glGetUniformLocation(glContext->mainShaderId, "dirLight.specular");
-					DQN_ASSERT(glContext->uniformDirLightDir      != -1);
-					DQN_ASSERT(glContext->uniformDirLightAmbient  != -1);
-					DQN_ASSERT(glContext->uniformDirLightDiffuse  != -1);
-					DQN_ASSERT(glContext->uniformDirLightSpecular != -1);
-				}
+	const u32 shaderInLoc = 4;
+	for (u32 col = 0; col < 4; col++)
+	{
+		void *vertexOffset = (void *)(offset + offsetof(LOGLInstance, model) + (col * sizeof(DqnV4)));
+		glVertexAttribPointer(shaderInLoc + col, 4, GL_FLOAT, GL_FALSE, sizeof(LOGLInstance), vertexOffset);
+	}
 
-				// Setup spot lights
-				if (1)
-				{
-					glContext->uniformSpotLightAmbient  = glGetUniformLocation(glContext->mainShaderId, "spotLight.ambient");
-					glContext->uniformSpotLightDiffuse  = glGetUniformLocation(glContext->mainShaderId, "spotLight.diffuse");
-					glContext->uniformSpotLightSpecular = glGetUniformLocation(glContext->mainShaderId, "spotLight.specular");
-					DQN_ASSERT(glContext->uniformSpotLightAmbient != -1);
-					DQN_ASSERT(glContext->uniformSpotLightDiffuse != -1);
-					DQN_ASSERT(glContext->uniformSpotLightSpecular != -1);
-
-					glContext->uniformSpotLightConstant  = glGetUniformLocation(glContext->mainShaderId, "spotLight.constant");
-					glContext->uniformSpotLightLinear    = glGetUniformLocation(glContext->mainShaderId, "spotLight.linear");
-					glContext->uniformSpotLightQuadratic = glGetUniformLocation(glContext->mainShaderId, "spotLight.quadratic");
-					DQN_ASSERT(glContext->uniformSpotLightConstant != -1);
-					DQN_ASSERT(glContext->uniformSpotLightLinear != -1);
-					DQN_ASSERT(glContext->uniformSpotLightQuadratic != -1);
-
-					glContext->uniformSpotLightPos         = glGetUniformLocation(glContext->mainShaderId, "spotLight.position");
-					glContext->uniformSpotLightDir         = glGetUniformLocation(glContext->mainShaderId, "spotLight.direction");
-					glContext->uniformSpotLightCutOff      = glGetUniformLocation(glContext->mainShaderId, "spotLight.cutOff");
-					glContext->uniformSpotLightOuterCutOff = glGetUniformLocation(glContext->mainShaderId, "spotLight.outerCutOff");
-					DQN_ASSERT(glContext->uniformSpotLightPos != -1);
-					DQN_ASSERT(glContext->uniformSpotLightDir != -1);
-					DQN_ASSERT(glContext->uniformSpotLightCutOff != -1);
-					DQN_ASSERT(glContext->uniformSpotLightOuterCutOff != -1);
-				}
+	const u32 normalShaderInLoc = shaderInLoc + 4;
+	for (u32 col = 0; col < 3; col++)
+	{
+		void *vertexOffset = (void *)(offset + offsetof(LOGLInstance, normalMatrix) + (col * sizeof(DqnV3)));
+		glVertexAttribPointer(normalShaderInLoc + col, 3, GL_FLOAT, GL_FALSE, sizeof(LOGLInstance), vertexOffset);
+	}
+}
 
-				// Upload projection to GPU
-				glUniformMatrix4fv(glContext->uniformProjectionLoc, 1, GL_FALSE, (f32 *)projection.e);
-			}
+// Map room for numInstances in the frame arena's vbo. The pointer can be written from any thread but
+// must be unmapped on the main thread before drawing.
+// offset: Set to the offset of the first instance in the vbo
+// return: NULL if numInstances is 0, the frame's region is full or the buffer could not be mapped.
+FILE_SCOPE LOGLInstance *LOGL_MapInstances(LOGLStateCache *const stateCache, LOGLFrameArena *const arena,
+                                           const u32 numInstances, size_t *const offset)
+{
+	if (numInstances == 0) return NULL;
 
-			DQN_ASSERT_HARD(
-			    OpenGL_LinkShaderProgram(&glContext->lightShaderId, vertexShader, lightFragmentShader));
-			// Setup light shader uniforms
-			{
-				// Upload projection to GPU
-				glUseProgram(glContext->lightShaderId);
+	LOGLStateCache_BindBuffer(stateCache, GL_ARRAY_BUFFER, arena->vbo);
+	auto *result = (LOGLInstance *)LOGLFrameArena_MapVertices(arena, sizeof(LOGLInstance) * numInstances, offset);
+	DQN_ASSERT_MSG(result, "Frame arena vbo is out of room for %u instances", numInstances);
+	return result;
+}
+
+// Copy this frame's instances into the frame arena's vbo.
+// return: FALSE if they could not be mapped, see LOGL_MapInstances().
+FILE_SCOPE bool LOGL_UploadInstances(LOGLStateCache *const stateCache, LOGLFrameArena *const arena,
+                                     const LOGLInstance *const instances, const u32 numInstances,
+                                     size_t *const offset)
+{
+	LOGLInstance *dest = LOGL_MapInstances(stateCache, arena, numInstances, offset);
+	if (!dest) return false;
+
+	memcpy(dest, instances, sizeof(*instances) * numInstances);
+	glUnmapBuffer(GL_ARRAY_BUFFER);
+	return true;
+}
+
+FILE_SCOPE void LOGL_DrawInstanced(LOGLState *const state, const u32 numIndices, const u32 numInstances)
+{
+	glDrawElementsInstanced(GL_TRIANGLES, numIndices, GL_UNSIGNED_SHORT, NULL, numInstances);
+	state->renderStats.numDrawCalls++;
+	state->renderStats.numInstances += numInstances;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Transform Stage
+////////////////////////////////////////////////////////////////////////////////
+// The object list is split into chunks that run on the job queue in two passes. The first culls
+// each chunk against the frustum into a list of visible indices, the main thread then prefix sums
+// the chunk counts so the second pass knows where each chunk's instances go and can write them
+// straight into the mapped instance buffer with no locking, in the same order as the objects.
+
+// NOTE: Only a handful of matrix writes per object, smaller chunks cost more in scheduling than
+// they gain in balance across threads.
+#define LOGL_TRANSFORM_MIN_OBJECTS_PER_CHUNK 256
+#define LOGL_TRANSFORM_CHUNKS_PER_THREAD     4
+
+// Inputs shared by every chunk of one transform stage
+struct LOGLTransformParams
+{
+	const DqnV3           *positions;
+	const LOGLCullSpheres *bounds; // Bounding sphere of each position
+	LOGLFrustum            frustum;
+
+	DqnMat4 rotate;          // Shared rotation of every object, the position is the translation
+	DqnV3   normalMatrix[3]; // Columns of DqnMat4_NormalMatrix(rotate)
+
+	u32          *visibleIndices; // Written per chunk at the chunk's start index by the cull pass
+	LOGLInstance *instances;      // Mapped instance buffer the transform pass writes to
+};
+
+struct LOGLTransformChunk
+{
+	const LOGLTransformParams *params;
+	u32 start;
+	u32 count;
+	u32 numVisible;  // Output of the cull pass
+	u32 outputIndex; // Index of the chunk's first instance for the transform pass
+};
+
+FILE_SCOPE void LOGL_CullChunkJob(DqnJobQueue *const queue, void *const userData)
+{
+	LOGLTransformChunk *chunk         = (LOGLTransformChunk *)userData;
+	const LOGLTransformParams *params = chunk->params;
+	u32 *visibleIndices               = params->visibleIndices + chunk->start;
+	chunk->numVisible = LOGLCull_Spheres(&params->frustum, params->bounds, chunk->start, chunk->count, visibleIndices);
+}
+
+FILE_SCOPE void LOGL_TransformChunkJob(DqnJobQueue *const queue, void *const userData)
+{
+	LOGLTransformChunk *chunk         = (LOGLTransformChunk *)userData;
+	const LOGLTransformParams *params = chunk->params;
+	const u32 *visibleIndices         = params->visibleIndices + chunk->start;
+	LOGLInstance *instances           = params->instances + chunk->outputIndex;
+
+	for (u32 i = 0; i < chunk->numVisible; i++)
+	{
+		LOGLInstance *instance = &instances[i];
+		instance->model        = params->rotate;
+		instance->model.col[3] = DqnV4_V3(params->positions[visibleIndices[i]], 1.0f);
+		for (u32 col = 0; col < 3; col++)
+			instance->normalMatrix[col] = params->normalMatrix[col];
+	}
+}
+
+// Run callback on every chunk and return once they are all complete. Chunks are run on the calling
+// thread if there is no queue or it doesn't accept jobs from this thread.
+FILE_SCOPE void LOGL_RunChunkJobs(DqnJobQueue *const queue, DqnJob_Callback *const callback,
+                                  LOGLTransformChunk *const chunks, const u32 numChunks)
+{
+	// NOTE: Wait on a counter rather than the whole queue, other work like texture loads can be in flight
+	DqnJobCounter counter = {};
+	for (u32 i = 0; i < numChunks; i++)
+	{
+		DqnJob job = {callback, &chunks[i], &counter};
+		if (!queue || !DqnJobQueue_AddJob(queue, job))
+			callback(queue, &chunks[i]);
+	}
+
+	DqnJobQueue_WaitForCounter(queue, &counter);
+}
+
+// Cull the objects and write the instances of the visible ones into the frame arena's vbo.
+// instanceOffset: Set to the offset of the first instance in the vbo
+// return: The number of instances written, 0 if nothing was visible or they could not be mapped.
+FILE_SCOPE u32 LOGL_TransformStage(DqnMemStack *const tempStack, DqnJobQueue *const queue, const u32 numThreads,
+                                   LOGLTransformParams *const params, const u32 numObjects,
+                                   LOGLStateCache *const stateCache, LOGLFrameArena *const arena,
+                                   size_t *const instanceOffset)
+{
+	if (numObjects == 0) return 0;
+
+	auto memRegion = tempStack->TempRegionGuard();
+	u32 maxChunks  = DQN_MAX(1u, (numThreads + 1) * LOGL_TRANSFORM_CHUNKS_PER_THREAD);
+	u32 numChunks  = (numObjects + LOGL_TRANSFORM_MIN_OBJECTS_PER_CHUNK - 1) / LOGL_TRANSFORM_MIN_OBJECTS_PER_CHUNK;
+	numChunks      = DQN_MIN(numChunks, maxChunks);
+
+	LOGLTransformChunk *chunks = (LOGLTransformChunk *)tempStack->Push(sizeof(*chunks) * numChunks);
+	params->visibleIndices     = (u32 *)tempStack->Push(sizeof(*params->visibleIndices) * numObjects);
+	if (!DQN_ASSERT(chunks && params->visibleIndices)) return 0;
+
+	u32 objectsPerChunk = numObjects / numChunks;
+	u32 remainder       = numObjects % numChunks;
+	u32 start           = 0;
+	for (u32 i = 0; i < numChunks; i++)
+	{
+		chunks[i]        = {};
+		chunks[i].params = params;
+		chunks[i].start  = start;
+		chunks[i].count  = objectsPerChunk + ((i < remainder) ? 1 : 0);
+		start           += chunks[i].count;
+	}
+
+	LOGL_RunChunkJobs(queue, LOGL_CullChunkJob, chunks, numChunks);
+
+	u32 numVisible = 0;
+	for (u32 i = 0; i < numChunks; i++)
+	{
+		chunks[i].outputIndex = numVisible;
+		numVisible           += chunks[i].numVisible;
+	}
+
+	params->instances = LOGL_MapInstances(stateCache, arena, numVisible, instanceOffset);
+	if (!params->instances) return 0;
+
+	LOGL_RunChunkJobs(queue, LOGL_TransformChunkJob, chunks, numChunks);
+	glUnmapBuffer(GL_ARRAY_BUFFER);
+	return numVisible;
+}
+
+// The shader files each program is built from, in LOGL_SHADER_DIR
+struct LOGLShaderProgramFiles
+{
+	const char *name;
+	const char *vertexPath;
+	const char *fragmentPath;
+};
+
+FILE_SCOPE const LOGLShaderProgramFiles LOGL_SHADER_PROGRAM_FILES[LOGLProgram_Count] = {
+    {"main",  "main.vert", "main.frag"},
+    {"light", "main.vert", "light.frag"},
+};
+
+// return: The file's contents null terminated in memStack, NULL if it couldn't be read.
+FILE_SCOPE char *LOGL_ReadShaderFile(DqnMemStack *const memStack, const char *const fileName)
+{
+	char path[256];
+	Dqn_sprintf(path, "%s/%s", LOGL_SHADER_DIR, fileName);
+
+	size_t fileSize;
+	char *result = NULL;
+	if (DqnFile_GetFileSize(path, &fileSize)) result = (char *)memStack->Push(fileSize + 1);
+
+	size_t bytesRead;
+	if (!result || !DqnFile_ReadEntireFile(path, (u8 *)result, fileSize, &bytesRead) || bytesRead != fileSize)
+	{
+		printf("LOGL: Failed to read shader %s\n", path);
+		return NULL;
+	}
+
+	result[fileSize] = 0;
+	return result;
+}
+
+// return: The location of a uniform of the live program, -1 if it has none, which GL ignores.
+#define LOGL_Uniform(state, type, name) LOGLShader_Uniform(&(state)->programs[type].uniforms, LOGL_UNIFORM(name))
+
+// Reflect the uniforms of a program that was just swapped in and set the ones that don't change per
+// frame. Programs only get the ones they declare, a uniform a program doesn't use, like one an edit
+// optimised out, has location -1 which GL ignores, so it isn't an error.
+FILE_SCOPE void LOGL_SetupProgram(LOGLState *const state, const enum LOGLProgram type)
+{
+	LOGLStateCache *const stateCache = &state->glContext.stateCache;
+	LOGLShaderProgram *const shader  = &state->programs[type];
+	if (!LOGLShader_ReflectUniforms(shader->program, &shader->uniforms))
+		printf("LOGL: Failed to hash the uniforms of %s\n", LOGL_SHADER_PROGRAM_FILES[type].name);
+
+	LOGLStateCache_UseProgram(stateCache, shader->program);
+	LOGLStateCache_UniformMatrix4fv(stateCache, LOGL_Uniform(state, type, "projection"), (f32 *)state->projection.e);
 
-				glContext->lightUniformProjectionLoc = glGetUniformLocation(glContext->lightShaderId, "projection");
-				glContext->lightUniformViewLoc       = glGetUniformLocation(glContext->lightShaderId, "view");
-				glContext->lightUniformModelLoc      = glGetUniformLocation(glContext->lightShaderId, "model");
-				DQN_ASSERT(glContext->lightUniformProjectionLoc != -1);
-				DQN_ASSERT(glContext->lightUniformViewLoc != -1);
-				DQN_ASSERT(glContext->lightUniformModelLoc != -1);
+	// Set the uniform sampler2D to use GL_TEXTURE0 and 1
+	LOGLStateCache_Uniform1i(stateCache, LOGL_Uniform(state, type, "material.diffuse"), 0);
+	LOGLStateCache_Uniform1i(stateCache, LOGL_Uniform(state, type, "material.specular"), 1);
 
-				glUniformMatrix4fv(glContext->lightUniformProjectionLoc, 1, GL_FALSE, (f32 *)projection.e);
+	u32 lightsBlockIndex = glGetUniformBlockIndex(shader->program, "Lights");
+	if (lightsBlockIndex != GL_INVALID_INDEX)
+		glUniformBlockBinding(shader->program, lightsBlockIndex, LOGLUniformBlockBinding_Lights);
+}
+
+// Start rebuilding a program from its shader files, unless they haven't changed since the live
+// program or the rebuild in flight was started. A rebuild of older sources is cancelled.
+FILE_SCOPE void LOGL_RebuildProgram(LOGLState *const state, DqnMemStack *const tempStack, const enum LOGLProgram type)
+{
+	auto tempRegion = tempStack->TempRegionGuard();
+
+	const LOGLShaderProgramFiles *files = &LOGL_SHADER_PROGRAM_FILES[type];
+	LOGLShaderProgram *const shader     = &state->programs[type];
+	char *vertexSrc                     = LOGL_ReadShaderFile(tempStack, files->vertexPath);
+	char *fragmentSrc                   = LOGL_ReadShaderFile(tempStack, files->fragmentPath);
+	if (!vertexSrc || !fragmentSrc) return;
+
+	u64 sourceHash = LOGLShader_HashSources(vertexSrc, fragmentSrc);
+	if (shader->rebuild.state != LOGLShaderBuildState_None)
+	{
+		if (shader->rebuild.sourceHash == sourceHash) return;
+		LOGLShader_CancelBuild(&shader->rebuild);
+	}
+	else if (shader->program && shader->sourceHash == sourceHash)
+	{
+		return;
+	}
+
+	LOGLShader_BeginBuild(&state->shaderCache, tempStack, vertexSrc, fragmentSrc, &shader->rebuild);
+}
+
+// Swap in the programs whose rebuild linked, on init wait for them to be done.
+FILE_SCOPE void LOGL_UpdatePrograms(LOGLState *const state, DqnMemStack *const tempStack, const bool wait)
+{
+	for (u32 type = 0; type < LOGLProgram_Count; type++)
+	{
+		LOGLShaderProgram *const shader = &state->programs[type];
+		LOGLShaderBuild *const rebuild  = &shader->rebuild;
+		if (rebuild->state == LOGLShaderBuildState_None) continue;
+
+		const char *name = LOGL_SHADER_PROGRAM_FILES[type].name;
+		if (!LOGLShader_PollBuild(&state->shaderCache, tempStack, rebuild, name, wait)) continue;
+
+		if (rebuild->state == LOGLShaderBuildState_Linked)
+		{
+			if (shader->program)
+			{
+				LOGLStateCache_DeleteProgram(&state->glContext.stateCache, shader->program);
+				state->shaderReloadStats.numReloads++;
 			}
 
-			glDeleteShader(vertexShader);
-			glDeleteShader(fragmentShader);
-			glDeleteShader(lightFragmentShader);
+			shader->program    = rebuild->program;
+			shader->sourceHash = rebuild->sourceHash;
+			LOGL_SetupProgram(state, (enum LOGLProgram)type);
+		}
+		else if (shader->program)
+		{
+			state->shaderReloadStats.numReloadsFailed++;
+		}
+
+		*rebuild = {};
+	}
+}
+
+// Sort the frame's draws and issue them in key order. The per frame uniforms are set each time a
+// program is switched to, the state cache drops them if the program already has them.
+FILE_SCOPE void LOGL_ExecuteRenderQueue(LOGLState *const state, const LOGLFrameArena *const arena,
+                                        LOGLRenderQueue *const queue, const DqnMat4 *const view)
+{
+	LOGLStateCache *const stateCache = &state->glContext.stateCache;
+	LOGLRenderQueue_Sort(queue);
+	state->renderStats.numPackets += queue->numPackets;
+
+	const LOGLRenderPacket *prevPacket = NULL;
+	for (u32 i = 0; i < queue->numPackets; i++)
+	{
+		const LOGLRenderPacket *packet = &queue->packets[queue->entries[i].index];
+		const u32 type                 = packet->program;
+		if (!state->programs[type].program) continue;
+
+		if (!prevPacket || prevPacket->program != packet->program) state->renderStats.numStateChanges++;
+		if (!prevPacket || prevPacket->vao != packet->vao) state->renderStats.numStateChanges++;
+		if (packet->material && (!prevPacket || prevPacket->material != packet->material))
+			state->renderStats.numStateChanges++;
+		prevPacket = packet;
+
+		LOGLStateCache_UseProgram(stateCache, state->programs[type].program);
+		LOGLStateCache_UniformMatrix4fv(stateCache, LOGL_Uniform(state, type, "view"), (f32 *)view->e);
+		LOGLStateCache_Uniform3fv(stateCache, LOGL_Uniform(state, type, "viewPos"), state->cameraP.e);
+		LOGLStateCache_BindVertexArray(stateCache, packet->vao);
+		LOGL_PointInstanceAttribs(stateCache, arena, packet->instanceOffset);
+
+		if (const LOGLMaterial *material = packet->material)
+		{
+			LOGL_BindTexture(stateCache, 0, &state->textureCache, material->diffuse);
+			LOGL_BindTexture(stateCache, 1, &state->textureCache, material->specular);
+			LOGLStateCache_Uniform1f(stateCache, LOGL_Uniform(state, type, "material.shininess"), material->shininess);
+		}
+
+		LOGL_DrawInstanced(state, packet->numIndices, packet->numInstances);
+	}
+}
+
+void LOGL_Update(struct PlatformInput *const input, struct PlatformMemory *const memory)
+{
+	DqnMemStack *const mainStack  = &memory->mainStack;
+	DqnMemStack *const tempStack  = &memory->tempStack;
+	auto tempRegion               = tempStack->TempRegionGuard();
+	DqnMemStack *const frameStack = LOGLFrameArena_BeginFrame(&memory->frameArena);
+
+	if (!memory->state)
+	{
+		memory->state = (LOGLState *)memory->mainStack.Push(sizeof(*memory->state));
+		if (!memory->state)
+		{
+			LOGLFrameArena_EndFrame(&memory->frameArena);
+			return;
+		}
+
+		LOGLState *const state       = memory->state;
+		LOGLContext *const glContext = &state->glContext;
+
+		LOGLStateCache_InvalidateBindings(&glContext->stateCache);
+
+		// Build shaders
+		{
+			// NOTE: The uniforms set when a program is swapped in need the projection
+			f32 fovDegrees    = 45.0f;
+			f32 aspectRatio   = input->screenDim.w / input->screenDim.h;
+			state->projection = DqnMat4_Perspective(fovDegrees, aspectRatio, 0.1f, 100.0f);
+
+			LOGLShader_InitCache(&state->shaderCache, memory->shaderCacheDir);
+			for (u32 type = 0; type < LOGLProgram_Count; type++)
+				LOGL_RebuildProgram(state, tempStack, (enum LOGLProgram)type);
+			LOGL_UpdatePrograms(state, tempStack, true);
+		}
+
+		// Setup light uniform block
+		{
+			// NOTE: The mirror starts zeroed, so the first frame's upload sends the whole block
+			glContext->lightBlock = {};
+			glGenBuffers(1, &glContext->lightUbo);
+			glBindBuffer(GL_UNIFORM_BUFFER, glContext->lightUbo);
+			glBufferData(GL_UNIFORM_BUFFER, sizeof(glContext->lightBlock), &glContext->lightBlock, GL_DYNAMIC_DRAW);
+			glBindBufferBase(GL_UNIFORM_BUFFER, LOGLUniformBlockBinding_Lights, glContext->lightUbo);
 		}
 
 		// Init geometry
@@ -419,73 +1017,70 @@ void LOGL_Update(struct PlatformInput *const input, struct PlatformMemory *const
 			glBindVertexArray(glContext->vao);
 
 			f32 vertices[] = {
-			    // positions          // color  // tex coords //normals
-			    -0.5f, -0.5f, -0.5f,  1, 1, 1,  0.0f, 0.0f,   0.0f,  0.0f, -1.0f,//
-			     0.5f, -0.5f, -0.5f,  1, 1, 1,  1.0f, 0.0f,   0.0f,  0.0f, -1.0f,//
-			     0.5f,  0.5f, -0.5f,  1, 1, 1,  1.0f, 1.0f,   0.0f,  0.0f, -1.0f,//
-			     0.5f,  0.5f, -0.5f,  1, 1, 1,  1.0f, 1.0f,   0.0f,  0.0f, -1.0f,//
-			    -0.5f,  0.5f, -0.5f,  1, 1, 1,  0.0f, 1.0f,   0.0f,  0.0f, -1.0f,//
-			    -0.5f, -0.5f, -0.5f,  1, 1, 1,  0.0f, 0.0f,   0.0f,  0.0f, -1.0f,//
-
-			    -0.5f, -0.5f,  0.5f,  1, 1, 1,  0.0f, 0.0f,   0.0f,  0.0f, 1.0f, //
-			     0.5f, -0.5f,  0.5f,  1, 1, 1,  1.0f, 0.0f,   0.0f,  0.0f, 1.0f, //
-			     0.5f,  0.5f,  0.5f,  1, 1, 1,  1.0f, 1.0f,   0.0f,  0.0f, 1.0f, //
-			     0.5f,  0.5f,  0.5f,  1, 1, 1,  1.0f, 1.0f,   0.0f,  0.0f, 1.0f, //
-			    -0.5f,  0.5f,  0.5f,  1, 1, 1,  0.0f, 1.0f,   0.0f,  0.0f, 1.0f, //
-			    -0.5f, -0.5f,  0.5f,  1, 1, 1,  0.0f, 0.0f,   0.0f,  0.0f, 1.0f, //
-
-			    -0.5f,  0.5f,  0.5f,  1, 1, 1,  1.0f, 0.0f,   1.0f,  0.0f,  0.0f,//
-			    -0.5f,  0.5f, -0.5f,  1, 1, 1,  1.0f, 1.0f,   1.0f,  0.0f,  0.0f,//
-			    -0.5f, -0.5f, -0.5f,  1, 1, 1,  0.0f, 1.0f,   1.0f,  0.0f,  0.0f,//
-			    -0.5f, -0.5f, -0.5f,  1, 1, 1,  0.0f, 1.0f,   1.0f,  0.0f,  0.0f,//
-			    -0.5f, -0.5f,  0.5f,  1, 1, 1,  0.0f, 0.0f,   1.0f,  0.0f,  0.0f,//
-			    -0.5f,  0.5f,  0.5f,  1, 1, 1,  1.0f, 0.0f,   1.0f,  0.0f,  0.0f,//
-
-			     0.5f,  0.5f,  0.5f,  1, 1, 1,  1.0f, 0.0f,   1.0f,  0.0f,  0.0f,//
-			     0.5f,  0.5f, -0.5f,  1, 1, 1,  1.0f, 1.0f,   1.0f,  0.0f,  0.0f,//
-			     0.5f, -0.5f, -0.5f,  1, 1, 1,  0.0f, 1.0f,   1.0f,  0.0f,  0.0f,//
-			     0.5f, -0.5f, -0.5f,  1, 1, 1,  0.0f, 1.0f,   1.0f,  0.0f,  0.0f,//
-			     0.5f, -0.5f,  0.5f,  1, 1, 1,  0.0f, 0.0f,   1.0f,  0.0f,  0.0f,//
-			     0.5f,  0.5f,  0.5f,  1, 1, 1,  1.0f, 0.0f,   1.0f,  0.0f,  0.0f,//
-
-			    -0.5f, -0.5f, -0.5f,  1, 1, 1,  0.0f, 1.0f,   0.0f, -1.0f,  0.0f,//
-			     0.5f, -0.5f, -0.5f,  1, 1, 1,  1.0f, 1.0f,   0.0f, -1.0f,  0.0f,//
-			     0.5f, -0.5f,  0.5f,  1, 1, 1,  1.0f, 0.0f,   0.0f, -1.0f,  0.0f,//
-			     0.5f, -0.5f,  0.5f,  1, 1, 1,  1.0f, 0.0f,   0.0f, -1.0f,  0.0f,//
-			    -0.5f, -0.5f,  0.5f,  1, 1, 1,  0.0f, 0.0f,   0.0f, -1.0f,  0.0f,//
-			    -0.5f, -0.5f, -0.5f,  1, 1, 1,  0.0f, 1.0f,   0.0f, -1.0f,  0.0f,//
-
-			    -0.5f,  0.5f, -0.5f,  1, 1, 1,  0.0f, 1.0f,   0.0f,  1.0f,  0.0f,//
-			     0.5f,  0.5f, -0.5f,  1, 1, 1,  1.0f, 1.0f,   0.0f,  1.0f,  0.0f,//
-			     0.5f,  0.5f,  0.5f,  1, 1, 1,  1.0f, 0.0f,   0.0f,  1.0f,  0.0f,//
-			     0.5f,  0.5f,  0.5f,  1, 1, 1,  1.0f, 0.0f,   0.0f,  1.0f,  0.0f,//
-			    -0.5f,  0.5f,  0.5f,  1, 1, 1,  0.0f, 0.0f,   0.0f,  1.0f,  0.0f,//
-			    -0.5f,  0.5f, -0.5f,  1, 1, 1,  0.0f, 1.0f,   0.0f,  1.0f,  0.0f,//
+			    // positions          // tex coords //normals
+			    -0.5f, -0.5f, -0.5f,  0.0f, 0.0f,   0.0f,  0.0f, -1.0f,//
+			     0.5f, -0.5f, -0.5f,  1.0f, 0.0f,   0.0f,  0.0f, -1.0f,//
+			     0.5f,  0.5f, -0.5f,  1.0f, 1.0f,   0.0f,  0.0f, -1.0f,//
+			     0.5f,  0.5f, -0.5f,  1.0f, 1.0f,   0.0f,  0.0f, -1.0f,//
+			    -0.5f,  0.5f, -0.5f,  0.0f, 1.0f,   0.0f,  0.0f, -1.0f,//
+			    -0.5f, -0.5f, -0.5f,  0.0f, 0.0f,   0.0f,  0.0f, -1.0f,//
+
+			    -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,   0.0f,  0.0f, 1.0f, //
+			     0.5f, -0.5f,  0.5f,  1.0f, 0.0f,   0.0f,  0.0f, 1.0f, //
+			     0.5f,  0.5f,  0.5f,  1.0f, 1.0f,   0.0f,  0.0f, 1.0f, //
+			     0.5f,  0.5f,  0.5f,  1.0f, 1.0f,   0.0f,  0.0f, 1.0f, //
+			    -0.5f,  0.5f,  0.5f,  0.0f, 1.0f,   0.0f,  0.0f, 1.0f, //
+			    -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,   0.0f,  0.0f, 1.0f, //
+
+			    -0.5f,  0.5f,  0.5f,  1.0f, 0.0f,   1.0f,  0.0f,  0.0f,//
+			    -0.5f,  0.5f, -0.5f,  1.0f, 1.0f,   1.0f,  0.0f,  0.0f,//
+			    -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,   1.0f,  0.0f,  0.0f,//
+			    -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,   1.0f,  0.0f,  0.0f,//
+			    -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,   1.0f,  0.0f,  0.0f,//
+			    -0.5f,  0.5f,  0.5f,  1.0f, 0.0f,   1.0f,  0.0f,  0.0f,//
+
+			     0.5f,  0.5f,  0.5f,  1.0f, 0.0f,   1.0f,  0.0f,  0.0f,//
+			     0.5f,  0.5f, -0.5f,  1.0f, 1.0f,   1.0f,  0.0f,  0.0f,//
+			     0.5f, -0.5f, -0.5f,  0.0f, 1.0f,   1.0f,  0.0f,  0.0f,//
+			     0.5f, -0.5f, -0.5f,  0.0f, 1.0f,   1.0f,  0.0f,  0.0f,//
+			     0.5f, -0.5f,  0.5f,  0.0f, 0.0f,   1.0f,  0.0f,  0.0f,//
+			     0.5f,  0.5f,  0.5f,  1.0f, 0.0f,   1.0f,  0.0f,  0.0f,//
+
+			    -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,   0.0f, -1.0f,  0.0f,//
+			     0.5f, -0.5f, -0.5f,  1.0f, 1.0f,   0.0f, -1.0f,  0.0f,//
+			     0.5f, -0.5f,  0.5f,  1.0f, 0.0f,   0.0f, -1.0f,  0.0f,//
+			     0.5f, -0.5f,  0.5f,  1.0f, 0.0f,   0.0f, -1.0f,  0.0f,//
+			    -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,   0.0f, -1.0f,  0.0f,//
+			    -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,   0.0f, -1.0f,  0.0f,//
+
+			    -0.5f,  0.5f, -0.5f,  0.0f, 1.0f,   0.0f,  1.0f,  0.0f,//
+			     0.5f,  0.5f, -0.5f,  1.0f, 1.0f,   0.0f,  1.0f,  0.0f,//
+			     0.5f,  0.5f,  0.5f,  1.0f, 0.0f,   0.0f,  1.0f,  0.0f,//
+			     0.5f,  0.5f,  0.5f,  1.0f, 0.0f,   0.0f,  1.0f,  0.0f,//
+			    -0.5f,  0.5f,  0.5f,  0.0f, 0.0f,   0.0f,  1.0f,  0.0f,//
+			    -0.5f,  0.5f, -0.5f,  0.0f, 1.0f,   0.0f,  1.0f,  0.0f,//
 			};
 
+			// NOTE: The array is authored unindexed, 6 vertices a face, build welds the shared
+			// corners of each face's two triangles into an index buffer.
+			const u32 numSrcVertices = DQN_ARRAY_COUNT(vertices) / (sizeof(LOGLMeshSourceVertex) / sizeof(f32));
+			LOGLMesh *cubeMesh       = &state->cubeMesh;
+			DQN_ASSERT_HARD(LOGL_BuildMesh(mainStack, tempStack, (LOGLMeshSourceVertex *)vertices, numSrcVertices,
+			                               cubeMesh));
+
 			// Copy vertices into a vertex buffer and upload to GPU
 			glGenBuffers(1, &glContext->vbo);
 			glBindBuffer(GL_ARRAY_BUFFER, glContext->vbo);
-			glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-			// Copy indices into vertex buffer and upload to GPU
-#if 0
-			u32 indices[] = {
-			    0, 1, 3, // first triangle
-			    1, 2, 3  // second triangle
-			};
+			glBufferData(GL_ARRAY_BUFFER, sizeof(*cubeMesh->vertices) * cubeMesh->numVertices, cubeMesh->vertices,
+			             GL_STATIC_DRAW);
 
+			// Copy indices into element buffer and upload to GPU, the binding is recorded in the bound VAO
 			glGenBuffers(1, &glContext->ebo);
 			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, glContext->ebo);
-			glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
-#endif
+			glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(*cubeMesh->indices) * cubeMesh->numIndices, cubeMesh->indices,
+			             GL_STATIC_DRAW);
 
-			const u32 numPosComponents    = 3;
-			const u32 numColorComponents  = 3;
-			const u32 numTexComponents    = 2;
-			const u32 numNormalComponents = 3;
-			const u32 stride       = sizeof(f32) * (numPosComponents + numColorComponents + numTexComponents + numNormalComponents);
-			GLboolean isNormalised = GL_FALSE;
+			const u32 stride = sizeof(LOGLVertex);
 
 			// Describe the vertex layout for OpenGL
 			if (1)
@@ -493,33 +1088,29 @@ void LOGL_Update(struct PlatformInput *const input, struct PlatformMemory *const
 				// Set the vertex attributes pointer for pos
 				{
 					const u32 shaderInLoc = 0;
-					glVertexAttribPointer(shaderInLoc, numPosComponents, GL_FLOAT, isNormalised, stride, NULL);
-					glEnableVertexAttribArray(shaderInLoc);
-				}
-
-				// Set the vertex attributes pointer for color
-				{
-					const u32 shaderInLoc = 1;
-					void *vertexOffset = (void *)(numPosComponents * sizeof(f32));
-					glVertexAttribPointer(shaderInLoc, numColorComponents, GL_FLOAT, isNormalised, stride, vertexOffset);
+					void *vertexOffset    = (void *)offsetof(LOGLVertex, pos);
+					glVertexAttribPointer(shaderInLoc, 3, GL_FLOAT, GL_FALSE, stride, vertexOffset);
 					glEnableVertexAttribArray(shaderInLoc);
 				}
 
 				// Set the vertex attributes pointer for textures
 				{
 					const u32 shaderInLoc = 2;
-					void *vertexOffset = (void *)((numColorComponents + numPosComponents) * sizeof(f32));
-					glVertexAttribPointer(shaderInLoc, numTexComponents, GL_FLOAT, isNormalised, stride, vertexOffset);
+					void *vertexOffset    = (void *)offsetof(LOGLVertex, texCoord);
+					glVertexAttribPointer(shaderInLoc, 2, GL_HALF_FLOAT, GL_FALSE, stride, vertexOffset);
 					glEnableVertexAttribArray(shaderInLoc);
 				}
 
 				// Set the vertex attributes pointer for normals
 				{
+					// NOTE: Packed formats must be given a size of 4, the shader ignores w
 					const u32 shaderInLoc = 3;
-					void *vertexOffset = (void *)((numColorComponents + numPosComponents + numTexComponents) * sizeof(f32));
-					glVertexAttribPointer(shaderInLoc, numNormalComponents, GL_FLOAT, isNormalised, stride, vertexOffset);
+					void *vertexOffset    = (void *)offsetof(LOGLVertex, normal);
+					glVertexAttribPointer(shaderInLoc, 4, GL_INT_2_10_10_10_REV, GL_TRUE, stride, vertexOffset);
 					glEnableVertexAttribArray(shaderInLoc);
 				}
+
+				LOGL_InitInstanceAttribs();
 			}
 
 			// Init lights
@@ -527,80 +1118,43 @@ void LOGL_Update(struct PlatformInput *const input, struct PlatformMemory *const
 				glGenVertexArrays(1, &glContext->lightVao);
 				glBindVertexArray(glContext->lightVao);
 				glBindBuffer(GL_ARRAY_BUFFER, glContext->vbo);
+				glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, glContext->ebo);
 
 				// Use just the pos data from the vertices array array
 				{
 					const u32 shaderInLoc = 0;
-					glVertexAttribPointer(shaderInLoc, numPosComponents, GL_FLOAT, isNormalised, stride, NULL);
+					void *vertexOffset    = (void *)offsetof(LOGLVertex, pos);
+					glVertexAttribPointer(shaderInLoc, 3, GL_FLOAT, GL_FALSE, stride, vertexOffset);
 					glEnableVertexAttribArray(shaderInLoc);
 				}
+
+				LOGL_InitInstanceAttribs();
 			}
 		}
 
 		// Load assets
 		{
-			stbi_set_flip_vertically_on_load(true);
-			auto regionGuard   = mainStack->TempRegionGuard();
-			LOGLBitmap *bitmap = (LOGLBitmap *)mainStack->Push(sizeof(LOGLBitmap));
-			if (LOGL_LoadBitmap(mainStack, tempStack, bitmap, "container.jpg"))
-			{
-				glGenTextures(1, &glContext->texIdContainer);
-				glBindTexture(GL_TEXTURE_2D, glContext->texIdContainer);
-
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_LINEAR);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, bitmap->dim.w, bitmap->dim.h, 0, GL_RGB,
-				             GL_UNSIGNED_BYTE, bitmap->memory);
-				glGenerateMipmap(GL_TEXTURE_2D);
-			}
-
-			*bitmap = {};
-			if (LOGL_LoadBitmap(mainStack, tempStack, bitmap, "awesomeface.png"))
-			{
-				glGenTextures(1, &glContext->texIdFace);
-				glBindTexture(GL_TEXTURE_2D, glContext->texIdFace);
-
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-		        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, bitmap->dim.w, bitmap->dim.h, 0, GL_RGBA, GL_UNSIGNED_BYTE, bitmap->memory);
-		        glGenerateMipmap(GL_TEXTURE_2D);
-			}
-
-			*bitmap = {};
-			if (LOGL_LoadBitmap(mainStack, tempStack, bitmap, "container2.png"))
-			{
-				glGenTextures(1, &glContext->texIdCrate);
-				glBindTexture(GL_TEXTURE_2D, glContext->texIdCrate);
-
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, bitmap->dim.w, bitmap->dim.h, 0, GL_RGBA, GL_UNSIGNED_BYTE, bitmap->memory);
-				glGenerateMipmap(GL_TEXTURE_2D);
-			}
-
-			*bitmap = {};
-			if (LOGL_LoadBitmap(mainStack, tempStack, bitmap, "container2_specular.png"))
-			{
-				glGenTextures(1, &glContext->texIdCrateSpecular);
-				glBindTexture(GL_TEXTURE_2D, glContext->texIdCrateSpecular);
-
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, bitmap->dim.w, bitmap->dim.h, 0, GL_RGBA, GL_UNSIGNED_BYTE, bitmap->memory);
-				glGenerateMipmap(GL_TEXTURE_2D);
-			}
+			state->textureLoadStartMs = DqnTimer_NowInMs();
+
+			LOGLTextureCache *cache = &state->textureCache;
+			DQN_ASSERT_HARD(LOGL_InitTextureCache(mainStack, cache, 64, input->textureBudget));
+			cache->texIdPlaceholder = LOGL_CreatePlaceholderTexture();
+			cache->bcQuality        = (i32)input->bcQuality;
+			cache->queue            = memory->jobQueue;
+			cache->hasPack = (memory->assetPack && LOGLPack_Open(memory->assetPack, memory->assetPackSize, &cache->pack));
+
+			state->crateMaterial.diffuse   = LOGL_AcquireTexture(cache, "container2.png", GL_LINEAR);
+			state->crateMaterial.specular  = LOGL_AcquireTexture(cache, "container2_specular.png", GL_LINEAR);
+			state->crateMaterial.shininess = 32.0f;
+
+			// NOTE: The earlier tutorials' textures aren't drawn, they're loaded unreferenced so they're
+			// the first to go when the cache is over budget
+			LOGL_ReleaseTexture(cache, LOGL_AcquireTexture(cache, "container.jpg", GL_NEAREST_MIPMAP_LINEAR));
+			LOGL_ReleaseTexture(cache, LOGL_AcquireTexture(cache, "awesomeface.png", GL_LINEAR));
+
+			state->numPendingTextures = LOGL_UpdateTextureCache(&glContext->stateCache, cache, &state->assetStats);
+			if (state->numPendingTextures == 0)
+				state->assetStats.msToLoad = DqnTimer_NowInMs() - state->textureLoadStartMs;
 		}
 
 		// Setup GL environment
@@ -609,22 +1163,97 @@ void LOGL_Update(struct PlatformInput *const input, struct PlatformMemory *const
 			// glEnable(GL_CULL_FACE);
 		}
 
+		// NOTE: Init binds objects to set them up without going through the state cache
+		LOGLStateCache_InvalidateBindings(&glContext->stateCache);
+
 		// Setup state
 		{
+			// NOTE: DqnMat4_LookAt views down -cameraFront, so a yaw of 90 starts the camera facing -z,
+			// towards the cubes. At 0 it faces -x and the whole scene is culled.
 			state->cameraP     = DqnV3_3f(0, 0, 3);
-			state->cameraYaw   = 0;
+			state->cameraYaw   = 90;
 			state->cameraPitch = 0;
 		}
+
+		// Setup scene
+		{
+			DqnV3 defaultCubePositions[] = {
+			    DqnV3_3f(0.0f, 0.0f, 0.0f),     //
+			    DqnV3_3f(2.0f, 5.0f, -15.0f),   //
+			    DqnV3_3f(-1.5f, -2.2f, -2.5f),  //
+			    DqnV3_3f(-3.8f, -2.0f, -12.3f), //
+			    DqnV3_3f(2.4f, -0.4f, -3.5f),   //
+			    DqnV3_3f(-1.7f, 3.0f, -7.5f),   //
+			    DqnV3_3f(1.3f, -2.0f, -2.5f),   //
+			    DqnV3_3f(1.5f, 2.0f, -2.5f),    //
+			    DqnV3_3f(1.5f, 0.2f, -1.5f),    //
+			    DqnV3_3f(-1.3f, 1.0f, -1.5f)    //
+			};
+
+			state->numCubes      = (input->numCubes > 0) ? input->numCubes : DQN_ARRAY_COUNT(defaultCubePositions);
+			state->cubePositions = (DqnV3 *)mainStack->Push(sizeof(*state->cubePositions) * state->numCubes);
+			DQN_ASSERT_HARD(state->cubePositions);
+
+			u32 numDefaultCubes = DQN_MIN(state->numCubes, DQN_ARRAY_COUNT(defaultCubePositions));
+			for (u32 i = 0; i < numDefaultCubes; i++)
+				state->cubePositions[i] = defaultCubePositions[i];
+
+			// Scatter any extra cubes in a volume in front of the camera that grows with the count
+			DqnRandPCGState rnd;
+			DqnRnd_PCGInitWithSeed(&rnd, 0xC0BE);
+			f32 extent = cbrtf((f32)state->numCubes) * 3.0f;
+			for (u32 i = numDefaultCubes; i < state->numCubes; i++)
+			{
+				DqnV3 *pos = &state->cubePositions[i];
+				pos->x     = (DqnRnd_PCGNextf(&rnd) - 0.5f) * extent;
+				pos->y     = (DqnRnd_PCGNextf(&rnd) - 0.5f) * extent;
+				pos->z     = -2.0f - (DqnRnd_PCGNextf(&rnd) * extent);
+			}
+
+			// Bounding spheres for culling, a unit cube's fits its corners whichever way it's rotated
+			DQN_ASSERT_HARD(LOGLCull_AllocSpheres(mainStack, &state->cubeBounds, state->numCubes));
+			for (u32 i = 0; i < state->numCubes; i++)
+			{
+				state->cubeBounds.x[i]      = state->cubePositions[i].x;
+				state->cubeBounds.y[i]      = state->cubePositions[i].y;
+				state->cubeBounds.z[i]      = state->cubePositions[i].z;
+				state->cubeBounds.radius[i] = sqrtf(3.0f) * 0.5f;
+			}
+
+			// NOTE: Room for every cube and light to be visible in the same frame. Creating the vbo binds it
+			// outside the state cache.
+			LOGLFrameArena_InitGL(&memory->frameArena, sizeof(LOGLInstance) * (state->numCubes + LOGL_NUM_POINT_LIGHTS) +
+			                                               (LOGL_FRAME_ARENA_VBO_ALIGNMENT * 2));
+			LOGLStateCache_InvalidateBindings(&glContext->stateCache);
+		}
 	}
 
-	LOGLState *const state       = memory->state;
-	LOGLContext *const glContext = &state->glContext;
+	LOGLState *const state           = memory->state;
+	LOGLContext *const glContext     = &state->glContext;
+	LOGLStateCache *const stateCache = &glContext->stateCache;
 	state->totalDt += input->deltaForFrame;
+	state->renderStats = {};
+	stateCache->stats  = {};
+
+	// NOTE: The asset stats time the textures acquired on init, later loads are re-streams
+	bool initialLoad = (state->numPendingTextures > 0 && state->assetStats.msToLoad == 0);
+	if (initialLoad) state->assetStats.numFramesToLoad++;
+
+	state->numPendingTextures = LOGL_UpdateTextureCache(stateCache, &state->textureCache, &state->assetStats);
+	if (initialLoad && state->numPendingTextures == 0)
+		state->assetStats.msToLoad = DqnTimer_NowInMs() - state->textureLoadStartMs;
+
+	if (input->shadersChanged)
+	{
+		for (u32 type = 0; type < LOGLProgram_Count; type++)
+			LOGL_RebuildProgram(state, tempStack, (enum LOGLProgram)type);
+	}
+	LOGL_UpdatePrograms(state, tempStack, false);
 
 	glClearColor(0.1f, 0.1f, 0.1f, 0.1f);
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-	glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+	LOGLStateCache_PolygonMode(stateCache, GL_FILL);
 
 	// Calculate view matrix/camera code
 	if (1)
@@ -649,9 +1278,16 @@ void LOGL_Update(struct PlatformInput *const input, struct PlatformMemory *const
 		if (input->key_d.endedDown) state->cameraP += (cameraRight * cameraSpeed);
 
 		DqnMat4 view = DqnMat4_LookAt(state->cameraP, state->cameraP + cameraFront, cameraUp);
+		LOGLFrustum frustum;
+		LOGLCull_ExtractFrustum(DqnMat4_Mul(state->projection, view), &frustum);
+
 		// Render model code
 		if (1)
 		{
+			// NOTE: Packets live in the frame's stack, which is reset when its turn comes round again
+			LOGLRenderQueue renderQueue;
+			LOGLRenderQueue_Init(&renderQueue, frameStack, LOGL_MAX_RENDER_PACKETS);
+
 			DqnV3 pointLightPositions[] = {
 			    DqnV3_3f(0.7f, 0.2f, 2.0f),    //
 			    DqnV3_3f(2.3f, -3.3f, -4.0f),  //
@@ -660,167 +1296,508 @@ void LOGL_Update(struct PlatformInput *const input, struct PlatformMemory *const
 			};
 
 			// Light source
+			if (state->programs[LOGLProgram_Light].program)
 			{
-				glUseProgram(glContext->lightShaderId);
-				glBindVertexArray(glContext->lightVao);
-				glUniformMatrix4fv(glContext->lightUniformViewLoc, 1, GL_FALSE, (f32 *)view.e);
+				// The lights don't rotate so their box stays axis aligned, cull them as AABBs
+				const u32 numLights = DQN_ARRAY_COUNT(pointLightPositions);
+				const f32 lightSize = 0.25f;
+				f32 lightX[numLights], lightY[numLights], lightZ[numLights], lightExtent[numLights];
+				for (u32 i = 0; i < numLights; i++)
+				{
+					lightX[i]      = pointLightPositions[i].x;
+					lightY[i]      = pointLightPositions[i].y;
+					lightZ[i]      = pointLightPositions[i].z;
+					lightExtent[i] = lightSize * 0.5f;
+				}
+
+				LOGLCullAABBs lightBounds = {lightX, lightY, lightZ, lightExtent, lightExtent, lightExtent, numLights};
+				u32 visibleLights[numLights];
+				u32 numVisibleLights = LOGLCull_AABBs(&frustum, &lightBounds, 0, numLights, visibleLights);
+				state->renderStats.numCulled += numLights - numVisibleLights;
+
+				LOGLInstance instances[numLights];
+				for (u32 i = 0; i < numVisibleLights; i++)
+				{
+					DqnMat4 model      = DqnMat4_TranslateV3(pointLightPositions[visibleLights[i]]);
+					instances[i].model = DqnMat4_Mul(model, DqnMat4_ScaleV3(DqnV3_1f(lightSize)));
 
-				for (i32 i = 0; i < DQN_ARRAY_COUNT(pointLightPositions); i++)
+					DqnMat4 normalMatrix = DqnMat4_NormalMatrix(instances[i].model);
+					for (u32 col = 0; col < 3; col++)
+						instances[i].normalMatrix[col] = normalMatrix.col[col].xyz;
+				}
+
+				size_t instanceOffset = 0;
+				if (LOGL_UploadInstances(stateCache, &memory->frameArena, instances, numVisibleLights, &instanceOffset))
 				{
-					DqnMat4 model = DqnMat4_TranslateV3(pointLightPositions[i]);
-					model         = DqnMat4_Mul(model, DqnMat4_ScaleV3(DqnV3_1f(0.25f)));
-					glUniformMatrix4fv(glContext->lightUniformModelLoc, 1, GL_FALSE, (f32 *)model.e);
-					glDrawArrays(GL_TRIANGLES, 0, 36);
+					// NOTE: An instanced batch spans the scene, it has no one depth to sort by
+					u64 key = LOGLRenderQueue_MakeKey(LOGLRenderLayer_Opaque, LOGLProgram_Light, 0, 0);
+					if (LOGLRenderPacket *packet = LOGLRenderQueue_Submit(&renderQueue, key))
+					{
+						packet->program        = LOGLProgram_Light;
+						packet->vao            = glContext->lightVao;
+						packet->numIndices     = state->cubeMesh.numIndices;
+						packet->numInstances   = numVisibleLights;
+						packet->instanceOffset = instanceOffset;
+					}
 				}
 			}
 
 			// Cube
+			if (state->programs[LOGLProgram_Main].program)
 			{
 				f32 degreesRotate = state->totalDt * 15.0f;
 				f32 radiansRotate = DQN_DEGREES_TO_RADIANS(degreesRotate);
 
-				glUseProgram(glContext->mainShaderId);
-				glBindVertexArray(glContext->vao);
-
-				// Activate texture bindings for cube
-				{
-					glActiveTexture(GL_TEXTURE0);
-					glBindTexture(GL_TEXTURE_2D, glContext->texIdCrate);
-					glActiveTexture(GL_TEXTURE1);
-					glBindTexture(GL_TEXTURE_2D, glContext->texIdCrateSpecular);
-				}
-
-				// Set view data
-				glUniformMatrix4fv(glContext->uniformViewLoc, 1, GL_FALSE, (f32 *)view.e);
-				glUniform3fv(glContext->uniformViewPos, 1, state->cameraP.e);
-
 				// Setup light
 				{
+					LOGLLightBlock lightBlock = {};
+
 					// Set point light data
 					{
-						DQN_ASSERT(DQN_ARRAY_COUNT(glContext->uniformPointLights) == DQN_ARRAY_COUNT(pointLightPositions));
-						for (i32 i = 0; i < DQN_ARRAY_COUNT(glContext->uniformPointLights); i++)
+						DQN_ASSERT(DQN_ARRAY_COUNT(lightBlock.pointLights) == DQN_ARRAY_COUNT(pointLightPositions));
+						for (u32 i = 0; i < DQN_ARRAY_COUNT(lightBlock.pointLights); i++)
 						{
-							LOGLPointLight *light = &glContext->uniformPointLights[i];
-							glUniform3fv(light->pos, 1, pointLightPositions[i].e);
+							LOGLPointLight *light = &lightBlock.pointLights[i];
+							light->pos            = pointLightPositions[i];
 
-							glUniform3f(light->ambient , 0.05f, 0.05f, 0.05f);
-							glUniform3f(light->diffuse , 0.8f, 0.8f, 0.8f);
-							glUniform3f(light->specular, 1.0f, 1.0f, 1.0f);
+							light->ambient  = DqnV3_1f(0.05f);
+							light->diffuse  = DqnV3_1f(0.8f);
+							light->specular = DqnV3_1f(1.0f);
 
-							glUniform1f(light->constant , 1.0f);
-							glUniform1f(light->linear   , 0.09f);
-							glUniform1f(light->quadratic, 0.032f);
+							light->constant  = 1.0f;
+							light->linear    = 0.09f;
+							light->quadratic = 0.032f;
 						}
 					}
 
 					// Set dir light
 					{
-						glUniform3f(glContext->uniformDirLightDir, -0.2f, -1.0f, -0.3f);
-						glUniform3f(glContext->uniformDirLightAmbient,  0.05f, 0.05f, 0.05f);
-						glUniform3f(glContext->uniformDirLightDiffuse,  0.4f, 0.4f, 0.4f);
-						glUniform3f(glContext->uniformDirLightSpecular, 0.5f, 0.5f, 0.5f);
+						LOGLDirLight *light = &lightBlock.dirLight;
+						light->dir          = DqnV3_3f(-0.2f, -1.0f, -0.3f);
+						light->ambient      = DqnV3_1f(0.05f);
+						light->diffuse      = DqnV3_1f(0.4f);
+						light->specular     = DqnV3_1f(0.5f);
 					}
 
 					// Set spot light data
 					{
-						glUniform3f(glContext->uniformSpotLightAmbient, 0.1f, 0.1f, 0.1f);
-						glUniform3f(glContext->uniformSpotLightDiffuse, 0.8f, 0.8f, 0.8f);
-						glUniform3f(glContext->uniformSpotLightSpecular, 1.0f, 1.0f, 1.0f);
+						LOGLSpotLight *light = &lightBlock.spotLight;
+						light->ambient       = DqnV3_1f(0.1f);
+						light->diffuse       = DqnV3_1f(0.8f);
+						light->specular      = DqnV3_1f(1.0f);
 
 						// Set light attenuation, a quadratic falloff in intensity
-						glUniform1f(glContext->uniformSpotLightConstant, 1.0f);
-						glUniform1f(glContext->uniformSpotLightLinear, 0.09f);
-						glUniform1f(glContext->uniformSpotLightQuadratic, 0.032f);
-
-						glUniform3fv(glContext->uniformSpotLightPos, 1, state->cameraP.e);
-						glUniform3fv(glContext->uniformSpotLightDir, 1, cameraFront.e);
-						glUniform1f(glContext->uniformSpotLightCutOff, cosf(DQN_DEGREES_TO_RADIANS(12.5f)));
-						glUniform1f(glContext->uniformSpotLightOuterCutOff, cosf(DQN_DEGREES_TO_RADIANS(17.5f)));
+						light->constant  = 1.0f;
+						light->linear    = 0.09f;
+						light->quadratic = 0.032f;
+
+						light->pos         = state->cameraP;
+						light->dir         = cameraFront;
+						light->cutOff      = cosf(DQN_DEGREES_TO_RADIANS(12.5f));
+						light->outerCutOff = cosf(DQN_DEGREES_TO_RADIANS(17.5f));
 					}
+
+					LOGL_UploadLightBlock(glContext, &lightBlock);
 				}
 
-				DqnV3 cubePositions[] = {
-				    DqnV3_3f(0.0f, 0.0f, 0.0f),     //
-				    DqnV3_3f(2.0f, 5.0f, -15.0f),   //
-				    DqnV3_3f(-1.5f, -2.2f, -2.5f),  //
-				    DqnV3_3f(-3.8f, -2.0f, -12.3f), //
-				    DqnV3_3f(2.4f, -0.4f, -3.5f),   //
-				    DqnV3_3f(-1.7f, 3.0f, -7.5f),   //
-				    DqnV3_3f(1.3f, -2.0f, -2.5f),   //
-				    DqnV3_3f(1.5f, 2.0f, -2.5f),    //
-				    DqnV3_3f(1.5f, 0.2f, -1.5f),    //
-				    DqnV3_3f(-1.3f, 1.0f, -1.5f)    //
-				};
-
-				// Set material uniforms
-				glUniform1f(glContext->uniformMaterialShininess, 32.0f);
-				for (DqnV3 vec : cubePositions)
+				// Set transform matrices, every cube spins the same so the model matrix is just the
+				// shared rotation with the cube's translation in the last column. Translation doesn't
+				// affect the normal matrix so it's also shared and only calculated once.
+				LOGLTransformParams params = {};
+				params.positions           = state->cubePositions;
+				params.bounds              = &state->cubeBounds;
+				params.frustum             = frustum;
+				params.rotate              = DqnMat4_Rotate(radiansRotate, 1.0f, 0.3f, 0.5f);
+
+				DqnMat4 normalMatrix = DqnMat4_NormalMatrix(params.rotate);
+				for (u32 col = 0; col < 3; col++)
+					params.normalMatrix[col] = normalMatrix.col[col].xyz;
+
+				size_t instanceOffset = 0;
+				u32 numVisible        = LOGL_TransformStage(tempStack, memory->jobQueue, memory->numJobThreads, &params,
+				                                            state->numCubes, stateCache, &memory->frameArena,
+				                                            &instanceOffset);
+				state->renderStats.numCulled += state->numCubes - numVisible;
+				if (numVisible > 0)
 				{
-					// Set transform matrices
-					DqnMat4 model = DqnMat4_TranslateV3(vec);
-					model         = DqnMat4_Mul(model, DqnMat4_Rotate(radiansRotate, 1.0f, 0.3f, 0.5f));
-					glUniformMatrix4fv(glContext->uniformModelLoc, 1, GL_FALSE, (f32 *)model.e);
-
-					glDrawArrays(GL_TRIANGLES, 0, 36);
+					// NOTE: Materials are told apart by their diffuse texture
+					const LOGLMaterial *material = &state->crateMaterial;
+					u64 key = LOGLRenderQueue_MakeKey(LOGLRenderLayer_Opaque, LOGLProgram_Main, material->diffuse, 0);
+					if (LOGLRenderPacket *packet = LOGLRenderQueue_Submit(&renderQueue, key))
+					{
+						packet->program        = LOGLProgram_Main;
+						packet->vao            = glContext->vao;
+						packet->numIndices     = state->cubeMesh.numIndices;
+						packet->numInstances   = numVisible;
+						packet->instanceOffset = instanceOffset;
+						packet->material       = material;
+					}
 				}
 			}
+
+			LOGL_ExecuteRenderQueue(state, &memory->frameArena, &renderQueue, &view);
 		}
 	}
 
-	// glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+	LOGLFrameArena_EndFrame(&memory->frameArena);
+}
+
+void LOGL_Shutdown(struct PlatformMemory *const memory)
+{
+	LOGLState *const state = memory->state;
+	if (!state) return;
+
+	// NOTE: A load job writes into its entry's load until it publishes, it can't outlive the cache
+	LOGLTextureCache *const cache = &state->textureCache;
+	DqnJobQueue_WaitForCounter(cache->queue, &cache->loadCounter);
+
+	for (u32 i = 0; i < cache->numEntries; i++)
+	{
+		LOGLTextureEntry *entry = &cache->entries[i];
+		if (entry->state != LOGLTextureState_Loading) continue;
+
+		entry->load.memStack.Free();
+		entry->load.numMips = 0;
+		entry->load.state   = LOGLTextureLoadState_Done;
+		entry->state        = LOGLTextureState_Evicted;
+	}
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 // Bitmap Loading Code
 ////////////////////////////////////////////////////////////////////////////////
-bool LOGL_LoadBitmap(DqnMemStack *const memStack, DqnMemStack *const tempStack, LOGLBitmap *const bitmap,
-                     const char *const path)
+// NOTE: stb_image allocates from the calling thread's LOGLStbAllocator while it is set up by
+// LOGL_OpenBitmap() or LOGL_DecodeBitmap(). Every scratch allocation is prefixed with its size so
+// realloc knows how much to copy.
+struct LOGLStbAllocator
 {
-	if (!bitmap || !memStack || !tempStack) return false;
+	DqnMemStack *tempStack;
+	u8          *dest;     // Handed out for the first allocation the size of the decoded pixels
+	size_t       pixelsSize;
+	size_t       destSize;
+	bool         destInUse;
+};
 
-	// Get file size necessary
-	size_t fileSize;
-	u8 *rawBytes                            = NULL;
-	DqnMemStackTempRegionGuard tmpMemRegion = tempStack->TempRegionGuard();
+FILE_SCOPE DQN_THREAD_LOCAL LOGLStbAllocator threadStbAllocator;
+
+FILE_SCOPE void *LOGL_StbMalloc(size_t size)
+{
+	LOGLStbAllocator *allocator = &threadStbAllocator;
+	if (!DQN_ASSERT_MSG(allocator->tempStack, "stb_image used outside of LOGL_OpenBitmap()/LOGL_DecodeBitmap()"))
+		return NULL;
+
+	// NOTE: stb_image allocates the image it returns as one block the size of the pixels, so that
+	// block is the destination and the pixels are decoded in place instead of copied after. The jpeg
+	// decoder asks for 1 more byte, it writes a throwaway alpha past the last RGB pixel.
+	if (allocator->dest && !allocator->destInUse && size >= allocator->pixelsSize && size <= allocator->destSize)
 	{
-		if (!DQN_ASSERT(DqnFile_GetFileSize(path, &fileSize))) return false;
+		allocator->destInUse = true;
+		return allocator->dest;
+	}
 
-		// Load raw file bytes
-		rawBytes = (u8 *)tempStack->Push(fileSize);
+	size_t *header = (size_t *)allocator->tempStack->Push(sizeof(*header) + size);
+	if (!header) return NULL;
 
-		size_t bytesRead;
-		if (!DqnFile_ReadEntireFile(path, rawBytes, fileSize, &bytesRead))
-			return false;
+	*header = size;
+	return header + 1;
+}
 
-		if (!DQN_ASSERT_MSG(bytesRead == fileSize, "bytesRead: %d, fileSize: %d", bytesRead, fileSize))
-			return false;
+FILE_SCOPE void LOGL_StbFree(void *ptr)
+{
+	LOGLStbAllocator *allocator = &threadStbAllocator;
+	if (!ptr) return;
+
+	if (ptr == allocator->dest)
+	{
+		allocator->destInUse = false;
+		return;
+	}
+
+	// NOTE: Only the last allocation can be popped, anything else is released when the caller's temp
+	// region ends. Never pop a block empty, the temp region may have started in it.
+	DqnMemStack *stack      = allocator->tempStack;
+	DqnMemStackBlock *block = stack->block;
+	size_t *header          = (size_t *)ptr - 1;
+	size_t allocSize        = DQN_ALIGN_POW_N(sizeof(*header) + *header, stack->byteAlign);
+	if ((u8 *)header > block->memory && (u8 *)header + allocSize == block->memory + block->used)
+		stack->Pop(header, allocSize);
+}
+
+FILE_SCOPE void *LOGL_StbRealloc(void *ptr, size_t newSize)
+{
+	LOGLStbAllocator *allocator = &threadStbAllocator;
+	if (!ptr) return LOGL_StbMalloc(newSize);
+
+	size_t oldSize;
+	if (ptr == allocator->dest)
+	{
+		// NOTE: Something other than the pixels happened to be their size, it moves to scratch memory
+		// and the destination becomes free for the real pixels.
+		oldSize              = allocator->pixelsSize;
+		allocator->destInUse = false;
+	}
+	else
+	{
+		DqnMemStack *stack      = allocator->tempStack;
+		DqnMemStackBlock *block = stack->block;
+		size_t *header          = (size_t *)ptr - 1;
+		oldSize                 = *header;
+		if (newSize <= oldSize) return ptr;
+
+		// NOTE: Grow in place when ptr is the last allocation and its block has room, which is how
+		// stb_image's zlib decoder grows its output.
+		size_t oldAllocSize = DQN_ALIGN_POW_N(sizeof(*header) + oldSize, stack->byteAlign);
+		size_t newAllocSize = DQN_ALIGN_POW_N(sizeof(*header) + newSize, stack->byteAlign);
+		size_t growSize     = newAllocSize - oldAllocSize;
+		if ((u8 *)header + oldAllocSize == block->memory + block->used &&
+		    block->used + growSize <= block->size)
+		{
+			if (growSize > 0 && !stack->Push(growSize)) return NULL;
+			*header = newSize;
+			return ptr;
+		}
+	}
+
+	void *result = LOGL_StbMalloc(newSize);
+	if (result && result != ptr) memcpy(result, ptr, DQN_MIN(oldSize, newSize));
+	return result;
+}
+
+bool LOGL_OpenBitmap(DqnMemStack *const memStack, LOGLBitmapFile *const file, const char *const path)
+{
+	if (!memStack || !file || !path) return false;
+
+	size_t fileSize;
+	if (!DqnFile_GetFileSize(path, &fileSize)) return false;
+
+	u8 *bytes = (u8 *)memStack->Push(fileSize);
+	if (!bytes) return false;
+
+	size_t bytesRead;
+	if (!DqnFile_ReadEntireFile(path, bytes, fileSize, &bytesRead))
+		return false;
+
+	if (!DQN_ASSERT_MSG(bytesRead == fileSize, "bytesRead: %d, fileSize: %d", bytesRead, fileSize))
+		return false;
+
+	// NOTE: Parsing the header may allocate, e.g. stb_image's jpeg decoder state
+	LOGLBitmapFile result = {};
+	i32 infoResult;
+	{
+		DqnMemStackTempRegionGuard tmpMemRegion = memStack->TempRegionGuard();
+		threadStbAllocator           = {};
+		threadStbAllocator.tempStack = memStack;
+		infoResult = stbi_info_from_memory(bytes, (i32)fileSize, &result.dim.w, &result.dim.h, &result.bytesPerPixel);
+		threadStbAllocator = {};
 	}
 
-	// Use stb to interpret bytes as pixels
+	if (!infoResult)
 	{
-		LOGLBitmap tmp = {};
-		tmp.memory     = stbi_load_from_memory(rawBytes, (i32)fileSize, &tmp.dim.w, &tmp.dim.h,
-		                                   &tmp.bytesPerPixel, 0);
-		if (!tmp.memory)
+		const char *failReason = stbi_failure_reason();
+		DQN_ASSERT_MSG(DQN_INVALID_CODE_PATH, "stbi_info_from_memory() failed: %s", failReason);
+		return false;
+	}
+
+	result.bytes      = bytes;
+	result.size       = fileSize;
+	result.pixelsSize = (size_t)result.dim.w * result.dim.h * result.bytesPerPixel;
+	result.decodeSize = result.pixelsSize + 1;
+	*file             = result;
+	return true;
+}
+
+bool LOGL_DecodeBitmap(DqnMemStack *const tempStack, const LOGLBitmapFile *const file, u8 *const dest)
+{
+	if (!tempStack || !file || !dest) return false;
+
+	DqnV2i dim;
+	i32 bytesPerPixel;
+	u8 *pixels;
+	{
+		DqnMemStackTempRegionGuard tmpMemRegion = tempStack->TempRegionGuard();
+		threadStbAllocator            = {};
+		threadStbAllocator.tempStack  = tempStack;
+		threadStbAllocator.dest       = dest;
+		threadStbAllocator.pixelsSize = file->pixelsSize;
+		threadStbAllocator.destSize   = file->decodeSize;
+
+		// NOTE: Every caller wants GL's row order, it's the same value from any thread
+		stbi_set_flip_vertically_on_load(true);
+		pixels = stbi_load_from_memory(file->bytes, (i32)file->size, &dim.w, &dim.h, &bytesPerPixel, 0);
+		threadStbAllocator = {};
+
+		if (!pixels)
 		{
 			const char *failReason = stbi_failure_reason();
 			DQN_ASSERT_MSG(DQN_INVALID_CODE_PATH, "stbi_load_from_memory() failed: %s", failReason);
 			return false;
 		}
 
-		// NOTE: We do this since stbi does alot of mallocing itself, we just let it use malloc and
-		// whatnot, then do our own allocation
-		*bitmap           = tmp;
-		size_t bitmapSize = bitmap->dim.w * bitmap->dim.h * bitmap->bytesPerPixel;
-		bitmap->memory    = (u8 *)memStack->Push(bitmapSize);
-		if (!bitmap->memory) return false;
+		if (!DQN_ASSERT_MSG(dim.w == file->dim.w && dim.h == file->dim.h && bytesPerPixel == file->bytesPerPixel,
+		                    "Decoded image does not match its header: %dx%dx%d, expected: %dx%dx%d", dim.w,
+		                    dim.h, bytesPerPixel, file->dim.w, file->dim.h, file->bytesPerPixel))
+		{
+			return false;
+		}
+
+		// NOTE: Only when stb_image allocated another block the pixels' size and kept it
+		if (pixels != dest) memcpy(dest, pixels, file->pixelsSize);
+	}
+
+	return true;
+}
+
+bool LOGL_LoadBitmap(DqnMemStack *const memStack, DqnMemStack *const tempStack, LOGLBitmap *const bitmap,
+                     const char *const path)
+{
+	if (!bitmap || !memStack || !tempStack) return false;
+
+	DqnMemStackTempRegionGuard tmpMemRegion = tempStack->TempRegionGuard();
+	LOGLBitmapFile file = {};
+	if (!LOGL_OpenBitmap(tempStack, &file, path)) return false;
+
+	u8 *memory = (u8 *)memStack->Push(file.decodeSize);
+	if (!memory) return false;
+
+	if (!LOGL_DecodeBitmap(tempStack, &file, memory))
+	{
+		memStack->Pop(memory, file.decodeSize);
+		return false;
+	}
+
+	bitmap->memory        = memory;
+	bitmap->dim           = file.dim;
+	bitmap->bytesPerPixel = file.bytesPerPixel;
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Mesh Building Code
+////////////////////////////////////////////////////////////////////////////////
+// NOTE: Rounds to nearest, values too small for a normal half flush to 0 and values too large go to
+// infinity. Plenty for texture coordinates.
+FILE_SCOPE u16 LOGL_F32ToF16(const f32 value)
+{
+	u32 bits;
+	memcpy(&bits, &value, sizeof(bits));
+
+	u32 sign     = (bits >> 16) & 0x8000;
+	i32 exponent = (i32)((bits >> 23) & 0xFF) - 127 + 15;
+	u32 mantissa = bits & 0x7FFFFF;
+
+	if (exponent <= 0)  return (u16)sign;
+	if (exponent >= 31) return (u16)(sign | 0x7C00);
+
+	// NOTE: If rounding carries out of the mantissa it correctly bumps the exponent
+	u32 result = sign | ((u32)exponent << 10) | (mantissa >> 13);
+	if (mantissa & 0x1000) result++;
+
+	return (u16)result;
+}
+
+// Pack a unit vector for GL_INT_2_10_10_10_REV, x in the lowest 10 bits and w left as 0.
+FILE_SCOPE u32 LOGL_PackNormal(const DqnV3 normal)
+{
+	u32 result = 0;
+	for (u32 i = 0; i < 3; i++)
+	{
+		f32 val       = DqnMath_Clampf(normal.e[i], -1.0f, 1.0f);
+		i32 quantised = (i32)roundf(val * 511.0f);
+		result |= ((u32)quantised & 0x3FF) << (i * 10);
+	}
+
+	return result;
+}
 
-		for (u32 i = 0; i < bitmapSize; i++)
-			bitmap->memory[i] = tmp.memory[i];
+bool LOGL_BuildMesh(DqnMemStack *const memStack, DqnMemStack *const tempStack,
+                    const LOGLMeshSourceVertex *const srcVertices, const u32 numSrcVertices, LOGLMesh *const mesh)
+{
+	if (!memStack || !tempStack || !srcVertices || !mesh) return false;
+	if (!DQN_ASSERT_MSG(numSrcVertices % 3 == 0, "numSrcVertices: %d, is not a triangle list", numSrcVertices))
+		return false;
+
+	DqnMemStackTempRegionGuard tmpMemRegion = tempStack->TempRegionGuard();
+
+	// Open addressing table of (vertex index + 1) into the welded vertices, 0 is an empty slot.
+	// Kept at most half full so probes stay short.
+	u32 tableSize = 1;
+	while (tableSize < numSrcVertices * 2) tableSize <<= 1;
+
+	u32 *table           = (u32 *)tempStack->Push(sizeof(*table) * tableSize);
+	LOGLVertex *vertices = (LOGLVertex *)tempStack->Push(sizeof(*vertices) * numSrcVertices);
+	u16 *indices         = (u16 *)memStack->Push(sizeof(*indices) * numSrcVertices);
+	if (!table || !vertices || !indices) return false;
+	memset(table, 0, sizeof(*table) * tableSize);
+
+	// NOTE: Weld after quantising, vertices that are different in f32 but the same once packed are
+	// indistinguishable to the GPU anyway.
+	u32 numVertices = 0;
+	for (u32 i = 0; i < numSrcVertices; i++)
+	{
+		const LOGLMeshSourceVertex *src = &srcVertices[i];
+		LOGLVertex vertex               = {};
+		vertex.pos                      = src->pos;
+		vertex.normal                   = LOGL_PackNormal(src->normal);
+		vertex.texCoord[0]              = LOGL_F32ToF16(src->texCoord.x);
+		vertex.texCoord[1]              = LOGL_F32ToF16(src->texCoord.y);
+
+		u32 slot = (u32)LOGL_HashFNV1a(&vertex, sizeof(vertex)) & (tableSize - 1);
+		while (table[slot] && memcmp(&vertices[table[slot] - 1], &vertex, sizeof(vertex)) != 0)
+			slot = (slot + 1) & (tableSize - 1);
+
+		if (!table[slot])
+		{
+			if (!DQN_ASSERT_MSG(numVertices <= 0xFFFF, "Mesh has more unique vertices than u16 indices can address"))
+				return false;
+
+			vertices[numVertices++] = vertex;
+			table[slot]             = numVertices;
+		}
 
-		free(tmp.memory);
+		indices[i] = (u16)(table[slot] - 1);
 	}
 
+	mesh->vertices = (LOGLVertex *)memStack->Push(sizeof(*mesh->vertices) * numVertices);
+	if (!mesh->vertices) return false;
+	memcpy(mesh->vertices, vertices, sizeof(*mesh->vertices) * numVertices);
+
+	mesh->indices     = indices;
+	mesh->numVertices = numVertices;
+	mesh->numIndices  = numSrcVertices;
 	return true;
 }
+
+f32 LOGL_MeshACMR(const u16 *const indices, const u32 numIndices, const u32 cacheSize)
+{
+	u32 cache[64];
+	if (!DQN_ASSERT_MSG(cacheSize > 0 && cacheSize <= DQN_ARRAY_COUNT(cache), "cacheSize: %d", cacheSize))
+		return 0;
+
+	if (!indices || numIndices < 3) return 0;
+
+	u32 numCached = 0;
+	u32 head      = 0; // Oldest entry once the cache is full
+	u32 numMisses = 0;
+	for (u32 i = 0; i < numIndices; i++)
+	{
+		bool hit = false;
+		for (u32 j = 0; j < numCached && !hit; j++)
+			hit = (cache[j] == indices[i]);
+
+		if (hit) continue;
+
+		numMisses++;
+		if (numCached < cacheSize)
+		{
+			cache[numCached++] = indices[i];
+		}
+		else
+		{
+			cache[head] = indices[i];
+			head        = (head + 1) % cacheSize;
+		}
+	}
+
+	f32 result = (f32)numMisses / (f32)(numIndices / 3);
+	return result;
+}
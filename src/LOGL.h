@@ -1,6 +1,13 @@
 #ifndef LOGL_H
 #define LOGL_H
 
+#include "LOGLBC.h"
+#include "LOGLCull.h"
+#include "LOGLMip.h"
+#include "LOGLPack.h"
+#include "LOGLRenderQueue.h"
+#include "LOGLShader.h"
+#include "LOGLStateCache.h"
 #include "dqn.h"
 
 
@@ -11,82 +18,363 @@ struct LOGLBitmap
 	i32    bytesPerPixel;
 };
 
-union LOGLPointLight {
-	// Uniform locations
-	i32 uniforms[7];
-	struct
-	{
-		i32 pos;
+// An image file read into memory that hasn't been decoded yet, see LOGL_OpenBitmap()
+struct LOGLBitmapFile
+{
+	u8    *bytes;
+	size_t size;
+	DqnV2i dim;
+	i32    bytesPerPixel;
+	size_t pixelsSize; // Bytes of decoded pixels
+	size_t decodeSize; // Bytes a buffer decoded into must hold, stb_image may write just past the pixels
+};
+
+// NOTE: The light structs mirror the std140 layout of the "Lights" uniform block in the main
+// shader. std140 aligns vec3's to 16 bytes, so scalars are packed into the 4th component of the
+// vec3 before them to avoid padding, the shader structs must be declared in the same order.
+struct LOGLPointLight
+{
+	DqnV3 pos;
+	f32   constant;
 
-		i32 ambient;
-		i32 diffuse;
-		i32 specular;
+	DqnV3 ambient;
+	f32   linear;
 
-		i32 constant;
-		i32 linear;
-		i32 quadratic;
-	};
+	DqnV3 diffuse;
+	f32   quadratic;
+
+	DqnV3 specular;
+	f32   pad0;
 };
+DQN_COMPILE_ASSERT(sizeof(LOGLPointLight) == 64);
 
-struct LOGLContext
+struct LOGLDirLight
+{
+	DqnV3 dir;
+	f32   pad0;
+
+	DqnV3 ambient;
+	f32   pad1;
+
+	DqnV3 diffuse;
+	f32   pad2;
+
+	DqnV3 specular;
+	f32   pad3;
+};
+DQN_COMPILE_ASSERT(sizeof(LOGLDirLight) == 64);
+
+struct LOGLSpotLight
 {
-	i32 lightUniformProjectionLoc;
-	i32 lightUniformViewLoc;
-	i32 lightUniformModelLoc;
+	DqnV3 pos;
+	f32   cutOff;
 
-	i32 uniformProjectionLoc;
-	i32 uniformViewLoc;
-	i32 uniformModelLoc;
+	DqnV3 dir;
+	f32   outerCutOff;
 
-	i32 uniformMaterialDiffuse;
-	i32 uniformMaterialSpecular;
-	i32 uniformMaterialShininess;
+	DqnV3 ambient;
+	f32   constant;
 
-	i32 uniformDirLightDir;
-	i32 uniformDirLightAmbient;
-	i32 uniformDirLightDiffuse;
-	i32 uniformDirLightSpecular;
+	DqnV3 diffuse;
+	f32   linear;
 
-	LOGLPointLight uniformPointLights[4];
-	i32 uniformSpotLightPos;
-	i32 uniformSpotLightDir;
-	i32 uniformSpotLightCutOff;
-	i32 uniformSpotLightOuterCutOff;
-	i32 uniformSpotLightAmbient;
-	i32 uniformSpotLightDiffuse;
-	i32 uniformSpotLightSpecular;
-	i32 uniformSpotLightConstant;
-	i32 uniformSpotLightLinear;
-	i32 uniformSpotLightQuadratic;
+	DqnV3 specular;
+	f32   quadratic;
+};
+DQN_COMPILE_ASSERT(sizeof(LOGLSpotLight) == 80);
 
-	i32 uniformViewPos;
+#define LOGL_NUM_POINT_LIGHTS 4
+struct LOGLLightBlock
+{
+	LOGLPointLight pointLights[LOGL_NUM_POINT_LIGHTS];
+	LOGLDirLight   dirLight;
+	LOGLSpotLight  spotLight;
+};
 
-	u32 mainShaderId;
-	u32 lightShaderId;
+enum LOGLUniformBlockBinding
+{
+	LOGLUniformBlockBinding_Lights,
+};
+
+// Vertex as it is uploaded to GL, see LOGL_BuildMesh() for the quantisation
+struct LOGLVertex
+{
+	DqnV3 pos;
+	u32   normal;      // GL_INT_2_10_10_10_REV, xyz as signed normalised 10 bit values
+	u16   texCoord[2]; // GL_HALF_FLOAT
+};
+DQN_COMPILE_ASSERT(sizeof(LOGLVertex) == 20);
+
+// Unindexed, full precision vertex that meshes are authored in
+struct LOGLMeshSourceVertex
+{
+	DqnV3 pos;
+	DqnV2 texCoord;
+	DqnV3 normal;
+};
+DQN_COMPILE_ASSERT(sizeof(LOGLMeshSourceVertex) == sizeof(f32) * 8);
+
+struct LOGLMesh
+{
+	LOGLVertex *vertices;
+	u16        *indices;
+	u32         numVertices;
+	u32         numIndices;
+};
+
+// Per instance vertex attributes, the layout is described in LOGL_InitInstanceBuffer()
+struct LOGLInstance
+{
+	DqnMat4 model;
+	DqnV3   normalMatrix[3]; // Columns of DqnMat4_NormalMatrix(model), so the shader doesn't invert per vertex
+};
+
+// Textures are read and decoded by LOGL_TextureLoadJob() on the job queue into the load's own
+// memStack, the main thread uploads them once their state is Decoded.
+enum LOGLTextureLoadState
+{
+	LOGLTextureLoadState_Queued,
+	LOGLTextureLoadState_Decoded,
+	LOGLTextureLoadState_Failed,
+	LOGLTextureLoadState_Done, // Uploaded or failed, and its memory released
+};
+
+struct LOGLTextureLoad
+{
+	const char *path;
+	i32         minFilter;
+
+	// Owned by the job until state leaves Queued
+	DqnMemStack    memStack;                  // Just the mips and compressed mips, the file is decoded in scratch
+	LOGLBitmap     mips[LOGL_MIP_MAX_LEVELS]; // Level 0 is the decoded file
+	u32            numMips;
+	i32            bcQuality;                           // LOGLBCQuality, None to upload mips as they are
+	LOGLBCImage    compressedMips[LOGL_MIP_MAX_LEVELS]; // Encoded from mips when bcQuality isn't None
+	size_t         uploadSize;                          // Bytes of the mips that will be uploaded
+	i32 volatile   state;
+};
+
+// Textures shared by path. Handles are reference counted, but a texture stays resident after its
+// last release so acquiring it again is a hit. Resident textures that weren't bound last frame are
+// evicted least recently used first, unreferenced ones before referenced, whenever the resident
+// bytes are over budget. Binding an evicted texture re-streams it, the placeholder is bound until
+// it's resident again. See LOGL_UpdateTextureCache().
+#define LOGL_TEXTURE_CACHE_MAX_PATH LOGL_PACK_MAX_NAME
+
+typedef u32 LOGLTextureHandle; // 0 is invalid and binds the placeholder
+
+enum LOGLTextureState
+{
+	LOGLTextureState_Evicted,   // Not resident, how every texture starts
+	LOGLTextureState_Requested, // Wants loading, started by the next LOGL_UpdateTextureCache()
+	LOGLTextureState_Loading,   // Decoding on the job queue
+	LOGLTextureState_Resident,
+	LOGLTextureState_Failed,    // Binds the placeholder and is never loaded again
+};
+
+struct LOGLTextureEntry
+{
+	u64                   pathHash;
+	char                  path[LOGL_TEXTURE_CACHE_MAX_PATH];
+	i32                   minFilter;
+	enum LOGLTextureState state;
+	u32                   refCount;
+	u32                   texId;         // 0 unless resident
+	size_t                residentSize;  // Bytes of the mips in GL
+	u64                   lastUsedFrame; // Frame the texture was last bound or acquired
+	LOGLTextureLoad       load;          // Valid while Loading
+};
+
+struct LOGLTextureCacheStats
+{
+	u32    numHits;      // Acquires of a path the cache already had
+	u32    numMisses;    // Acquires that had to load a new path
+	u32    numEvictions; // Textures deleted from GL to stay in budget
+	u32    numRestreams; // Loads of textures that were evicted
+	u32    numResident;
+	size_t residentBytes;
+	size_t peakResidentBytes;
+};
+
+struct LOGLTextureCache
+{
+	LOGLTextureEntry *entries; // Never moved or removed, a handle is its entry's index + 1
+	u32               numEntries;
+	u32               maxEntries;
+	u32              *slots;    // Open addressed hash table of handles by path hash, 0 is empty
+	u32               numSlots; // A power of 2
+
+	size_t        budget;           // Resident bytes before textures are evicted, 0 for no limit
+	u64           frame;            // Incremented by every LOGL_UpdateTextureCache()
+	u32           texIdPlaceholder; // Bound in place of textures that aren't resident
+	i32           bcQuality;        // LOGLBCQuality of textures decoded from their source images
+	LOGLPack      pack;             // Textures found in the pack are uploaded from it without decoding
+	bool          hasPack;
+	DqnJobQueue  *queue;
+	DqnJobCounter loadCounter;      // Load jobs on the queue that haven't published their state
+
+	LOGLTextureCacheStats stats;
+};
+
+struct LOGLAssetStats
+{
+	u32 numTexturesLoaded;
+	u32 numTexturesFailed;
+	u32 numTexturesFromPack;   // Loaded textures that were uploaded from the asset pack with no decoding
+	u32 numTexturesCompressed; // Loaded textures that were uploaded block compressed
+	u64 textureBytes;          // Bytes of every mip uploaded
+	u32 numFramesToLoad; // Frames from queueing the loads until the last one was done
+	f64 msToLoad;
+};
+
+struct LOGLRenderStats
+{
+	u32 numDrawCalls;
+	u32 numInstances;
+	u32 numCulled;       // Objects outside the view frustum that were not submitted
+	u32 numPackets;      // Draws submitted to the render queue
+	u32 numStateChanges; // Program, VAO and material switches between packets in key order
+};
+
+struct LOGLContext
+{
+	// Per frame binds and uniforms go through here, so the ones that don't change aren't sent
+	LOGLStateCache stateCache;
+
+	// The light block as it was last uploaded to lightUbo, so only the bytes that changed are sent
+	LOGLLightBlock lightBlock;
+	u32            lightUbo;
 
 	u32 lightVao;
 	u32 vao;
 	u32 vbo;
 	u32 ebo;
 
-	u32 texIdCrateSpecular;
-	u32 texIdCrate;
-	u32 texIdContainer;
-	u32 texIdFace;
+};
+
+// GLSL sources are read from LOGL_SHADER_DIR, relative to the working directory like the textures
+#define LOGL_SHADER_DIR "shaders"
+
+enum LOGLProgram
+{
+	LOGLProgram_Main,  // Lit and textured cubes
+	LOGLProgram_Light, // Light sources
+	LOGLProgram_Count,
+};
+
+// A program built from its shader files. When they change it's rebuilt without stalling the frame
+// and swapped in at the start of the frame the rebuild is done by. A rebuild that fails to compile
+// or link leaves the live program as it was.
+struct LOGLShaderProgram
+{
+	u32                program;    // Live program, 0 if its files have never built, which skips its draws
+	u64                sourceHash; // Of the live program's sources
+	LOGLShaderUniforms uniforms;   // Of the live program, see LOGL_Uniform()
+	LOGLShaderBuild    rebuild;    // In flight unless its state is None
+};
+
+// Draws are submitted to a LOGLRenderQueue each frame then sorted and executed, see LOGLRenderQueue.h
+#define LOGL_MAX_RENDER_PACKETS 64
+
+enum LOGLRenderLayer
+{
+	LOGLRenderLayer_Opaque,
+	LOGLRenderLayer_Count,
+};
+
+struct LOGLShaderReloadStats
+{
+	u32 numReloads;       // Rebuilds that replaced a live program
+	u32 numReloadsFailed; // Rebuilds that failed and kept the live program
+};
+
+struct LOGLMaterial
+{
+	LOGLTextureHandle diffuse;
+	LOGLTextureHandle specular;
+	f32               shininess;
 };
 
 struct LOGLState
 {
-	LOGLContext glContext;
+	LOGLContext           glContext;
+	LOGLShaderCache       shaderCache;
+	LOGLShaderProgram     programs[LOGLProgram_Count];
+	LOGLShaderReloadStats shaderReloadStats;
 
 	DqnV3 cameraP;
 	f32   cameraYaw;
 	f32   cameraPitch;
 
 	f32 totalDt;
+
+	DqnMat4 projection;
+
+	LOGLMesh cubeMesh;
+
+	DqnV3          *cubePositions;
+	LOGLCullSpheres cubeBounds;
+	u32             numCubes;
+
+	LOGLMaterial crateMaterial;
+
+	LOGLTextureCache textureCache;
+	u32              numPendingTextures; // Requested or loading, as of the last LOGL_UpdateTextureCache()
+	f64              textureLoadStartMs;
+	LOGLAssetStats   assetStats;
+
+	LOGLRenderStats renderStats; // Stats of the last frame rendered
 };
 
 void LOGL_Update    (struct PlatformInput *const input, struct PlatformMemory *const memory);
+
+// Wait for the asset jobs still on the job queue and release the memory they were loading into.
+// Call on the main thread before the job queue, frame arena and memory stacks are freed.
+void LOGL_Shutdown  (struct PlatformMemory *const memory);
+
+// FNV-1a, continuing from hash so data in pieces hashes like it was contiguous.
+#define LOGL_FNV1A_SEED  14695981039346656037ULL
+#define LOGL_FNV1A_PRIME 1099511628211ULL
+u64 LOGL_HashFNV1a(const void *const data, const size_t size, const u64 hash = LOGL_FNV1A_SEED);
+
+// FNV-1a of a string without its null terminator, the same as LOGL_HashFNV1a(str, DqnStr_Len(str)).
+constexpr u64 LOGL_HashFNV1aConst(const char *const str, const u64 hash = LOGL_FNV1A_SEED)
+{
+	u64 result = hash;
+	for (const char *ptr = str; *ptr; ptr++)
+	{
+		result ^= (u8)*ptr;
+		result *= LOGL_FNV1A_PRIME;
+	}
+
+	return result;
+}
+
+template <u64 Value> struct LOGLConstU64 { static constexpr u64 value = Value; };
+
+// Hash of a uniform's name for LOGLShader_Uniform(), evaluated at compile time.
+#define LOGL_UNIFORM(name) (LOGLConstU64<LOGL_HashFNV1aConst(name)>::value)
+
 bool LOGL_LoadBitmap(DqnMemStack *const memStack, DqnMemStack *const tempStack, LOGLBitmap *const bitmap, const char *const path);
 
+// Read the image file at path into memStack and get its dimensions without decoding it.
+// return: FALSE if the file could not be read or is not an image stb_image supports.
+bool LOGL_OpenBitmap  (DqnMemStack *const memStack, LOGLBitmapFile *const file, const char *const path);
+
+// Decode the pixels of an opened file into dest, which must hold file->decodeSize bytes. stb_image
+// decodes straight into dest and takes its scratch memory from tempStack, released before returning.
+// Rows are decoded bottom row first, the order GL expects.
+// return: FALSE if decoding failed, the contents of dest are undefined.
+bool LOGL_DecodeBitmap(DqnMemStack *const tempStack, const LOGLBitmapFile *const file, u8 *const dest);
+
+// Quantise the source vertices and weld the ones that become identical into an indexed mesh
+// allocated from memStack. Source vertices are read as a triangle list.
+// return: FALSE if memory ran out or the mesh has more unique vertices than a u16 index can address.
+bool LOGL_BuildMesh(DqnMemStack *const memStack, DqnMemStack *const tempStack,
+                    const LOGLMeshSourceVertex *const srcVertices, const u32 numSrcVertices, LOGLMesh *const mesh);
+
+// Average cache miss ratio, the vertex shader invocations per triangle when drawing the indices
+// through a FIFO post transform cache of cacheSize entries. 0.5 is ideal, 3 means no reuse.
+f32 LOGL_MeshACMR(const u16 *const indices, const u32 numIndices, const u32 cacheSize);
+
 #endif
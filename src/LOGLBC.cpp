@@ -0,0 +1,701 @@
+#include "LOGL.h"
+#include "LOGLBC.h"
+
+#define DQN_PLATFORM_HEADER // For DqnJobQueue
+#include "dqn.h"
+
+#include <math.h> // For INFINITY, log10(), sqrtf()
+
+// NOTE: A block is a few hundred ns to a few us depending on quality, below this many a job costs
+// more in scheduling than it gains in balance
+#define LOGL_BC_MIN_BLOCKS_PER_JOB 256
+#define LOGL_BC_MAX_JOBS           64
+
+u32 LOGLBC_BlockSize(const enum LOGLBCFormat format)
+{
+	switch (format)
+	{
+		case LOGLBCFormat_BC1:
+		case LOGLBCFormat_BC4: return 8;
+		case LOGLBCFormat_BC3:
+		case LOGLBCFormat_BC5: return 16;
+		default:               return 0;
+	}
+}
+
+size_t LOGLBC_EncodedSize(const enum LOGLBCFormat format, const u32 width, const u32 height)
+{
+	size_t result = (size_t)((width + 3) / 4) * ((height + 3) / 4) * LOGLBC_BlockSize(format);
+	return result;
+}
+
+enum LOGLBCFormat LOGLBC_PickFormat(const LOGLBitmap *const bitmap)
+{
+	if (!bitmap || !bitmap->memory) return LOGLBCFormat_None;
+
+	const i32 bytesPerPixel = bitmap->bytesPerPixel;
+	if (bytesPerPixel == 1) return LOGLBCFormat_BC4;
+	if (bytesPerPixel == 2) return LOGLBCFormat_BC5;
+	if (bytesPerPixel != 3 && bytesPerPixel != 4) return LOGLBCFormat_None;
+
+	bool grey   = true;
+	bool opaque = true;
+	const u8 *pixel = bitmap->memory;
+	for (i32 i = 0; i < bitmap->dim.w * bitmap->dim.h; i++, pixel += bytesPerPixel)
+	{
+		grey &= (pixel[0] == pixel[1] && pixel[0] == pixel[2]);
+		if (bytesPerPixel == 4) opaque &= (pixel[3] == 255);
+	}
+
+	if (!opaque) return LOGLBCFormat_BC3;
+	if (grey)    return LOGLBCFormat_BC4;
+	return LOGLBCFormat_BC1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Block Encoding
+////////////////////////////////////////////////////////////////////////////////
+// The 16 pixels of a block as RGBA, a row at a time
+struct LOGLBCBlock
+{
+	u8 pixels[16][4];
+};
+
+FILE_SCOPE void LOGLBCInternal_FetchBlock(const LOGLBitmap *const bitmap, const u32 blockX, const u32 blockY,
+                                          LOGLBCBlock *const block)
+{
+	const i32 bytesPerPixel = bitmap->bytesPerPixel;
+	const size_t pitch      = (size_t)bitmap->dim.w * bytesPerPixel;
+	for (u32 y = 0; y < 4; y++)
+	{
+		const u8 *row = bitmap->memory + ((size_t)DQN_MIN((i32)(blockY * 4 + y), bitmap->dim.h - 1) * pitch);
+		for (u32 x = 0; x < 4; x++)
+		{
+			const u8 *src = row + ((size_t)DQN_MIN((i32)(blockX * 4 + x), bitmap->dim.w - 1) * bytesPerPixel);
+			u8 *dest      = block->pixels[(y * 4) + x];
+			switch (bytesPerPixel)
+			{
+				case 1:  dest[0] = src[0]; dest[1] = src[0]; dest[2] = src[0]; dest[3] = 255;    break;
+				case 2:  dest[0] = src[0]; dest[1] = src[1]; dest[2] = 0;      dest[3] = 255;    break;
+				case 3:  dest[0] = src[0]; dest[1] = src[1]; dest[2] = src[2]; dest[3] = 255;    break;
+				default: dest[0] = src[0]; dest[1] = src[1]; dest[2] = src[2]; dest[3] = src[3]; break;
+			}
+		}
+	}
+}
+
+FILE_SCOPE inline u16 LOGLBCInternal_To565(const i32 *const rgb)
+{
+	u32 r = (u32)((DQN_MIN(DQN_MAX(rgb[0], 0), 255) * 31) + 127) / 255;
+	u32 g = (u32)((DQN_MIN(DQN_MAX(rgb[1], 0), 255) * 63) + 127) / 255;
+	u32 b = (u32)((DQN_MIN(DQN_MAX(rgb[2], 0), 255) * 31) + 127) / 255;
+	return (u16)((r << 11) | (g << 5) | b);
+}
+
+FILE_SCOPE inline void LOGLBCInternal_From565(const u16 color, i32 *const rgb)
+{
+	i32 r  = (color >> 11) & 31;
+	i32 g  = (color >> 5) & 63;
+	i32 b  = color & 31;
+	rgb[0] = (r << 3) | (r >> 2);
+	rgb[1] = (g << 2) | (g >> 4);
+	rgb[2] = (b << 3) | (b >> 2);
+}
+
+// fourColor: BC1 blocks with color0 <= color1 have 3 colours and black instead, BC3 always has 4.
+FILE_SCOPE void LOGLBCInternal_ColorPalette(const u16 color0, const u16 color1, const bool fourColor,
+                                            i32 palette[4][3])
+{
+	LOGLBCInternal_From565(color0, palette[0]);
+	LOGLBCInternal_From565(color1, palette[1]);
+	for (u32 i = 0; i < 3; i++)
+	{
+		if (fourColor)
+		{
+			palette[2][i] = ((2 * palette[0][i]) + palette[1][i] + 1) / 3;
+			palette[3][i] = (palette[0][i] + (2 * palette[1][i]) + 1) / 3;
+		}
+		else
+		{
+			palette[2][i] = (palette[0][i] + palette[1][i] + 1) / 2;
+			palette[3][i] = 0;
+		}
+	}
+}
+
+FILE_SCOPE inline u32 LOGLBCInternal_ColorError(const u8 *const pixel, const i32 *const color)
+{
+	i32 r = pixel[0] - color[0];
+	i32 g = pixel[1] - color[1];
+	i32 b = pixel[2] - color[2];
+	return (u32)((r * r) + (g * g) + (b * b));
+}
+
+// Order the endpoints for 4 colour mode and pick the nearest palette entry for each pixel.
+// return: The summed squared error of the block.
+FILE_SCOPE u32 LOGLBCInternal_FinishColorBlock(const LOGLBCBlock *const block, u16 *const color0,
+                                               u16 *const color1, u32 *const indices)
+{
+	if (*color0 < *color1) DQN_SWAP(u16, *color0, *color1);
+
+	i32 palette[4][3];
+	LOGLBCInternal_ColorPalette(*color0, *color1, true, palette);
+
+	// NOTE: Equal endpoints are 3 colour mode in BC1, index 0 is the only entry both modes agree on
+	u32 numColors = (*color0 == *color1) ? 1 : 4;
+	u32 result    = 0;
+	*indices      = 0;
+	for (u32 i = 0; i < 16; i++)
+	{
+		u32 bestError = LOGLBCInternal_ColorError(block->pixels[i], palette[0]);
+		u32 bestIndex = 0;
+		for (u32 j = 1; j < numColors; j++)
+		{
+			u32 error = LOGLBCInternal_ColorError(block->pixels[i], palette[j]);
+			if (error < bestError)
+			{
+				bestError = error;
+				bestIndex = j;
+			}
+		}
+
+		*indices |= bestIndex << (i * 2);
+		result   += bestError;
+	}
+
+	return result;
+}
+
+// The box diagonal runs from the minimum to the maximum of every channel, channels that fall as the
+// widest one rises are flipped. Both ends are inset as the extremes are rarely worth hitting exactly.
+FILE_SCOPE void LOGLBCInternal_BoundingBoxEndpoints(const LOGLBCBlock *const block, i32 *const end0,
+                                                    i32 *const end1)
+{
+	i32 minColor[3] = {255, 255, 255};
+	i32 maxColor[3] = {0, 0, 0};
+	i32 sum[3]      = {};
+	for (u32 i = 0; i < 16; i++)
+	{
+		for (u32 c = 0; c < 3; c++)
+		{
+			minColor[c] = DQN_MIN(minColor[c], (i32)block->pixels[i][c]);
+			maxColor[c] = DQN_MAX(maxColor[c], (i32)block->pixels[i][c]);
+			sum[c]     += block->pixels[i][c];
+		}
+	}
+
+	u32 widest = 0;
+	for (u32 c = 1; c < 3; c++)
+	{
+		if (maxColor[c] - minColor[c] > maxColor[widest] - minColor[widest]) widest = c;
+	}
+
+	for (u32 c = 0; c < 3; c++)
+	{
+		i32 covariance = 0;
+		for (u32 i = 0; i < 16; i++)
+			covariance += ((block->pixels[i][widest] * 16) - sum[widest]) * ((block->pixels[i][c] * 16) - sum[c]);
+
+		if (covariance < 0) DQN_SWAP(i32, minColor[c], maxColor[c]);
+
+		i32 inset = (maxColor[c] - minColor[c]) / 16;
+		end0[c]   = maxColor[c] - inset;
+		end1[c]   = minColor[c] + inset;
+	}
+}
+
+// The endpoints are the pixels furthest apart along the principal axis of the block's colours,
+// found by power iteration on their covariance.
+FILE_SCOPE void LOGLBCInternal_PrincipalAxisEndpoints(const LOGLBCBlock *const block, i32 *const end0,
+                                                      i32 *const end1)
+{
+	f32 mean[3] = {};
+	for (u32 i = 0; i < 16; i++)
+	{
+		for (u32 c = 0; c < 3; c++)
+			mean[c] += block->pixels[i][c];
+	}
+	for (u32 c = 0; c < 3; c++)
+		mean[c] /= 16.0f;
+
+	// NOTE: Symmetric, rr rg rb gg gb bb
+	f32 covariance[6] = {};
+	for (u32 i = 0; i < 16; i++)
+	{
+		f32 r = block->pixels[i][0] - mean[0];
+		f32 g = block->pixels[i][1] - mean[1];
+		f32 b = block->pixels[i][2] - mean[2];
+		covariance[0] += r * r;
+		covariance[1] += r * g;
+		covariance[2] += r * b;
+		covariance[3] += g * g;
+		covariance[4] += g * b;
+		covariance[5] += b * b;
+	}
+
+	f32 axis[3] = {covariance[0], covariance[3], covariance[5]};
+	for (u32 iteration = 0; iteration < 4; iteration++)
+	{
+		f32 r = (axis[0] * covariance[0]) + (axis[1] * covariance[1]) + (axis[2] * covariance[2]);
+		f32 g = (axis[0] * covariance[1]) + (axis[1] * covariance[3]) + (axis[2] * covariance[4]);
+		f32 b = (axis[0] * covariance[2]) + (axis[1] * covariance[4]) + (axis[2] * covariance[5]);
+
+		f32 length = sqrtf((r * r) + (g * g) + (b * b));
+		if (length < 1e-6f) break;
+		axis[0] = r / length;
+		axis[1] = g / length;
+		axis[2] = b / length;
+	}
+
+	// NOTE: Endpoints are the extent of the pixels along the axis through the mean, inset like the
+	// bounding box as the extremes are rarely worth a palette entry to themselves
+	f32 minDot = 0, maxDot = 0;
+	for (u32 i = 0; i < 16; i++)
+	{
+		f32 r   = block->pixels[i][0] - mean[0];
+		f32 g   = block->pixels[i][1] - mean[1];
+		f32 b   = block->pixels[i][2] - mean[2];
+		f32 dot = (r * axis[0]) + (g * axis[1]) + (b * axis[2]);
+		minDot  = DQN_MIN(minDot, dot);
+		maxDot  = DQN_MAX(maxDot, dot);
+	}
+
+	f32 inset = (maxDot - minDot) / 16.0f;
+	minDot   += inset;
+	maxDot   -= inset;
+	for (u32 c = 0; c < 3; c++)
+	{
+		end0[c] = DQN_MIN(DQN_MAX((i32)(mean[c] + (axis[c] * maxDot) + 0.5f), 0), 255);
+		end1[c] = DQN_MIN(DQN_MAX((i32)(mean[c] + (axis[c] * minDot) + 0.5f), 0), 255);
+	}
+}
+
+// Solve for the endpoints that best fit the pixels given their indices, in the least squares sense.
+// return: FALSE if every pixel uses the same weight so the endpoints can't be solved for.
+FILE_SCOPE bool LOGLBCInternal_RefineEndpoints(const LOGLBCBlock *const block, const u32 indices, i32 *const end0,
+                                               i32 *const end1)
+{
+	// NOTE: Weight of color0 for each index in 4 colour mode
+	const f32 WEIGHTS[4] = {1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f};
+
+	f32 aa = 0, bb = 0, ab = 0;
+	f32 ap[3] = {}, bp[3] = {};
+	for (u32 i = 0; i < 16; i++)
+	{
+		f32 a = WEIGHTS[(indices >> (i * 2)) & 3];
+		f32 b = 1.0f - a;
+		aa += a * a;
+		bb += b * b;
+		ab += a * b;
+		for (u32 c = 0; c < 3; c++)
+		{
+			ap[c] += a * block->pixels[i][c];
+			bp[c] += b * block->pixels[i][c];
+		}
+	}
+
+	f32 determinant = (aa * bb) - (ab * ab);
+	if (DQN_ABS(determinant) < 1e-6f) return false;
+
+	f32 invDeterminant = 1.0f / determinant;
+	for (u32 c = 0; c < 3; c++)
+	{
+		end0[c] = (i32)((((ap[c] * bb) - (bp[c] * ab)) * invDeterminant) + 0.5f);
+		end1[c] = (i32)((((bp[c] * aa) - (ap[c] * ab)) * invDeterminant) + 0.5f);
+	}
+
+	return true;
+}
+
+FILE_SCOPE void LOGLBCInternal_EncodeColorBlock(const LOGLBCBlock *const block, const enum LOGLBCQuality quality,
+                                                u8 *const dest)
+{
+	i32 end0[3], end1[3];
+	if (quality == LOGLBCQuality_Fast) LOGLBCInternal_BoundingBoxEndpoints(block, end0, end1);
+	else                               LOGLBCInternal_PrincipalAxisEndpoints(block, end0, end1);
+
+	u16 color0 = LOGLBCInternal_To565(end0);
+	u16 color1 = LOGLBCInternal_To565(end1);
+	u32 indices;
+	u32 error = LOGLBCInternal_FinishColorBlock(block, &color0, &color1, &indices);
+
+	if (quality == LOGLBCQuality_High)
+	{
+		for (u32 iteration = 0; iteration < 2 && error > 0; iteration++)
+		{
+			if (!LOGLBCInternal_RefineEndpoints(block, indices, end0, end1)) break;
+
+			u16 refinedColor0 = LOGLBCInternal_To565(end0);
+			u16 refinedColor1 = LOGLBCInternal_To565(end1);
+			u32 refinedIndices;
+			u32 refinedError = LOGLBCInternal_FinishColorBlock(block, &refinedColor0, &refinedColor1, &refinedIndices);
+			if (refinedError >= error) break;
+
+			color0  = refinedColor0;
+			color1  = refinedColor1;
+			indices = refinedIndices;
+			error   = refinedError;
+		}
+	}
+
+	dest[0] = (u8)(color0 & 0xFF);
+	dest[1] = (u8)(color0 >> 8);
+	dest[2] = (u8)(color1 & 0xFF);
+	dest[3] = (u8)(color1 >> 8);
+	for (u32 i = 0; i < 4; i++)
+		dest[4 + i] = (u8)(indices >> (i * 8));
+}
+
+// end0 > end1 interpolates 6 values between them, otherwise 4 values plus 0 and 255
+FILE_SCOPE void LOGLBCInternal_BC4Palette(const u8 end0, const u8 end1, u8 palette[8])
+{
+	palette[0] = end0;
+	palette[1] = end1;
+	if (end0 > end1)
+	{
+		for (u32 i = 1; i <= 6; i++)
+			palette[i + 1] = (u8)((((7 - i) * end0) + (i * end1) + 3) / 7);
+	}
+	else
+	{
+		for (u32 i = 1; i <= 4; i++)
+			palette[i + 1] = (u8)((((5 - i) * end0) + (i * end1) + 2) / 5);
+		palette[6] = 0;
+		palette[7] = 255;
+	}
+}
+
+// return: The summed squared error of the block.
+FILE_SCOPE u32 LOGLBCInternal_BC4Indices(const u8 *const values, const u8 end0, const u8 end1, u64 *const indices)
+{
+	u8 palette[8];
+	LOGLBCInternal_BC4Palette(end0, end1, palette);
+
+	u32 result = 0;
+	*indices   = 0;
+	for (u32 i = 0; i < 16; i++)
+	{
+		u32 bestError = 0xFFFFFFFF;
+		u64 bestIndex = 0;
+		for (u32 j = 0; j < 8; j++)
+		{
+			i32 diff  = (i32)values[i] - palette[j];
+			u32 error = (u32)(diff * diff);
+			if (error < bestError)
+			{
+				bestError = error;
+				bestIndex = j;
+			}
+		}
+
+		*indices |= bestIndex << (i * 3);
+		result   += bestError;
+	}
+
+	return result;
+}
+
+FILE_SCOPE void LOGLBCInternal_EncodeBC4Block(const u8 *const values, const enum LOGLBCQuality quality, u8 *const dest)
+{
+	u8 minValue = 255, maxValue = 0;
+	u8 minInner = 255, maxInner = 0; // Ignoring 0 and 255
+	for (u32 i = 0; i < 16; i++)
+	{
+		minValue = DQN_MIN(minValue, values[i]);
+		maxValue = DQN_MAX(maxValue, values[i]);
+		if (values[i] != 0 && values[i] != 255)
+		{
+			minInner = DQN_MIN(minInner, values[i]);
+			maxInner = DQN_MAX(maxInner, values[i]);
+		}
+	}
+
+	u8 end0 = maxValue, end1 = minValue;
+	u64 indices;
+	u32 error = LOGLBCInternal_BC4Indices(values, end0, end1, &indices);
+
+	// NOTE: 0 and 255 come free in the 4 value mode, so its endpoints only need to span what's between
+	if (quality >= LOGLBCQuality_Normal && error > 0)
+	{
+		if (minInner > maxInner) minInner = maxInner = 0;
+
+		u64 innerIndices;
+		u32 innerError = LOGLBCInternal_BC4Indices(values, minInner, maxInner, &innerIndices);
+		if (innerError < error)
+		{
+			end0    = minInner;
+			end1    = maxInner;
+			indices = innerIndices;
+			error   = innerError;
+		}
+	}
+
+	if (quality == LOGLBCQuality_High && error > 0)
+	{
+		for (i32 delta0 = -2; delta0 <= 2; delta0++)
+		{
+			for (i32 delta1 = -2; delta1 <= 2; delta1++)
+			{
+				i32 tryEnd0 = DQN_MIN(DQN_MAX((i32)maxValue + delta0, 0), 255);
+				i32 tryEnd1 = DQN_MIN(DQN_MAX((i32)minValue + delta1, 0), 255);
+				if (tryEnd0 <= tryEnd1) continue;
+
+				u64 tryIndices;
+				u32 tryError = LOGLBCInternal_BC4Indices(values, (u8)tryEnd0, (u8)tryEnd1, &tryIndices);
+				if (tryError < error)
+				{
+					end0    = (u8)tryEnd0;
+					end1    = (u8)tryEnd1;
+					indices = tryIndices;
+					error   = tryError;
+				}
+			}
+		}
+	}
+
+	dest[0] = end0;
+	dest[1] = end1;
+	for (u32 i = 0; i < 6; i++)
+		dest[2 + i] = (u8)(indices >> (i * 8));
+}
+
+FILE_SCOPE inline void LOGLBCInternal_GetChannel(const LOGLBCBlock *const block, const u32 channel, u8 *const values)
+{
+	for (u32 i = 0; i < 16; i++)
+		values[i] = block->pixels[i][channel];
+}
+
+struct LOGLBCEncodeJob
+{
+	const LOGLBitmap  *bitmap;
+	enum LOGLBCFormat  format;
+	enum LOGLBCQuality quality;
+	u8                *dest;
+	u32                blockYStart;
+	u32                blockYEnd;
+};
+
+FILE_SCOPE void LOGLBCInternal_EncodeJob(DqnJobQueue *const queue, void *const userData)
+{
+	const LOGLBCEncodeJob *job = (LOGLBCEncodeJob *)userData;
+	const u32 blocksWide       = (job->bitmap->dim.w + 3) / 4;
+	const u32 blockSize        = LOGLBC_BlockSize(job->format);
+
+	LOGLBCBlock block;
+	u8 values[16];
+	for (u32 blockY = job->blockYStart; blockY < job->blockYEnd; blockY++)
+	{
+		u8 *dest = job->dest + ((size_t)blockY * blocksWide * blockSize);
+		for (u32 blockX = 0; blockX < blocksWide; blockX++, dest += blockSize)
+		{
+			LOGLBCInternal_FetchBlock(job->bitmap, blockX, blockY, &block);
+			switch (job->format)
+			{
+				case LOGLBCFormat_BC1:
+				{
+					LOGLBCInternal_EncodeColorBlock(&block, job->quality, dest);
+				}
+				break;
+
+				case LOGLBCFormat_BC3:
+				{
+					LOGLBCInternal_GetChannel(&block, 3, values);
+					LOGLBCInternal_EncodeBC4Block(values, job->quality, dest);
+					LOGLBCInternal_EncodeColorBlock(&block, job->quality, dest + 8);
+				}
+				break;
+
+				case LOGLBCFormat_BC4:
+				{
+					LOGLBCInternal_GetChannel(&block, 0, values);
+					LOGLBCInternal_EncodeBC4Block(values, job->quality, dest);
+				}
+				break;
+
+				case LOGLBCFormat_BC5:
+				{
+					LOGLBCInternal_GetChannel(&block, 0, values);
+					LOGLBCInternal_EncodeBC4Block(values, job->quality, dest);
+					LOGLBCInternal_GetChannel(&block, 1, values);
+					LOGLBCInternal_EncodeBC4Block(values, job->quality, dest + 8);
+				}
+				break;
+
+				default: DQN_ASSERT(DQN_INVALID_CODE_PATH); break;
+			}
+		}
+	}
+}
+
+bool LOGLBC_Encode(DqnJobQueue *const queue, const LOGLBitmap *const bitmap, const enum LOGLBCFormat format,
+                   const enum LOGLBCQuality quality, u8 *const dest)
+{
+	if (!bitmap || !bitmap->memory || !dest || bitmap->dim.w <= 0 || bitmap->dim.h <= 0) return false;
+	if (bitmap->bytesPerPixel < 1 || bitmap->bytesPerPixel > 4) return false;
+	if (LOGLBC_BlockSize(format) == 0 || quality <= LOGLBCQuality_None || quality >= LOGLBCQuality_Count)
+		return false;
+
+	const u32 blocksWide   = (bitmap->dim.w + 3) / 4;
+	const u32 blocksHigh   = (bitmap->dim.h + 3) / 4;
+	u32 blockRowsPerJob    = DQN_MAX(1u, LOGL_BC_MIN_BLOCKS_PER_JOB / blocksWide);
+	blockRowsPerJob        = DQN_MAX(blockRowsPerJob, (blocksHigh + LOGL_BC_MAX_JOBS - 1) / LOGL_BC_MAX_JOBS);
+
+	LOGLBCEncodeJob jobs[LOGL_BC_MAX_JOBS];
+	DqnJobCounter counter = {};
+	u32 numJobs           = 0;
+	for (u32 blockY = 0; blockY < blocksHigh; blockY += blockRowsPerJob)
+	{
+		LOGLBCEncodeJob *job = &jobs[numJobs++];
+		job->bitmap          = bitmap;
+		job->format          = format;
+		job->quality         = quality;
+		job->dest            = dest;
+		job->blockYStart     = blockY;
+		job->blockYEnd       = DQN_MIN(blockY + blockRowsPerJob, blocksHigh);
+
+		DqnJob queueJob = {LOGLBCInternal_EncodeJob, job, &counter};
+		if (!queue || !DqnJobQueue_AddJob(queue, queueJob))
+			LOGLBCInternal_EncodeJob(queue, job);
+	}
+
+	DqnJobQueue_WaitForCounter(queue, &counter);
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Block Decoding
+////////////////////////////////////////////////////////////////////////////////
+FILE_SCOPE void LOGLBCInternal_DecodeColorBlock(const u8 *const src, const bool alwaysFourColor,
+                                                LOGLBCBlock *const block)
+{
+	u16 color0  = (u16)(src[0] | (src[1] << 8));
+	u16 color1  = (u16)(src[2] | (src[3] << 8));
+	u32 indices = (u32)src[4] | ((u32)src[5] << 8) | ((u32)src[6] << 16) | ((u32)src[7] << 24);
+
+	i32 palette[4][3];
+	LOGLBCInternal_ColorPalette(color0, color1, alwaysFourColor || color0 > color1, palette);
+	for (u32 i = 0; i < 16; i++)
+	{
+		const i32 *color = palette[(indices >> (i * 2)) & 3];
+		for (u32 c = 0; c < 3; c++)
+			block->pixels[i][c] = (u8)color[c];
+	}
+}
+
+FILE_SCOPE void LOGLBCInternal_DecodeBC4Block(const u8 *const src, const u32 channel, LOGLBCBlock *const block)
+{
+	u8 palette[8];
+	LOGLBCInternal_BC4Palette(src[0], src[1], palette);
+
+	u64 indices = 0;
+	for (u32 i = 0; i < 6; i++)
+		indices |= (u64)src[2 + i] << (i * 8);
+
+	for (u32 i = 0; i < 16; i++)
+		block->pixels[i][channel] = palette[(indices >> (i * 3)) & 7];
+}
+
+bool LOGLBC_Decode(const LOGLBCImage *const image, LOGLBitmap *const dest)
+{
+	if (!image || !image->blocks || !dest || !dest->memory) return false;
+	if (dest->dim.w != image->dim.w || dest->dim.h != image->dim.h || dest->dim.w <= 0 || dest->dim.h <= 0)
+		return false;
+	if (dest->bytesPerPixel < 1 || dest->bytesPerPixel > 4) return false;
+
+	const u32 blockSize = LOGLBC_BlockSize(image->format);
+	if (blockSize == 0 || image->size < LOGLBC_EncodedSize(image->format, image->dim.w, image->dim.h)) return false;
+
+	const i32 bytesPerPixel = dest->bytesPerPixel;
+	const size_t pitch      = (size_t)dest->dim.w * bytesPerPixel;
+	const u32 blocksWide    = (image->dim.w + 3) / 4;
+	const u32 blocksHigh    = (image->dim.h + 3) / 4;
+	const u8 *src           = image->blocks;
+	for (u32 blockY = 0; blockY < blocksHigh; blockY++)
+	{
+		for (u32 blockX = 0; blockX < blocksWide; blockX++, src += blockSize)
+		{
+			LOGLBCBlock block;
+			for (u32 i = 0; i < 16; i++)
+			{
+				block.pixels[i][0] = block.pixels[i][1] = block.pixels[i][2] = 0;
+				block.pixels[i][3] = 255;
+			}
+
+			switch (image->format)
+			{
+				case LOGLBCFormat_BC1: LOGLBCInternal_DecodeColorBlock(src, false, &block); break;
+				case LOGLBCFormat_BC3:
+				{
+					LOGLBCInternal_DecodeBC4Block(src, 3, &block);
+					LOGLBCInternal_DecodeColorBlock(src + 8, true, &block);
+				}
+				break;
+				case LOGLBCFormat_BC4: LOGLBCInternal_DecodeBC4Block(src, 0, &block); break;
+				case LOGLBCFormat_BC5:
+				{
+					LOGLBCInternal_DecodeBC4Block(src, 0, &block);
+					LOGLBCInternal_DecodeBC4Block(src + 8, 1, &block);
+				}
+				break;
+				default: return false;
+			}
+
+			// NOTE: Edge blocks hang over the image, drop the pixels outside of it
+			u32 width  = DQN_MIN(4, dest->dim.w - (i32)(blockX * 4));
+			u32 height = DQN_MIN(4, dest->dim.h - (i32)(blockY * 4));
+			for (u32 y = 0; y < height; y++)
+			{
+				u8 *destPixel = dest->memory + ((blockY * 4 + y) * pitch) + ((size_t)blockX * 4 * bytesPerPixel);
+				for (u32 x = 0; x < width; x++, destPixel += bytesPerPixel)
+				{
+					for (i32 c = 0; c < bytesPerPixel; c++)
+						destPixel[c] = block.pixels[(y * 4) + x][c];
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+f32 LOGLBC_PSNR(DqnMemStack *const tempStack, const LOGLBitmap *const bitmap, const LOGLBCImage *const image)
+{
+	if (!tempStack || !bitmap || !bitmap->memory || !image) return 0;
+
+	const i32 bytesPerPixel = bitmap->bytesPerPixel;
+	i32 numChannels;
+	switch (image->format)
+	{
+		case LOGLBCFormat_BC1: numChannels = DQN_MIN(bytesPerPixel, 3); break;
+		case LOGLBCFormat_BC3: numChannels = bytesPerPixel;             break;
+		case LOGLBCFormat_BC4: numChannels = 1;                         break;
+		case LOGLBCFormat_BC5: numChannels = DQN_MIN(bytesPerPixel, 2); break;
+		default: return 0;
+	}
+
+	auto memRegion     = tempStack->TempRegionGuard();
+	LOGLBitmap decoded = {};
+	decoded.dim           = bitmap->dim;
+	decoded.bytesPerPixel = bytesPerPixel;
+	decoded.memory        = (u8 *)tempStack->Push((size_t)bitmap->dim.w * bitmap->dim.h * bytesPerPixel);
+	if (!decoded.memory || !LOGLBC_Decode(image, &decoded)) return 0;
+
+	u64 sumSquaredError = 0;
+	const i32 numPixels = bitmap->dim.w * bitmap->dim.h;
+	for (i32 i = 0; i < numPixels; i++)
+	{
+		const u8 *a = bitmap->memory + ((size_t)i * bytesPerPixel);
+		const u8 *b = decoded.memory + ((size_t)i * bytesPerPixel);
+		for (i32 c = 0; c < numChannels; c++)
+		{
+			i32 diff         = (i32)a[c] - b[c];
+			sumSquaredError += (u64)(diff * diff);
+		}
+	}
+
+	if (sumSquaredError == 0) return INFINITY;
+
+	f64 meanSquaredError = (f64)sumSquaredError / ((f64)numPixels * numChannels);
+	f32 result           = (f32)(10.0 * log10((255.0 * 255.0) / meanSquaredError));
+	return result;
+}
@@ -0,0 +1,68 @@
+#ifndef LOGL_BC_H
+#define LOGL_BC_H
+
+#define DQN_PLATFORM_HEADER // For DqnJobQueue
+#include "dqn.h"
+
+// Block compression of 8 bit bitmaps into the BCn formats GL samples directly, cutting texture
+// memory to a quarter (BC1, BC4) or half (BC3, BC5) of RGBA8. Bitmaps are encoded as 4x4 blocks in
+// memory order, edge blocks of sizes that aren't a multiple of 4 repeat the last row and column.
+// BC4/BC5 are core in GL 3.0, BC1/BC3 need EXT_texture_compression_s3tc which desktop drivers have.
+
+enum LOGLBCFormat
+{
+	LOGLBCFormat_None,
+	LOGLBCFormat_BC1, // RGB in 8 bytes a block, alpha is dropped
+	LOGLBCFormat_BC3, // RGBA in 16 bytes a block, a BC4 block of alpha then a BC1 block of colour
+	LOGLBCFormat_BC4, // R in 8 bytes a block
+	LOGLBCFormat_BC5, // RG in 16 bytes a block, a BC4 block for each channel
+	LOGLBCFormat_Count,
+};
+
+enum LOGLBCQuality
+{
+	LOGLBCQuality_None,   // Don't compress
+	LOGLBCQuality_Fast,   // Endpoints from the bounding box of each block
+	LOGLBCQuality_Normal, // Endpoints along the principal axis of each block's colours, both BC4 modes
+	LOGLBCQuality_High,   // Normal, then refine the endpoints by least squares and a local BC4 search
+	LOGLBCQuality_Count,
+};
+
+// A compressed image, one mip of a texture
+struct LOGLBCImage
+{
+	const u8         *blocks;
+	size_t            size;
+	DqnV2i            dim; // In pixels
+	enum LOGLBCFormat format;
+};
+
+struct LOGLBitmap;
+
+// return: The bytes in one 4x4 block, 0 if format is invalid.
+u32 LOGLBC_BlockSize(const enum LOGLBCFormat format);
+
+// return: The bytes to hold a width x height image in format, 0 if format is invalid.
+size_t LOGLBC_EncodedSize(const enum LOGLBCFormat format, const u32 width, const u32 height);
+
+// Pick the smallest format that keeps the channels bitmap uses: BC4 for a single channel or grey
+// RGB(A) that's opaque, BC5 for 2 channels, BC3 for RGBA with any alpha below 255 and BC1 otherwise.
+enum LOGLBCFormat LOGLBC_PickFormat(const LOGLBitmap *const bitmap);
+
+// Encode bitmap into dest. Rows of blocks are split across queue if there is one, the calling thread
+// helps until they complete. BC4 encodes the first channel, BC5 the first two.
+// dest: Must hold LOGLBC_EncodedSize() bytes.
+// return: FALSE if the format, quality or bitmap is invalid.
+bool LOGLBC_Encode(DqnJobQueue *const queue, const LOGLBitmap *const bitmap, const enum LOGLBCFormat format,
+                   const enum LOGLBCQuality quality, u8 *const dest);
+
+// Decode image into dest, which must have the same dimensions. Channels the format doesn't store
+// are set like GL would sample them, 0 for colour and 255 for alpha.
+// return: FALSE if the image or dest is invalid.
+bool LOGLBC_Decode(const LOGLBCImage *const image, LOGLBitmap *const dest);
+
+// Decode image and compare it to the bitmap it was encoded from over the channels its format stores.
+// return: Peak signal to noise ratio in dB, INFINITY if it's lossless, 0 if tempStack ran out of memory.
+f32 LOGLBC_PSNR(DqnMemStack *const tempStack, const LOGLBitmap *const bitmap, const LOGLBCImage *const image);
+
+#endif
@@ -0,0 +1,1136 @@
+#include "LOGL.h"
+#include "LOGLBC.h"
+#include "LOGLBench.h"
+#include "LOGLCull.h"
+#include "LOGLMip.h"
+#include "LOGLRenderQueue.h"
+
+#define DQN_PLATFORM_HEADER // For DqnJobQueue
+#include "dqn.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h> // For qsort(), malloc()
+#include <string.h> // For memcpy(), memset()
+
+typedef DqnMat4 LOGLBenchMat4Proc(DqnMat4 a);
+
+FILE_SCOPE DqnMat4 LOGLBench_TransposeInverse(DqnMat4 a)
+{
+	DqnMat4 result = DqnMat4_Transpose(DqnMat4_Inverse(a));
+	return result;
+}
+
+// Time one pass of expr over the working set as the best of 5 runs, stored in ns per item in timeNs
+#define LOGL_BENCH_TIME(timeNs, numItems, expr)                                                 \
+	do                                                                                          \
+	{                                                                                           \
+		f64 bestTimeInMs_ = 0;                                                                  \
+		for (u32 run_ = 0; run_ < 5; run_++)                                                    \
+		{                                                                                       \
+			f64 startTimeInMs_ = DqnTimer_NowInMs();                                            \
+			expr;                                                                               \
+			f64 timeInMs_ = DqnTimer_NowInMs() - startTimeInMs_;                                \
+			if (run_ == 0 || timeInMs_ < bestTimeInMs_) bestTimeInMs_ = timeInMs_;              \
+		}                                                                                       \
+		timeNs = (bestTimeInMs_ * 1000000.0) / (numItems);                                      \
+	} while (0)
+
+FILE_SCOPE void LOGLBench_Mat4(DqnMat4 *const matrices, DqnMat4 *const results, const u32 numMatrices)
+{
+	// Model matrices like the scene's, with non uniform scale so the normal matrix isn't just the rotation
+	DqnRandPCGState rnd;
+	DqnRnd_PCGInitWithSeed(&rnd, 0xBE4C);
+	for (u32 i = 0; i < numMatrices; i++)
+	{
+		DqnV3 pos   = DqnV3_3f(DqnRnd_PCGNextf(&rnd), DqnRnd_PCGNextf(&rnd), DqnRnd_PCGNextf(&rnd)) * 100.0f;
+		DqnV3 axis  = DqnV3_3f(DqnRnd_PCGNextf(&rnd), DqnRnd_PCGNextf(&rnd), DqnRnd_PCGNextf(&rnd)) + DqnV3_1f(0.1f);
+		DqnV3 scale = DqnV3_3f(DqnRnd_PCGNextf(&rnd), DqnRnd_PCGNextf(&rnd), DqnRnd_PCGNextf(&rnd)) * 2.0f + DqnV3_1f(0.5f);
+		f32 radians = DqnRnd_PCGNextf(&rnd) * DQN_PI;
+
+		DqnMat4 rotate = DqnMat4_Rotate(radians, axis.x, axis.y, axis.z);
+		matrices[i]    = DqnMat4_Mul(DqnMat4_TranslateV3(pos), DqnMat4_Mul(rotate, DqnMat4_ScaleV3(scale)));
+	}
+
+	struct
+	{
+		const char        *name;
+		LOGLBenchMat4Proc *proc;
+	} benches[] = {
+	    {"DqnMat4_Transpose",            DqnMat4_Transpose},
+	    {"DqnMat4_Inverse",              DqnMat4_Inverse},
+	    {"DqnMat4_Transpose(Inverse())", LOGLBench_TransposeInverse},
+	    {"DqnMat4_NormalMatrix",         DqnMat4_NormalMatrix},
+	};
+
+	printf("Bench: %u matrices\n", numMatrices);
+	for (u32 i = 0; i < DQN_ARRAY_COUNT(benches); i++)
+	{
+		LOGLBenchMat4Proc *proc = benches[i].proc;
+		f64 nsPerMatrix;
+		LOGL_BENCH_TIME(nsPerMatrix, numMatrices, for (u32 j = 0; j < numMatrices; j++) results[j] = proc(matrices[j]));
+		printf("  %-30s %6.2f ns/matrix\n", benches[i].name, nsPerMatrix);
+	}
+
+	// Check the results against the identities they should satisfy
+	f32 maxInverseError = 0;
+	f32 maxNormalError  = 0;
+	for (u32 i = 0; i < numMatrices; i++)
+	{
+		DqnMat4 inverse  = DqnMat4_Inverse(matrices[i]);
+		DqnMat4 identity = DqnMat4_Mul(matrices[i], inverse);
+		DqnMat4 expected = DqnMat4_Transpose(inverse);
+		DqnMat4 normal   = DqnMat4_NormalMatrix(matrices[i]);
+		for (u32 col = 0; col < 4; col++)
+		{
+			for (u32 row = 0; row < 4; row++)
+			{
+				f32 identityVal = (col == row) ? 1.0f : 0.0f;
+				maxInverseError = DQN_MAX(maxInverseError, fabsf(identity.e[col][row] - identityVal));
+				if (col < 3 && row < 3)
+					maxNormalError = DQN_MAX(maxNormalError, fabsf(normal.e[col][row] - expected.e[col][row]));
+			}
+		}
+	}
+
+	printf("  max error |m * inverse(m) - I| %g, |normal matrix - transpose(inverse(m))| %g\n",
+	       maxInverseError, maxNormalError);
+}
+
+// Plain scalar versions to check the SIMD paths in dqn.h against and show what they gain
+FILE_SCOPE DqnMat4 LOGLBench_Mat4MulScalar(const DqnMat4 *const a, const DqnMat4 *const b)
+{
+	DqnMat4 result;
+	for (u32 j = 0; j < 4; j++)
+		for (u32 i = 0; i < 4; i++)
+			result.e[j][i] = (a->e[0][i] * b->e[j][0]) + (a->e[1][i] * b->e[j][1]) +
+			                 (a->e[2][i] * b->e[j][2]) + (a->e[3][i] * b->e[j][3]);
+
+	return result;
+}
+
+FILE_SCOPE DqnV4 LOGLBench_Mat4MulV4Scalar(const DqnMat4 *const a, const DqnV4 *const b)
+{
+	DqnV4 result;
+	for (u32 i = 0; i < 4; i++)
+		result.e[i] = (a->e[0][i] * b->x) + (a->e[1][i] * b->y) + (a->e[2][i] * b->z) + (a->e[3][i] * b->w);
+
+	return result;
+}
+
+FILE_SCOPE f32 LOGLBench_MaxError(const f32 *const a, const f32 *const b, const size_t count)
+{
+	f32 result = 0;
+	for (size_t i = 0; i < count; i++)
+		result = DQN_MAX(result, fabsf(a[i] - b[i]));
+
+	return result;
+}
+
+FILE_SCOPE void LOGLBench_Mat4Mul(const DqnMat4 *const matrices, DqnMat4 *const results,
+                                  DqnMat4 *const expected, const u32 numMatrices)
+{
+#if defined(DQN_AVX)
+	const char *simd = "AVX";
+#elif defined(DQN_SSE2)
+	const char *simd = "SSE2";
+#else
+	const char *simd = "none";
+#endif
+
+	// A view projection like matrix applied to every model, as a renderer would
+	DqnMat4 viewProj = DqnMat4_Mul(DqnMat4_Perspective(45.0f, 4.0f / 3.0f, 0.1f, 100.0f),
+	                               DqnMat4_LookAt(DqnV3_3f(0, 0, 3), DqnV3_3f(0, 0, 0), DqnV3_3f(0, 1, 0)));
+
+	f64 scalarNs, mulNs, batchNs;
+	LOGL_BENCH_TIME(scalarNs, numMatrices,
+	                for (u32 i = 0; i < numMatrices; i++) expected[i] = LOGLBench_Mat4MulScalar(&viewProj, &matrices[i]));
+	LOGL_BENCH_TIME(mulNs, numMatrices,
+	                for (u32 i = 0; i < numMatrices; i++) results[i] = DqnMat4_Mul(viewProj, matrices[i]));
+	f32 mulError = LOGLBench_MaxError(&results[0].e[0][0], &expected[0].e[0][0], numMatrices * 16);
+	LOGL_BENCH_TIME(batchNs, numMatrices, DqnMat4_MulBatch(viewProj, matrices, results, numMatrices));
+	f32 batchError = LOGLBench_MaxError(&results[0].e[0][0], &expected[0].e[0][0], numMatrices * 16);
+
+	printf("Bench: %u matrix multiplies, SIMD %s\n", numMatrices, simd);
+	printf("  %-30s %6.2f ns/matrix\n", "scalar reference", scalarNs);
+	printf("  %-30s %6.2f ns/matrix - max error %g\n", "DqnMat4_Mul", mulNs, mulError);
+	printf("  %-30s %6.2f ns/matrix - max error %g\n", "DqnMat4_MulBatch", batchNs, batchError);
+
+	// Reuse the matrices as vectors, the results have to fit in the same memory
+	const DqnV4 *vectors   = (const DqnV4 *)matrices;
+	DqnV4 *vectorResults   = (DqnV4 *)results;
+	DqnV4 *vectorsExpected = (DqnV4 *)expected;
+	const u32 numVectors   = numMatrices * 4;
+
+	f64 scalarV4Ns, mulV4Ns, batchV4Ns;
+	LOGL_BENCH_TIME(scalarV4Ns, numVectors,
+	                for (u32 i = 0; i < numVectors; i++) vectorsExpected[i] = LOGLBench_Mat4MulV4Scalar(&viewProj, &vectors[i]));
+	LOGL_BENCH_TIME(mulV4Ns, numVectors,
+	                for (u32 i = 0; i < numVectors; i++) vectorResults[i] = DqnMat4_MulV4(viewProj, vectors[i]));
+	f32 mulV4Error = LOGLBench_MaxError(vectorResults[0].e, vectorsExpected[0].e, numVectors * 4);
+	LOGL_BENCH_TIME(batchV4Ns, numVectors, DqnMat4_MulV4Batch(viewProj, vectors, vectorResults, numVectors));
+	f32 batchV4Error = LOGLBench_MaxError(vectorResults[0].e, vectorsExpected[0].e, numVectors * 4);
+
+	printf("Bench: %u matrix * vector, SIMD %s\n", numVectors, simd);
+	printf("  %-30s %6.2f ns/vector\n", "scalar reference", scalarV4Ns);
+	printf("  %-30s %6.2f ns/vector - max error %g\n", "DqnMat4_MulV4", mulV4Ns, mulV4Error);
+	printf("  %-30s %6.2f ns/vector - max error %g\n", "DqnMat4_MulV4Batch", batchV4Ns, batchV4Error);
+}
+
+// Scalar reference for LOGLCull_Spheres() with the same order of operations, so the results must match exactly
+FILE_SCOPE u32 LOGLBench_CullSpheresScalar(const LOGLFrustum *const frustum, const LOGLCullSpheres *const spheres,
+                                           u32 *const visibleIndices)
+{
+	u32 numVisible = 0;
+	for (u32 i = 0; i < spheres->count; i++)
+	{
+		bool inside = true;
+		for (u32 j = 0; j < 6 && inside; j++)
+		{
+			const DqnV4 *plane = &frustum->planes[j];
+			f32 dist = (plane->x * spheres->x[i]) + plane->w;
+			dist    += (plane->y * spheres->y[i]);
+			dist    += (plane->z * spheres->z[i]);
+			inside   = (dist >= -spheres->radius[i]);
+		}
+
+		if (inside) visibleIndices[numVisible++] = i;
+	}
+
+	return numVisible;
+}
+
+FILE_SCOPE u32 LOGLBench_CullAABBsScalar(const LOGLFrustum *const frustum, const LOGLCullAABBs *const aabbs,
+                                         u32 *const visibleIndices)
+{
+	u32 numVisible = 0;
+	for (u32 i = 0; i < aabbs->count; i++)
+	{
+		bool inside = true;
+		for (u32 j = 0; j < 6 && inside; j++)
+		{
+			const DqnV4 *plane = &frustum->planes[j];
+			f32 dist = (plane->x * aabbs->centerX[i]) + plane->w;
+			dist    += (plane->y * aabbs->centerY[i]);
+			dist    += (plane->z * aabbs->centerZ[i]);
+
+			f32 radius = fabsf(plane->x) * aabbs->extentX[i];
+			radius    += fabsf(plane->y) * aabbs->extentY[i];
+			radius    += fabsf(plane->z) * aabbs->extentZ[i];
+			inside     = (dist + radius >= 0);
+		}
+
+		if (inside) visibleIndices[numVisible++] = i;
+	}
+
+	return numVisible;
+}
+
+FILE_SCOPE u32 LOGLBench_CountMismatches(const u32 *const a, const u32 numA, const u32 *const b, const u32 numB)
+{
+	u32 result = (numA > numB) ? (numA - numB) : (numB - numA);
+	for (u32 i = 0; i < DQN_MIN(numA, numB); i++)
+		result += (a[i] != b[i]) ? 1 : 0;
+
+	return result;
+}
+
+// Randomised scene of spheres and boxes around a camera, sized so a few percent end up visible like
+// the headless --cubes scenes
+FILE_SCOPE bool LOGLBench_Cull(DqnMemStack *const memStack, const u32 numObjects)
+{
+#if defined(DQN_AVX)
+	const char *simd = "AVX";
+#elif defined(DQN_SSE2)
+	const char *simd = "SSE2";
+#else
+	const char *simd = "none";
+#endif
+
+	auto memRegion = memStack->TempRegionGuard();
+	LOGLCullSpheres spheres;
+	LOGLCullAABBs aabbs;
+	u32 *visible  = (u32 *)memStack->Push(sizeof(*visible) * numObjects);
+	u32 *expected = (u32 *)memStack->Push(sizeof(*expected) * numObjects);
+	if (!LOGLCull_AllocSpheres(memStack, &spheres, numObjects) || !LOGLCull_AllocAABBs(memStack, &aabbs, numObjects) ||
+	    !visible || !expected)
+		return false;
+
+	DqnRandPCGState rnd;
+	DqnRnd_PCGInitWithSeed(&rnd, 0xC011);
+	const f32 extent = 300.0f;
+	for (u32 i = 0; i < numObjects; i++)
+	{
+		spheres.x[i]      = aabbs.centerX[i] = (DqnRnd_PCGNextf(&rnd) - 0.5f) * extent;
+		spheres.y[i]      = aabbs.centerY[i] = (DqnRnd_PCGNextf(&rnd) - 0.5f) * extent;
+		spheres.z[i]      = aabbs.centerZ[i] = (DqnRnd_PCGNextf(&rnd) - 0.5f) * extent;
+		spheres.radius[i] = 0.5f + DqnRnd_PCGNextf(&rnd) * 2.0f;
+		aabbs.extentX[i]  = 0.5f + DqnRnd_PCGNextf(&rnd);
+		aabbs.extentY[i]  = 0.5f + DqnRnd_PCGNextf(&rnd);
+		aabbs.extentZ[i]  = 0.5f + DqnRnd_PCGNextf(&rnd);
+	}
+
+	LOGLFrustum frustum;
+	LOGLCull_ExtractFrustum(DqnMat4_Mul(DqnMat4_Perspective(45.0f, 4.0f / 3.0f, 0.1f, 100.0f),
+	                                    DqnMat4_LookAt(DqnV3_3f(0, 0, 3), DqnV3_3f(0, 0, 0), DqnV3_3f(0, 1, 0))),
+	                        &frustum);
+
+	u32 numExpected = 0, numVisible = 0;
+	f64 scalarNs, simdNs;
+	LOGL_BENCH_TIME(scalarNs, numObjects, numExpected = LOGLBench_CullSpheresScalar(&frustum, &spheres, expected));
+	LOGL_BENCH_TIME(simdNs, numObjects, numVisible = LOGLCull_Spheres(&frustum, &spheres, 0, numObjects, visible));
+	u32 sphereMismatches = LOGLBench_CountMismatches(visible, numVisible, expected, numExpected);
+
+	printf("Bench: %u objects frustum culled, SIMD %s\n", numObjects, simd);
+	printf("  %-30s %6.2f ns/sphere\n", "scalar reference", scalarNs);
+	printf("  %-30s %6.2f ns/sphere - %u visible, %u mismatches\n", "LOGLCull_Spheres", simdNs, numVisible,
+	       sphereMismatches);
+
+	LOGL_BENCH_TIME(scalarNs, numObjects, numExpected = LOGLBench_CullAABBsScalar(&frustum, &aabbs, expected));
+	LOGL_BENCH_TIME(simdNs, numObjects, numVisible = LOGLCull_AABBs(&frustum, &aabbs, 0, numObjects, visible));
+	u32 aabbMismatches = LOGLBench_CountMismatches(visible, numVisible, expected, numExpected);
+
+	printf("  %-30s %6.2f ns/box\n", "scalar reference", scalarNs);
+	printf("  %-30s %6.2f ns/box - %u visible, %u mismatches\n", "LOGLCull_AABBs", simdNs, numVisible,
+	       aabbMismatches);
+	return true;
+}
+
+struct LOGLBenchJobSlot
+{
+	u32 numRuns; // Times the job ran, every job must run exactly once per pass
+	u32 hash;
+};
+
+struct LOGLBenchJobParent
+{
+	LOGLBenchJobSlot *children;
+	u32               numChildren;
+};
+
+// A few dozen ns of work so the queue's overhead is visible in the timings without dominating them
+FILE_SCOPE void LOGLBench_Job(DqnJobQueue *const queue, void *const userData)
+{
+	LOGLBenchJobSlot *slot = (LOGLBenchJobSlot *)userData;
+	u32 hash               = (u32)(size_t)slot;
+	for (u32 i = 0; i < 32; i++)
+		hash = (hash * 1664525) + 1013904223;
+
+	slot->hash = hash;
+	slot->numRuns++;
+}
+
+FILE_SCOPE void LOGLBench_ParentJob(DqnJobQueue *const queue, void *const userData)
+{
+	LOGLBenchJobParent *parent = (LOGLBenchJobParent *)userData;
+	for (u32 i = 0; i < parent->numChildren; i++)
+	{
+		DqnJob job = {LOGLBench_Job, &parent->children[i]};
+		if (!DqnJobQueue_AddChildJob(queue, job)) LOGLBench_Job(queue, job.userData);
+	}
+}
+
+// Add a job for each of the numItems of userData and wait for them and any children they add
+FILE_SCOPE void LOGLBench_RunJobs(DqnJobQueue *const queue, DqnJob_Callback *const callback, void *const userData,
+                                  const size_t userDataSize, const u32 numItems)
+{
+	DqnJobCounter counter = {};
+	for (u32 i = 0; i < numItems; i++)
+	{
+		DqnJob job = {callback, (u8 *)userData + (i * userDataSize), &counter};
+		if (!DqnJobQueue_AddJob(queue, job)) callback(queue, job.userData);
+	}
+
+	DqnJobQueue_WaitForCounter(queue, &counter);
+}
+
+// return: The number of slots that didn't run exactly numRuns times
+FILE_SCOPE u32 LOGLBench_CountBadJobSlots(LOGLBenchJobSlot *const slots, const u32 numSlots, const u32 numRuns)
+{
+	u32 result = 0;
+	for (u32 i = 0; i < numSlots; i++)
+	{
+		result += (slots[i].numRuns != numRuns) ? 1 : 0;
+		slots[i].numRuns = 0;
+	}
+
+	return result;
+}
+
+// Contention of the job queue with everything added from the main thread, where every worker steals
+// from the one deque, and with parents spread over the workers that each add their own children.
+FILE_SCOPE bool LOGLBench_JobQueue(DqnMemStack *const memStack, const u32 numJobs)
+{
+	const u32 NUM_PARENTS = 64;
+	auto memRegion              = memStack->TempRegionGuard();
+	LOGLBenchJobSlot *slots     = (LOGLBenchJobSlot *)memStack->Push(sizeof(*slots) * numJobs);
+	LOGLBenchJobParent *parents = (LOGLBenchJobParent *)memStack->Push(sizeof(*parents) * NUM_PARENTS);
+	if (!slots || !parents) return false;
+
+	u32 numChildrenPerParent = numJobs / NUM_PARENTS;
+	for (u32 i = 0; i < NUM_PARENTS; i++)
+	{
+		parents[i].children    = slots + (i * numChildrenPerParent);
+		parents[i].numChildren = numChildrenPerParent;
+	}
+
+	u32 numCores, numThreadsPerCore;
+	DqnPlatform_GetNumThreadsAndCores(&numCores, &numThreadsPerCore);
+	printf("Bench: DqnJobQueue %u jobs, %u logical cores, threads are the workers plus the main thread\n", numJobs,
+	       numCores * numThreadsPerCore);
+	printf("  %-8s %14s %14s %10s\n", "threads", "flat ns/job", "fan out ns/job", "bad jobs");
+
+	const u32 NUM_RUNS = 5; // Passes of LOGL_BENCH_TIME()
+	for (u32 numThreads = 1; numThreads <= 64; numThreads *= 2)
+	{
+		DqnJobQueue queue = {};
+		if (!DqnJobQueue_Init(&queue, numThreads)) return false;
+
+		memset(slots, 0, sizeof(*slots) * numJobs);
+		f64 flatNs;
+		LOGL_BENCH_TIME(flatNs, numJobs, LOGLBench_RunJobs(&queue, LOGLBench_Job, slots, sizeof(*slots), numJobs));
+		u32 numBadJobs = LOGLBench_CountBadJobSlots(slots, numJobs, NUM_RUNS);
+
+		f64 fanOutNs;
+		LOGL_BENCH_TIME(fanOutNs, numChildrenPerParent * NUM_PARENTS,
+		                LOGLBench_RunJobs(&queue, LOGLBench_ParentJob, parents, sizeof(*parents), NUM_PARENTS));
+		numBadJobs += LOGLBench_CountBadJobSlots(slots, numChildrenPerParent * NUM_PARENTS, NUM_RUNS);
+
+		DqnJobQueue_Free(&queue);
+		printf("  %-8u %14.2f %14.2f %10u\n", numThreads + 1, flatNs, fanOutNs, numBadJobs);
+	}
+
+	return true;
+}
+
+// Executing the packets in entry order, count the times the program, VAO and material change
+FILE_SCOPE u32 LOGLBench_CountStateChanges(const LOGLRenderQueue *const queue)
+{
+	u32 result                         = 0;
+	const LOGLRenderPacket *lastPacket = NULL;
+	for (u32 i = 0; i < queue->numPackets; i++)
+	{
+		const LOGLRenderPacket *packet = &queue->packets[queue->entries[i].index];
+		if (!lastPacket || packet->program  != lastPacket->program)  result++;
+		if (!lastPacket || packet->vao      != lastPacket->vao)      result++;
+		if (!lastPacket || packet->material != lastPacket->material) result++;
+		lastPacket = packet;
+	}
+
+	return result;
+}
+
+// return: The number of entries out of key order, or out of submission order within a key
+FILE_SCOPE u32 LOGLBench_CountUnsorted(const DqnSortKeyU64 *const entries, const u32 numEntries)
+{
+	u32 result = 0;
+	for (u32 i = 1; i < numEntries; i++)
+	{
+		const DqnSortKeyU64 *a = &entries[i - 1];
+		const DqnSortKeyU64 *b = &entries[i];
+		if (a->key > b->key || (a->key == b->key && a->index > b->index)) result++;
+	}
+
+	return result;
+}
+
+FILE_SCOPE bool LOGLBench_RenderQueueEntryLessThan(const void *const val1, const void *const val2)
+{
+	const DqnSortKeyU64 *a = (const DqnSortKeyU64 *)val1;
+	const DqnSortKeyU64 *b = (const DqnSortKeyU64 *)val2;
+	return (a->key < b->key);
+}
+
+// Packets for a scene of many programs and materials submitted in a random order, sorted by the
+// radix sort and by Dqn_QuickSort() for reference. State changes are counted as the executor would
+// make them, before and after sorting.
+FILE_SCOPE bool LOGLBench_RenderQueue(DqnMemStack *const memStack)
+{
+	const u32 NUM_LAYERS    = 2;
+	const u32 NUM_PROGRAMS  = 8;
+	const u32 NUM_MATERIALS = 256;
+	printf("Bench: render queue sort, %u layers, %u programs, %u materials, random depth\n", NUM_LAYERS, NUM_PROGRAMS,
+	       NUM_MATERIALS);
+	printf("  %-9s %12s %16s %10s %18s %15s\n", "packets", "radix ns/pkt", "QuickSort ns/pkt", "bad order",
+	       "submitted changes", "sorted changes");
+
+	for (u32 numPackets = 10000; numPackets <= 1000000; numPackets *= 10)
+	{
+		auto memRegion          = memStack->TempRegionGuard();
+		LOGLMaterial *materials = (LOGLMaterial *)memStack->Push(sizeof(*materials) * NUM_MATERIALS);
+		DqnSortKeyU64 *copy     = (DqnSortKeyU64 *)memStack->Push(sizeof(*copy) * numPackets);
+		LOGLRenderQueue queue;
+		if (!materials || !copy || !LOGLRenderQueue_Init(&queue, memStack, numPackets)) return false;
+
+		DqnRandPCGState rnd;
+		DqnRnd_PCGInitWithSeed(&rnd, 0x50A7);
+		for (u32 i = 0; i < numPackets; i++)
+		{
+			u32 layer    = DqnRnd_PCGRange(&rnd, 0, NUM_LAYERS - 1);
+			u32 program  = DqnRnd_PCGRange(&rnd, 0, NUM_PROGRAMS - 1);
+			u32 material = DqnRnd_PCGRange(&rnd, 0, NUM_MATERIALS - 1);
+			f32 depth    = 0.1f + DqnRnd_PCGNextf(&rnd) * 100.0f;
+
+			LOGLRenderPacket *packet = LOGLRenderQueue_Submit(&queue, LOGLRenderQueue_MakeKey(layer, program, material, depth));
+			packet->program          = program;
+			packet->vao              = program + 1;
+			packet->numIndices       = 36;
+			packet->numInstances     = 1;
+			packet->material         = &materials[material];
+		}
+
+		u32 submittedChanges = LOGLBench_CountStateChanges(&queue);
+		memcpy(copy, queue.entries, sizeof(*copy) * numPackets);
+
+		// NOTE: Each pass sorts the submitted order again, time the copy on its own to take it out
+		f64 copyNs, radixNs, quickSortNs;
+		LOGL_BENCH_TIME(copyNs, numPackets, memcpy(queue.entries, copy, sizeof(*copy) * numPackets));
+		LOGL_BENCH_TIME(radixNs, numPackets, memcpy(queue.entries, copy, sizeof(*copy) * numPackets);
+		                LOGLRenderQueue_Sort(&queue));
+		u32 numUnsorted   = LOGLBench_CountUnsorted(queue.entries, numPackets);
+		u32 sortedChanges = LOGLBench_CountStateChanges(&queue);
+
+		LOGL_BENCH_TIME(quickSortNs, numPackets, memcpy(queue.scratch, copy, sizeof(*copy) * numPackets);
+		                Dqn_QuickSort(queue.scratch, numPackets, LOGLBench_RenderQueueEntryLessThan));
+
+		printf("  %-9u %12.2f %16.2f %10u %18u %15u\n", numPackets, radixNs - copyNs, quickSortNs - copyNs,
+		       numUnsorted, submittedChanges, sortedChanges);
+	}
+
+	return true;
+}
+
+FILE_SCOPE bool LOGLBench_SortKeyLessThan(const void *const val1, const void *const val2)
+{
+	return (((const DqnSortKeyU32 *)val1)->key < ((const DqnSortKeyU32 *)val2)->key);
+}
+
+FILE_SCOPE void LOGLBench_SortKeySwap(void *const val1, void *const val2)
+{
+	DQN_SWAP(DqnSortKeyU32, *(DqnSortKeyU32 *)val1, *(DqnSortKeyU32 *)val2);
+}
+
+FILE_SCOPE int LOGLBench_SortKeyCompare(const void *val1, const void *val2)
+{
+	u32 a = ((const DqnSortKeyU32 *)val1)->key;
+	u32 b = ((const DqnSortKeyU32 *)val2)->key;
+	return (a < b) ? -1 : (a > b) ? 1 : 0;
+}
+
+// return: The number of keys out of order, stable also counts indexes out of order within a key
+template <typename T>
+FILE_SCOPE u32 LOGLBench_CountUnsortedKeys(const T *const keys, const u32 numKeys, const bool stable)
+{
+	u32 result = 0;
+	for (u32 i = 1; i < numKeys; i++)
+	{
+		if (keys[i].key < keys[i - 1].key) result++;
+		else if (stable && keys[i].key == keys[i - 1].key && keys[i].index < keys[i - 1].index) result++;
+	}
+
+	return result;
+}
+
+// Key + index pairs sorted by Dqn_RadixSort(), Dqn_IntroSort(), the callback driven Dqn_QuickSortC()
+// and libc's qsort() over inputs that break naive quicksorts, the already sorted and reversed ones
+// and ones of few distinct keys.
+FILE_SCOPE bool LOGLBench_Sort(DqnMemStack *const memStack)
+{
+	enum LOGLBenchSortInput
+	{
+		LOGLBenchSortInput_Random,
+		LOGLBenchSortInput_Sorted,
+		LOGLBenchSortInput_Reversed,
+		LOGLBenchSortInput_Duplicates,
+		LOGLBenchSortInput_Count,
+	};
+	const char *const inputNames[LOGLBenchSortInput_Count] = {"random", "sorted", "reversed", "16 keys"};
+
+	const u32 NUM_KEYS = 1000000;
+	auto memRegion          = memStack->TempRegionGuard();
+	DqnSortKeyU32 *input    = (DqnSortKeyU32 *)memStack->Push(sizeof(*input) * NUM_KEYS);
+	DqnSortKeyU32 *keys     = (DqnSortKeyU32 *)memStack->Push(sizeof(*keys) * NUM_KEYS);
+	DqnSortKeyU32 *scratch  = (DqnSortKeyU32 *)memStack->Push(sizeof(*scratch) * NUM_KEYS);
+	if (!input || !keys || !scratch) return false;
+
+	printf("Bench: sort %u key + index pairs, ns/key\n", NUM_KEYS);
+	printf("  %-10s %8s %10s %11s %8s %10s\n", "input", "radix", "IntroSort", "QuickSortC", "qsort", "bad order");
+
+	auto KeyLessThan = [](const DqnSortKeyU32 &a, const DqnSortKeyU32 &b) { return a.key < b.key; };
+	DqnRandPCGState rnd;
+	DqnRnd_PCGInitWithSeed(&rnd, 0x5027);
+	for (u32 inputIndex = 0; inputIndex < LOGLBenchSortInput_Count; inputIndex++)
+	{
+		for (u32 i = 0; i < NUM_KEYS; i++)
+		{
+			input[i].index = i;
+			switch (inputIndex)
+			{
+				case LOGLBenchSortInput_Random:     input[i].key = DqnRnd_PCGNext(&rnd);          break;
+				case LOGLBenchSortInput_Sorted:     input[i].key = i;                             break;
+				case LOGLBenchSortInput_Reversed:   input[i].key = NUM_KEYS - i;                  break;
+				case LOGLBenchSortInput_Duplicates: input[i].key = DqnRnd_PCGRange(&rnd, 0, 15);  break;
+			}
+		}
+
+		// NOTE: Each pass sorts the input again, time the copy on its own to take it out
+		const size_t inputSize = sizeof(*input) * NUM_KEYS;
+		u32 numUnsorted        = 0;
+		f64 copyNs, radixNs, introSortNs, quickSortCNs, qsortNs;
+		LOGL_BENCH_TIME(copyNs, NUM_KEYS, memcpy(keys, input, inputSize));
+
+		LOGL_BENCH_TIME(radixNs, NUM_KEYS, memcpy(keys, input, inputSize); Dqn_RadixSort(keys, NUM_KEYS, scratch));
+		numUnsorted += LOGLBench_CountUnsortedKeys(keys, NUM_KEYS, true);
+
+		LOGL_BENCH_TIME(introSortNs, NUM_KEYS, memcpy(keys, input, inputSize); Dqn_IntroSort(keys, NUM_KEYS, KeyLessThan));
+		numUnsorted += LOGLBench_CountUnsortedKeys(keys, NUM_KEYS, false);
+
+		LOGL_BENCH_TIME(quickSortCNs, NUM_KEYS, memcpy(keys, input, inputSize);
+		                Dqn_QuickSortC(keys, sizeof(*keys), NUM_KEYS, LOGLBench_SortKeyLessThan, LOGLBench_SortKeySwap));
+		numUnsorted += LOGLBench_CountUnsortedKeys(keys, NUM_KEYS, false);
+
+		LOGL_BENCH_TIME(qsortNs, NUM_KEYS, memcpy(keys, input, inputSize);
+		                qsort(keys, NUM_KEYS, sizeof(*keys), LOGLBench_SortKeyCompare));
+		numUnsorted += LOGLBench_CountUnsortedKeys(keys, NUM_KEYS, false);
+
+		printf("  %-10s %8.2f %10.2f %11.2f %8.2f %10u\n", inputNames[inputIndex], radixNs - copyNs,
+		       introSortNs - copyNs, quickSortCNs - copyNs, qsortNs - copyNs, numUnsorted);
+	}
+
+	// NOTE: The wider and float keys only change the radix passes, check they order right
+	{
+		DqnSortKeyU64 *keys64  = (DqnSortKeyU64 *)memStack->Push(sizeof(*keys64) * NUM_KEYS * 2);
+		DqnSortKeyF32 *keysF32 = (DqnSortKeyF32 *)keys;
+		if (!keys64) return false;
+
+		for (u32 i = 0; i < NUM_KEYS; i++)
+		{
+			keys64[i].key    = ((u64)DqnRnd_PCGNext(&rnd) << 32) | DqnRnd_PCGNext(&rnd);
+			keys64[i].index  = i;
+			keysF32[i].key   = (DqnRnd_PCGNextf(&rnd) - 0.5f) * 2000.0f;
+			keysF32[i].index = i;
+		}
+
+		f64 start = DqnTimer_NowInMs();
+		Dqn_RadixSort(keys64, NUM_KEYS, keys64 + NUM_KEYS);
+		f64 u64Ns = ((DqnTimer_NowInMs() - start) * 1000000.0) / NUM_KEYS;
+
+		start = DqnTimer_NowInMs();
+		Dqn_RadixSort(keysF32, NUM_KEYS, (DqnSortKeyF32 *)scratch);
+		f64 f32Ns = ((DqnTimer_NowInMs() - start) * 1000000.0) / NUM_KEYS;
+
+		u32 numUnsorted = LOGLBench_CountUnsortedKeys(keys64, NUM_KEYS, true) +
+		                  LOGLBench_CountUnsortedKeys(keysF32, NUM_KEYS, true);
+		printf("  radix random u64 keys %.2f ns/key, f32 keys %.2f ns/key, %u bad order\n", u64Ns, f32Ns, numUnsorted);
+	}
+
+	return true;
+}
+
+// DqnJobQueue_ParallelSort() against Dqn_RadixSort() on the calling thread. A stable sort has one
+// answer, every thread count must give exactly the single threaded result.
+FILE_SCOPE bool LOGLBench_ParallelSort(DqnMemStack *const memStack)
+{
+	u32 numCores, numThreadsPerCore;
+	DqnPlatform_GetNumThreadsAndCores(&numCores, &numThreadsPerCore);
+	printf("Bench: DqnJobQueue_ParallelSort random key + index pairs, %u logical cores, threads are the workers plus "
+	       "the main thread\n",
+	       numCores * numThreadsPerCore);
+	printf("  %-10s %-8s %8s %8s %11s\n", "keys", "threads", "ns/key", "speedup", "mismatches");
+
+	for (u32 numKeys = 1000000; numKeys <= 100000000; numKeys *= 10)
+	{
+		auto memRegion          = memStack->TempRegionGuard();
+		DqnSortKeyU32 *input    = (DqnSortKeyU32 *)memStack->Push(sizeof(*input) * numKeys);
+		DqnSortKeyU32 *expected = (DqnSortKeyU32 *)memStack->Push(sizeof(*expected) * numKeys);
+		DqnSortKeyU32 *keys     = (DqnSortKeyU32 *)memStack->Push(sizeof(*keys) * numKeys);
+		if (!input || !expected || !keys)
+		{
+			printf("  %-10u skipped, out of memory\n", numKeys);
+			continue;
+		}
+
+		DqnRandPCGState rnd;
+		DqnRnd_PCGInitWithSeed(&rnd, 0x5027);
+		for (u32 i = 0; i < numKeys; i++)
+		{
+			input[i].key   = DqnRnd_PCGNext(&rnd);
+			input[i].index = i;
+		}
+
+		const size_t inputSize = sizeof(*input) * numKeys;
+		f64 copyNs, radixNs;
+		{
+			auto scratchRegion     = memStack->TempRegionGuard();
+			DqnSortKeyU32 *scratch = (DqnSortKeyU32 *)memStack->Push(inputSize);
+			if (!scratch)
+			{
+				printf("  %-10u skipped, out of memory\n", numKeys);
+				continue;
+			}
+
+			LOGL_BENCH_TIME(copyNs, numKeys, memcpy(expected, input, inputSize));
+			LOGL_BENCH_TIME(radixNs, numKeys, memcpy(expected, input, inputSize);
+			                Dqn_RadixSort(expected, numKeys, scratch));
+			radixNs -= copyNs;
+		}
+		printf("  %-10u %-8u %8.2f %8.2f %11s\n", numKeys, 1, radixNs, 1.0f, "radix");
+
+		for (u32 numThreads = 1; numThreads <= 8; numThreads *= 2)
+		{
+			DqnJobQueue queue = {};
+			if (!DqnJobQueue_Init(&queue, numThreads)) return false;
+
+			bool sorted = true;
+			f64 parallelNs;
+			LOGL_BENCH_TIME(parallelNs, numKeys, memcpy(keys, input, inputSize);
+			                sorted &= DqnJobQueue_ParallelSort(&queue, memStack, keys, numKeys));
+			DqnJobQueue_Free(&queue);
+			parallelNs -= copyNs;
+
+			if (!sorted)
+			{
+				printf("  %-10u %-8u skipped, out of memory\n", numKeys, numThreads + 1);
+				break;
+			}
+
+			u32 numMismatches = 0;
+			for (u32 i = 0; i < numKeys; i++)
+			{
+				if (keys[i].key != expected[i].key || keys[i].index != expected[i].index) numMismatches++;
+			}
+
+			printf("  %-10u %-8u %8.2f %8.2f %11u\n", numKeys, numThreads + 1, parallelNs, radixNs / parallelNs,
+			       numMismatches);
+		}
+	}
+
+	return true;
+}
+
+#define LOGL_BENCH_ALLOCS_PER_JOB 1024
+
+struct LOGLBenchAllocJob
+{
+	DqnMemStackShared *shared;
+	const u32         *sizes;    // LOGL_BENCH_ALLOCS_PER_JOB sizes, the same for every job
+	u8               **pointers; // LOGL_BENCH_ALLOCS_PER_JOB, for malloc's frees
+	u32                tag;
+	u32                numBad;   // Allocations that failed or were overwritten by another
+};
+
+enum LOGLBenchAllocator
+{
+	LOGLBenchAllocator_Malloc,     // Freed by the job
+	LOGLBenchAllocator_MallocKept, // Freed once every job is done, like the shared stack
+	LOGLBenchAllocator_Scratch,
+	LOGLBenchAllocator_Shared,
+	LOGLBenchAllocator_Count,
+};
+
+// Tag both ends of every allocation and check them once the job has made them all, allocations
+// handed out twice or overlapping another thread's are overwritten and counted as bad
+FILE_SCOPE void LOGLBench_AllocJob(DqnJobQueue *const queue, LOGLBenchAllocJob *const job,
+                                   const enum LOGLBenchAllocator allocator)
+{
+	DqnMemStack *scratch = DqnJobQueue_GetScratch(queue);
+	for (u32 i = 0; i < LOGL_BENCH_ALLOCS_PER_JOB; i++)
+	{
+		const u32 size = job->sizes[i];
+		u8 *ptr        = NULL;
+		switch (allocator)
+		{
+			case LOGLBenchAllocator_Malloc:
+			case LOGLBenchAllocator_MallocKept: ptr = (u8 *)malloc(size);                              break;
+			case LOGLBenchAllocator_Scratch:    ptr = (u8 *)scratch->Push(size);                       break;
+			case LOGLBenchAllocator_Shared:     ptr = (u8 *)DqnMemStackShared_Push(job->shared, size); break;
+			default: break;
+		}
+
+		job->pointers[i] = ptr;
+		if (!ptr) continue;
+
+		const u32 tag = job->tag + i;
+		memcpy(ptr, &tag, sizeof(tag));
+		memcpy(ptr + size - sizeof(tag), &tag, sizeof(tag));
+	}
+
+	for (u32 i = 0; i < LOGL_BENCH_ALLOCS_PER_JOB; i++)
+	{
+		const u8 *ptr = job->pointers[i];
+		if (!ptr)
+		{
+			job->numBad++;
+			continue;
+		}
+
+		const u32 size = job->sizes[i];
+		const u32 tag  = job->tag + i;
+		if (memcmp(ptr, &tag, sizeof(tag)) != 0 || memcmp(ptr + size - sizeof(tag), &tag, sizeof(tag)) != 0)
+			job->numBad++;
+	}
+
+	// NOTE: The scratch stack is released when the job returns, the rest after every job is done
+	if (allocator == LOGLBenchAllocator_Malloc)
+	{
+		for (u32 i = 0; i < LOGL_BENCH_ALLOCS_PER_JOB; i++)
+			free(job->pointers[i]);
+	}
+}
+
+FILE_SCOPE void LOGLBench_MallocJob(DqnJobQueue *const queue, void *const userData)
+{
+	LOGLBench_AllocJob(queue, (LOGLBenchAllocJob *)userData, LOGLBenchAllocator_Malloc);
+}
+
+FILE_SCOPE void LOGLBench_MallocKeptJob(DqnJobQueue *const queue, void *const userData)
+{
+	LOGLBench_AllocJob(queue, (LOGLBenchAllocJob *)userData, LOGLBenchAllocator_MallocKept);
+}
+
+// Free what every LOGLBench_MallocKeptJob() allocated and release the shared stack
+FILE_SCOPE void LOGLBench_FreeAllocs(DqnMemStackShared *const shared, u8 **const pointers, const u32 numPointers,
+                                     const enum LOGLBenchAllocator allocator)
+{
+	if (allocator == LOGLBenchAllocator_MallocKept)
+	{
+		for (u32 i = 0; i < numPointers; i++)
+			free(pointers[i]);
+	}
+
+	DqnMemStackShared_Clear(shared);
+}
+
+FILE_SCOPE void LOGLBench_ScratchJob(DqnJobQueue *const queue, void *const userData)
+{
+	LOGLBench_AllocJob(queue, (LOGLBenchAllocJob *)userData, LOGLBenchAllocator_Scratch);
+}
+
+FILE_SCOPE void LOGLBench_SharedJob(DqnJobQueue *const queue, void *const userData)
+{
+	LOGLBench_AllocJob(queue, (LOGLBenchAllocJob *)userData, LOGLBenchAllocator_Shared);
+}
+
+// Many small allocations made from jobs at once, with malloc(), each thread's DqnJobQueue scratch
+// stack and one DqnMemStackShared for every thread. Scratch and malloc freed by the job reuse the
+// same few cache hot KB, the shared stack and kept mallocs write fresh memory for every allocation
+// of a pass. The shared stack starts small so the first pass chains blocks while threads race for
+// them, "blocks" is how many it took.
+FILE_SCOPE bool LOGLBench_Alloc(DqnMemStack *const memStack)
+{
+	const u32 NUM_JOBS          = 256;
+	const u32 NUM_ALLOCS        = NUM_JOBS * LOGL_BENCH_ALLOCS_PER_JOB;
+	const u32 MIN_SIZE          = 16;
+	const u32 MAX_SIZE          = 256;
+	auto memRegion              = memStack->TempRegionGuard();
+	LOGLBenchAllocJob *jobs     = (LOGLBenchAllocJob *)memStack->Push(sizeof(*jobs) * NUM_JOBS);
+	u32 *sizes                  = (u32 *)memStack->Push(sizeof(*sizes) * LOGL_BENCH_ALLOCS_PER_JOB);
+	u8 **pointers               = (u8 **)memStack->Push(sizeof(*pointers) * NUM_ALLOCS);
+	if (!jobs || !sizes || !pointers) return false;
+
+	DqnRandPCGState rnd;
+	DqnRnd_PCGInitWithSeed(&rnd, 0xA110C);
+	for (u32 i = 0; i < LOGL_BENCH_ALLOCS_PER_JOB; i++)
+		sizes[i] = (u32)DqnRnd_PCGRange(&rnd, MIN_SIZE, MAX_SIZE);
+
+	u32 numCores, numThreadsPerCore;
+	DqnPlatform_GetNumThreadsAndCores(&numCores, &numThreadsPerCore);
+	printf("Bench: allocation stress, %u jobs of %u allocations of %u-%u bytes, %u logical cores, threads are the "
+	       "workers plus the main thread\n",
+	       NUM_JOBS, LOGL_BENCH_ALLOCS_PER_JOB, MIN_SIZE, MAX_SIZE, numCores * numThreadsPerCore);
+	printf("  %-8s %10s %10s %10s %10s %7s %11s\n", "threads", "malloc ns", "scratch ns", "kept ns", "shared ns",
+	       "blocks", "bad allocs");
+
+	DqnJob_Callback *callbacks[LOGLBenchAllocator_Count] = {};
+	callbacks[LOGLBenchAllocator_Malloc]                 = LOGLBench_MallocJob;
+	callbacks[LOGLBenchAllocator_MallocKept]             = LOGLBench_MallocKeptJob;
+	callbacks[LOGLBenchAllocator_Scratch]                = LOGLBench_ScratchJob;
+	callbacks[LOGLBenchAllocator_Shared]                 = LOGLBench_SharedJob;
+
+	for (u32 numThreads = 1; numThreads <= 8; numThreads *= 2)
+	{
+		DqnJobQueue queue = {};
+		if (!DqnJobQueue_Init(&queue, numThreads)) return false;
+
+		DqnMemStackShared shared = {};
+		if (!DqnMemStackShared_Init(&shared, DQN_KILOBYTE(256), false, 16))
+		{
+			DqnJobQueue_Free(&queue);
+			return false;
+		}
+
+		for (u32 i = 0; i < NUM_JOBS; i++)
+		{
+			jobs[i]          = {};
+			jobs[i].shared   = &shared;
+			jobs[i].sizes    = sizes;
+			jobs[i].pointers = pointers + (i * LOGL_BENCH_ALLOCS_PER_JOB);
+			jobs[i].tag      = i * LOGL_BENCH_ALLOCS_PER_JOB;
+		}
+
+		// NOTE: An untimed pass to see how many blocks the shared stack chains from its first size
+		LOGLBench_RunJobs(&queue, LOGLBench_SharedJob, jobs, sizeof(*jobs), NUM_JOBS);
+		i32 numBlocks = shared.numBlocks;
+		DqnMemStackShared_Clear(&shared);
+
+		f64 timeNs[LOGLBenchAllocator_Count];
+		for (u32 allocator = 0; allocator < LOGLBenchAllocator_Count; allocator++)
+		{
+			LOGL_BENCH_TIME(timeNs[allocator], NUM_ALLOCS,
+			                LOGLBench_RunJobs(&queue, callbacks[allocator], jobs, sizeof(*jobs), NUM_JOBS);
+			                LOGLBench_FreeAllocs(&shared, pointers, NUM_ALLOCS, (enum LOGLBenchAllocator)allocator));
+		}
+
+		u32 numBad = 0;
+		for (u32 i = 0; i < NUM_JOBS; i++)
+			numBad += jobs[i].numBad;
+
+		DqnMemStackShared_Free(&shared);
+		DqnJobQueue_Free(&queue);
+		printf("  %-8u %10.2f %10.2f %10.2f %10.2f %7d %11u\n", numThreads + 1, timeNs[LOGLBenchAllocator_Malloc],
+		       timeNs[LOGLBenchAllocator_Scratch], timeNs[LOGLBenchAllocator_MallocKept],
+		       timeNs[LOGLBenchAllocator_Shared], numBlocks, numBad);
+	}
+
+	return true;
+}
+
+// The box filter the pack cooker used before LOGLMip, odd edges reuse their last row or column
+FILE_SCOPE void LOGLBench_DownsampleNaive(const LOGLBitmap *const src, LOGLBitmap *const dest)
+{
+	const u32 bytesPerPixel = src->bytesPerPixel;
+	const size_t srcPitch   = (size_t)src->dim.w * bytesPerPixel;
+
+	u8 *destPixel = dest->memory;
+	for (i32 y = 0; y < dest->dim.h; y++)
+	{
+		const u8 *row0 = src->memory + ((size_t)(y * 2) * srcPitch);
+		const u8 *row1 = src->memory + ((size_t)DQN_MIN(y * 2 + 1, src->dim.h - 1) * srcPitch);
+		for (i32 x = 0; x < dest->dim.w; x++)
+		{
+			size_t col0 = (size_t)(x * 2) * bytesPerPixel;
+			size_t col1 = (size_t)DQN_MIN(x * 2 + 1, src->dim.w - 1) * bytesPerPixel;
+			for (u32 i = 0; i < bytesPerPixel; i++)
+			{
+				u32 sum      = row0[col0 + i] + row0[col1 + i] + row1[col0 + i] + row1[col1 + i];
+				*destPixel++ = (u8)((sum + 2) / 4);
+			}
+		}
+	}
+}
+
+// return: The number of bytes that differ in the levels down to the first odd sized one, where both
+//         filters should agree exactly. Odd levels are filtered differently by design.
+FILE_SCOPE u32 LOGLBench_CountMipMismatches(const LOGLBitmap *const a, const LOGLBitmap *const b, const u32 numLevels)
+{
+	u32 result = 0;
+	for (u32 levelIndex = 1; levelIndex < numLevels; levelIndex++)
+	{
+		const LOGLBitmap *src = &a[levelIndex - 1];
+		if ((src->dim.w & 1) || (src->dim.h & 1)) break;
+
+		size_t size = (size_t)a[levelIndex].dim.w * a[levelIndex].dim.h * a[levelIndex].bytesPerPixel;
+		for (size_t i = 0; i < size; i++)
+			result += (a[levelIndex].memory[i] != b[levelIndex].memory[i]) ? 1 : 0;
+	}
+
+	return result;
+}
+
+// Decode a sample texture into bitmap, or fill it with noise and rename it if the image can't be found.
+// return: FALSE if memStack ran out of memory or the image failed to decode.
+FILE_SCOPE bool LOGLBench_LoadSampleImage(DqnMemStack *const memStack, const char **const name,
+                                          LOGLBitmap *const bitmap)
+{
+	LOGLBitmapFile file = {};
+	if (LOGL_OpenBitmap(memStack, &file, *name))
+	{
+		bitmap->memory        = (u8 *)memStack->Push(file.decodeSize);
+		bitmap->dim           = file.dim;
+		bitmap->bytesPerPixel = file.bytesPerPixel;
+		return (bitmap->memory && LOGL_DecodeBitmap(memStack, &file, bitmap->memory));
+	}
+
+	// NOTE: Odd sized like container2.png, so both mip filters and partial BC blocks are exercised
+	*name                 = "noise (image not found)";
+	bitmap->dim           = DqnV2i_2i(500, 500);
+	bitmap->bytesPerPixel = 4;
+	bitmap->memory        = (u8 *)memStack->Push((size_t)bitmap->dim.w * bitmap->dim.h * 4);
+	if (!bitmap->memory) return false;
+
+	DqnRandPCGState rnd;
+	DqnRnd_PCGInitWithSeed(&rnd, 0x319);
+	for (i32 i = 0; i < bitmap->dim.w * bitmap->dim.h * 4; i++)
+		bitmap->memory[i] = (u8)DqnRnd_PCGNext(&rnd);
+	return true;
+}
+
+// Full mip chains of the sample textures, run from the data directory to use them. Falls back to
+// noise if they can't be found so the filters are still timed.
+FILE_SCOPE bool LOGLBench_Mips(DqnMemStack *const memStack)
+{
+#if defined(DQN_AVX)
+	const char *simd = "AVX";
+#elif defined(DQN_SSE2)
+	const char *simd = "SSE2";
+#else
+	const char *simd = "none";
+#endif
+
+	const char *const imagePaths[] = {"container.jpg", "container2.png", "container2_specular.png", "awesomeface.png"};
+
+	u32 numCores, numThreadsPerCore;
+	DqnPlatform_GetNumThreadsAndCores(&numCores, &numThreadsPerCore);
+	u32 numWorkers = DQN_MAX(1u, (numCores * numThreadsPerCore) - 1);
+
+	DqnJobQueue queue = {};
+	if (!DqnJobQueue_Init(&queue, numWorkers)) return false;
+
+	printf("Bench: mip chains, SIMD %s, ns per source pixel, threads are the workers plus the main thread\n", simd);
+	printf("  %-24s %-11s %8s %8s %8s %10s %10s\n", "image", "size", "naive", "linear", "sRGB", "linear x", "mismatches");
+
+	bool result = true;
+	for (u32 imageIndex = 0; imageIndex < DQN_ARRAY_COUNT(imagePaths) && result; imageIndex++)
+	{
+		auto memRegion   = memStack->TempRegionGuard();
+		const char *name = imagePaths[imageIndex];
+
+		LOGLBitmap naive[LOGL_MIP_MAX_LEVELS] = {};
+		LOGLBitmap mips[LOGL_MIP_MAX_LEVELS]  = {};
+		if (!LOGLBench_LoadSampleImage(memStack, &name, &naive[0]))
+		{
+			result = false;
+			break;
+		}
+
+		u32 numLevels = LOGLMip_NumLevels(naive[0].dim.w, naive[0].dim.h);
+		for (u32 levelIndex = 1; levelIndex < numLevels; levelIndex++)
+		{
+			LOGLBitmap *level    = &naive[levelIndex];
+			level->dim           = LOGLMip_NextLevelDim(naive[levelIndex - 1].dim);
+			level->bytesPerPixel = naive[0].bytesPerPixel;
+			level->memory        = (u8 *)memStack->Push((size_t)level->dim.w * level->dim.h * level->bytesPerPixel);
+			if (!level->memory) result = false;
+		}
+		if (!result) break;
+
+		const u32 numPixels = naive[0].dim.w * naive[0].dim.h;
+		mips[0]             = naive[0];
+
+		f64 naiveNs, linearNs, srgbNs, threadedNs;
+		LOGL_BENCH_TIME(naiveNs, numPixels,
+		                for (u32 j = 1; j < numLevels; j++) LOGLBench_DownsampleNaive(&naive[j - 1], &naive[j]));
+		LOGL_BENCH_TIME(linearNs, numPixels, {
+			auto region = memStack->TempRegionGuard();
+			LOGLMip_BuildChain(memStack, NULL, mips, numLevels, LOGLMipColorSpace_Linear);
+		});
+		LOGL_BENCH_TIME(srgbNs, numPixels, {
+			auto region = memStack->TempRegionGuard();
+			LOGLMip_BuildChain(memStack, NULL, mips, numLevels, LOGLMipColorSpace_SRGB);
+		});
+		LOGL_BENCH_TIME(threadedNs, numPixels, {
+			auto region = memStack->TempRegionGuard();
+			LOGLMip_BuildChain(memStack, &queue, mips, numLevels, LOGLMipColorSpace_Linear);
+		});
+
+		if (LOGLMip_BuildChain(memStack, &queue, mips, numLevels, LOGLMipColorSpace_Linear) != numLevels)
+		{
+			result = false;
+			break;
+		}
+		u32 mismatches = LOGLBench_CountMipMismatches(naive, mips, numLevels);
+
+		char size[16];
+		snprintf(size, sizeof(size), "%dx%dx%d", naive[0].dim.w, naive[0].dim.h, naive[0].bytesPerPixel);
+		printf("  %-24s %-11s %8.2f %8.2f %8.2f %6.2f x%-2u %10u\n", name, size, naiveNs, linearNs, srgbNs,
+		       threadedNs, numWorkers + 1, mismatches);
+	}
+
+	DqnJobQueue_Free(&queue);
+	return result;
+}
+
+// Block compression of the sample textures at each quality into the format LOGLBC_PickFormat()
+// chooses for them, run from the data directory to use them.
+FILE_SCOPE bool LOGLBench_BC(DqnMemStack *const memStack)
+{
+	const char *const imagePaths[]            = {"container.jpg", "container2.png", "container2_specular.png", "awesomeface.png"};
+	const char *formatStr[LOGLBCFormat_Count] = {"None", "BC1", "BC3", "BC4", "BC5"};
+
+	u32 numCores, numThreadsPerCore;
+	DqnPlatform_GetNumThreadsAndCores(&numCores, &numThreadsPerCore);
+	u32 numWorkers = DQN_MAX(1u, (numCores * numThreadsPerCore) - 1);
+
+	DqnJobQueue queue = {};
+	if (!DqnJobQueue_Init(&queue, numWorkers)) return false;
+
+	printf("Bench: block compression, ns per pixel and PSNR in dB, threads are the workers plus the main thread\n");
+	printf("  %-24s %-11s %-6s %8s %8s %8s %10s %8s %8s %8s\n", "image", "size", "format", "fast", "normal",
+	       "high", "normal x", "fast dB", "norm dB", "high dB");
+
+	bool result = true;
+	for (u32 imageIndex = 0; imageIndex < DQN_ARRAY_COUNT(imagePaths) && result; imageIndex++)
+	{
+		auto memRegion    = memStack->TempRegionGuard();
+		const char *name  = imagePaths[imageIndex];
+		LOGLBitmap bitmap = {};
+		if (!LOGLBench_LoadSampleImage(memStack, &name, &bitmap))
+		{
+			result = false;
+			break;
+		}
+
+		enum LOGLBCFormat format = LOGLBC_PickFormat(&bitmap);
+		LOGLBCImage image        = {};
+		image.size               = LOGLBC_EncodedSize(format, bitmap.dim.w, bitmap.dim.h);
+		image.dim                = bitmap.dim;
+		image.format             = format;
+		u8 *blocks               = (u8 *)memStack->Push(image.size);
+		if (!blocks)
+		{
+			result = false;
+			break;
+		}
+		image.blocks = blocks;
+
+		const u32 numPixels = bitmap.dim.w * bitmap.dim.h;
+		f64 timeNs[LOGLBCQuality_Count];
+		f32 psnr[LOGLBCQuality_Count];
+		for (i32 quality = LOGLBCQuality_Fast; quality < LOGLBCQuality_Count; quality++)
+		{
+			LOGL_BENCH_TIME(timeNs[quality], numPixels,
+			                LOGLBC_Encode(NULL, &bitmap, format, (enum LOGLBCQuality)quality, blocks));
+			psnr[quality] = LOGLBC_PSNR(memStack, &bitmap, &image);
+		}
+
+		f64 threadedNs;
+		LOGL_BENCH_TIME(threadedNs, numPixels, LOGLBC_Encode(&queue, &bitmap, format, LOGLBCQuality_Normal, blocks));
+
+		char size[16];
+		snprintf(size, sizeof(size), "%dx%dx%d", bitmap.dim.w, bitmap.dim.h, bitmap.bytesPerPixel);
+		printf("  %-24s %-11s %-6s %8.2f %8.2f %8.2f %6.2f x%-2u %8.2f %8.2f %8.2f\n", name, size, formatStr[format],
+		       timeNs[LOGLBCQuality_Fast], timeNs[LOGLBCQuality_Normal], timeNs[LOGLBCQuality_High], threadedNs,
+		       numWorkers + 1, psnr[LOGLBCQuality_Fast], psnr[LOGLBCQuality_Normal], psnr[LOGLBCQuality_High]);
+	}
+
+	DqnJobQueue_Free(&queue);
+	return result;
+}
+
+bool LOGLBench_Run(DqnMemStack *const memStack, const u32 numItems)
+{
+	if (!memStack) return false;
+
+	const u32 numMatrices = (numItems > 0) ? numItems : 65536;
+	auto memRegion        = memStack->TempRegionGuard();
+	DqnMat4 *matrices     = (DqnMat4 *)memStack->Push(sizeof(*matrices) * numMatrices);
+	DqnMat4 *results      = (DqnMat4 *)memStack->Push(sizeof(*results) * numMatrices);
+	DqnMat4 *expected     = (DqnMat4 *)memStack->Push(sizeof(*expected) * numMatrices);
+	if (!matrices || !results || !expected) return false;
+
+	LOGLBench_Mat4(matrices, results, numMatrices);
+	LOGLBench_Mat4Mul(matrices, results, expected, numMatrices);
+	return LOGLBench_Cull(memStack, numMatrices) && LOGLBench_JobQueue(memStack, numMatrices) &&
+	       LOGLBench_Alloc(memStack) && LOGLBench_Sort(memStack) && LOGLBench_ParallelSort(memStack) &&
+	       LOGLBench_RenderQueue(memStack) && LOGLBench_Mips(memStack) && LOGLBench_BC(memStack);
+}
@@ -0,0 +1,12 @@
+#ifndef LOGL_BENCH_H
+#define LOGL_BENCH_H
+
+#include "dqn.h"
+
+// CPU micro-benchmarks of the math and data paths used by LOGL_Update(), results go to stdout.
+// Timings are only meaningful in an optimised build, see DebugMode in build.sh.
+// numItems: Size of the working set each benchmark loops over, 0 for the default.
+// return: FALSE if the working set could not be allocated from memStack.
+bool LOGLBench_Run(DqnMemStack *const memStack, const u32 numItems);
+
+#endif
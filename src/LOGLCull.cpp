@@ -0,0 +1,293 @@
+#include "LOGLCull.h"
+
+#include <math.h>
+
+void LOGLCull_ExtractFrustum(const DqnMat4 viewProjection, LOGLFrustum *const frustum)
+{
+	// NOTE: Each plane is the 4th row of the clip matrix plus or minus one of the other rows, i.e.
+	// -w <= x <= w in clip space becomes (row3 + row0).p >= 0 and (row3 - row0).p >= 0
+	DqnV4 row[4];
+	for (u32 i = 0; i < 4; i++)
+		row[i] = DqnV4_4f(viewProjection.e[0][i], viewProjection.e[1][i], viewProjection.e[2][i], viewProjection.e[3][i]);
+
+	for (u32 i = 0; i < 3; i++)
+	{
+		frustum->planes[(i * 2) + 0] = row[3] + row[i];
+		frustum->planes[(i * 2) + 1] = row[3] - row[i];
+	}
+
+	// Normalise so a dot product with a point is its signed distance to the plane
+	for (u32 i = 0; i < DQN_ARRAY_COUNT(frustum->planes); i++)
+	{
+		DqnV4 *plane = &frustum->planes[i];
+		f32 length   = sqrtf((plane->x * plane->x) + (plane->y * plane->y) + (plane->z * plane->z));
+		*plane       = *plane * (1.0f / length);
+	}
+}
+
+bool LOGLCull_AllocSpheres(DqnMemStack *const memStack, LOGLCullSpheres *const spheres, const u32 count)
+{
+	if (!memStack || !spheres) return false;
+
+	*spheres        = {};
+	spheres->x      = (f32 *)memStack->Push(sizeof(f32) * count);
+	spheres->y      = (f32 *)memStack->Push(sizeof(f32) * count);
+	spheres->z      = (f32 *)memStack->Push(sizeof(f32) * count);
+	spheres->radius = (f32 *)memStack->Push(sizeof(f32) * count);
+	if (!spheres->x || !spheres->y || !spheres->z || !spheres->radius) return false;
+
+	spheres->count = count;
+	return true;
+}
+
+bool LOGLCull_AllocAABBs(DqnMemStack *const memStack, LOGLCullAABBs *const aabbs, const u32 count)
+{
+	if (!memStack || !aabbs) return false;
+
+	*aabbs         = {};
+	aabbs->centerX = (f32 *)memStack->Push(sizeof(f32) * count);
+	aabbs->centerY = (f32 *)memStack->Push(sizeof(f32) * count);
+	aabbs->centerZ = (f32 *)memStack->Push(sizeof(f32) * count);
+	aabbs->extentX = (f32 *)memStack->Push(sizeof(f32) * count);
+	aabbs->extentY = (f32 *)memStack->Push(sizeof(f32) * count);
+	aabbs->extentZ = (f32 *)memStack->Push(sizeof(f32) * count);
+	if (!aabbs->centerX || !aabbs->centerY || !aabbs->centerZ || !aabbs->extentX || !aabbs->extentY ||
+	    !aabbs->extentZ)
+		return false;
+
+	aabbs->count = count;
+	return true;
+}
+
+// Append index + lane for each set bit of mask without branching. Every lane is stored but the
+// count only advances over visible ones, so the stores never run past the lanes tested so far.
+FILE_SCOPE inline u32 LOGLCullInternal_AppendVisible(u32 *const visibleIndices, u32 numVisible, const u32 index,
+                                                      const u32 mask, const u32 numLanes)
+{
+	for (u32 lane = 0; lane < numLanes; lane++)
+	{
+		visibleIndices[numVisible] = index + lane;
+		numVisible += (mask >> lane) & 1;
+	}
+
+	return numVisible;
+}
+
+u32 LOGLCull_Spheres(const LOGLFrustum *const frustum, const LOGLCullSpheres *const spheres, const u32 start,
+                     const u32 count, u32 *const visibleIndices)
+{
+	if (!frustum || !spheres || !visibleIndices) return 0;
+	DQN_ASSERT(start + count <= spheres->count);
+
+	const DqnV4 *planes = frustum->planes;
+	const u32 end       = start + count;
+	u32 numVisible      = 0;
+	u32 i               = start;
+
+#if defined(DQN_AVX)
+	{
+		__m256 planeX[6], planeY[6], planeZ[6], planeW[6];
+		for (u32 j = 0; j < 6; j++)
+		{
+			planeX[j] = _mm256_set1_ps(planes[j].x);
+			planeY[j] = _mm256_set1_ps(planes[j].y);
+			planeZ[j] = _mm256_set1_ps(planes[j].z);
+			planeW[j] = _mm256_set1_ps(planes[j].w);
+		}
+
+		for (; i + 8 <= end; i += 8)
+		{
+			__m256 x         = _mm256_loadu_ps(spheres->x + i);
+			__m256 y         = _mm256_loadu_ps(spheres->y + i);
+			__m256 z         = _mm256_loadu_ps(spheres->z + i);
+			__m256 negRadius = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(spheres->radius + i));
+
+			__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+			for (u32 j = 0; j < 6; j++)
+			{
+				__m256 dist = _mm256_add_ps(_mm256_mul_ps(planeX[j], x), planeW[j]);
+				dist        = _mm256_add_ps(dist, _mm256_mul_ps(planeY[j], y));
+				dist        = _mm256_add_ps(dist, _mm256_mul_ps(planeZ[j], z));
+				inside      = _mm256_and_ps(inside, _mm256_cmp_ps(dist, negRadius, _CMP_GE_OQ));
+			}
+
+			u32 mask   = (u32)_mm256_movemask_ps(inside);
+			numVisible = LOGLCullInternal_AppendVisible(visibleIndices, numVisible, i, mask, 8);
+		}
+	}
+#endif
+
+#if defined(DQN_SSE2)
+	{
+		__m128 planeX[6], planeY[6], planeZ[6], planeW[6];
+		for (u32 j = 0; j < 6; j++)
+		{
+			planeX[j] = _mm_set1_ps(planes[j].x);
+			planeY[j] = _mm_set1_ps(planes[j].y);
+			planeZ[j] = _mm_set1_ps(planes[j].z);
+			planeW[j] = _mm_set1_ps(planes[j].w);
+		}
+
+		for (; i + 4 <= end; i += 4)
+		{
+			__m128 x         = _mm_loadu_ps(spheres->x + i);
+			__m128 y         = _mm_loadu_ps(spheres->y + i);
+			__m128 z         = _mm_loadu_ps(spheres->z + i);
+			__m128 negRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(spheres->radius + i));
+
+			__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+			for (u32 j = 0; j < 6; j++)
+			{
+				__m128 dist = _mm_add_ps(_mm_mul_ps(planeX[j], x), planeW[j]);
+				dist        = _mm_add_ps(dist, _mm_mul_ps(planeY[j], y));
+				dist        = _mm_add_ps(dist, _mm_mul_ps(planeZ[j], z));
+				inside      = _mm_and_ps(inside, _mm_cmpge_ps(dist, negRadius));
+			}
+
+			u32 mask   = (u32)_mm_movemask_ps(inside);
+			numVisible = LOGLCullInternal_AppendVisible(visibleIndices, numVisible, i, mask, 4);
+		}
+	}
+#endif
+
+	// NOTE: The remainder that doesn't fill a SIMD register, or everything with DQN_NO_SIMD
+	for (; i < end; i++)
+	{
+		u32 inside = 1;
+		for (u32 j = 0; j < 6; j++)
+		{
+			f32 dist = (planes[j].x * spheres->x[i]) + planes[j].w;
+			dist    += (planes[j].y * spheres->y[i]);
+			dist    += (planes[j].z * spheres->z[i]);
+			inside  &= (dist >= -spheres->radius[i]) ? 1 : 0;
+		}
+
+		numVisible = LOGLCullInternal_AppendVisible(visibleIndices, numVisible, i, inside, 1);
+	}
+
+	return numVisible;
+}
+
+// A box is outside a plane if its corner furthest along the plane's normal is. The furthest corner's
+// distance is the centre's plus the extent projected onto the absolute value of the normal.
+u32 LOGLCull_AABBs(const LOGLFrustum *const frustum, const LOGLCullAABBs *const aabbs, const u32 start,
+                   const u32 count, u32 *const visibleIndices)
+{
+	if (!frustum || !aabbs || !visibleIndices) return 0;
+	DQN_ASSERT(start + count <= aabbs->count);
+
+	const DqnV4 *planes = frustum->planes;
+	const u32 end       = start + count;
+	u32 numVisible      = 0;
+	u32 i               = start;
+
+#if defined(DQN_AVX)
+	{
+		__m256 planeX[6], planeY[6], planeZ[6], planeW[6];
+		__m256 absPlaneX[6], absPlaneY[6], absPlaneZ[6];
+		for (u32 j = 0; j < 6; j++)
+		{
+			planeX[j]    = _mm256_set1_ps(planes[j].x);
+			planeY[j]    = _mm256_set1_ps(planes[j].y);
+			planeZ[j]    = _mm256_set1_ps(planes[j].z);
+			planeW[j]    = _mm256_set1_ps(planes[j].w);
+			absPlaneX[j] = _mm256_set1_ps(fabsf(planes[j].x));
+			absPlaneY[j] = _mm256_set1_ps(fabsf(planes[j].y));
+			absPlaneZ[j] = _mm256_set1_ps(fabsf(planes[j].z));
+		}
+
+		for (; i + 8 <= end; i += 8)
+		{
+			__m256 centerX = _mm256_loadu_ps(aabbs->centerX + i);
+			__m256 centerY = _mm256_loadu_ps(aabbs->centerY + i);
+			__m256 centerZ = _mm256_loadu_ps(aabbs->centerZ + i);
+			__m256 extentX = _mm256_loadu_ps(aabbs->extentX + i);
+			__m256 extentY = _mm256_loadu_ps(aabbs->extentY + i);
+			__m256 extentZ = _mm256_loadu_ps(aabbs->extentZ + i);
+
+			__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+			for (u32 j = 0; j < 6; j++)
+			{
+				__m256 dist = _mm256_add_ps(_mm256_mul_ps(planeX[j], centerX), planeW[j]);
+				dist        = _mm256_add_ps(dist, _mm256_mul_ps(planeY[j], centerY));
+				dist        = _mm256_add_ps(dist, _mm256_mul_ps(planeZ[j], centerZ));
+
+				__m256 radius = _mm256_mul_ps(absPlaneX[j], extentX);
+				radius        = _mm256_add_ps(radius, _mm256_mul_ps(absPlaneY[j], extentY));
+				radius        = _mm256_add_ps(radius, _mm256_mul_ps(absPlaneZ[j], extentZ));
+
+				dist   = _mm256_add_ps(dist, radius);
+				inside = _mm256_and_ps(inside, _mm256_cmp_ps(dist, _mm256_setzero_ps(), _CMP_GE_OQ));
+			}
+
+			u32 mask   = (u32)_mm256_movemask_ps(inside);
+			numVisible = LOGLCullInternal_AppendVisible(visibleIndices, numVisible, i, mask, 8);
+		}
+	}
+#endif
+
+#if defined(DQN_SSE2)
+	{
+		__m128 planeX[6], planeY[6], planeZ[6], planeW[6];
+		__m128 absPlaneX[6], absPlaneY[6], absPlaneZ[6];
+		for (u32 j = 0; j < 6; j++)
+		{
+			planeX[j]    = _mm_set1_ps(planes[j].x);
+			planeY[j]    = _mm_set1_ps(planes[j].y);
+			planeZ[j]    = _mm_set1_ps(planes[j].z);
+			planeW[j]    = _mm_set1_ps(planes[j].w);
+			absPlaneX[j] = _mm_set1_ps(fabsf(planes[j].x));
+			absPlaneY[j] = _mm_set1_ps(fabsf(planes[j].y));
+			absPlaneZ[j] = _mm_set1_ps(fabsf(planes[j].z));
+		}
+
+		for (; i + 4 <= end; i += 4)
+		{
+			__m128 centerX = _mm_loadu_ps(aabbs->centerX + i);
+			__m128 centerY = _mm_loadu_ps(aabbs->centerY + i);
+			__m128 centerZ = _mm_loadu_ps(aabbs->centerZ + i);
+			__m128 extentX = _mm_loadu_ps(aabbs->extentX + i);
+			__m128 extentY = _mm_loadu_ps(aabbs->extentY + i);
+			__m128 extentZ = _mm_loadu_ps(aabbs->extentZ + i);
+
+			__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+			for (u32 j = 0; j < 6; j++)
+			{
+				__m128 dist = _mm_add_ps(_mm_mul_ps(planeX[j], centerX), planeW[j]);
+				dist        = _mm_add_ps(dist, _mm_mul_ps(planeY[j], centerY));
+				dist        = _mm_add_ps(dist, _mm_mul_ps(planeZ[j], centerZ));
+
+				__m128 radius = _mm_mul_ps(absPlaneX[j], extentX);
+				radius        = _mm_add_ps(radius, _mm_mul_ps(absPlaneY[j], extentY));
+				radius        = _mm_add_ps(radius, _mm_mul_ps(absPlaneZ[j], extentZ));
+
+				dist   = _mm_add_ps(dist, radius);
+				inside = _mm_and_ps(inside, _mm_cmpge_ps(dist, _mm_setzero_ps()));
+			}
+
+			u32 mask   = (u32)_mm_movemask_ps(inside);
+			numVisible = LOGLCullInternal_AppendVisible(visibleIndices, numVisible, i, mask, 4);
+		}
+	}
+#endif
+
+	for (; i < end; i++)
+	{
+		u32 inside = 1;
+		for (u32 j = 0; j < 6; j++)
+		{
+			f32 dist = (planes[j].x * aabbs->centerX[i]) + planes[j].w;
+			dist    += (planes[j].y * aabbs->centerY[i]);
+			dist    += (planes[j].z * aabbs->centerZ[i]);
+
+			f32 radius = fabsf(planes[j].x) * aabbs->extentX[i];
+			radius    += fabsf(planes[j].y) * aabbs->extentY[i];
+			radius    += fabsf(planes[j].z) * aabbs->extentZ[i];
+			inside    &= (dist + radius >= 0) ? 1 : 0;
+		}
+
+		numVisible = LOGLCullInternal_AppendVisible(visibleIndices, numVisible, i, inside, 1);
+	}
+
+	return numVisible;
+}
@@ -0,0 +1,54 @@
+#ifndef LOGL_CULL_H
+#define LOGL_CULL_H
+
+#include "dqn.h"
+
+// View frustum culling. Bounding volumes are stored as a structure of arrays so the SIMD paths can
+// test 4 (SSE2) or 8 (AVX) volumes against a plane at once, see DQN_SSE2 and DQN_AVX in dqn.h.
+
+// Normalised planes facing into the frustum, xyz is the normal and w the distance from the origin
+struct LOGLFrustum
+{
+	DqnV4 planes[6];
+};
+
+// Each array holds count elements
+struct LOGLCullSpheres
+{
+	f32 *x;
+	f32 *y;
+	f32 *z;
+	f32 *radius;
+	u32  count;
+};
+
+// Axis aligned boxes as a centre and a half extent on each axis, each array holds count elements
+struct LOGLCullAABBs
+{
+	f32 *centerX;
+	f32 *centerY;
+	f32 *centerZ;
+	f32 *extentX;
+	f32 *extentY;
+	f32 *extentZ;
+	u32  count;
+};
+
+// Gribb-Hartmann plane extraction, works with any projection * view matrix.
+void LOGLCull_ExtractFrustum(const DqnMat4 viewProjection, LOGLFrustum *const frustum);
+
+// Allocate the arrays for count volumes from memStack, their contents are left uninitialised.
+// return: FALSE if memStack ran out of memory.
+bool LOGLCull_AllocSpheres(DqnMemStack *const memStack, LOGLCullSpheres *const spheres, const u32 count);
+bool LOGLCull_AllocAABBs  (DqnMemStack *const memStack, LOGLCullAABBs   *const aabbs,   const u32 count);
+
+// Test the volumes in [start, start + count) and write the indices of the ones inside or touching
+// the frustum to visibleIndices in ascending order. Volumes straddling a plane count as visible.
+// visibleIndices: Must have room for count indices.
+// return: The number of indices written.
+u32 LOGLCull_Spheres(const LOGLFrustum *const frustum, const LOGLCullSpheres *const spheres, const u32 start,
+                     const u32 count, u32 *const visibleIndices);
+u32 LOGLCull_AABBs  (const LOGLFrustum *const frustum, const LOGLCullAABBs *const aabbs, const u32 start,
+                     const u32 count, u32 *const visibleIndices);
+
+#endif
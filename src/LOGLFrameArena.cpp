@@ -0,0 +1,106 @@
+#include "LOGLFrameArena.h"
+#include "OpenGL.h"
+
+#define DQN_PLATFORM_HEADER // For DqnTimer
+#include "dqn.h"
+
+bool LOGLFrameArena_Init(LOGLFrameArena *const arena, const size_t sizePerFrame)
+{
+	*arena = {};
+	for (u32 i = 0; i < LOGL_FRAME_ARENA_COUNT; i++)
+	{
+		if (!DqnMemStack_InitWithFixedSize(&arena->stacks[i], sizePerFrame, false, 16))
+		{
+			LOGLFrameArena_Free(arena);
+			return false;
+		}
+	}
+
+	arena->stats.size = sizePerFrame;
+	return true;
+}
+
+void LOGLFrameArena_Free(LOGLFrameArena *const arena)
+{
+	for (u32 i = 0; i < LOGL_FRAME_ARENA_COUNT; i++)
+		DqnMemStack_Free(&arena->stacks[i]);
+
+	// NOTE: Fences and the vbo belong to the GL context, they go with it
+	*arena = {};
+}
+
+void LOGLFrameArena_InitGL(LOGLFrameArena *const arena, const size_t vboSizePerFrame)
+{
+	arena->stats.vboSize = DQN_ALIGN_POW_N(vboSizePerFrame, LOGL_FRAME_ARENA_VBO_ALIGNMENT);
+
+	glGenBuffers(1, &arena->vbo);
+	glBindBuffer(GL_ARRAY_BUFFER, arena->vbo);
+	glBufferData(GL_ARRAY_BUFFER, arena->stats.vboSize * LOGL_FRAME_ARENA_COUNT, NULL, GL_STREAM_DRAW);
+}
+
+void *LOGLFrameArena_MapVertices(LOGLFrameArena *const arena, const size_t size, size_t *const offset)
+{
+	if (!DQN_ASSERT(arena->inFrame && arena->vbo)) return NULL;
+
+	size_t alignedSize = DQN_ALIGN_POW_N(size, LOGL_FRAME_ARENA_VBO_ALIGNMENT);
+	if (size == 0 || alignedSize > arena->stats.vboSize - arena->vboUsed) return NULL;
+
+	// NOTE: Unsynchronized, the fence waited on in BeginFrame() is what makes writing the region safe
+	*offset      = (arena->stats.vboSize * arena->current) + arena->vboUsed;
+	void *result = glMapBufferRange(GL_ARRAY_BUFFER, (GLintptr)*offset, (GLsizeiptr)size,
+	                                GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+	if (result) arena->vboUsed += alignedSize;
+
+	return result;
+}
+
+DqnMemStack *LOGLFrameArena_BeginFrame(LOGLFrameArena *const arena)
+{
+	if (arena->inFrame) LOGLFrameArena_EndFrame(arena);
+
+	arena->current = (arena->current + 1) % LOGL_FRAME_ARENA_COUNT;
+	arena->inFrame = true;
+
+	GLsync *fence = &arena->fences[arena->current];
+	if (*fence)
+	{
+		// NOTE: Flush so the fence is sure to be signalled, a wait could otherwise be on commands
+		// the driver is still holding on to
+		f64 startTimeInMs          = DqnTimer_NowInMs();
+		const GLuint64 timeoutInNs = 1000000000;
+		GLenum status              = glClientWaitSync(*fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+		if (status == GL_TIMEOUT_EXPIRED)
+		{
+			arena->stats.numFenceWaits++;
+			do
+			{
+				status = glClientWaitSync(*fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeoutInNs);
+			} while (status == GL_TIMEOUT_EXPIRED);
+			arena->stats.msWaited += DqnTimer_NowInMs() - startTimeInMs;
+		}
+
+		DQN_ASSERT_MSG(status != GL_WAIT_FAILED, "glClientWaitSync() failed, reusing the frame's memory anyway");
+		glDeleteSync(*fence);
+		*fence = NULL;
+	}
+
+	DqnMemStack *result = &arena->stacks[arena->current];
+	DqnMemStack_ClearCurrBlock(result, false);
+	arena->vboUsed = 0;
+	return result;
+}
+
+void LOGLFrameArena_EndFrame(LOGLFrameArena *const arena)
+{
+	if (!arena->inFrame) return;
+	arena->inFrame = false;
+
+	const DqnMemStack *stack   = &arena->stacks[arena->current];
+	arena->stats.used          = (stack->block) ? stack->block->used : 0;
+	arena->stats.highWaterMark = DQN_MAX(arena->stats.highWaterMark, arena->stats.used);
+
+	arena->stats.vboUsed          = arena->vboUsed;
+	arena->stats.vboHighWaterMark = DQN_MAX(arena->stats.vboHighWaterMark, arena->vboUsed);
+
+	arena->fences[arena->current] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
@@ -0,0 +1,74 @@
+#ifndef LOGL_FRAME_ARENA_H
+#define LOGL_FRAME_ARENA_H
+
+#include "OpenGL.h"
+
+#include "dqn.h"
+
+// Memory that lives for exactly one frame, like render packets and instance data. There's a fixed
+// size stack for each of LOGL_FRAME_ARENA_COUNT frames in flight, a frame allocates from its own and
+// the stack is reset in O(1) when its turn comes round again. The stacks are only read by the CPU.
+//
+// Vertex data the GPU reads goes in the frame's region of vbo, a GL buffer with a region for each
+// frame in flight. Regions are mapped with GL_MAP_UNSYNCHRONIZED_BIT so the driver neither stalls nor
+// copies, which leaves the frame's fence as the only thing that stops a frame overwriting vertices
+// the GPU is still drawing from. Each frame ends with a GL fence, before a frame's stack and region
+// are reused its fence is waited on. This also bounds how many frames the CPU can queue ahead of the
+// GPU.
+//
+// Stacks and regions don't grow, a push or map that doesn't fit returns NULL. The high water marks
+// are the numbers to size them by.
+
+#define LOGL_FRAME_ARENA_COUNT         3
+#define LOGL_FRAME_ARENA_VBO_ALIGNMENT 64 // The minimum GL_MIN_MAP_BUFFER_ALIGNMENT
+
+struct LOGLFrameArenaStats
+{
+	size_t size;             // Bytes in each frame's stack
+	size_t used;             // Bytes the last frame used
+	size_t highWaterMark;    // Most bytes any frame has used
+	size_t vboSize;          // Bytes in each frame's region of the vbo
+	size_t vboUsed;          // Bytes of its region the last frame mapped
+	size_t vboHighWaterMark; // Most bytes of its region any frame has mapped
+	u32    numFenceWaits;    // Frames that had to wait for the GPU to finish with their stack and region
+	f64    msWaited;         // Total time spent in those waits
+};
+
+struct LOGLFrameArena
+{
+	DqnMemStack stacks[LOGL_FRAME_ARENA_COUNT];
+	GLsync      fences[LOGL_FRAME_ARENA_COUNT]; // Signalled when the GPU is done with the stack and region's last frame, NULL if there's nothing to wait on
+	u32         current;                        // Index of the stack and region of the frame in progress
+	bool        inFrame;
+	u32         vbo;                            // 0 until LOGLFrameArena_InitGL()
+	size_t      vboUsed;                        // Bytes of the current frame's region mapped so far
+
+	LOGLFrameArenaStats stats;
+};
+
+// Allocate a stack of sizePerFrame bytes for each frame in flight. Doesn't call GL, the platform can
+// do this before it has a context.
+// return: FALSE if out of memory, the arena is then left zero cleared.
+bool LOGLFrameArena_Init(LOGLFrameArena *const arena, const size_t sizePerFrame);
+void LOGLFrameArena_Free(LOGLFrameArena *const arena);
+
+// Create the vbo with a region of vboSizePerFrame bytes for each frame in flight. Needs the GL
+// context, the vbo is left bound to GL_ARRAY_BUFFER.
+void LOGLFrameArena_InitGL(LOGLFrameArena *const arena, const size_t vboSizePerFrame);
+
+// Map size bytes of the current frame's region of the vbo for writing, the vbo must be bound to
+// GL_ARRAY_BUFFER. Unmap it with glUnmapBuffer() before drawing from it, the mapping can be written
+// from any thread until then.
+// offset: Set to where the mapping starts in the vbo, for the vertex attribute pointers
+// return: NULL if the region is out of room or the map failed.
+void *LOGLFrameArena_MapVertices(LOGLFrameArena *const arena, const size_t size, size_t *const offset);
+
+// Move to the next frame's stack and region, waiting on its fence if the GPU hasn't finished the frame
+// that used them last, then reset them. Ends the last frame first if it wasn't.
+// return: The stack to allocate this frame's memory from, valid until the frame ends.
+DqnMemStack *LOGLFrameArena_BeginFrame(LOGLFrameArena *const arena);
+
+// Record the frame's usage and put a fence after the GL commands issued this frame.
+void LOGLFrameArena_EndFrame(LOGLFrameArena *const arena);
+
+#endif
@@ -0,0 +1,400 @@
+#include "LOGL.h"
+#include "LOGLMip.h"
+
+#define DQN_PLATFORM_HEADER // For DqnJobQueue, DqnAtomic
+#include "dqn.h"
+
+#include <math.h>   // For powf()
+#include <string.h> // For memcpy()
+
+// NOTE: Below this many pixels a level isn't worth splitting, scheduling costs more than it saves
+#define LOGL_MIP_MIN_PIXELS_PER_JOB 16384
+#define LOGL_MIP_MAX_JOBS_PER_LEVEL 32
+#define LOGL_MIP_SRGB_TABLE_SIZE    4096
+
+u32 LOGLMip_NumLevels(const u32 width, const u32 height)
+{
+	u32 result = 1;
+	for (u32 size = DQN_MAX(width, height); size > 1; size >>= 1)
+		result++;
+
+	return result;
+}
+
+DqnV2i LOGLMip_NextLevelDim(const DqnV2i dim)
+{
+	DqnV2i result = {};
+	result.w      = DQN_MAX(1, dim.w / 2);
+	result.h      = DQN_MAX(1, dim.h / 2);
+	return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// sRGB Tables
+////////////////////////////////////////////////////////////////////////////////
+enum LOGLMipTablesState
+{
+	LOGLMipTablesState_Empty,
+	LOGLMipTablesState_Building,
+	LOGLMipTablesState_Ready,
+};
+
+struct LOGLMipSRGBTables
+{
+	f32 toLinear[256];
+	u8  fromLinear[LOGL_MIP_SRGB_TABLE_SIZE]; // Indexed by linear * (LOGL_MIP_SRGB_TABLE_SIZE - 1)
+	i32 volatile state;
+};
+
+FILE_SCOPE LOGLMipSRGBTables loglMipSRGBTables;
+
+// Built by the first thread to ask for them, any others arriving meanwhile wait until they're ready.
+FILE_SCOPE const LOGLMipSRGBTables *LOGLMipInternal_GetSRGBTables()
+{
+	LOGLMipSRGBTables *result = &loglMipSRGBTables;
+	if (result->state == LOGLMipTablesState_Ready) return result;
+
+	if (DqnAtomic_CompareSwap32(&result->state, LOGLMipTablesState_Building, LOGLMipTablesState_Empty) ==
+	    LOGLMipTablesState_Empty)
+	{
+		for (u32 i = 0; i < DQN_ARRAY_COUNT(result->toLinear); i++)
+		{
+			f32 srgb = i / 255.0f;
+			result->toLinear[i] = (srgb <= 0.04045f) ? (srgb / 12.92f) : powf((srgb + 0.055f) / 1.055f, 2.4f);
+		}
+
+		for (u32 i = 0; i < DQN_ARRAY_COUNT(result->fromLinear); i++)
+		{
+			f32 linear = i / (f32)(LOGL_MIP_SRGB_TABLE_SIZE - 1);
+			f32 srgb   = (linear <= 0.0031308f) ? (linear * 12.92f) : ((1.055f * powf(linear, 1 / 2.4f)) - 0.055f);
+			result->fromLinear[i] = (u8)((srgb * 255.0f) + 0.5f);
+		}
+
+		DqnAtomic_MemoryBarrier();
+		result->state = LOGLMipTablesState_Ready;
+	}
+	else
+	{
+		while (result->state != LOGLMipTablesState_Ready)
+			;
+		DqnAtomic_MemoryBarrier();
+	}
+
+	return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Filters
+////////////////////////////////////////////////////////////////////////////////
+// Source texels and their weights along one axis for one dest texel
+struct LOGLMipTaps
+{
+	u32 first;
+	u32 count;
+	f32 weights[3];
+};
+
+FILE_SCOPE inline LOGLMipTaps LOGLMipInternal_Taps(const u32 srcSize, const u32 destSize, const u32 index)
+{
+	LOGLMipTaps result = {};
+	result.first       = index * 2;
+	if (srcSize == 1)
+	{
+		result.count      = 1;
+		result.weights[0] = 1.0f;
+	}
+	else if ((srcSize & 1) == 0)
+	{
+		result.count      = 2;
+		result.weights[0] = 0.5f;
+		result.weights[1] = 0.5f;
+	}
+	else
+	{
+		// NOTE: srcSize is (destSize * 2) + 1, the outer weights slide across the axis so each source
+		// texel adds up to the same total weight
+		f32 invSrcSize    = 1.0f / srcSize;
+		result.count      = 3;
+		result.weights[0] = (destSize - index) * invSrcSize;
+		result.weights[1] = destSize * invSrcSize;
+		result.weights[2] = (index + 1) * invSrcSize;
+	}
+
+	return result;
+}
+
+// Handles any size, bytes per pixel and colour space.
+FILE_SCOPE void LOGLMipInternal_DownsampleRowsScalar(const LOGLBitmap *const src, LOGLBitmap *const dest,
+                                                     const LOGLMipSRGBTables *const srgbTables, const u32 yStart,
+                                                     const u32 yEnd)
+{
+	const u32 bytesPerPixel = src->bytesPerPixel;
+	const size_t srcPitch   = (size_t)src->dim.w * bytesPerPixel;
+	const size_t destPitch  = (size_t)dest->dim.w * bytesPerPixel;
+
+	// NOTE: Alpha is the last channel of 2 and 4 byte pixels and is always averaged as is
+	u32 numSRGBChannels = 0;
+	if (srgbTables) numSRGBChannels = (bytesPerPixel == 2 || bytesPerPixel == 4) ? bytesPerPixel - 1 : bytesPerPixel;
+
+	for (u32 y = yStart; y < yEnd; y++)
+	{
+		LOGLMipTaps rowTaps = LOGLMipInternal_Taps(src->dim.h, dest->dim.h, y);
+		u8 *destPixel       = dest->memory + (y * destPitch);
+		for (u32 x = 0; x < (u32)dest->dim.w; x++)
+		{
+			LOGLMipTaps colTaps = LOGLMipInternal_Taps(src->dim.w, dest->dim.w, x);
+			f32 sums[4]         = {};
+			for (u32 j = 0; j < rowTaps.count; j++)
+			{
+				const u8 *row = src->memory + ((rowTaps.first + j) * srcPitch);
+				for (u32 i = 0; i < colTaps.count; i++)
+				{
+					const u8 *pixel = row + ((colTaps.first + i) * bytesPerPixel);
+					f32 weight      = rowTaps.weights[j] * colTaps.weights[i];
+
+					u32 channel = 0;
+					for (; channel < numSRGBChannels; channel++)
+						sums[channel] += weight * srgbTables->toLinear[pixel[channel]];
+					for (; channel < bytesPerPixel; channel++)
+						sums[channel] += weight * pixel[channel];
+				}
+			}
+
+			u32 channel = 0;
+			for (; channel < numSRGBChannels; channel++)
+			{
+				u32 index          = (u32)((sums[channel] * (LOGL_MIP_SRGB_TABLE_SIZE - 1)) + 0.5f);
+				destPixel[channel] = srgbTables->fromLinear[DQN_MIN(index, LOGL_MIP_SRGB_TABLE_SIZE - 1u)];
+			}
+			for (; channel < bytesPerPixel; channel++)
+				destPixel[channel] = (u8)DQN_MIN(sums[channel] + 0.5f, 255.0f);
+
+			destPixel += bytesPerPixel;
+		}
+	}
+}
+
+#if defined(DQN_SSE2)
+// Box filter 8 source pixels of each row into 4 dest pixels at a time.
+// return: The number of dest pixels written, a multiple of 4.
+FILE_SCOPE u32 LOGLMipInternal_BoxRowRGBA(const u8 *const row0, const u8 *const row1, u8 *const dest,
+                                          const u32 destWidth)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i two  = _mm_set1_epi16(2);
+
+	u32 x = 0;
+	for (; x + 4 <= destWidth; x += 4)
+	{
+		__m128i a0 = _mm_loadu_si128((const __m128i *)(row0 + (x * 8)));
+		__m128i a1 = _mm_loadu_si128((const __m128i *)(row0 + (x * 8) + 16));
+		__m128i b0 = _mm_loadu_si128((const __m128i *)(row1 + (x * 8)));
+		__m128i b1 = _mm_loadu_si128((const __m128i *)(row1 + (x * 8) + 16));
+
+		// NOTE: Widen to 16 bits and add the rows, each register holds 2 pixels
+		__m128i sum01 = _mm_add_epi16(_mm_unpacklo_epi8(a0, zero), _mm_unpacklo_epi8(b0, zero));
+		__m128i sum23 = _mm_add_epi16(_mm_unpackhi_epi8(a0, zero), _mm_unpackhi_epi8(b0, zero));
+		__m128i sum45 = _mm_add_epi16(_mm_unpacklo_epi8(a1, zero), _mm_unpacklo_epi8(b1, zero));
+		__m128i sum67 = _mm_add_epi16(_mm_unpackhi_epi8(a1, zero), _mm_unpackhi_epi8(b1, zero));
+
+		// NOTE: Then add each pair of pixels, the dest pixel ends up in the low 4 lanes
+		__m128i dest0 = _mm_add_epi16(sum01, _mm_srli_si128(sum01, 8));
+		__m128i dest1 = _mm_add_epi16(sum23, _mm_srli_si128(sum23, 8));
+		__m128i dest2 = _mm_add_epi16(sum45, _mm_srli_si128(sum45, 8));
+		__m128i dest3 = _mm_add_epi16(sum67, _mm_srli_si128(sum67, 8));
+
+		__m128i dest01 = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(dest0, dest1), two), 2);
+		__m128i dest23 = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(dest2, dest3), two), 2);
+		_mm_storeu_si128((__m128i *)(dest + (x * 4)), _mm_packus_epi16(dest01, dest23));
+	}
+
+	return x;
+}
+
+// return: The number of dest pixels written, a multiple of 4.
+FILE_SCOPE u32 LOGLMipInternal_BoxRowRGB(const u8 *const row0, const u8 *const row1, u8 *const dest,
+                                         const u32 destWidth)
+{
+	const __m128i zero  = _mm_setzero_si128();
+	const __m128i two   = _mm_set1_epi16(2);
+	const __m128i mask3 = _mm_setr_epi8(-1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+
+	u32 x = 0;
+	for (; x + 4 <= destWidth; x += 4)
+	{
+		// NOTE: 8 source pixels are 24 bytes, load exactly that so the last pixels of a row don't read past it
+		const u8 *src0 = row0 + (x * 6);
+		const u8 *src1 = row1 + (x * 6);
+		__m128i a0     = _mm_loadu_si128((const __m128i *)src0);
+		__m128i a1     = _mm_loadl_epi64((const __m128i *)(src0 + 16));
+		__m128i b0     = _mm_loadu_si128((const __m128i *)src1);
+		__m128i b1     = _mm_loadl_epi64((const __m128i *)(src1 + 16));
+
+		// NOTE: Sum of the rows for bytes 0-7, 8-15 and 16-23
+		__m128i v0 = _mm_add_epi16(_mm_unpacklo_epi8(a0, zero), _mm_unpacklo_epi8(b0, zero));
+		__m128i v1 = _mm_add_epi16(_mm_unpackhi_epi8(a0, zero), _mm_unpackhi_epi8(b0, zero));
+		__m128i v2 = _mm_add_epi16(_mm_unpacklo_epi8(a1, zero), _mm_unpacklo_epi8(b1, zero));
+
+		// NOTE: Add each byte to the one a pixel (3 lanes) on, dest pixel n is then at byte 6n
+		__m128i h0 = _mm_add_epi16(v0, _mm_or_si128(_mm_srli_si128(v0, 6), _mm_slli_si128(v1, 10)));
+		__m128i h1 = _mm_add_epi16(v1, _mm_or_si128(_mm_srli_si128(v1, 6), _mm_slli_si128(v2, 10)));
+		__m128i h2 = _mm_add_epi16(v2, _mm_srli_si128(v2, 6));
+		h0         = _mm_srli_epi16(_mm_add_epi16(h0, two), 2);
+		h1         = _mm_srli_epi16(_mm_add_epi16(h1, two), 2);
+		h2         = _mm_srli_epi16(_mm_add_epi16(h2, two), 2);
+
+		// NOTE: Gather bytes 0-2, 6-8, 12-14 and 18-20 into 12 contiguous bytes
+		__m128i bytes0to15  = _mm_packus_epi16(h0, h1);
+		__m128i bytes16to23 = _mm_packus_epi16(h2, zero);
+		__m128i result      = _mm_and_si128(bytes0to15, mask3);
+		result = _mm_or_si128(result, _mm_and_si128(_mm_srli_si128(bytes0to15, 3), _mm_slli_si128(mask3, 3)));
+		result = _mm_or_si128(result, _mm_and_si128(_mm_srli_si128(bytes0to15, 6), _mm_slli_si128(mask3, 6)));
+		result = _mm_or_si128(result, _mm_and_si128(_mm_slli_si128(bytes16to23, 7), _mm_slli_si128(mask3, 9)));
+
+		u8 *destPixel = dest + (x * 3);
+		u32 lastBytes = (u32)_mm_cvtsi128_si32(_mm_srli_si128(result, 8));
+		_mm_storel_epi64((__m128i *)destPixel, result);
+		memcpy(destPixel + 8, &lastBytes, sizeof(lastBytes));
+	}
+
+	return x;
+}
+#endif
+
+// Linear 2x2 box filter for even sized sources, matches the scalar filter bit for bit.
+FILE_SCOPE void LOGLMipInternal_DownsampleRowsBox(const LOGLBitmap *const src, LOGLBitmap *const dest,
+                                                  const u32 yStart, const u32 yEnd)
+{
+	const u32 bytesPerPixel = src->bytesPerPixel;
+	const u32 destWidth     = dest->dim.w;
+	const size_t srcPitch   = (size_t)src->dim.w * bytesPerPixel;
+	const size_t destPitch  = (size_t)destWidth * bytesPerPixel;
+
+	for (u32 y = yStart; y < yEnd; y++)
+	{
+		const u8 *row0 = src->memory + ((size_t)(y * 2) * srcPitch);
+		const u8 *row1 = row0 + srcPitch;
+		u8 *destRow    = dest->memory + (y * destPitch);
+
+		u32 x = 0;
+#if defined(DQN_SSE2)
+		if (bytesPerPixel == 4)      x = LOGLMipInternal_BoxRowRGBA(row0, row1, destRow, destWidth);
+		else if (bytesPerPixel == 3) x = LOGLMipInternal_BoxRowRGB (row0, row1, destRow, destWidth);
+#endif
+
+		// NOTE: The tail of the SIMD rows and every pixel of the other formats
+		for (; x < destWidth; x++)
+		{
+			const u8 *pixel0 = row0 + ((size_t)(x * 2) * bytesPerPixel);
+			const u8 *pixel1 = row1 + ((size_t)(x * 2) * bytesPerPixel);
+			u8 *destPixel    = destRow + ((size_t)x * bytesPerPixel);
+			for (u32 i = 0; i < bytesPerPixel; i++)
+			{
+				u32 sum      = pixel0[i] + pixel0[i + bytesPerPixel] + pixel1[i] + pixel1[i + bytesPerPixel];
+				destPixel[i] = (u8)((sum + 2) >> 2);
+			}
+		}
+	}
+}
+
+FILE_SCOPE void LOGLMipInternal_DownsampleRows(const LOGLBitmap *const src, LOGLBitmap *const dest,
+                                               const enum LOGLMipColorSpace colorSpace, const u32 yStart,
+                                               const u32 yEnd)
+{
+	bool evenSize = ((src->dim.w & 1) == 0 && (src->dim.h & 1) == 0);
+	if (colorSpace == LOGLMipColorSpace_Linear && evenSize)
+	{
+		LOGLMipInternal_DownsampleRowsBox(src, dest, yStart, yEnd);
+	}
+	else
+	{
+		const LOGLMipSRGBTables *srgbTables =
+		    (colorSpace == LOGLMipColorSpace_SRGB) ? LOGLMipInternal_GetSRGBTables() : NULL;
+		LOGLMipInternal_DownsampleRowsScalar(src, dest, srgbTables, yStart, yEnd);
+	}
+}
+
+void LOGLMip_Downsample(const LOGLBitmap *const src, LOGLBitmap *const dest, const enum LOGLMipColorSpace colorSpace)
+{
+	if (!src || !dest || !src->memory || !dest->memory) return;
+
+	DqnV2i destDim = LOGLMip_NextLevelDim(src->dim);
+	if (!DQN_ASSERT(dest->dim.w == destDim.w && dest->dim.h == destDim.h)) return;
+	if (!DQN_ASSERT(dest->bytesPerPixel == src->bytesPerPixel && src->bytesPerPixel >= 1 && src->bytesPerPixel <= 4))
+		return;
+
+	LOGLMipInternal_DownsampleRows(src, dest, colorSpace, 0, dest->dim.h);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Chain
+////////////////////////////////////////////////////////////////////////////////
+struct LOGLMipRowsJob
+{
+	const LOGLBitmap      *src;
+	LOGLBitmap            *dest;
+	enum LOGLMipColorSpace colorSpace;
+	u32                    yStart;
+	u32                    yEnd;
+};
+
+FILE_SCOPE void LOGLMipInternal_RowsJob(DqnJobQueue *const queue, void *const userData)
+{
+	LOGLMipRowsJob *job = (LOGLMipRowsJob *)userData;
+	LOGLMipInternal_DownsampleRows(job->src, job->dest, job->colorSpace, job->yStart, job->yEnd);
+}
+
+u32 LOGLMip_BuildChain(DqnMemStack *const memStack, DqnJobQueue *const queue, LOGLBitmap *const levels,
+                       const u32 maxLevels, const enum LOGLMipColorSpace colorSpace)
+{
+	if (!memStack || !levels || maxLevels == 0) return 0;
+
+	const LOGLBitmap *level0 = &levels[0];
+	if (!level0->memory || level0->dim.w <= 0 || level0->dim.h <= 0) return 0;
+	if (level0->bytesPerPixel < 1 || level0->bytesPerPixel > 4) return 0;
+
+	// NOTE: Build the tables up front rather than have every job wait on the first one to build them
+	if (colorSpace == LOGLMipColorSpace_SRGB) LOGLMipInternal_GetSRGBTables();
+
+	u32 result = DQN_MIN(maxLevels, LOGLMip_NumLevels(level0->dim.w, level0->dim.h));
+	for (u32 levelIndex = 1; levelIndex < result; levelIndex++)
+	{
+		const LOGLBitmap *src = &levels[levelIndex - 1];
+		LOGLBitmap *dest      = &levels[levelIndex];
+		dest->dim             = LOGLMip_NextLevelDim(src->dim);
+		dest->bytesPerPixel   = src->bytesPerPixel;
+		dest->memory          = (u8 *)memStack->Push((size_t)dest->dim.w * dest->dim.h * dest->bytesPerPixel);
+		if (!dest->memory) return 0;
+
+		const u32 destHeight = dest->dim.h;
+		u32 rowsPerJob       = DQN_MAX(1u, LOGL_MIP_MIN_PIXELS_PER_JOB / (u32)dest->dim.w);
+		rowsPerJob = DQN_MAX(rowsPerJob, (destHeight + LOGL_MIP_MAX_JOBS_PER_LEVEL - 1) / LOGL_MIP_MAX_JOBS_PER_LEVEL);
+		if (!queue || rowsPerJob >= destHeight)
+		{
+			LOGLMipInternal_DownsampleRows(src, dest, colorSpace, 0, destHeight);
+			continue;
+		}
+
+		// NOTE: Each level reads the one above it, so wait for a level before starting the next
+		LOGLMipRowsJob jobs[LOGL_MIP_MAX_JOBS_PER_LEVEL];
+		DqnJobCounter counter = {};
+		u32 numJobs           = 0;
+		for (u32 y = 0; y < destHeight; y += rowsPerJob)
+		{
+			LOGLMipRowsJob *job = &jobs[numJobs++];
+			job->src            = src;
+			job->dest           = dest;
+			job->colorSpace     = colorSpace;
+			job->yStart         = y;
+			job->yEnd           = DQN_MIN(y + rowsPerJob, destHeight);
+
+			DqnJob queueJob = {LOGLMipInternal_RowsJob, job, &counter};
+			if (!DqnJobQueue_AddJob(queue, queueJob))
+				LOGLMipInternal_RowsJob(queue, job);
+		}
+
+		DqnJobQueue_WaitForCounter(queue, &counter);
+	}
+
+	return result;
+}
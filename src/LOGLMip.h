@@ -0,0 +1,42 @@
+#ifndef LOGL_MIP_H
+#define LOGL_MIP_H
+
+#define DQN_PLATFORM_HEADER // For DqnJobQueue
+#include "dqn.h"
+
+// Mip chain generation on the CPU. Each level is filtered from the one above it, even sized levels
+// with a 2x2 box and odd sized axes with a 3 tap polyphase box so every source texel contributes.
+// 8 bit RGB/RGBA levels with even dimensions in linear mode take the SSE2 path, see DQN_SSE2 in
+// dqn.h, everything else takes the scalar filter.
+
+#define LOGL_MIP_MAX_LEVELS 16 // A full chain for up to 32768x32768
+
+enum LOGLMipColorSpace
+{
+	LOGLMipColorSpace_Linear, // Average the stored values as they are
+	LOGLMipColorSpace_SRGB,   // Average colour channels in linear light, alpha is always linear
+};
+
+struct LOGLBitmap;
+
+// return: The number of levels in a full chain, from width x height down to 1x1.
+u32 LOGLMip_NumLevels(const u32 width, const u32 height);
+
+// return: The dimensions of the level below dim, half on each axis rounded down to a minimum of 1.
+DqnV2i LOGLMip_NextLevelDim(const DqnV2i dim);
+
+// Filter src down to the next level on the calling thread.
+// dest: Must have the dimensions from LOGLMip_NextLevelDim(), the same bytesPerPixel as src and
+//       memory for its pixels.
+void LOGLMip_Downsample(const LOGLBitmap *const src, LOGLBitmap *const dest, const enum LOGLMipColorSpace colorSpace);
+
+// Build the chain below levels[0], pushing the memory of each level from memStack. Levels are
+// split into bands of rows that run on queue if there is one, the calling thread helps until each
+// level completes.
+// maxLevels: The number of bitmaps levels can hold, the chain stops early if it's too short.
+// return: The number of levels in levels including level 0, 0 if memStack ran out of memory or
+//         levels[0] is not 1 to 4 bytes per pixel.
+u32 LOGLMip_BuildChain(DqnMemStack *const memStack, DqnJobQueue *const queue, LOGLBitmap *const levels,
+                       const u32 maxLevels, const enum LOGLMipColorSpace colorSpace);
+
+#endif
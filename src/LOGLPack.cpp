@@ -0,0 +1,235 @@
+#include "LOGL.h"
+#include "LOGLBC.h"
+#include "LOGLMip.h"
+#include "LOGLPack.h"
+
+#define DQN_PLATFORM_HEADER // For DqnFile
+#include "dqn.h"
+
+#include <math.h>   // For INFINITY
+#include <string.h> // For memcpy(), memset()
+
+u32 LOGLPack_BytesPerPixel(const enum LOGLPackFormat format)
+{
+	switch (format)
+	{
+		case LOGLPackFormat_R8:    return 1;
+		case LOGLPackFormat_RGB8:  return 3;
+		case LOGLPackFormat_RGBA8: return 4;
+		default:                   return 0;
+	}
+}
+
+enum LOGLBCFormat LOGLPack_BCFormat(const enum LOGLPackFormat format)
+{
+	switch (format)
+	{
+		case LOGLPackFormat_BC1: return LOGLBCFormat_BC1;
+		case LOGLPackFormat_BC3: return LOGLBCFormat_BC3;
+		case LOGLPackFormat_BC4: return LOGLBCFormat_BC4;
+		case LOGLPackFormat_BC5: return LOGLBCFormat_BC5;
+		default:                 return LOGLBCFormat_None;
+	}
+}
+
+u64 LOGLPack_MipSize(const enum LOGLPackFormat format, const u32 width, const u32 height)
+{
+	enum LOGLBCFormat bcFormat = LOGLPack_BCFormat(format);
+	if (bcFormat != LOGLBCFormat_None) return LOGLBC_EncodedSize(bcFormat, width, height);
+
+	u64 result = (u64)width * height * LOGLPack_BytesPerPixel(format);
+	return result;
+}
+
+// return: LOGLPackFormat_Invalid if there's no format for the bitmap.
+FILE_SCOPE enum LOGLPackFormat LOGLPackInternal_PickFormat(const LOGLBitmap *const bitmap,
+                                                            const enum LOGLBCQuality quality)
+{
+	if (quality != LOGLBCQuality_None)
+	{
+		switch (LOGLBC_PickFormat(bitmap))
+		{
+			case LOGLBCFormat_BC1: return LOGLPackFormat_BC1;
+			case LOGLBCFormat_BC3: return LOGLPackFormat_BC3;
+			case LOGLBCFormat_BC4: return LOGLPackFormat_BC4;
+			case LOGLBCFormat_BC5: return LOGLPackFormat_BC5;
+			default: break;
+		}
+	}
+
+	switch (bitmap->bytesPerPixel)
+	{
+		case 1:  return LOGLPackFormat_R8;
+		case 3:  return LOGLPackFormat_RGB8;
+		case 4:  return LOGLPackFormat_RGBA8;
+		default: return LOGLPackFormat_Invalid;
+	}
+}
+
+bool LOGLPack_Cook(DqnMemStack *const memStack, DqnMemStack *const tempStack, DqnJobQueue *const queue,
+                   const char *const *const imagePaths, const u32 numImages, const char *const packPath,
+                   const enum LOGLBCQuality quality, f32 *const psnrs)
+{
+	if (!memStack || !tempStack || !imagePaths || !packPath || numImages == 0) return false;
+
+	auto memRegion            = memStack->TempRegionGuard();
+	auto tempRegion           = tempStack->TempRegionGuard();
+	LOGLBitmap *mips          = (LOGLBitmap *)tempStack->Push(sizeof(*mips) * LOGL_PACK_MAX_MIPS * numImages);
+	LOGLPackTexture *textures = (LOGLPackTexture *)tempStack->Push(sizeof(*textures) * numImages);
+	if (!mips || !textures) return false;
+
+	// NOTE: A texture's format depends on its pixels when compressing, so every image is decoded and
+	// has its mips built before the pack can be laid out
+	size_t packSize = DQN_ALIGN_POW_N(sizeof(LOGLPackHeader) + (sizeof(*textures) * numImages), LOGL_PACK_ALIGNMENT);
+	for (u32 i = 0; i < numImages; i++)
+	{
+		LOGLPackTexture *texture = &textures[i];
+		LOGLBitmap *levels       = &mips[i * LOGL_PACK_MAX_MIPS];
+		*texture                 = {};
+
+		LOGLBitmapFile file = {};
+		if (!LOGL_OpenBitmap(tempStack, &file, imagePaths[i])) return false;
+		if (!DQN_ASSERT_MSG(file.dim.w <= LOGL_PACK_MAX_DIM && file.dim.h <= LOGL_PACK_MAX_DIM,
+		                    "Image is larger than %d pixels a side: %s", LOGL_PACK_MAX_DIM, imagePaths[i]))
+			return false;
+
+		levels[0].memory        = (u8 *)tempStack->Push(file.decodeSize);
+		levels[0].dim           = file.dim;
+		levels[0].bytesPerPixel = file.bytesPerPixel;
+		if (!levels[0].memory || !LOGL_DecodeBitmap(tempStack, &file, levels[0].memory)) return false;
+
+		texture->format = LOGLPackInternal_PickFormat(&levels[0], quality);
+		if (texture->format == LOGLPackFormat_Invalid)
+		{
+			DQN_ASSERT_MSG(DQN_INVALID_CODE_PATH, "Unhandled bytes per pixel: %d, %s", file.bytesPerPixel,
+			               imagePaths[i]);
+			return false;
+		}
+
+		i32 nameLen = DqnStr_Len(imagePaths[i]);
+		if (!DQN_ASSERT_MSG(nameLen < LOGL_PACK_MAX_NAME, "Image path is too long to name a texture: %s", imagePaths[i]))
+			return false;
+		memcpy(texture->name, imagePaths[i], nameLen + 1);
+
+		// NOTE: The runtime textures aren't sRGB, filter them the way GL would
+		texture->numMips = LOGLMip_BuildChain(tempStack, queue, levels, LOGL_PACK_MAX_MIPS, LOGLMipColorSpace_Linear);
+		if (!DQN_ASSERT(texture->numMips == LOGLMip_NumLevels(file.dim.w, file.dim.h))) return false;
+
+		for (u32 mipIndex = 0; mipIndex < texture->numMips; mipIndex++)
+		{
+			LOGLPackMip *mip = &texture->mips[mipIndex];
+			mip->width       = levels[mipIndex].dim.w;
+			mip->height      = levels[mipIndex].dim.h;
+			mip->size        = LOGLPack_MipSize((enum LOGLPackFormat)texture->format, mip->width, mip->height);
+			mip->offset      = packSize;
+			packSize        += DQN_ALIGN_POW_N((size_t)mip->size, LOGL_PACK_ALIGNMENT);
+		}
+	}
+
+	u8 *pack = (u8 *)memStack->Push(packSize);
+	if (!pack) return false;
+	memset(pack, 0, packSize);
+
+	LOGLPackHeader header = {};
+	header.magic          = LOGL_PACK_MAGIC;
+	header.version        = LOGL_PACK_VERSION;
+	header.numTextures    = numImages;
+	header.alignment      = LOGL_PACK_ALIGNMENT;
+	header.fileSize       = packSize;
+	memcpy(pack, &header, sizeof(header));
+	memcpy(pack + sizeof(header), textures, sizeof(*textures) * numImages);
+
+	for (u32 i = 0; i < numImages; i++)
+	{
+		const LOGLPackTexture *texture = &textures[i];
+		const LOGLBitmap *levels       = &mips[i * LOGL_PACK_MAX_MIPS];
+		enum LOGLBCFormat bcFormat     = LOGLPack_BCFormat((enum LOGLPackFormat)texture->format);
+		for (u32 mipIndex = 0; mipIndex < texture->numMips; mipIndex++)
+		{
+			const LOGLPackMip *mip = &texture->mips[mipIndex];
+			u8 *dest               = pack + mip->offset;
+			if (bcFormat == LOGLBCFormat_None)
+				memcpy(dest, levels[mipIndex].memory, (size_t)mip->size);
+			else if (!LOGLBC_Encode(queue, &levels[mipIndex], bcFormat, quality, dest))
+				return false;
+		}
+
+		if (psnrs)
+		{
+			LOGLBCImage image = {pack + texture->mips[0].offset, (size_t)texture->mips[0].size, levels[0].dim, bcFormat};
+			psnrs[i]          = (bcFormat == LOGLBCFormat_None) ? INFINITY : LOGLBC_PSNR(tempStack, &levels[0], &image);
+		}
+	}
+
+	DqnFile file = {};
+	if (!DqnFile_Open(packPath, &file, DqnFilePermissionFlag_Write, DqnFileAction_ClearIfExist))
+	{
+		if (!DqnFile_Open(packPath, &file, DqnFilePermissionFlag_Write, DqnFileAction_CreateIfNotExist))
+			return false;
+	}
+
+	size_t bytesWritten = DqnFile_Write(&file, pack, packSize, 0);
+	DqnFile_Close(&file);
+	return (bytesWritten == packSize);
+}
+
+bool LOGLPack_Open(const u8 *const data, const size_t size, LOGLPack *const pack)
+{
+	if (!data || !pack || size < sizeof(LOGLPackHeader)) return false;
+	*pack = {};
+
+	const LOGLPackHeader *header = (const LOGLPackHeader *)data;
+	if (header->magic != LOGL_PACK_MAGIC || header->version != LOGL_PACK_VERSION ||
+	    header->alignment != LOGL_PACK_ALIGNMENT || header->fileSize != size)
+	{
+		return false;
+	}
+
+	if (header->numTextures > (size - sizeof(*header)) / sizeof(LOGLPackTexture)) return false;
+
+	// NOTE: Check everything the runtime will read, so a truncated or corrupt pack is rejected up front
+	const LOGLPackTexture *textures = (const LOGLPackTexture *)(data + sizeof(*header));
+	for (u32 i = 0; i < header->numTextures; i++)
+	{
+		const LOGLPackTexture *texture = &textures[i];
+		enum LOGLPackFormat format     = (enum LOGLPackFormat)texture->format;
+		if (format <= LOGLPackFormat_Invalid || format >= LOGLPackFormat_Count) return false;
+		if (texture->numMips == 0 || texture->numMips > LOGL_PACK_MAX_MIPS) return false;
+		if (memchr(texture->name, 0, sizeof(texture->name)) == NULL) return false;
+
+		// NOTE: Capping the first mip keeps every mip's size from overflowing
+		const LOGLPackMip *base = &texture->mips[0];
+		if (base->width == 0 || base->height == 0) return false;
+		if (base->width > LOGL_PACK_MAX_DIM || base->height > LOGL_PACK_MAX_DIM) return false;
+
+		for (u32 mipIndex = 0; mipIndex < texture->numMips; mipIndex++)
+		{
+			// NOTE: Each mip halves the last down to 1x1, the way LOGLMip_BuildChain() cooks them
+			const LOGLPackMip *mip = &texture->mips[mipIndex];
+			if (mip->width != DQN_MAX(1u, base->width >> mipIndex)) return false;
+			if (mip->height != DQN_MAX(1u, base->height >> mipIndex)) return false;
+			if (mip->size != LOGLPack_MipSize(format, mip->width, mip->height)) return false;
+			if ((mip->offset % LOGL_PACK_ALIGNMENT) != 0) return false;
+			if (mip->offset > size || mip->size > size - mip->offset) return false;
+		}
+	}
+
+	pack->data        = data;
+	pack->size        = size;
+	pack->textures    = textures;
+	pack->numTextures = header->numTextures;
+	return true;
+}
+
+const LOGLPackTexture *LOGLPack_FindTexture(const LOGLPack *const pack, const char *const name)
+{
+	if (!pack || !name) return NULL;
+
+	for (u32 i = 0; i < pack->numTextures; i++)
+	{
+		if (DqnStr_Cmp(pack->textures[i].name, name) == 0)
+			return &pack->textures[i];
+	}
+
+	return NULL;
+}
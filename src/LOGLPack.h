@@ -0,0 +1,100 @@
+#ifndef LOGL_PACK_H
+#define LOGL_PACK_H
+
+#include "LOGLBC.h"
+#include "LOGLMip.h"
+#include "dqn.h"
+
+// Cooked asset pack. LOGLPack_Cook() decodes source images, builds their mip chains and optionally
+// block compresses them offline, so at runtime the pack is mapped into memory and the mips are
+// handed straight to GL with nothing to decode, generate or encode.
+
+// File Format
+// Header: LOGLPackHeader
+// Then numTextures LOGLPackTexture entries, followed by the pixels of every mip. Offsets are from
+// the start of the file and each mip starts on a LOGL_PACK_ALIGNMENT boundary. Rows, or rows of
+// 4x4 blocks for the BC formats, are tightly packed and stored bottom row first, the order GL expects.
+
+#define LOGL_PACK_MAGIC     0x4B504C4C // 'LLPK'
+#define LOGL_PACK_VERSION   2
+#define LOGL_PACK_ALIGNMENT 64
+#define LOGL_PACK_MAX_MIPS  LOGL_MIP_MAX_LEVELS
+#define LOGL_PACK_MAX_NAME  64
+#define LOGL_PACK_MAX_DIM   16384 // Largest width or height of a texture's first mip
+
+enum LOGLPackFormat
+{
+	LOGLPackFormat_Invalid,
+	LOGLPackFormat_R8,
+	LOGLPackFormat_RGB8,
+	LOGLPackFormat_RGBA8,
+	LOGLPackFormat_BC1, // See LOGLBC.h
+	LOGLPackFormat_BC3,
+	LOGLPackFormat_BC4,
+	LOGLPackFormat_BC5,
+	LOGLPackFormat_Count,
+};
+
+struct LOGLPackHeader
+{
+	u32 magic;       // LOGL_PACK_MAGIC
+	u32 version;     // LOGL_PACK_VERSION
+	u32 numTextures;
+	u32 alignment;   // LOGL_PACK_ALIGNMENT when the pack was cooked
+	u64 fileSize;
+};
+
+struct LOGLPackMip
+{
+	u64 offset;
+	u64 size;
+	u32 width;
+	u32 height;
+};
+
+struct LOGLPackTexture
+{
+	char        name[LOGL_PACK_MAX_NAME]; // Null terminated path of the image the texture was cooked from
+	u32         format;                   // LOGLPackFormat
+	u32         numMips;                  // Level 0 down to 1x1
+	LOGLPackMip mips[LOGL_PACK_MAX_MIPS];
+};
+
+// A validated pack in memory, the memory must outlive it
+struct LOGLPack
+{
+	const u8              *data;
+	size_t                 size;
+	const LOGLPackTexture *textures;
+	u32                    numTextures;
+};
+
+// Decode each image, build its mip chain and write them all to a pack at packPath. The pack is
+// assembled in memStack, tempStack holds the source files and their mips. Mips are built and
+// compressed on queue if there is one.
+// quality: LOGLBCQuality_None stores the pixels as they are, otherwise each texture is block
+//          compressed into the format from LOGLBC_PickFormat().
+// psnrs: Optional, gets the PSNR of each image's compressed level 0, INFINITY if it's stored as is.
+// return: FALSE if an image could not be decoded or has no LOGLPackFormat, memory ran out or the
+//         file could not be written.
+bool LOGLPack_Cook(DqnMemStack *const memStack, DqnMemStack *const tempStack, DqnJobQueue *const queue,
+                   const char *const *const imagePaths, const u32 numImages, const char *const packPath,
+                   const enum LOGLBCQuality quality, f32 *const psnrs);
+
+// Validate the pack in data, e.g. a mapped file.
+// return: FALSE if data is not a pack of this version or any texture lies outside of it.
+bool LOGLPack_Open(const u8 *const data, const size_t size, LOGLPack *const pack);
+
+// return: NULL if the pack has no texture cooked from the image at name.
+const LOGLPackTexture *LOGLPack_FindTexture(const LOGLPack *const pack, const char *const name);
+
+// return: 0 if format is invalid or block compressed.
+u32 LOGLPack_BytesPerPixel(const enum LOGLPackFormat format);
+
+// return: LOGLBCFormat_None if format is invalid or not block compressed.
+enum LOGLBCFormat LOGLPack_BCFormat(const enum LOGLPackFormat format);
+
+// return: The bytes of a width x height mip in format, 0 if format is invalid.
+u64 LOGLPack_MipSize(const enum LOGLPackFormat format, const u32 width, const u32 height);
+
+#endif
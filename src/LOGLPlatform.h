@@ -1,7 +1,10 @@
 #ifndef LOGL_PLATFORM_H
 #define LOGL_PLATFORM_H
 
+#include "LOGLFrameArena.h"
 #include "OpenGL.h"
+
+#define DQN_PLATFORM_HEADER // For DqnJobQueue
 #include "dqn.h"
 
 enum PlatformKey
@@ -51,8 +54,21 @@ struct PlatformMouse
 struct PlatformMemory
 {
 	DqnMemStack      mainStack;
-	DqnMemStack      tempStack;
+	DqnMemStack      tempStack;  // Scratch, popped at the end of each LOGL_Update()
+	LOGLFrameArena   frameArena; // Memory for one frame that the GPU may read, see LOGLFrameArena.h
 	struct LOGLState *state;
+
+	// Worker threads for the app to split frame work across, NULL to do everything on the main thread
+	DqnJobQueue *jobQueue;
+	u32          numJobThreads; // Not including the main thread, which also completes jobs while it waits
+
+	// Cooked textures mapped read only by the platform, see LOGLPack.h. NULL if there is no pack.
+	const u8 *assetPack;
+	size_t    assetPackSize;
+
+	// Directory created by the platform for the app to cache shader binaries in, see LOGLShader.h.
+	// NULL to always compile shaders from source.
+	const char *shaderCacheDir;
 };
 
 struct PlatformInput
@@ -60,7 +76,12 @@ struct PlatformInput
 	f32 deltaForFrame;
 	PlatformMouse mouse;
 
-	DqnV2 screenDim;
+	DqnV2  screenDim;
+	u32    numCubes;      // Number of cubes to populate the scene with on init, 0 for the default scene
+	u32    bcQuality;     // LOGLBCQuality to block compress textures decoded at load, 0 to upload them as they are
+	size_t textureBudget; // Bytes of resident textures before the least recently used are evicted, 0 for no limit
+	bool   shadersChanged; // A file in LOGL_SHADER_DIR was written since the last frame
+
 	union {
 		PlatformKeyState key[PlatformKey_Count];
 		struct
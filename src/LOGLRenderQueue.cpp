@@ -0,0 +1,57 @@
+#include "LOGLRenderQueue.h"
+
+#include "dqn.h"
+
+#include <string.h> // For memcpy()
+
+u64 LOGLRenderQueue_MakeKey(const u32 layer, const u32 program, const u32 material, const f32 depth)
+{
+	// NOTE: The bits of a positive float order the same as its value, so depth sorts as an integer
+	u32 depthBits = 0;
+	if (depth > 0) memcpy(&depthBits, &depth, sizeof(depthBits));
+
+	const u32 depthShift    = 0;
+	const u32 materialShift = depthShift + LOGL_RENDER_KEY_DEPTH_BITS;
+	const u32 programShift  = materialShift + LOGL_RENDER_KEY_MATERIAL_BITS;
+	const u32 layerShift    = programShift + LOGL_RENDER_KEY_PROGRAM_BITS;
+
+	u64 result = ((u64)(layer & ((1u << LOGL_RENDER_KEY_LAYER_BITS) - 1)) << layerShift) |
+	             ((u64)(program & ((1u << LOGL_RENDER_KEY_PROGRAM_BITS) - 1)) << programShift) |
+	             ((u64)(material & ((1u << LOGL_RENDER_KEY_MATERIAL_BITS) - 1)) << materialShift) |
+	             ((u64)depthBits << depthShift);
+	return result;
+}
+
+bool LOGLRenderQueue_Init(LOGLRenderQueue *const queue, DqnMemStack *const arena, const u32 maxPackets)
+{
+	*queue          = {};
+	queue->packets  = (LOGLRenderPacket *)arena->Push(sizeof(*queue->packets) * maxPackets);
+	queue->entries  = (DqnSortKeyU64 *)arena->Push(sizeof(*queue->entries) * maxPackets);
+	queue->scratch  = (DqnSortKeyU64 *)arena->Push(sizeof(*queue->scratch) * maxPackets);
+	if (!queue->packets || !queue->entries || !queue->scratch)
+	{
+		*queue = {};
+		return false;
+	}
+
+	queue->maxPackets = maxPackets;
+	return true;
+}
+
+LOGLRenderPacket *LOGLRenderQueue_Submit(LOGLRenderQueue *const queue, const u64 key)
+{
+	if (queue->numPackets >= queue->maxPackets) return NULL;
+
+	DqnSortKeyU64 *entry = &queue->entries[queue->numPackets];
+	entry->key           = key;
+	entry->index         = queue->numPackets;
+
+	LOGLRenderPacket *result = &queue->packets[queue->numPackets++];
+	*result                  = {};
+	return result;
+}
+
+void LOGLRenderQueue_Sort(LOGLRenderQueue *const queue)
+{
+	Dqn_RadixSort(queue->entries, queue->numPackets, queue->scratch);
+}
@@ -0,0 +1,58 @@
+#ifndef LOGL_RENDER_QUEUE_H
+#define LOGL_RENDER_QUEUE_H
+
+#include "dqn.h"
+
+// Draws are submitted as packets with a 64 bit sort key instead of being issued as they're
+// generated. Sorting the keys orders the draws by layer, then program, then material, then depth, so
+// executing them in order changes each piece of state as few times as it can be and the state cache
+// filters the rest. Keys are sorted with Dqn_RadixSort(), which skips the passes where every key has the
+// same digit so the unused high bits of a small scene cost nothing.
+//
+// Key layout, most significant bits first:
+// | layer 4 | program 8 | material 20 | depth 32 |
+
+#define LOGL_RENDER_KEY_LAYER_BITS    4
+#define LOGL_RENDER_KEY_PROGRAM_BITS  8
+#define LOGL_RENDER_KEY_MATERIAL_BITS 20
+#define LOGL_RENDER_KEY_DEPTH_BITS    32
+DQN_COMPILE_ASSERT(LOGL_RENDER_KEY_LAYER_BITS + LOGL_RENDER_KEY_PROGRAM_BITS + LOGL_RENDER_KEY_MATERIAL_BITS +
+                   LOGL_RENDER_KEY_DEPTH_BITS == 64);
+
+struct LOGLMaterial;
+
+// Everything to issue one instanced draw of the indexed mesh in vao
+struct LOGLRenderPacket
+{
+	u32                        program;  // The caller's index of the program to draw with
+	u32                        vao;
+	u32                        numIndices;
+	u32                        numInstances;
+	size_t                     instanceOffset; // Of the first instance in the frame arena's vbo
+	const struct LOGLMaterial *material;       // NULL to draw with the textures that are bound
+};
+
+struct LOGLRenderQueue
+{
+	LOGLRenderPacket *packets;    // In the order they were submitted
+	DqnSortKeyU64    *entries;    // Key and packet index, in key order after LOGLRenderQueue_Sort()
+	DqnSortKeyU64    *scratch;    // Sort buffer, the same size as entries
+	u32               numPackets;
+	u32               maxPackets;
+};
+
+// Lower layers draw first, depth should be the view distance so nearer draws are first in a layer.
+// Fields are masked to their bits and negative depths are drawn at 0.
+u64 LOGLRenderQueue_MakeKey(const u32 layer, const u32 program, const u32 material, const f32 depth);
+
+// Take room for maxPackets from arena, they live until the arena is popped, i.e. the end of the frame.
+// return: FALSE if the arena ran out of memory, the queue then accepts no packets.
+bool LOGLRenderQueue_Init(LOGLRenderQueue *const queue, DqnMemStack *const arena, const u32 maxPackets);
+
+// return: The packet to fill in, NULL if the queue is full.
+LOGLRenderPacket *LOGLRenderQueue_Submit(LOGLRenderQueue *const queue, const u64 key);
+
+// Stable sort of entries by key, packets with the same key keep the order they were submitted in.
+void LOGLRenderQueue_Sort(LOGLRenderQueue *const queue);
+
+#endif
@@ -0,0 +1,340 @@
+#include "LOGL.h"
+#include "LOGLShader.h"
+#include "OpenGL.h"
+
+#define DQN_PLATFORM_HEADER // For DqnFile, DqnTimer
+#include "dqn.h"
+
+#include <stdio.h>  // For printf(), snprintf()
+#include <string.h> // For memcpy()
+
+enum LOGLShaderInternalType
+{
+	LOGLShaderInternalType_Vertex,
+	LOGLShaderInternalType_Fragment,
+};
+
+FILE_SCOPE u32 LOGLShaderInternal_Compile(const char *const srcCode, const enum LOGLShaderInternalType type)
+{
+	u32 result = glCreateShader((type == LOGLShaderInternalType_Vertex) ? GL_VERTEX_SHADER : GL_FRAGMENT_SHADER);
+
+	GLchar *src = (GLchar *)srcCode;
+	glShaderSource(result, 1, &src, NULL);
+	glCompileShader(result);
+	return result;
+}
+
+// return: FALSE if the shader failed to compile, its log is printed.
+FILE_SCOPE bool LOGLShaderInternal_CheckCompile(const u32 shader, const char *const name, const char *const stage)
+{
+	i32 success;
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+	if (!success)
+	{
+		char infoLog[2048] = {};
+		glGetShaderInfoLog(shader, DQN_ARRAY_COUNT(infoLog), NULL, infoLog);
+		printf("LOGLShader: %s %s shader failed to compile:\n%s\n", name, stage, infoLog);
+	}
+
+	return success;
+}
+
+FILE_SCOPE void LOGLShaderInternal_EndBuild(LOGLShaderBuild *const build, const enum LOGLShaderBuildState state)
+{
+	// NOTE: Attached shaders are only flagged for deletion, they go when the program does
+	if (build->vertexShader)   glDeleteShader(build->vertexShader);
+	if (build->fragmentShader) glDeleteShader(build->fragmentShader);
+	build->vertexShader   = 0;
+	build->fragmentShader = 0;
+
+	if (state == LOGLShaderBuildState_Failed)
+	{
+		glDeleteProgram(build->program);
+		build->program = 0;
+	}
+	build->state = state;
+}
+
+// return: FALSE if there's no binary for sourceHash or it came from another driver, which is counted.
+FILE_SCOPE bool LOGLShaderInternal_ReadBinary(LOGLShaderCache *const cache, DqnMemStack *const tempStack,
+                                              const char *const path, const u64 sourceHash,
+                                              LOGLShaderBinaryHeader *const header, u8 **const binary)
+{
+	size_t fileSize;
+	if (!DqnFile_GetFileSize(path, &fileSize) || fileSize < sizeof(*header)) return false;
+
+	u8 *bytes = (u8 *)tempStack->Push(fileSize);
+	size_t bytesRead;
+	if (!bytes || !DqnFile_ReadEntireFile(path, bytes, fileSize, &bytesRead) || bytesRead != fileSize)
+		return false;
+
+	memcpy(header, bytes, sizeof(*header));
+	if (header->magic != LOGL_SHADER_BINARY_MAGIC || header->version != LOGL_SHADER_BINARY_VERSION ||
+	    header->sourceHash != sourceHash || header->binarySize != fileSize - sizeof(*header))
+	{
+		return false;
+	}
+
+	if (header->driverHash != cache->driverHash)
+	{
+		cache->stats.numDriverMismatches++;
+		return false;
+	}
+
+	*binary = bytes + sizeof(*header);
+	return true;
+}
+
+FILE_SCOPE void LOGLShaderInternal_WriteBinary(const LOGLShaderCache *const cache, DqnMemStack *const tempStack,
+                                               const char *const path, const u64 sourceHash, const u32 program)
+{
+	i32 binarySize = 0;
+	glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binarySize);
+	if (binarySize <= 0) return;
+
+	LOGLShaderBinaryHeader header = {};
+	size_t fileSize               = sizeof(header) + (size_t)binarySize;
+	u8 *bytes                     = (u8 *)tempStack->Push(fileSize);
+	if (!bytes) return;
+
+	GLsizei length      = 0;
+	GLenum binaryFormat = 0;
+	glGetProgramBinary(program, binarySize, &length, &binaryFormat, bytes + sizeof(header));
+	if (length != binarySize) return;
+
+	header.magic        = LOGL_SHADER_BINARY_MAGIC;
+	header.version      = LOGL_SHADER_BINARY_VERSION;
+	header.sourceHash   = sourceHash;
+	header.driverHash   = cache->driverHash;
+	header.binaryFormat = binaryFormat;
+	header.binarySize   = (u32)binarySize;
+	memcpy(bytes, &header, sizeof(header));
+
+	// NOTE: A failed write only costs a compile next run, the binary is rewritten then
+	DqnFile file = {};
+	if (!DqnFile_Open(path, &file, DqnFilePermissionFlag_Write, DqnFileAction_ClearIfExist))
+	{
+		if (!DqnFile_Open(path, &file, DqnFilePermissionFlag_Write, DqnFileAction_CreateIfNotExist))
+			return;
+	}
+
+	DqnFile_Write(&file, bytes, fileSize, 0);
+	DqnFile_Close(&file);
+}
+
+void LOGLShader_InitCache(LOGLShaderCache *const cache, const char *const dir)
+{
+	*cache = {};
+
+	i32 numExtensions = 0;
+	glGetIntegerv(GL_NUM_EXTENSIONS, &numExtensions);
+	for (i32 i = 0; i < numExtensions && !cache->parallelCompile; i++)
+	{
+		const char *extension  = (const char *)glGetStringi(GL_EXTENSIONS, (GLuint)i);
+		cache->parallelCompile = (extension && DqnStr_Cmp(extension, "GL_KHR_parallel_shader_compile") == 0);
+	}
+
+	// NOTE: The binary functions are from GL 4.1, a 3.3 driver may not have them
+	if (!dir || !glGetProgramBinary || !glProgramBinary || !glProgramParameteri) return;
+	cache->dir = dir;
+
+	// NOTE: Binaries are only valid for the driver that made them, which these strings identify
+	const GLenum DRIVER_STRINGS[] = {GL_VENDOR, GL_RENDERER, GL_VERSION};
+	cache->driverHash             = LOGL_FNV1A_SEED;
+	for (u32 i = 0; i < DQN_ARRAY_COUNT(DRIVER_STRINGS); i++)
+	{
+		const char *str = (const char *)glGetString(DRIVER_STRINGS[i]);
+		if (!str) str = "";
+		cache->driverHash = LOGL_HashFNV1a(str, DqnStr_Len(str) + 1, cache->driverHash);
+	}
+}
+
+u64 LOGLShader_HashSources(const char *const vertexSrc, const char *const fragmentSrc)
+{
+	// NOTE: Hashing the null terminators keeps the boundary between the sources in the hash
+	u64 result = LOGL_HashFNV1a(vertexSrc, DqnStr_Len(vertexSrc) + 1);
+	result     = LOGL_HashFNV1a(fragmentSrc, DqnStr_Len(fragmentSrc) + 1, result);
+	return result;
+}
+
+FILE_SCOPE void LOGLShaderInternal_BinaryPath(const LOGLShaderCache *const cache, const u64 sourceHash,
+                                              char *const path, const size_t pathSize)
+{
+	snprintf(path, pathSize, "%s/%016llx.glbin", cache->dir, (unsigned long long)sourceHash);
+}
+
+void LOGLShader_BeginBuild(LOGLShaderCache *const cache, DqnMemStack *const tempStack, const char *const vertexSrc,
+                           const char *const fragmentSrc, LOGLShaderBuild *const build)
+{
+	f64 startTimeInMs = DqnTimer_NowInMs();
+	auto tempRegion   = tempStack->TempRegionGuard();
+
+	*build            = {};
+	build->sourceHash = LOGLShader_HashSources(vertexSrc, fragmentSrc);
+	build->program    = glCreateProgram();
+
+	if (cache->dir)
+	{
+		char path[512];
+		LOGLShaderInternal_BinaryPath(cache, build->sourceHash, path, sizeof(path));
+
+		LOGLShaderBinaryHeader header;
+		u8 *binary;
+		if (LOGLShaderInternal_ReadBinary(cache, tempStack, path, build->sourceHash, &header, &binary))
+		{
+			glProgramBinary(build->program, header.binaryFormat, binary, (GLsizei)header.binarySize);
+
+			i32 success;
+			glGetProgramiv(build->program, GL_LINK_STATUS, &success);
+			if (success)
+			{
+				cache->stats.numHits++;
+				cache->stats.msToBuild += DqnTimer_NowInMs() - startTimeInMs;
+				build->state = LOGLShaderBuildState_Linked;
+				return;
+			}
+
+			cache->stats.numRejected++;
+		}
+	}
+
+	// NOTE: Compile and link into the program a binary failed to load into without querying any
+	// status, which would wait for the driver to finish
+	cache->stats.numMisses++;
+	build->state          = LOGLShaderBuildState_Compiling;
+	build->vertexShader   = LOGLShaderInternal_Compile(vertexSrc, LOGLShaderInternalType_Vertex);
+	build->fragmentShader = LOGLShaderInternal_Compile(fragmentSrc, LOGLShaderInternalType_Fragment);
+	glAttachShader(build->program, build->vertexShader);
+	glAttachShader(build->program, build->fragmentShader);
+	if (cache->dir) glProgramParameteri(build->program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	glLinkProgram(build->program);
+
+	cache->stats.msToBuild += DqnTimer_NowInMs() - startTimeInMs;
+}
+
+bool LOGLShader_PollBuild(LOGLShaderCache *const cache, DqnMemStack *const tempStack, LOGLShaderBuild *const build,
+                          const char *const name, const bool wait)
+{
+	if (build->state != LOGLShaderBuildState_Compiling) return true;
+
+	if (!wait)
+	{
+		if (cache->parallelCompile)
+		{
+			i32 complete;
+			glGetProgramiv(build->program, GL_COMPLETION_STATUS_KHR, &complete);
+			if (!complete) return false;
+		}
+		else if (build->numPolls++ == 0)
+		{
+			return false;
+		}
+	}
+
+	f64 startTimeInMs = DqnTimer_NowInMs();
+	auto tempRegion   = tempStack->TempRegionGuard();
+
+	i32 success;
+	glGetProgramiv(build->program, GL_LINK_STATUS, &success);
+	if (success)
+	{
+		if (cache->dir)
+		{
+			char path[512];
+			LOGLShaderInternal_BinaryPath(cache, build->sourceHash, path, sizeof(path));
+			LOGLShaderInternal_WriteBinary(cache, tempStack, path, build->sourceHash, build->program);
+		}
+		LOGLShaderInternal_EndBuild(build, LOGLShaderBuildState_Linked);
+	}
+	else
+	{
+		// NOTE: A shader that didn't compile makes the link fail with no useful log, report the
+		// shader's log instead
+		if (LOGLShaderInternal_CheckCompile(build->vertexShader, name, "vertex") &&
+		    LOGLShaderInternal_CheckCompile(build->fragmentShader, name, "fragment"))
+		{
+			char infoLog[2048] = {};
+			glGetProgramInfoLog(build->program, DQN_ARRAY_COUNT(infoLog), NULL, infoLog);
+			printf("LOGLShader: %s failed to link:\n%s\n", name, infoLog);
+		}
+
+		cache->stats.numFailed++;
+		LOGLShaderInternal_EndBuild(build, LOGLShaderBuildState_Failed);
+	}
+
+	cache->stats.msToBuild += DqnTimer_NowInMs() - startTimeInMs;
+	return true;
+}
+
+void LOGLShader_CancelBuild(LOGLShaderBuild *const build)
+{
+	if (build->state == LOGLShaderBuildState_Compiling)
+		LOGLShaderInternal_EndBuild(build, LOGLShaderBuildState_Failed);
+	build->state = LOGLShaderBuildState_None;
+}
+
+FILE_SCOPE void LOGLShaderInternal_ClearUniforms(LOGLShaderUniforms *const uniforms)
+{
+	*uniforms = {};
+	for (u32 i = 0; i < DQN_ARRAY_COUNT(uniforms->slots); i++)
+		uniforms->slots[i].location = -1;
+}
+
+bool LOGLShader_ReflectUniforms(const u32 program, LOGLShaderUniforms *const uniforms)
+{
+	LOGLShaderUniformSlot found[LOGL_SHADER_MAX_UNIFORM_SLOTS / 2];
+	u32 numFound = 0;
+
+	i32 numActive = 0;
+	glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &numActive);
+	for (i32 i = 0; i < numActive && numFound < DQN_ARRAY_COUNT(found); i++)
+	{
+		char name[128];
+		GLsizei nameLen = 0;
+		GLint size;
+		GLenum type;
+		glGetActiveUniform(program, (GLuint)i, sizeof(name), &nameLen, &size, &type, name);
+		if (nameLen <= 0) continue;
+
+		i32 location = glGetUniformLocation(program, name);
+		if (location == -1) continue;
+
+		// NOTE: Arrays are reported as "name[0]", look them up by name like glGetUniformLocation()
+		if (nameLen > 3 && DqnStr_Cmp(name + nameLen - 3, "[0]") == 0) nameLen -= 3;
+
+		found[numFound].nameHash = LOGL_HashFNV1a(name, (size_t)nameLen);
+		found[numFound].location = location;
+		numFound++;
+	}
+
+	// NOTE: Try the smallest tables first, for each size try every window of the hash as the index
+	// until one puts each name in its own slot
+	LOGLShaderInternal_ClearUniforms(uniforms);
+	for (u32 numSlots = 1; numSlots <= LOGL_SHADER_MAX_UNIFORM_SLOTS; numSlots *= 2)
+	{
+		if (numSlots < numFound) continue;
+
+		u32 mask = numSlots - 1;
+		for (u32 shift = 0; shift < 64; shift++)
+		{
+			u64 usedSlots[LOGL_SHADER_MAX_UNIFORM_SLOTS / 64] = {};
+			bool collided = false;
+			for (u32 i = 0; i < numFound && !collided; i++)
+			{
+				u32 slot = (u32)(found[i].nameHash >> shift) & mask;
+				collided = (usedSlots[slot / 64] >> (slot % 64)) & 1;
+				usedSlots[slot / 64] |= (1ULL << (slot % 64));
+			}
+			if (collided) continue;
+
+			uniforms->mask        = mask;
+			uniforms->shift       = shift;
+			uniforms->numUniforms = numFound;
+			for (u32 i = 0; i < numFound; i++)
+				uniforms->slots[(found[i].nameHash >> shift) & mask] = found[i];
+			return true;
+		}
+	}
+
+	return false;
+}
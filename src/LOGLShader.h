@@ -0,0 +1,128 @@
+#ifndef LOGL_SHADER_H
+#define LOGL_SHADER_H
+
+#define DQN_PLATFORM_HEADER // For DqnTimer
+#include "dqn.h"
+
+// Shader programs built from GLSL source, with their linked binaries cached on disk across runs
+// through glGetProgramBinary(). A binary is keyed by the hash of the sources it was built from and
+// is only loaded if it came from the same driver, identified by the GL vendor, renderer and version
+// strings. A miss, a driver mismatch or a binary the driver rejects compiles the program from source
+// and rewrites the binary.
+//
+// Builds can be started and polled for later, so a rebuild doesn't stall the frame it was started
+// in. With KHR_parallel_shader_compile the driver compiles on its own threads and the build is done
+// once it reports completion, without it the link status is queried the frame after the build was
+// started, which is as long as a driver compiling in the background can be given.
+//
+// A linked program's uniforms are reflected into a table of name hash to location, so they're looked
+// up by a hash computed at compile time (see LOGL_UNIFORM()) and a new uniform in the GLSL needs no
+// code to query its location.
+
+#define LOGL_SHADER_BINARY_MAGIC   0x4C47534C // 'LSGL'
+#define LOGL_SHADER_BINARY_VERSION 1
+
+// Cached binary file, the header then binarySize bytes of program binary
+struct LOGLShaderBinaryHeader
+{
+	u32 magic;   // LOGL_SHADER_BINARY_MAGIC
+	u32 version; // LOGL_SHADER_BINARY_VERSION
+	u64 sourceHash;
+	u64 driverHash;
+	u32 binaryFormat;
+	u32 binarySize;
+};
+DQN_COMPILE_ASSERT(sizeof(LOGLShaderBinaryHeader) == 32);
+
+struct LOGLShaderCacheStats
+{
+	u32 numHits;
+	u32 numMisses;           // Programs compiled from source, including the two below
+	u32 numDriverMismatches; // Binaries that were cached by another driver
+	u32 numRejected;         // Binaries the driver failed to load
+	u32 numFailed;           // Programs that failed to compile or link
+	f64 msToBuild;           // Spent in the build calls on the calling thread, hits and misses
+};
+
+struct LOGLShaderCache
+{
+	const char          *dir; // NULL to always compile from source
+	u64                  driverHash;
+	bool                 parallelCompile; // The GL has KHR_parallel_shader_compile
+	LOGLShaderCacheStats stats;
+};
+
+enum LOGLShaderBuildState
+{
+	LOGLShaderBuildState_None,
+	LOGLShaderBuildState_Compiling,
+	LOGLShaderBuildState_Linked,
+	LOGLShaderBuildState_Failed, // The program has been deleted and the errors printed
+};
+
+struct LOGLShaderBuild
+{
+	enum LOGLShaderBuildState state;
+	u32                       program;
+	u64                       sourceHash; // See LOGLShader_HashSources()
+	u32                       vertexShader;
+	u32                       fragmentShader;
+	u32                       numPolls;
+};
+
+#define LOGL_SHADER_MAX_UNIFORM_SLOTS 128
+
+struct LOGLShaderUniformSlot
+{
+	u64 nameHash; // LOGL_HashFNV1a() of the name, arrays by their name without "[0]"
+	i32 location; // -1 if the slot is empty
+};
+
+// Perfect hash of the program's default block uniforms, a name is in slot (nameHash >> shift) & mask
+// and no two names share a slot.
+struct LOGLShaderUniforms
+{
+	LOGLShaderUniformSlot slots[LOGL_SHADER_MAX_UNIFORM_SLOTS];
+	u32                   mask;
+	u32                   shift;
+	u32                   numUniforms;
+};
+
+// dir: Directory binaries are read from and written to, it must exist. NULL to always compile from
+//      source, which is also what happens if the GL has no program binary functions.
+void LOGLShader_InitCache(LOGLShaderCache *const cache, const char *const dir);
+
+// return: The hash a program's binary is cached by, to tell if its sources have changed.
+u64 LOGLShader_HashSources(const char *const vertexSrc, const char *const fragmentSrc);
+
+// Start building a program from a vertex and fragment shader. A program the cache has a binary of
+// is Linked on return, otherwise it's Compiling until LOGLShader_PollBuild() says it's done. The
+// sources are copied by GL and can be freed on return.
+// tempStack: Holds the binary while it's read, released before returning.
+void LOGLShader_BeginBuild(LOGLShaderCache *const cache, DqnMemStack *const tempStack, const char *const vertexSrc,
+                           const char *const fragmentSrc, LOGLShaderBuild *const build);
+
+// Finish a build that's done compiling, writing the binary of a program that linked to the cache.
+// Compile and link errors are printed with the name of the build.
+// wait: Block until the build is done instead of returning if it's still compiling.
+// return: TRUE if the build is Linked or Failed, FALSE if it's still Compiling.
+bool LOGLShader_PollBuild(LOGLShaderCache *const cache, DqnMemStack *const tempStack, LOGLShaderBuild *const build,
+                          const char *const name, const bool wait);
+
+// Abandon a build that's still compiling, deleting its program.
+void LOGLShader_CancelBuild(LOGLShaderBuild *const build);
+
+// Fill uniforms with the locations of a linked program's uniforms. Uniforms in blocks have no
+// location and are left out, as are any past LOGL_SHADER_MAX_UNIFORM_SLOTS / 2.
+// return: FALSE if no table size could hash every name to its own slot, the table is left empty.
+bool LOGLShader_ReflectUniforms(const u32 program, LOGLShaderUniforms *const uniforms);
+
+// nameHash: LOGL_UNIFORM() of the name
+// return: The uniform's location, -1 if the program has no such uniform, which GL ignores.
+inline i32 LOGLShader_Uniform(const LOGLShaderUniforms *const uniforms, const u64 nameHash)
+{
+	const LOGLShaderUniformSlot *slot = &uniforms->slots[(nameHash >> uniforms->shift) & uniforms->mask];
+	return (slot->nameHash == nameHash) ? slot->location : -1;
+}
+
+#endif
@@ -0,0 +1,181 @@
+#include "LOGLStateCache.h"
+#include "OpenGL.h"
+
+#include "dqn.h"
+
+#include <string.h> // For memcmp(), memcpy()
+
+void LOGLStateCache_InvalidateBindings(LOGLStateCache *const cache)
+{
+	cache->program       = LOGL_STATE_CACHE_UNKNOWN;
+	cache->vao           = LOGL_STATE_CACHE_UNKNOWN;
+	cache->activeTexture = LOGL_STATE_CACHE_UNKNOWN;
+	cache->arrayBuffer   = LOGL_STATE_CACHE_UNKNOWN;
+	cache->uniformBuffer = LOGL_STATE_CACHE_UNKNOWN;
+	cache->polygonMode   = LOGL_STATE_CACHE_UNKNOWN;
+	for (u32 i = 0; i < LOGL_STATE_CACHE_TEXTURE_UNITS; i++)
+		cache->textures[i] = LOGL_STATE_CACHE_UNKNOWN;
+}
+
+// return: TRUE if the shadowed state was already value, otherwise it's updated and the call should
+// be issued. Counts the call either way.
+FILE_SCOPE bool LOGLStateCacheInternal_Filter(LOGLStateCache *const cache, u32 *const shadow, const u32 value)
+{
+	if (*shadow == value)
+	{
+		cache->stats.numFiltered++;
+		return true;
+	}
+
+	*shadow = value;
+	cache->stats.numIssued++;
+	return false;
+}
+
+void LOGLStateCache_UseProgram(LOGLStateCache *const cache, const u32 program)
+{
+	if (!LOGLStateCacheInternal_Filter(cache, &cache->program, program)) glUseProgram(program);
+}
+
+void LOGLStateCache_BindVertexArray(LOGLStateCache *const cache, const u32 vao)
+{
+	if (!LOGLStateCacheInternal_Filter(cache, &cache->vao, vao)) glBindVertexArray(vao);
+}
+
+void LOGLStateCache_PolygonMode(LOGLStateCache *const cache, const u32 mode)
+{
+	if (!LOGLStateCacheInternal_Filter(cache, &cache->polygonMode, mode)) glPolygonMode(GL_FRONT_AND_BACK, mode);
+}
+
+void LOGLStateCache_BindTexture(LOGLStateCache *const cache, const u32 unit, const u32 texture)
+{
+	if (!DQN_ASSERT(unit < LOGL_STATE_CACHE_TEXTURE_UNITS)) return;
+	if (LOGLStateCacheInternal_Filter(cache, &cache->textures[unit], texture)) return;
+
+	// NOTE: Only counted when it's issued, the binds on a unit that's already active don't need it
+	if (cache->activeTexture != unit)
+	{
+		cache->activeTexture = unit;
+		cache->stats.numIssued++;
+		glActiveTexture(GL_TEXTURE0 + unit);
+	}
+
+	glBindTexture(GL_TEXTURE_2D, texture);
+}
+
+void LOGLStateCache_BindBuffer(LOGLStateCache *const cache, const u32 target, const u32 buffer)
+{
+	u32 *shadow = NULL;
+	switch (target)
+	{
+		case GL_ARRAY_BUFFER:   shadow = &cache->arrayBuffer;   break;
+		case GL_UNIFORM_BUFFER: shadow = &cache->uniformBuffer; break;
+	}
+
+	if (shadow && LOGLStateCacheInternal_Filter(cache, shadow, buffer)) return;
+	if (!shadow) cache->stats.numIssued++;
+	glBindBuffer(target, buffer);
+}
+
+void LOGLStateCache_DeleteTexture(LOGLStateCache *const cache, const u32 texture)
+{
+	// NOTE: GL unbinds a deleted texture from every unit it's bound to
+	for (u32 i = 0; i < LOGL_STATE_CACHE_TEXTURE_UNITS; i++)
+	{
+		if (cache->textures[i] == texture) cache->textures[i] = 0;
+	}
+
+	glDeleteTextures(1, &texture);
+}
+
+void LOGLStateCache_DeleteProgram(LOGLStateCache *const cache, const u32 program)
+{
+	// NOTE: A bound program is only flagged for deletion so it stays bound, but its id can't be used
+	// to tell if the next program is bound
+	if (cache->program == program) cache->program = LOGL_STATE_CACHE_UNKNOWN;
+
+	// NOTE: Programs are only deleted when they're rebuilt, dropping every value is simpler than
+	// removing the program's from the open addressed table and costs one set of each
+	for (u32 i = 0; i < LOGL_STATE_CACHE_UNIFORMS; i++)
+		cache->uniforms[i].program = 0;
+	cache->numUniforms = 0;
+
+	glDeleteProgram(program);
+}
+
+// return: The uniform's slot for the bound program, NULL if the program isn't known or the table is
+// too full to add it.
+FILE_SCOPE LOGLStateCacheUniform *LOGLStateCacheInternal_FindUniform(LOGLStateCache *const cache, const i32 location)
+{
+	const u32 program = cache->program;
+	if (program == 0 || program == LOGL_STATE_CACHE_UNKNOWN) return NULL;
+
+	const u32 mask = LOGL_STATE_CACHE_UNIFORMS - 1;
+	u32 index      = ((program * 2654435761u) ^ (u32)location) & mask;
+	for (u32 probe = 0; probe < LOGL_STATE_CACHE_UNIFORMS; probe++, index = (index + 1) & mask)
+	{
+		LOGLStateCacheUniform *result = &cache->uniforms[index];
+		if (result->program == program && result->location == location) return result;
+		if (result->program != 0) continue;
+
+		// NOTE: Keep a quarter of the table free so probes stay short
+		if (cache->numUniforms >= (LOGL_STATE_CACHE_UNIFORMS / 4) * 3) return NULL;
+		cache->numUniforms++;
+		result->program  = program;
+		result->location = location;
+		result->size     = 0;
+		return result;
+	}
+
+	return NULL;
+}
+
+// return: TRUE if the uniform already has value and the call can be dropped.
+FILE_SCOPE bool LOGLStateCacheInternal_FilterUniform(LOGLStateCache *const cache, const i32 location,
+                                                     const void *const value, const u32 size)
+{
+	DQN_ASSERT(size <= LOGL_STATE_CACHE_UNIFORM_SIZE);
+	if (location == -1)
+	{
+		cache->stats.numFiltered++;
+		return true;
+	}
+
+	LOGLStateCacheUniform *uniform = LOGLStateCacheInternal_FindUniform(cache, location);
+	if (uniform && uniform->size == size && memcmp(uniform->value, value, size) == 0)
+	{
+		cache->stats.numFiltered++;
+		return true;
+	}
+
+	if (uniform)
+	{
+		uniform->size = size;
+		memcpy(uniform->value, value, size);
+	}
+
+	cache->stats.numIssued++;
+	return false;
+}
+
+void LOGLStateCache_Uniform1i(LOGLStateCache *const cache, const i32 location, const i32 value)
+{
+	if (!LOGLStateCacheInternal_FilterUniform(cache, location, &value, sizeof(value))) glUniform1i(location, value);
+}
+
+void LOGLStateCache_Uniform1f(LOGLStateCache *const cache, const i32 location, const f32 value)
+{
+	if (!LOGLStateCacheInternal_FilterUniform(cache, location, &value, sizeof(value))) glUniform1f(location, value);
+}
+
+void LOGLStateCache_Uniform3fv(LOGLStateCache *const cache, const i32 location, const f32 *const value)
+{
+	if (!LOGLStateCacheInternal_FilterUniform(cache, location, value, sizeof(*value) * 3))
+		glUniform3fv(location, 1, value);
+}
+
+void LOGLStateCache_UniformMatrix4fv(LOGLStateCache *const cache, const i32 location, const f32 *const value)
+{
+	if (!LOGLStateCacheInternal_FilterUniform(cache, location, value, sizeof(*value) * 16))
+		glUniformMatrix4fv(location, 1, GL_FALSE, value);
+}
@@ -0,0 +1,75 @@
+#ifndef LOGL_STATE_CACHE_H
+#define LOGL_STATE_CACHE_H
+
+#include "dqn.h"
+
+// Shadows the GL state the renderer sets every frame, the bound program, VAO, 2D textures on each
+// unit, array and uniform buffers, polygon mode and the default block uniforms of each program, so a
+// call that would set state to what it already is never reaches GL. Bindings are shadowed across
+// frames, a frame that draws what the last one did only issues the calls for what changed.
+//
+// GL state changed around the cache, like by a texture upload binding the texture it creates, makes
+// the shadow stale. LOGLStateCache_InvalidateBindings() after such code so the next binds are issued.
+
+#define LOGL_STATE_CACHE_UNKNOWN       0xFFFFFFFF // Binding that isn't known, the next bind is issued
+#define LOGL_STATE_CACHE_TEXTURE_UNITS 8
+#define LOGL_STATE_CACHE_UNIFORMS      64 // Uniform values shadowed, must be a power of 2
+#define LOGL_STATE_CACHE_UNIFORM_SIZE  64 // Largest uniform value shadowed, a mat4
+
+struct LOGLStateCacheStats
+{
+	u32 numIssued;   // Calls that changed state and were passed on to GL
+	u32 numFiltered; // Calls that set state to what it already was and were dropped
+};
+
+struct LOGLStateCacheUniform
+{
+	u32 program; // 0 if the slot is empty
+	i32 location;
+	u32 size;
+	u8  value[LOGL_STATE_CACHE_UNIFORM_SIZE];
+};
+
+struct LOGLStateCache
+{
+	u32 program;
+	u32 vao;
+	u32 activeTexture; // Unit index, not the GL_TEXTUREi enum
+	u32 textures[LOGL_STATE_CACHE_TEXTURE_UNITS];
+	u32 arrayBuffer;
+	u32 uniformBuffer;
+	u32 polygonMode;
+
+	// Open addressed by program and location
+	LOGLStateCacheUniform uniforms[LOGL_STATE_CACHE_UNIFORMS];
+	u32                   numUniforms;
+
+	LOGLStateCacheStats stats; // Reset by the caller, i.e. each frame
+};
+
+// Forget every binding, the uniform values are kept as they belong to the programs. Also how the
+// cache is initialised, after zero clearing it.
+void LOGLStateCache_InvalidateBindings(LOGLStateCache *const cache);
+
+void LOGLStateCache_UseProgram     (LOGLStateCache *const cache, const u32 program);
+void LOGLStateCache_BindVertexArray(LOGLStateCache *const cache, const u32 vao);
+void LOGLStateCache_PolygonMode    (LOGLStateCache *const cache, const u32 mode); // For GL_FRONT_AND_BACK
+
+// Bind a 2D texture to unit, only making unit the active texture if the binding has to change.
+void LOGLStateCache_BindTexture(LOGLStateCache *const cache, const u32 unit, const u32 texture);
+
+// GL_ARRAY_BUFFER and GL_UNIFORM_BUFFER are shadowed, other targets are passed straight on.
+void LOGLStateCache_BindBuffer(LOGLStateCache *const cache, const u32 target, const u32 buffer);
+
+// Delete through the cache so an id GL reuses for a new object isn't taken to be bound already, or to
+// have the uniform values of the program it used to name.
+void LOGLStateCache_DeleteTexture(LOGLStateCache *const cache, const u32 texture);
+void LOGLStateCache_DeleteProgram(LOGLStateCache *const cache, const u32 program);
+
+// Set a uniform of the bound program. Location -1 is filtered as GL would ignore it.
+void LOGLStateCache_Uniform1i       (LOGLStateCache *const cache, const i32 location, const i32 value);
+void LOGLStateCache_Uniform1f       (LOGLStateCache *const cache, const i32 location, const f32 value);
+void LOGLStateCache_Uniform3fv      (LOGLStateCache *const cache, const i32 location, const f32 *const value);
+void LOGLStateCache_UniformMatrix4fv(LOGLStateCache *const cache, const i32 location, const f32 *const value);
+
+#endif
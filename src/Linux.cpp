@@ -0,0 +1,1275 @@
+#include "LOGL.h"
+#include "LOGLBench.h"
+#include "LOGLPlatform.h"
+#include "OpenGL.h"
+#include "OpenGLRecorder.h"
+
+#define DQN_IMPLEMENTATION
+#define DQN_PLATFORM_HEADER
+#define DQN_UNIX_IMPLEMENTATION
+#include "dqn.h"
+
+#include <X11/XKBlib.h>  // For XkbSetDetectableAutoRepeat()
+#include <X11/keysym.h>
+#include <math.h>        // For INFINITY
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>      // For memcpy()
+#include <unistd.h>      // For usleep(), sysconf()
+#include <fcntl.h>       // For open()
+#include <sys/mman.h>    // For mmap()
+#include <sys/stat.h>    // For fstat(), mkdir()
+#include <errno.h>       // For errno
+#include <sys/inotify.h> // For inotify_init1(), inotify_add_watch()
+
+glXCreateContextAttribsARBProc *glXCreateContextAttribsARB;
+
+// GL 1.1
+glGetErrorProc       *glGetError;
+glGetStringProc      *glGetString;
+glGetIntegervProc    *glGetIntegerv;
+glClearProc          *glClear;
+glClearColorProc     *glClearColor;
+glEnableProc         *glEnable;
+glDisableProc        *glDisable;
+glPolygonModeProc    *glPolygonMode;
+glViewportProc       *glViewport;
+glPixelStoreiProc    *glPixelStorei;
+glDrawArraysProc     *glDrawArrays;
+glGenTexturesProc    *glGenTextures;
+glDeleteTexturesProc *glDeleteTextures;
+glBindTextureProc    *glBindTexture;
+glTexParameteriProc  *glTexParameteri;
+glTexImage2DProc     *glTexImage2D;
+
+// GL 1.3
+glActiveTextureProc        *glActiveTexture;
+glCompressedTexImage2DProc *glCompressedTexImage2D;
+
+// GL 1.5
+glGenBuffersProc    *glGenBuffers;
+glBindBufferProc    *glBindBuffer;
+glBufferDataProc    *glBufferData;
+glBufferSubDataProc *glBufferSubData;
+glUnmapBufferProc   *glUnmapBuffer;
+
+// GL 2.0
+glCreateShaderProc             *glCreateShader;
+glShaderSourceProc             *glShaderSource;
+glCompileShaderProc            *glCompileShader;
+glGetShaderivProc              *glGetShaderiv;
+glGetShaderInfoLogProc         *glGetShaderInfoLog;
+glCreateProgramProc            *glCreateProgram;
+glAttachShaderProc             *glAttachShader;
+glLinkProgramProc              *glLinkProgram;
+glUseProgramProc               *glUseProgram;
+glDeleteShaderProc             *glDeleteShader;
+glDeleteProgramProc            *glDeleteProgram;
+glGetProgramInfoLogProc        *glGetProgramInfoLog;
+glGetProgramivProc             *glGetProgramiv;
+glGetActiveUniformProc         *glGetActiveUniform;
+
+glGetUniformLocationProc       *glGetUniformLocation;
+glUniform1fProc                *glUniform1f;
+glUniform1iProc                *glUniform1i;
+glUniform3fProc                *glUniform3f;
+glUniform4fProc                *glUniform4f;
+glUniform3fvProc               *glUniform3fv;
+glUniformMatrix4fvProc         *glUniformMatrix4fv;
+
+glEnableVertexAttribArrayProc  *glEnableVertexAttribArray;
+glDisableVertexAttribArrayProc *glDisableVertexAttribArray;
+glVertexAttribPointerProc      *glVertexAttribPointer;
+
+// GL 3.0
+glGetStringiProc      *glGetStringi;
+glGenVertexArraysProc *glGenVertexArrays;
+glBindVertexArrayProc *glBindVertexArray;
+glGenerateMipmapProc  *glGenerateMipmap;
+glBindBufferBaseProc  *glBindBufferBase;
+glMapBufferRangeProc  *glMapBufferRange;
+
+// GL 3.1
+glGetUniformBlockIndexProc  *glGetUniformBlockIndex;
+glUniformBlockBindingProc   *glUniformBlockBinding;
+glDrawArraysInstancedProc   *glDrawArraysInstanced;
+glDrawElementsInstancedProc *glDrawElementsInstanced;
+
+// GL 3.2
+glFenceSyncProc      *glFenceSync;
+glClientWaitSyncProc *glClientWaitSync;
+glDeleteSyncProc     *glDeleteSync;
+
+// GL 3.3
+glVertexAttribDivisorProc *glVertexAttribDivisor;
+
+// GL 4.1
+glGetProgramBinaryProc  *glGetProgramBinary;
+glProgramBinaryProc     *glProgramBinary;
+glProgramParameteriProc *glProgramParameteri;
+
+FILE_SCOPE bool globalRunning = true;
+
+FILE_SCOPE inline void LinuxUpdateKey(PlatformKeyState *const key, const bool isDown)
+{
+	if (key->endedDown != isDown)
+	{
+		key->endedDown = isDown;
+		key->halfTransitionCount++;
+	}
+}
+
+FILE_SCOPE void LinuxProcessInputSeparately(Display *const display, const Window window,
+                                            const Atom wmDeleteWindow, PlatformInput *const input)
+{
+	DQN_ASSERT(input);
+	DqnV2 screenDim     = input->screenDim;
+	DqnV2 halfScreenDim = screenDim * 0.5f;
+
+	while (XPending(display))
+	{
+		XEvent event;
+		XNextEvent(display, &event);
+		switch (event.type)
+		{
+			case ClientMessage:
+			{
+				if ((Atom)event.xclient.data.l[0] == wmDeleteWindow) globalRunning = false;
+			}
+			break;
+
+			case ConfigureNotify:
+			{
+				glViewport(0, 0, event.xconfigure.width, event.xconfigure.height);
+			}
+			break;
+
+			case ButtonPress:
+			case ButtonRelease:
+			{
+				PlatformMouse *mouse = &input->mouse;
+
+				bool isDown = (event.type == ButtonPress);
+				if (event.xbutton.button == Button1)
+					LinuxUpdateKey(&mouse->leftBtn, isDown);
+				else if (event.xbutton.button == Button3)
+					LinuxUpdateKey(&mouse->rightBtn, isDown);
+			}
+			break;
+
+			case MotionNotify:
+			{
+				PlatformMouse *mouse = &input->mouse;
+				mouse->dx = event.xmotion.x;
+				mouse->dy = (i32)screenDim.h - event.xmotion.y;
+
+				mouse->dx -= (i32)halfScreenDim.w;
+				mouse->dy -= (i32)halfScreenDim.h;
+			}
+			break;
+
+			case KeyPress:
+			case KeyRelease:
+			{
+				bool isDown   = (event.type == KeyPress);
+				KeySym keySym = XLookupKeysym(&event.xkey, 0);
+				switch (keySym)
+				{
+					case XK_Up:    LinuxUpdateKey(&input->key_up, isDown);    break;
+					case XK_Down:  LinuxUpdateKey(&input->key_down, isDown);  break;
+					case XK_Left:  LinuxUpdateKey(&input->key_left, isDown);  break;
+					case XK_Right: LinuxUpdateKey(&input->key_right, isDown); break;
+
+					case XK_1: LinuxUpdateKey(&input->key_1, isDown); break;
+					case XK_2: LinuxUpdateKey(&input->key_2, isDown); break;
+					case XK_3: LinuxUpdateKey(&input->key_3, isDown); break;
+					case XK_4: LinuxUpdateKey(&input->key_4, isDown); break;
+
+					case XK_q: LinuxUpdateKey(&input->key_q, isDown); break;
+					case XK_w: LinuxUpdateKey(&input->key_w, isDown); break;
+					case XK_e: LinuxUpdateKey(&input->key_e, isDown); break;
+					case XK_r: LinuxUpdateKey(&input->key_r, isDown); break;
+
+					case XK_a: LinuxUpdateKey(&input->key_a, isDown); break;
+					case XK_s: LinuxUpdateKey(&input->key_s, isDown); break;
+					case XK_d: LinuxUpdateKey(&input->key_d, isDown); break;
+					case XK_f: LinuxUpdateKey(&input->key_f, isDown); break;
+
+					case XK_z: LinuxUpdateKey(&input->key_z, isDown); break;
+					case XK_x: LinuxUpdateKey(&input->key_x, isDown); break;
+					case XK_c: LinuxUpdateKey(&input->key_c, isDown); break;
+					case XK_v: LinuxUpdateKey(&input->key_v, isDown); break;
+
+					case XK_Escape:
+					{
+						if (isDown) globalRunning = false;
+					}
+					break;
+
+					default: break;
+				}
+			}
+			break;
+
+			default: break;
+		}
+	}
+
+	// TODO(doyle): Make capturing mouse toggleable.
+	// Reset mouse to center of screen
+	XWarpPointer(display, None, window, 0, 0, 0, 0, (i32)halfScreenDim.w, (i32)halfScreenDim.h);
+}
+
+// return: The resident set size of the process in kb, 0 if it could not be queried.
+FILE_SCOPE u32 LinuxGetResidentMemInKb()
+{
+	u32 result = 0;
+	FILE *handle = fopen("/proc/self/statm", "r");
+	if (handle)
+	{
+		unsigned long numPages, numResidentPages;
+		if (fscanf(handle, "%lu %lu", &numPages, &numResidentPages) == 2)
+			result = (u32)((numResidentPages * (unsigned long)sysconf(_SC_PAGESIZE)) / 1024);
+		fclose(handle);
+	}
+
+	return result;
+}
+
+// Map the whole file at path read only.
+// return: NULL if the file could not be opened, is empty or could not be mapped.
+FILE_SCOPE const u8 *LinuxMapFile(const char *const path, size_t *const size)
+{
+	i32 handle = open(path, O_RDONLY);
+	if (handle == -1) return NULL;
+
+	// NOTE: The mapping keeps the file alive, the handle isn't needed after mmap()
+	const u8 *result = NULL;
+	struct stat fileStat;
+	if (fstat(handle, &fileStat) == 0 && fileStat.st_size > 0)
+	{
+		void *memory = mmap(NULL, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, handle, 0);
+		if (memory != MAP_FAILED)
+		{
+			result = (const u8 *)memory;
+			*size  = (size_t)fileStat.st_size;
+		}
+	}
+
+	close(handle);
+	return result;
+}
+
+FILE_SCOPE void LinuxUnmapFile(const u8 *const memory, const size_t size)
+{
+	if (memory) munmap((void *)memory, size);
+}
+
+// return: A non-blocking inotify handle watching LOGL_SHADER_DIR for files being written, -1 if the
+// directory can't be watched.
+FILE_SCOPE i32 LinuxWatchShaderDir()
+{
+	i32 result = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (result == -1) return -1;
+
+	// NOTE: Editors that save by writing a temporary file and renaming it over the original show up
+	// as IN_MOVED_TO, the rest as IN_CLOSE_WRITE once the file is complete
+	if (inotify_add_watch(result, LOGL_SHADER_DIR, IN_CLOSE_WRITE | IN_MOVED_TO) == -1)
+	{
+		close(result);
+		return -1;
+	}
+
+	return result;
+}
+
+// return: TRUE if a file in the watched directory was written since the last call.
+FILE_SCOPE bool LinuxShaderDirChanged(const i32 watchHandle)
+{
+	if (watchHandle == -1) return false;
+
+	// NOTE: Drain every event, one save can be several and they all mean the same thing
+	bool result = false;
+	char events[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+	while (read(watchHandle, events, sizeof(events)) > 0)
+		result = true;
+
+	return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Null GL
+////////////////////////////////////////////////////////////////////////////////
+// A GL backend that does nothing, used by the headless mode so that the frame
+// loop can be driven without a display or GPU. Object creation hands out
+// increasing ids and every query reports success so LOGL_Update takes the same
+// path it does on a real context.
+FILE_SCOPE GLuint globalNullGLNextId = 1;
+
+FILE_SCOPE GLenum         LinuxNullGL_glGetError      (void)                                   { return GL_NO_ERROR; }
+FILE_SCOPE const GLubyte *LinuxNullGL_glGetString     (GLenum)                                 { return (const GLubyte *)"Null GL"; }
+FILE_SCOPE void           LinuxNullGL_glClear         (GLbitfield)                             { }
+FILE_SCOPE void           LinuxNullGL_glClearColor    (GLclampf, GLclampf, GLclampf, GLclampf) { }
+FILE_SCOPE void           LinuxNullGL_glEnable        (GLenum)                                 { }
+FILE_SCOPE void           LinuxNullGL_glDisable       (GLenum)                                 { }
+FILE_SCOPE void           LinuxNullGL_glPolygonMode   (GLenum, GLenum)                         { }
+FILE_SCOPE void           LinuxNullGL_glViewport      (GLint, GLint, GLsizei, GLsizei)         { }
+FILE_SCOPE void           LinuxNullGL_glPixelStorei   (GLenum, GLint)                          { }
+FILE_SCOPE void           LinuxNullGL_glDrawArrays    (GLenum, GLint, GLsizei)                 { }
+FILE_SCOPE void           LinuxNullGL_glDeleteTextures(GLsizei, const GLuint *)                { }
+FILE_SCOPE void           LinuxNullGL_glBindTexture   (GLenum, GLuint)                         { }
+FILE_SCOPE void           LinuxNullGL_glTexParameteri (GLenum, GLenum, GLint)                  { }
+FILE_SCOPE void           LinuxNullGL_glTexImage2D    (GLenum, GLint, GLint, GLsizei, GLsizei, GLint, GLenum, GLenum, const void *) { }
+
+FILE_SCOPE void LinuxNullGL_GenIds(GLsizei n, GLuint *ids)
+{
+	for (GLsizei i = 0; i < n; i++)
+		ids[i] = globalNullGLNextId++;
+}
+
+FILE_SCOPE void LinuxNullGL_glActiveTexture       (GLenum)                                                          { }
+FILE_SCOPE void LinuxNullGL_glCompressedTexImage2D(GLenum, GLint, GLenum, GLsizei, GLsizei, GLint, GLsizei, const void *) { }
+
+FILE_SCOPE void LinuxNullGL_glBindBuffer   (GLenum, GLuint)                               { }
+FILE_SCOPE void LinuxNullGL_glBufferData   (GLenum, GLsizeiptr, const void *, GLenum)     { }
+FILE_SCOPE void LinuxNullGL_glBufferSubData(GLenum, GLintptr, GLsizeiptr, const void *)   { }
+FILE_SCOPE GLboolean LinuxNullGL_glUnmapBuffer(GLenum) { return GL_TRUE; }
+
+FILE_SCOPE GLuint LinuxNullGL_glCreateObject      (void)                                       { return globalNullGLNextId++; }
+FILE_SCOPE GLuint LinuxNullGL_glCreateShader      (GLenum)                                     { return globalNullGLNextId++; }
+FILE_SCOPE void   LinuxNullGL_glShaderSource      (GLuint, GLsizei, GLchar **, const GLint *)  { }
+FILE_SCOPE void   LinuxNullGL_glObject            (GLuint)                                     { }
+FILE_SCOPE void   LinuxNullGL_glAttachShader      (GLuint, GLuint)                             { }
+FILE_SCOPE void   LinuxNullGL_glGetObjectiv       (GLuint, GLenum, GLint *params)              { *params = GL_TRUE; }
+FILE_SCOPE void   LinuxNullGL_glGetObjectInfoLog  (GLuint, GLsizei, GLsizei *length, GLchar *) { if (length) *length = 0; }
+
+FILE_SCOPE GLint  LinuxNullGL_glGetUniformLocation(GLuint, const GLchar *)                     { return (GLint)globalNullGLNextId++; }
+FILE_SCOPE void   LinuxNullGL_glUniform1f         (GLint, GLfloat)                             { }
+FILE_SCOPE void   LinuxNullGL_glUniform1i         (GLint, GLint)                               { }
+FILE_SCOPE void   LinuxNullGL_glUniform3f         (GLint, GLfloat, GLfloat, GLfloat)           { }
+FILE_SCOPE void   LinuxNullGL_glUniform4f         (GLint, GLfloat, GLfloat, GLfloat, GLfloat)  { }
+FILE_SCOPE void   LinuxNullGL_glUniform3fv        (GLint, GLsizei, const GLfloat *)            { }
+FILE_SCOPE void   LinuxNullGL_glUniformMatrix4fv  (GLint, GLsizei, GLboolean, const GLfloat *) { }
+
+FILE_SCOPE void LinuxNullGL_glVertexAttribArray (GLuint)                                                     { }
+FILE_SCOPE void LinuxNullGL_glVertexAttribPointer(GLuint, GLint, GLenum, GLboolean, GLsizei, const void *) { }
+
+// NOTE: Reports KHR_parallel_shader_compile so shader rebuilds take the polling path headless, the
+// completion status is always GL_TRUE like every other query
+FILE_SCOPE const char LINUX_NULL_GL_EXTENSION[] = "GL_KHR_parallel_shader_compile";
+FILE_SCOPE void LinuxNullGL_glGetIntegerv(GLenum pname, GLint *data)
+{
+	*data = (pname == GL_NUM_EXTENSIONS) ? 1 : 0;
+}
+
+FILE_SCOPE const GLubyte *LinuxNullGL_glGetStringi(GLenum name, GLuint index)
+{
+	return (name == GL_EXTENSIONS && index == 0) ? (const GLubyte *)LINUX_NULL_GL_EXTENSION : NULL;
+}
+
+FILE_SCOPE void LinuxNullGL_glBindVertexArray(GLuint)                 { }
+FILE_SCOPE void LinuxNullGL_glGenerateMipmap (GLenum)                 { }
+FILE_SCOPE void LinuxNullGL_glBindBufferBase (GLenum, GLuint, GLuint) { }
+
+// NOTE: Mapped writes go to a scratch block that grows to fit the largest mapping and is never freed
+FILE_SCOPE void *LinuxNullGL_glMapBufferRange(GLenum, GLintptr, GLsizeiptr length, GLbitfield)
+{
+	LOCAL_PERSIST u8 *scratch            = NULL;
+	LOCAL_PERSIST GLsizeiptr scratchSize = 0;
+	if (length > scratchSize)
+	{
+		u8 *newScratch = (u8 *)DqnMem_Realloc(scratch, length);
+		if (!newScratch) return NULL;
+
+		scratch     = newScratch;
+		scratchSize = length;
+	}
+
+	return scratch;
+}
+
+FILE_SCOPE GLuint LinuxNullGL_glGetUniformBlockIndex (GLuint, const GLchar *)                           { return globalNullGLNextId++; }
+FILE_SCOPE void   LinuxNullGL_glUniformBlockBinding  (GLuint, GLuint, GLuint)                           { }
+FILE_SCOPE void   LinuxNullGL_glDrawArraysInstanced  (GLenum, GLint, GLsizei, GLsizei)                  { }
+FILE_SCOPE void   LinuxNullGL_glDrawElementsInstanced(GLenum, GLsizei, GLenum, const void *, GLsizei) { }
+
+// NOTE: There's no GPU to wait on, every fence is signalled as soon as it's made
+FILE_SCOPE GLsync LinuxNullGL_glFenceSync     (GLenum, GLbitfield)           { return (GLsync)(uintptr_t)globalNullGLNextId++; }
+FILE_SCOPE GLenum LinuxNullGL_glClientWaitSync(GLsync, GLbitfield, GLuint64) { return GL_ALREADY_SIGNALED; }
+FILE_SCOPE void   LinuxNullGL_glDeleteSync    (GLsync)                       { }
+
+FILE_SCOPE void LinuxNullGL_glVertexAttribDivisor(GLuint, GLuint) { }
+
+// NOTE: Hands out a fixed binary for every program and loads any binary, so the shader cache's hits
+// and misses can be exercised headless
+FILE_SCOPE const char LINUX_NULL_GL_PROGRAM_BINARY[] = "Null GL program";
+// NOTE: Programs have no active uniforms, so every uniform is looked up as -1 which GL ignores
+FILE_SCOPE void LinuxNullGL_glGetProgramiv(GLuint, GLenum pname, GLint *params)
+{
+	if      (pname == GL_PROGRAM_BINARY_LENGTH) *params = (GLint)sizeof(LINUX_NULL_GL_PROGRAM_BINARY);
+	else if (pname == GL_ACTIVE_UNIFORMS)       *params = 0;
+	else                                        *params = GL_TRUE;
+}
+
+FILE_SCOPE void LinuxNullGL_glGetActiveUniform(GLuint, GLuint, GLsizei, GLsizei *length, GLint *size, GLenum *type,
+                                               GLchar *name)
+{
+	if (length) *length = 0;
+	if (name) name[0] = 0;
+	*size = 0;
+	*type = 0;
+}
+
+FILE_SCOPE void LinuxNullGL_glGetProgramBinary(GLuint, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat,
+                                               void *binary)
+{
+	GLsizei size = DQN_MIN(bufSize, (GLsizei)sizeof(LINUX_NULL_GL_PROGRAM_BINARY));
+	memcpy(binary, LINUX_NULL_GL_PROGRAM_BINARY, size);
+	if (length) *length = size;
+	*binaryFormat = 0;
+}
+
+FILE_SCOPE void LinuxNullGL_glProgramBinary    (GLuint, GLenum, const void *, GLsizei) { }
+FILE_SCOPE void LinuxNullGL_glProgramParameteri(GLuint, GLenum, GLint)                 { }
+
+FILE_SCOPE void LinuxLoadNullGLFunctions()
+{
+	glGetError       = LinuxNullGL_glGetError;
+	glGetString      = LinuxNullGL_glGetString;
+	glGetIntegerv    = LinuxNullGL_glGetIntegerv;
+	glClear          = LinuxNullGL_glClear;
+	glClearColor     = LinuxNullGL_glClearColor;
+	glEnable         = LinuxNullGL_glEnable;
+	glDisable        = LinuxNullGL_glDisable;
+	glPolygonMode    = LinuxNullGL_glPolygonMode;
+	glViewport       = LinuxNullGL_glViewport;
+	glPixelStorei    = LinuxNullGL_glPixelStorei;
+	glDrawArrays     = LinuxNullGL_glDrawArrays;
+	glGenTextures    = LinuxNullGL_GenIds;
+	glDeleteTextures = LinuxNullGL_glDeleteTextures;
+	glBindTexture    = LinuxNullGL_glBindTexture;
+	glTexParameteri  = LinuxNullGL_glTexParameteri;
+	glTexImage2D     = LinuxNullGL_glTexImage2D;
+
+	glActiveTexture        = LinuxNullGL_glActiveTexture;
+	glCompressedTexImage2D = LinuxNullGL_glCompressedTexImage2D;
+
+	glGenBuffers    = LinuxNullGL_GenIds;
+	glBindBuffer    = LinuxNullGL_glBindBuffer;
+	glBufferData    = LinuxNullGL_glBufferData;
+	glBufferSubData = LinuxNullGL_glBufferSubData;
+	glUnmapBuffer   = LinuxNullGL_glUnmapBuffer;
+
+	glCreateShader      = LinuxNullGL_glCreateShader;
+	glShaderSource      = LinuxNullGL_glShaderSource;
+	glCompileShader     = LinuxNullGL_glObject;
+	glGetShaderiv       = LinuxNullGL_glGetObjectiv;
+	glGetShaderInfoLog  = LinuxNullGL_glGetObjectInfoLog;
+	glCreateProgram     = LinuxNullGL_glCreateObject;
+	glAttachShader      = LinuxNullGL_glAttachShader;
+	glLinkProgram       = LinuxNullGL_glObject;
+	glUseProgram        = LinuxNullGL_glObject;
+	glDeleteShader      = LinuxNullGL_glObject;
+	glDeleteProgram     = LinuxNullGL_glObject;
+	glGetProgramInfoLog = LinuxNullGL_glGetObjectInfoLog;
+	glGetProgramiv      = LinuxNullGL_glGetProgramiv;
+	glGetActiveUniform  = LinuxNullGL_glGetActiveUniform;
+
+	glGetUniformLocation = LinuxNullGL_glGetUniformLocation;
+	glUniform1f          = LinuxNullGL_glUniform1f;
+	glUniform1i          = LinuxNullGL_glUniform1i;
+	glUniform3f          = LinuxNullGL_glUniform3f;
+	glUniform4f          = LinuxNullGL_glUniform4f;
+	glUniform3fv         = LinuxNullGL_glUniform3fv;
+	glUniformMatrix4fv   = LinuxNullGL_glUniformMatrix4fv;
+
+	glEnableVertexAttribArray  = LinuxNullGL_glVertexAttribArray;
+	glDisableVertexAttribArray = LinuxNullGL_glVertexAttribArray;
+	glVertexAttribPointer      = LinuxNullGL_glVertexAttribPointer;
+
+	glGetStringi      = LinuxNullGL_glGetStringi;
+	glGenVertexArrays = LinuxNullGL_GenIds;
+	glBindVertexArray = LinuxNullGL_glBindVertexArray;
+	glGenerateMipmap  = LinuxNullGL_glGenerateMipmap;
+	glBindBufferBase  = LinuxNullGL_glBindBufferBase;
+	glMapBufferRange  = LinuxNullGL_glMapBufferRange;
+
+	glGetUniformBlockIndex  = LinuxNullGL_glGetUniformBlockIndex;
+	glUniformBlockBinding   = LinuxNullGL_glUniformBlockBinding;
+	glDrawArraysInstanced   = LinuxNullGL_glDrawArraysInstanced;
+	glDrawElementsInstanced = LinuxNullGL_glDrawElementsInstanced;
+
+	glFenceSync      = LinuxNullGL_glFenceSync;
+	glClientWaitSync = LinuxNullGL_glClientWaitSync;
+	glDeleteSync     = LinuxNullGL_glDeleteSync;
+
+	glVertexAttribDivisor = LinuxNullGL_glVertexAttribDivisor;
+
+	glGetProgramBinary  = LinuxNullGL_glGetProgramBinary;
+	glProgramBinary     = LinuxNullGL_glProgramBinary;
+	glProgramParameteri = LinuxNullGL_glProgramParameteri;
+}
+
+#define LINUX_GL_LOAD_FUNCTION(glFunction)                                                         \
+	do                                                                                             \
+	{                                                                                              \
+		glFunction = (glFunction##Proc *)(glXGetProcAddressARB((const GLubyte *)#glFunction));     \
+		DQN_ASSERT(glFunction);                                                                    \
+	} while (0)
+
+FILE_SCOPE void LinuxLoadGLFunctions()
+{
+	LINUX_GL_LOAD_FUNCTION(glGetError);
+	LINUX_GL_LOAD_FUNCTION(glGetString);
+	LINUX_GL_LOAD_FUNCTION(glGetIntegerv);
+	LINUX_GL_LOAD_FUNCTION(glClear);
+	LINUX_GL_LOAD_FUNCTION(glClearColor);
+	LINUX_GL_LOAD_FUNCTION(glEnable);
+	LINUX_GL_LOAD_FUNCTION(glDisable);
+	LINUX_GL_LOAD_FUNCTION(glPolygonMode);
+	LINUX_GL_LOAD_FUNCTION(glViewport);
+	LINUX_GL_LOAD_FUNCTION(glPixelStorei);
+	LINUX_GL_LOAD_FUNCTION(glDrawArrays);
+	LINUX_GL_LOAD_FUNCTION(glGenTextures);
+	LINUX_GL_LOAD_FUNCTION(glDeleteTextures);
+	LINUX_GL_LOAD_FUNCTION(glBindTexture);
+	LINUX_GL_LOAD_FUNCTION(glTexParameteri);
+	LINUX_GL_LOAD_FUNCTION(glTexImage2D);
+
+	LINUX_GL_LOAD_FUNCTION(glActiveTexture);
+	LINUX_GL_LOAD_FUNCTION(glCompressedTexImage2D);
+
+	LINUX_GL_LOAD_FUNCTION(glGenBuffers);
+	LINUX_GL_LOAD_FUNCTION(glBindBuffer);
+	LINUX_GL_LOAD_FUNCTION(glBufferData);
+	LINUX_GL_LOAD_FUNCTION(glBufferSubData);
+	LINUX_GL_LOAD_FUNCTION(glUnmapBuffer);
+	LINUX_GL_LOAD_FUNCTION(glCreateShader);
+	LINUX_GL_LOAD_FUNCTION(glShaderSource);
+	LINUX_GL_LOAD_FUNCTION(glCompileShader);
+	LINUX_GL_LOAD_FUNCTION(glGetShaderiv);
+	LINUX_GL_LOAD_FUNCTION(glGetShaderInfoLog);
+	LINUX_GL_LOAD_FUNCTION(glCreateProgram);
+	LINUX_GL_LOAD_FUNCTION(glAttachShader);
+	LINUX_GL_LOAD_FUNCTION(glLinkProgram);
+	LINUX_GL_LOAD_FUNCTION(glUseProgram);
+	LINUX_GL_LOAD_FUNCTION(glDeleteShader);
+	LINUX_GL_LOAD_FUNCTION(glDeleteProgram);
+	LINUX_GL_LOAD_FUNCTION(glGetProgramInfoLog);
+	LINUX_GL_LOAD_FUNCTION(glGetProgramiv);
+	LINUX_GL_LOAD_FUNCTION(glGetActiveUniform);
+
+	LINUX_GL_LOAD_FUNCTION(glGetUniformLocation);
+	LINUX_GL_LOAD_FUNCTION(glUniform1f);
+	LINUX_GL_LOAD_FUNCTION(glUniform1i);
+	LINUX_GL_LOAD_FUNCTION(glUniform3f);
+	LINUX_GL_LOAD_FUNCTION(glUniform4f);
+	LINUX_GL_LOAD_FUNCTION(glUniform3fv);
+	LINUX_GL_LOAD_FUNCTION(glUniformMatrix4fv);
+
+	LINUX_GL_LOAD_FUNCTION(glEnableVertexAttribArray);
+	LINUX_GL_LOAD_FUNCTION(glDisableVertexAttribArray);
+	LINUX_GL_LOAD_FUNCTION(glVertexAttribPointer);
+
+	LINUX_GL_LOAD_FUNCTION(glGetStringi);
+	LINUX_GL_LOAD_FUNCTION(glGenVertexArrays);
+	LINUX_GL_LOAD_FUNCTION(glBindVertexArray);
+	LINUX_GL_LOAD_FUNCTION(glGenerateMipmap);
+	LINUX_GL_LOAD_FUNCTION(glBindBufferBase);
+	LINUX_GL_LOAD_FUNCTION(glMapBufferRange);
+
+	LINUX_GL_LOAD_FUNCTION(glGetUniformBlockIndex);
+	LINUX_GL_LOAD_FUNCTION(glUniformBlockBinding);
+	LINUX_GL_LOAD_FUNCTION(glDrawArraysInstanced);
+	LINUX_GL_LOAD_FUNCTION(glDrawElementsInstanced);
+
+	LINUX_GL_LOAD_FUNCTION(glFenceSync);
+	LINUX_GL_LOAD_FUNCTION(glClientWaitSync);
+	LINUX_GL_LOAD_FUNCTION(glDeleteSync);
+
+	LINUX_GL_LOAD_FUNCTION(glVertexAttribDivisor);
+
+	LINUX_GL_LOAD_FUNCTION(glGetProgramBinary);
+	LINUX_GL_LOAD_FUNCTION(glProgramBinary);
+	LINUX_GL_LOAD_FUNCTION(glProgramParameteri);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Headless Frame Loop
+////////////////////////////////////////////////////////////////////////////////
+enum LinuxGLBackend
+{
+	LinuxGLBackend_Null,
+	LinuxGLBackend_Recorder,
+};
+
+typedef struct LinuxHeadlessConfig
+{
+	u32                 numFrames;
+	f32                 deltaForFrame;
+	enum LinuxGLBackend glBackend;
+	const char         *recordPath; // If set, the recorder's command log is written here on exit
+	const char         *replayPath; // If set, the GL recording is replayed instead of running LOGL_Update
+	i32                 shaderWatch; // See LinuxWatchShaderDir(), -1 if shaders aren't reloaded
+} LinuxHeadlessConfig;
+
+FILE_SCOPE void LinuxPrintGLStats(const char *const label, const GLRecorderFrameStats *const stats,
+                                  const f64 numFrames)
+{
+	f64 instancesPerDraw = (stats->numDrawCalls > 0) ? ((f64)stats->numInstances / stats->numDrawCalls) : 0;
+	printf("GL: %s - %5.1f calls/f - %5.1f draws/f - %5.1f instances/draw - %5.1f state changes/f - %'.0f bytes uploaded/f\n",
+	       label, stats->numCalls / numFrames, stats->numDrawCalls / numFrames, instancesPerDraw,
+	       stats->numStateChanges / numFrames, stats->numBytesUploaded / numFrames);
+}
+
+// Runs LOGL_Update for a fixed number of frames with a fixed delta and no window, then prints the
+// frame timings. Frame limiting is disabled so the timings are the raw cost of the update. With the
+// recorder backend the GL calls of each frame are also counted, so the numbers include the cost of
+// recording them.
+FILE_SCOPE i32 LinuxRunHeadless(PlatformInput *const input, PlatformMemory *const memory,
+                                const LinuxHeadlessConfig *const config)
+{
+	GLRecorder recorder = {};
+	if (config->glBackend == LinuxGLBackend_Recorder)
+	{
+		if (!GLRecorder_Init(&recorder, DQN_MEGABYTE(1)))
+		{
+			printf("GLRecorder_Init() failed\n");
+			return -1;
+		}
+		GLRecorder_LoadFunctions(&recorder);
+
+		// NOTE: A cached program binary would take the place of its GLSL in the log, which has to
+		// replay on any driver
+		memory->shaderCacheDir = NULL;
+	}
+	else
+	{
+		LinuxLoadNullGLFunctions();
+	}
+
+	GLRecorderReplay replay = {};
+	if (config->replayPath && !GLRecorderReplay_Open(&replay, config->replayPath))
+	{
+		printf("GLRecorderReplay_Open() failed to load: %s\n", config->replayPath);
+		return -1;
+	}
+
+	input->deltaForFrame = config->deltaForFrame;
+	bool keepLog         = (config->recordPath != NULL);
+
+	GLRecorderFrameStats totalStats = {};
+	GLRecorderFrameStats frameStats = {};
+	f64 totalTimeInMs  = 0;
+	f64 minTimeInMs    = DBL_MAX;
+	f64 maxTimeInMs    = 0;
+	u32 numFramesRun   = 0;
+	for (u32 frameIndex = 0; frameIndex < config->numFrames; frameIndex++)
+	{
+		f64 startFrameTimeInMs = DqnTimer_NowInMs();
+		if (config->replayPath)
+		{
+			if (!GLRecorderReplay_Frame(&replay)) break;
+		}
+		else
+		{
+			input->shadersChanged = LinuxShaderDirChanged(config->shaderWatch);
+			LOGL_Update(input, memory);
+		}
+		f64 frameTimeInMs = DqnTimer_NowInMs() - startFrameTimeInMs;
+		numFramesRun++;
+
+		if (config->glBackend == LinuxGLBackend_Recorder)
+			frameStats = GLRecorder_EndFrame(&recorder, keepLog);
+
+		// NOTE: The first frame initialises the app state, don't let it skew the steady state numbers
+		if (frameIndex == 0)
+		{
+			printf("Headless: init frame %5.3f ms\n", frameTimeInMs);
+			if (config->glBackend == LinuxGLBackend_Recorder)
+				LinuxPrintGLStats("init frame", &frameStats, 1);
+			continue;
+		}
+
+		totalTimeInMs += frameTimeInMs;
+		minTimeInMs    = DQN_MIN(minTimeInMs, frameTimeInMs);
+		maxTimeInMs    = DQN_MAX(maxTimeInMs, frameTimeInMs);
+
+		totalStats.numCalls         += frameStats.numCalls;
+		totalStats.numDrawCalls     += frameStats.numDrawCalls;
+		totalStats.numInstances     += frameStats.numInstances;
+		totalStats.numStateChanges  += frameStats.numStateChanges;
+		totalStats.numBytesUploaded += frameStats.numBytesUploaded;
+	}
+
+	if (numFramesRun > 1)
+	{
+		u32 numTimedFrames = numFramesRun - 1;
+		printf("Headless: %u frames, dt %5.4f s - avg %5.4f ms/f - min %5.4f ms/f - max %5.4f ms/f - resident mem %ukb\n",
+		       numTimedFrames, config->deltaForFrame, totalTimeInMs / numTimedFrames, minTimeInMs,
+		       maxTimeInMs, LinuxGetResidentMemInKb());
+
+		if (memory->state)
+		{
+			const LOGLRenderStats *renderStats = &memory->state->renderStats;
+			f64 instancesPerDraw = (renderStats->numDrawCalls > 0)
+			                           ? ((f64)renderStats->numInstances / renderStats->numDrawCalls)
+			                           : 0;
+			printf("Render: %u cubes - %u culled/f - %u draws/f - %u instances/f - %5.1f instances/draw - %u job threads\n",
+			       memory->state->numCubes, renderStats->numCulled, renderStats->numDrawCalls,
+			       renderStats->numInstances, instancesPerDraw, memory->numJobThreads);
+			printf("Render queue: %u packets/f - %u program/VAO/material changes/f\n", renderStats->numPackets,
+			       renderStats->numStateChanges);
+
+			const LOGLFrameArenaStats *arenaStats = &memory->frameArena.stats;
+			printf("Frame arena: %'zu bytes/f (peak %'zu of %'zu) + vbo %'zu bytes/f (peak %'zu of %'zu) x %d frames in "
+			       "flight - %u fence waits, %5.3f ms\n",
+			       arenaStats->used, arenaStats->highWaterMark, arenaStats->size, arenaStats->vboUsed,
+			       arenaStats->vboHighWaterMark, arenaStats->vboSize, LOGL_FRAME_ARENA_COUNT,
+			       arenaStats->numFenceWaits, arenaStats->msWaited);
+
+			const LOGLStateCacheStats *stateStats = &memory->state->glContext.stateCache.stats;
+			u32 numStateCalls = stateStats->numIssued + stateStats->numFiltered;
+			printf("State: %u binds/uniforms/f - %u issued, %u filtered (%4.1f%%)\n", numStateCalls,
+			       stateStats->numIssued, stateStats->numFiltered,
+			       (numStateCalls > 0) ? (100.0f * stateStats->numFiltered / numStateCalls) : 0.0f);
+
+			const LOGLMesh *mesh = &memory->state->cubeMesh;
+			const u32 cacheSize  = 16;
+			printf("Mesh: cube %u vertices, %u indices, %u bytes/vertex, ACMR %4.2f (FIFO %u)\n",
+			       mesh->numVertices, mesh->numIndices, (u32)sizeof(*mesh->vertices),
+			       LOGL_MeshACMR(mesh->indices, mesh->numIndices, cacheSize), cacheSize);
+
+			const LOGLAssetStats *assetStats = &memory->state->assetStats;
+			if (memory->state->numPendingTextures > 0)
+			{
+				printf("Assets: %u of %u textures still loading\n", memory->state->numPendingTextures,
+				       memory->state->textureCache.numEntries);
+			}
+			else
+			{
+				printf("Assets: %u textures loaded (%u from pack, %u compressed, %'llu bytes), %u failed - ready after "
+				       "%u frames, %5.3f ms\n",
+				       assetStats->numTexturesLoaded, assetStats->numTexturesFromPack, assetStats->numTexturesCompressed,
+				       (unsigned long long)assetStats->textureBytes, assetStats->numTexturesFailed,
+				       assetStats->numFramesToLoad, assetStats->msToLoad);
+			}
+
+			const LOGLTextureCache *cache           = &memory->state->textureCache;
+			const LOGLTextureCacheStats *cacheStats = &cache->stats;
+			printf("Textures: %u of %u resident, %'zu bytes (peak %'zu, budget %'zu) - %u hits, %u misses, "
+			       "%u evictions, %u re-streams\n",
+			       cacheStats->numResident, cache->numEntries, cacheStats->residentBytes, cacheStats->peakResidentBytes,
+			       cache->budget, cacheStats->numHits, cacheStats->numMisses, cacheStats->numEvictions,
+			       cacheStats->numRestreams);
+
+			const LOGLShaderCacheStats *shaderStats = &memory->state->shaderCache.stats;
+			const LOGLShaderReloadStats *reloadStats = &memory->state->shaderReloadStats;
+			printf("Shaders: %u hits, %u misses (%u driver mismatches, %u rejected), %u failed - %5.3f ms to build - "
+			       "%u reloads, %u failed\n",
+			       shaderStats->numHits, shaderStats->numMisses, shaderStats->numDriverMismatches,
+			       shaderStats->numRejected, shaderStats->numFailed, shaderStats->msToBuild,
+			       reloadStats->numReloads, reloadStats->numReloadsFailed);
+		}
+
+		if (config->glBackend == LinuxGLBackend_Recorder)
+		{
+			LinuxPrintGLStats("steady state", &totalStats, numTimedFrames);
+
+			printf("GL: last frame calls by function\n");
+			for (i32 cmd = 0; cmd < GLRecorderCmd_Count; cmd++)
+			{
+				u32 numCalls = frameStats.numCallsPerCmd[cmd];
+				if (numCalls > 0) printf("  %-28s %u\n", GLRecorder_CmdToStr((enum GLRecorderCmd)cmd), numCalls);
+			}
+		}
+	}
+
+	i32 result = 0;
+	if (config->recordPath)
+	{
+		if (GLRecorder_WriteToFile(&recorder, config->recordPath))
+		{
+			printf("GL: wrote %zu byte recording to %s\n", recorder.logSize, config->recordPath);
+		}
+		else
+		{
+			printf("GLRecorder_WriteToFile() failed to write: %s\n", config->recordPath);
+			result = -1;
+		}
+	}
+
+	GLRecorderReplay_Close(&replay);
+	GLRecorder_Free(&recorder);
+	return result;
+}
+
+// Cook the images into a pack at path, then map it back and print its contents as a check that the
+// runtime can read it.
+FILE_SCOPE i32 LinuxCookPack(PlatformMemory *const memory, const char *const path, char **const imagePaths,
+                             const u32 numImages, const enum LOGLBCQuality quality)
+{
+	auto memRegion = memory->mainStack.TempRegionGuard();
+	f32 *psnrs     = (f32 *)memory->mainStack.Push(sizeof(*psnrs) * DQN_MAX(numImages, 1u));
+	if (!psnrs) return -1;
+
+	f64 startTimeInMs = DqnTimer_NowInMs();
+	if (!LOGLPack_Cook(&memory->mainStack, &memory->tempStack, memory->jobQueue, imagePaths, numImages, path,
+	                   quality, psnrs))
+	{
+		printf("Cook: failed to cook %u images into %s\n", numImages, path);
+		return -1;
+	}
+	f64 cookTimeInMs = DqnTimer_NowInMs() - startTimeInMs;
+
+	size_t packSize;
+	const u8 *packData = LinuxMapFile(path, &packSize);
+	LOGLPack pack      = {};
+	if (!LOGLPack_Open(packData, packSize, &pack))
+	{
+		printf("Cook: %s was written but is not a valid pack\n", path);
+		LinuxUnmapFile(packData, packSize);
+		return -1;
+	}
+
+	const char *formatStr[LOGLPackFormat_Count] = {"Invalid", "R8", "RGB8", "RGBA8", "BC1", "BC3", "BC4", "BC5"};
+	for (u32 i = 0; i < pack.numTextures; i++)
+	{
+		const LOGLPackTexture *texture = &pack.textures[i];
+		u64 textureSize                = 0;
+		for (u32 mipIndex = 0; mipIndex < texture->numMips; mipIndex++)
+			textureSize += texture->mips[mipIndex].size;
+
+		// NOTE: The pack keeps the order the images were cooked in
+		char psnrStr[32] = "lossless";
+		if (psnrs[i] != INFINITY) snprintf(psnrStr, sizeof(psnrStr), "%5.2f dB", psnrs[i]);
+
+		printf("Cook: %-24s %4ux%-4u %-5s %2u mips %'9llu bytes, PSNR %s\n", texture->name,
+		       texture->mips[0].width, texture->mips[0].height, formatStr[texture->format], texture->numMips,
+		       (unsigned long long)textureSize, psnrStr);
+	}
+
+	printf("Cook: wrote %u textures to %s, %'zu bytes in %5.3f ms\n", pack.numTextures, path, packSize, cookTimeInMs);
+	LinuxUnmapFile(packData, packSize);
+	return 0;
+}
+
+FILE_SCOPE void LinuxPrintUsage(const char *const exeName)
+{
+	printf("Usage: %s [--headless <numFrames>] [--dt <secondsPerFrame>] [--gl null|record]\n"
+	       "          [--record <file>] [--replay <file>] [--cubes <numCubes>] [--threads <numThreads>]\n"
+	       "          [--pack <file>] [--cook <file> <image>...] [--bc off|fast|normal|high]\n"
+	       "          [--texture-budget <MB>] [--shader-cache <dir>|none] [--bench]\n", exeName);
+	printf("  --headless <numFrames>  Run numFrames of LOGL_Update with no window or GL context and print timings\n");
+	printf("  --dt <secondsPerFrame>  Fixed frame delta used in headless mode, default 1/60\n");
+	printf("  --gl null|record        GL backend used in headless mode, record counts every GL call per frame\n");
+	printf("  --record <file>         Write the headless GL command log to file, implies --gl record\n");
+	printf("  --replay <file>         Play back a GL command log instead of running the app. Headless replays\n"
+	       "                          into the recorder so its stats can be compared with the recording\n");
+	printf("  --cubes <numCubes>      Number of cubes in the scene, default 10\n");
+	printf("  --threads <numThreads>  Worker threads for frame jobs, default one less than the logical cores,\n"
+	       "                          0 to do all work on the main thread\n");
+	printf("  --pack <file>           Asset pack to upload cooked textures from, default textures.pack.\n"
+	       "                          Textures that aren't in it are decoded from their source images\n");
+	printf("  --cook <file> <image>...\n"
+	       "                          Decode the images and build their mips into an asset pack and exit,\n"
+	       "                          images are named by their path so cook from the data directory\n");
+	printf("  --bc off|fast|normal|high\n"
+	       "                          Block compress textures decoded at load and the images of --cook,\n"
+	       "                          trading encode time for quality, default off\n");
+	printf("  --texture-budget <MB>   Texture memory kept resident before the least recently used textures\n"
+	       "                          are evicted, default 0 for no limit\n");
+	printf("  --shader-cache <dir>|none\n"
+	       "                          Directory linked shader program binaries are cached in across runs,\n"
+	       "                          created if it doesn't exist, default shadercache\n");
+	printf("  --bench                 Run the CPU micro-benchmarks in LOGLBench.cpp and exit\n");
+}
+
+int main(int argc, char *argv[])
+{
+	////////////////////////////////////////////////////////////////////////////
+	// App Init
+	////////////////////////////////////////////////////////////////////////////
+	// Main Loop Config
+	const f32 TARGET_FRAMES_PER_S = 60.0f;
+	f32 targetSecondsPerFrame     = 1 / TARGET_FRAMES_PER_S;
+
+	// Window Config
+	const char WINDOW_TITLE[] = u8"LearnOpenGL";
+	const u32 BUFFER_WIDTH    = 800;
+	const u32 BUFFER_HEIGHT   = 600;
+
+	// Command line
+	bool runHeadless                   = false;
+	bool runBench                      = false;
+	u32 numCubes                       = 0;
+	enum LOGLBCQuality bcQuality       = LOGLBCQuality_None;
+	size_t textureBudget               = 0;
+	i32 numJobThreads                  = -1;
+	const char *packPath               = "textures.pack";
+	const char *shaderCacheDir         = "shadercache";
+	const char *cookPath               = NULL;
+	char **cookImagePaths              = NULL;
+	u32 numCookImages                  = 0;
+	LinuxHeadlessConfig headlessConfig = {};
+	headlessConfig.deltaForFrame       = targetSecondsPerFrame;
+	headlessConfig.glBackend           = LinuxGLBackend_Null;
+	for (i32 argIndex = 1; argIndex < argc; argIndex++)
+	{
+		const char *arg  = argv[argIndex];
+		bool hasNextArg  = (argIndex + 1 < argc);
+		if (DqnStr_Cmp(arg, "--headless") == 0 && hasNextArg)
+		{
+			const char *val          = argv[++argIndex];
+			runHeadless              = true;
+			headlessConfig.numFrames = (u32)Dqn_StrToI64(val, DqnStr_Len(val));
+		}
+		else if (DqnStr_Cmp(arg, "--dt") == 0 && hasNextArg)
+		{
+			const char *val              = argv[++argIndex];
+			headlessConfig.deltaForFrame = Dqn_StrToF32(val, DqnStr_Len(val));
+		}
+		else if (DqnStr_Cmp(arg, "--gl") == 0 && hasNextArg)
+		{
+			const char *val = argv[++argIndex];
+			if (DqnStr_Cmp(val, "null") == 0)
+			{
+				headlessConfig.glBackend = LinuxGLBackend_Null;
+			}
+			else if (DqnStr_Cmp(val, "record") == 0)
+			{
+				headlessConfig.glBackend = LinuxGLBackend_Recorder;
+			}
+			else
+			{
+				LinuxPrintUsage(argv[0]);
+				return -1;
+			}
+		}
+		else if (DqnStr_Cmp(arg, "--record") == 0 && hasNextArg)
+		{
+			headlessConfig.recordPath = argv[++argIndex];
+		}
+		else if (DqnStr_Cmp(arg, "--replay") == 0 && hasNextArg)
+		{
+			headlessConfig.replayPath = argv[++argIndex];
+		}
+		else if (DqnStr_Cmp(arg, "--cubes") == 0 && hasNextArg)
+		{
+			const char *val = argv[++argIndex];
+			numCubes        = (u32)Dqn_StrToI64(val, DqnStr_Len(val));
+		}
+		else if (DqnStr_Cmp(arg, "--threads") == 0 && hasNextArg)
+		{
+			const char *val = argv[++argIndex];
+			numJobThreads   = DQN_MAX(0, (i32)Dqn_StrToI64(val, DqnStr_Len(val)));
+		}
+		else if (DqnStr_Cmp(arg, "--bc") == 0 && hasNextArg)
+		{
+			const char *val = argv[++argIndex];
+			if      (DqnStr_Cmp(val, "off") == 0)    bcQuality = LOGLBCQuality_None;
+			else if (DqnStr_Cmp(val, "fast") == 0)   bcQuality = LOGLBCQuality_Fast;
+			else if (DqnStr_Cmp(val, "normal") == 0) bcQuality = LOGLBCQuality_Normal;
+			else if (DqnStr_Cmp(val, "high") == 0)   bcQuality = LOGLBCQuality_High;
+			else
+			{
+				LinuxPrintUsage(argv[0]);
+				return -1;
+			}
+		}
+		else if (DqnStr_Cmp(arg, "--texture-budget") == 0 && hasNextArg)
+		{
+			const char *val = argv[++argIndex];
+			textureBudget   = (size_t)DQN_MEGABYTE(Dqn_StrToF32(val, DqnStr_Len(val)));
+		}
+		else if (DqnStr_Cmp(arg, "--shader-cache") == 0 && hasNextArg)
+		{
+			const char *val = argv[++argIndex];
+			shaderCacheDir  = (DqnStr_Cmp(val, "none") == 0) ? NULL : val;
+		}
+		else if (DqnStr_Cmp(arg, "--bench") == 0)
+		{
+			runBench = true;
+		}
+		else if (DqnStr_Cmp(arg, "--pack") == 0 && hasNextArg)
+		{
+			packPath = argv[++argIndex];
+		}
+		else if (DqnStr_Cmp(arg, "--cook") == 0 && hasNextArg)
+		{
+			// NOTE: Every argument up to the next option is an image to cook
+			cookPath       = argv[++argIndex];
+			cookImagePaths = &argv[argIndex + 1];
+			while (argIndex + 1 < argc && argv[argIndex + 1][0] != '-')
+			{
+				numCookImages++;
+				argIndex++;
+			}
+		}
+		else
+		{
+			LinuxPrintUsage(argv[0]);
+			return -1;
+		}
+	}
+
+	PlatformInput input = {};
+	input.screenDim     = DqnV2_2i(BUFFER_WIDTH, BUFFER_HEIGHT);
+	input.numCubes      = numCubes;
+	input.bcQuality     = bcQuality;
+	input.textureBudget = textureBudget;
+
+	PlatformMemory memory = {};
+	bool memInitResult    = (memory.mainStack.Init(DQN_MEGABYTE(16), true, 4) &&
+	                         memory.tempStack.Init(DQN_MEGABYTE(16), true, 4) &&
+	                         LOGLFrameArena_Init(&memory.frameArena, DQN_MEGABYTE(1)));
+	if (!DQN_ASSERT(memInitResult)) return -1;
+
+	// Job queue, the main thread helps complete jobs so it gets one less worker than there are threads
+	LOCAL_PERSIST DqnJobQueue jobQueue;
+	if (numJobThreads < 0)
+	{
+		u32 numCores, numThreadsPerCore;
+		DqnPlatform_GetNumThreadsAndCores(&numCores, &numThreadsPerCore);
+		numJobThreads = DQN_MAX(0, (i32)(numCores * numThreadsPerCore) - 1);
+	}
+
+	if (numJobThreads > 0 && DqnJobQueue_Init(&jobQueue, (u32)numJobThreads))
+	{
+		memory.jobQueue      = &jobQueue;
+		memory.numJobThreads = (u32)numJobThreads;
+	}
+
+	if (runBench)
+	{
+		i32 result = LOGLBench_Run(&memory.mainStack, 0) ? 0 : -1;
+		DqnJobQueue_Free(memory.jobQueue);
+		return result;
+	}
+
+	if (cookPath)
+	{
+		i32 result = LinuxCookPack(&memory, cookPath, cookImagePaths, numCookImages, bcQuality);
+		DqnJobQueue_Free(memory.jobQueue);
+		return result;
+	}
+
+	// NOTE: LOGL decodes the source images of any texture that isn't in the pack, so it's optional
+	memory.assetPack = LinuxMapFile(packPath, &memory.assetPackSize);
+
+	// NOTE: Without a directory the shaders are compiled from source every run
+	if (shaderCacheDir && (mkdir(shaderCacheDir, 0755) == 0 || errno == EEXIST))
+		memory.shaderCacheDir = shaderCacheDir;
+
+	// NOTE: Shaders are rebuilt when their files are written, if they can't be watched they're only
+	// built on init
+	i32 shaderWatch = LinuxWatchShaderDir();
+
+	if (runHeadless)
+	{
+		// NOTE: Recording or replaying in headless mode is only useful with the recorder's stats
+		if (headlessConfig.recordPath || headlessConfig.replayPath)
+			headlessConfig.glBackend = LinuxGLBackend_Recorder;
+		headlessConfig.shaderWatch = shaderWatch;
+		i32 result = LinuxRunHeadless(&input, &memory, &headlessConfig);
+		LOGL_Shutdown(&memory);
+		DqnJobQueue_Free(memory.jobQueue);
+		LOGLFrameArena_Free(&memory.frameArena);
+		LinuxUnmapFile(memory.assetPack, memory.assetPackSize);
+		if (shaderWatch != -1) close(shaderWatch);
+		return result;
+	}
+
+	////////////////////////////////////////////////////////////////////////////
+	// Setup OpenGL
+	////////////////////////////////////////////////////////////////////////////
+	Display *display = XOpenDisplay(NULL);
+	if (!display)
+	{
+		printf("XOpenDisplay() failed, use --headless to run without a display.\n");
+		return -1;
+	}
+
+	Window mainWindow;
+	Atom wmDeleteWindow;
+	{
+		const i32 DESIRED_FB_CONFIG[] = {GLX_X_RENDERABLE,  True,
+		                                 GLX_DRAWABLE_TYPE, GLX_WINDOW_BIT,
+		                                 GLX_RENDER_TYPE,   GLX_RGBA_BIT,
+		                                 GLX_X_VISUAL_TYPE, GLX_TRUE_COLOR,
+		                                 GLX_RED_SIZE,      8,
+		                                 GLX_GREEN_SIZE,    8,
+		                                 GLX_BLUE_SIZE,     8,
+		                                 GLX_ALPHA_SIZE,    8,
+		                                 GLX_DEPTH_SIZE,    24,
+		                                 GLX_STENCIL_SIZE,  8,
+		                                 GLX_DOUBLEBUFFER,  True,
+		                                 GLX_SAMPLE_BUFFERS, 1,
+		                                 GLX_SAMPLES,       4,
+		                                 None};
+
+		i32 numFbConfigs;
+		GLXFBConfig *fbConfigs =
+		    glXChooseFBConfig(display, DefaultScreen(display), DESIRED_FB_CONFIG, &numFbConfigs);
+		if (!fbConfigs || numFbConfigs == 0)
+		{
+			printf("glXChooseFBConfig() failed\n");
+			return -1;
+		}
+
+		GLXFBConfig fbConfig    = fbConfigs[0];
+		XVisualInfo *visualInfo = glXGetVisualFromFBConfig(display, fbConfig);
+		XFree(fbConfigs);
+		if (!visualInfo)
+		{
+			printf("glXGetVisualFromFBConfig() failed\n");
+			return -1;
+		}
+
+		////////////////////////////////////////////////////////////////////////
+		// Create Window
+		////////////////////////////////////////////////////////////////////////
+		Window rootWindow = RootWindow(display, visualInfo->screen);
+		XSetWindowAttributes windowAttribs = {};
+		windowAttribs.colormap   = XCreateColormap(display, rootWindow, visualInfo->visual, AllocNone);
+		windowAttribs.event_mask = KeyPressMask | KeyReleaseMask | ButtonPressMask | ButtonReleaseMask |
+		                           PointerMotionMask | StructureNotifyMask;
+
+		mainWindow = XCreateWindow(display, rootWindow, 0, 0, BUFFER_WIDTH, BUFFER_HEIGHT, 0,
+		                           visualInfo->depth, InputOutput, visualInfo->visual,
+		                           CWColormap | CWEventMask, &windowAttribs);
+		XFree(visualInfo);
+		if (!mainWindow)
+		{
+			printf("XCreateWindow() failed\n");
+			return -1;
+		}
+
+		XStoreName(display, mainWindow, WINDOW_TITLE);
+		wmDeleteWindow = XInternAtom(display, "WM_DELETE_WINDOW", False);
+		XSetWMProtocols(display, mainWindow, &wmDeleteWindow, 1);
+		XMapWindow(display, mainWindow);
+
+		// NOTE: X11 sends a release/press pair for every key repeat by default, which would look
+		// like the key was let go of to the app.
+		XkbSetDetectableAutoRepeat(display, True, NULL);
+
+		////////////////////////////////////////////////////////////////////////
+		// Create Modern OGL Context
+		////////////////////////////////////////////////////////////////////////
+		LINUX_GL_LOAD_FUNCTION(glXCreateContextAttribsARB);
+
+		const i32 OGL_MAJOR_MIN = 3, OGL_MINOR_MIN = 3;
+		const i32 CONTEXT_ATTRIBS[] = {GLX_CONTEXT_MAJOR_VERSION_ARB, OGL_MAJOR_MIN,
+		                               GLX_CONTEXT_MINOR_VERSION_ARB, OGL_MINOR_MIN,
+		                               GLX_CONTEXT_PROFILE_MASK_ARB,  GLX_CONTEXT_CORE_PROFILE_BIT_ARB,
+		                               None};
+
+		GLXContext oglRenderingContext =
+		    glXCreateContextAttribsARB(display, fbConfig, 0, True, CONTEXT_ATTRIBS);
+		if (!oglRenderingContext)
+		{
+			printf("glXCreateContextAttribsARB() failed\n");
+			return -1;
+		}
+
+		if (!glXMakeCurrent(display, mainWindow, oglRenderingContext))
+		{
+			printf("glXMakeCurrent() failed\n");
+			return -1;
+		}
+
+		LinuxLoadGLFunctions();
+		glViewport(0, 0, BUFFER_WIDTH, BUFFER_HEIGHT);
+	}
+
+	GLRecorderReplay replay = {};
+	if (headlessConfig.replayPath && !GLRecorderReplay_Open(&replay, headlessConfig.replayPath))
+	{
+		printf("GLRecorderReplay_Open() failed to load: %s\n", headlessConfig.replayPath);
+		return -1;
+	}
+
+	// Linux Configuration
+	{
+		// Hide the cursor by giving the window a blank 1x1 cursor
+		char blankBits[1]  = {};
+		XColor blankColor  = {};
+		Pixmap blankPixmap = XCreateBitmapFromData(display, mainWindow, blankBits, 1, 1);
+		Cursor blankCursor = XCreatePixmapCursor(display, blankPixmap, blankPixmap, &blankColor,
+		                                         &blankColor, 0, 0);
+		XDefineCursor(display, mainWindow, blankCursor);
+		XFreePixmap(display, blankPixmap);
+	}
+
+	f64 frameTimeInS = 0.0f;
+	while (globalRunning)
+	{
+		f64 startFrameTimeInS = DqnTimer_NowInS();
+		input.deltaForFrame   = (f32)frameTimeInS;
+		LinuxProcessInputSeparately(display, mainWindow, wmDeleteWindow, &input);
+
+		////////////////////////////////////////////////////////////////////////
+		// Update and Render
+		////////////////////////////////////////////////////////////////////////
+		if (headlessConfig.replayPath)
+		{
+			if (!GLRecorderReplay_Frame(&replay)) globalRunning = false;
+		}
+		else
+		{
+			input.shadersChanged = LinuxShaderDirChanged(shaderWatch);
+			LOGL_Update(&input, &memory);
+		}
+		glXSwapBuffers(display, mainWindow);
+
+		////////////////////////////////////////////////////////////////////////
+		// Frame Limiting
+		////////////////////////////////////////////////////////////////////////
+		if (1)
+		{
+			f64 workTimeInS = DqnTimer_NowInS() - startFrameTimeInS;
+			if (workTimeInS < targetSecondsPerFrame)
+			{
+				u32 remainingTimeInUs = (u32)((targetSecondsPerFrame - workTimeInS) * 1000000);
+				usleep(remainingTimeInUs);
+			}
+		}
+
+		frameTimeInS        = DqnTimer_NowInS() - startFrameTimeInS;
+		f32 msPerFrame      = 1000.0f * (f32)frameTimeInS;
+		f32 framesPerSecond = 1.0f / (f32)frameTimeInS;
+
+		////////////////////////////////////////////////////////////////////////
+		// Misc
+		////////////////////////////////////////////////////////////////////////
+		// Update title bar
+		if (1)
+		{
+			const f32 titleUpdateFrequencyInS  = 0.1f;
+			LOCAL_PERSIST f32 titleUpdateTimer = titleUpdateFrequencyInS;
+			titleUpdateTimer += (f32)frameTimeInS;
+			if (titleUpdateTimer > titleUpdateFrequencyInS)
+			{
+				titleUpdateTimer = 0;
+
+				const LOGLFrameArenaStats *arenaStats = &memory.frameArena.stats;
+				const char formatStr[] = "%s - dev - %5.2f ms/f - %5.2f fps - resident mem %'dkb - frame mem %'dkb (peak %'dkb)";
+				char windowTitleBuf[DQN_ARRAY_COUNT(formatStr) + DQN_ARRAY_COUNT(WINDOW_TITLE) + 64] = {};
+				Dqn_sprintf(windowTitleBuf, formatStr, WINDOW_TITLE, msPerFrame, framesPerSecond,
+				            LinuxGetResidentMemInKb(), (u32)(arenaStats->used / 1024),
+				            (u32)(arenaStats->highWaterMark / 1024));
+				XStoreName(display, mainWindow, windowTitleBuf);
+			}
+		}
+	}
+
+	LOGL_Shutdown(&memory);
+	GLRecorderReplay_Close(&replay);
+	XCloseDisplay(display);
+	DqnJobQueue_Free(memory.jobQueue);
+	LOGLFrameArena_Free(&memory.frameArena);
+	LinuxUnmapFile(memory.assetPack, memory.assetPackSize);
+	if (shaderWatch != -1) close(shaderWatch);
+	return 0;
+}
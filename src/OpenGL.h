@@ -10,9 +10,12 @@
 // #TOC Table Of Contents
 ////////////////////////////////////////////////////////////////////////////////
 // #WGL               WindowsGL Extension Definitions
+// #GL11              OpenGL 1.1 Definitions (Unix only, Win32 uses <gl/gl.h>)
+// #GLX               X11 GL Extension Definitions
 // #OGL               OpenGL Extension Definitions
 // #GlobalGLFunctions Exposed public function pointers
 
+#if defined(_WIN32)
 ////////////////////////////////////////////////////////////////////////////////
 // #WGL Windows GL Extension
 ////////////////////////////////////////////////////////////////////////////////
@@ -58,6 +61,154 @@
 	typedef HGLRC wglCreateContextAttribsARBProc(HDC hDC, HGLRC hShareContext, const int *attribList);
 #endif /* WGL_ARGB_create_context */
 
+#else
+////////////////////////////////////////////////////////////////////////////////
+// #GL11 OpenGL 1.1
+////////////////////////////////////////////////////////////////////////////////
+// NOTE: We don't include <GL/gl.h> on Unix since it prototypes every entry
+// point up to GL 1.3. Instead all of GL is exposed through function pointers,
+// including 1.1, so that the platform layer can route them anywhere.
+#include <stddef.h>
+
+#ifndef GL_VERSION_1_1
+#define GL_VERSION_1_1 1
+	typedef unsigned int   GLenum;
+	typedef unsigned char  GLboolean;
+	typedef unsigned int   GLbitfield;
+	typedef void           GLvoid;
+	typedef signed char    GLbyte;
+	typedef short          GLshort;
+	typedef int            GLint;
+	typedef int            GLsizei;
+	typedef unsigned char  GLubyte;
+	typedef unsigned short GLushort;
+	typedef unsigned int   GLuint;
+	typedef float          GLfloat;
+	typedef float          GLclampf;
+	typedef double         GLdouble;
+
+	#define GL_FALSE                          0
+	#define GL_TRUE                           1
+
+	#define GL_NO_ERROR                       0
+	#define GL_INVALID_ENUM                   0x0500
+	#define GL_INVALID_VALUE                  0x0501
+	#define GL_INVALID_OPERATION              0x0502
+	#define GL_STACK_OVERFLOW                 0x0503
+	#define GL_STACK_UNDERFLOW                0x0504
+	#define GL_OUT_OF_MEMORY                  0x0505
+
+	#define GL_DEPTH_BUFFER_BIT               0x00000100
+	#define GL_COLOR_BUFFER_BIT               0x00004000
+
+	#define GL_TRIANGLES                      0x0004
+	#define GL_FRONT_AND_BACK                 0x0408
+	#define GL_CULL_FACE                      0x0B44
+	#define GL_DEPTH_TEST                     0x0B71
+	#define GL_UNPACK_ALIGNMENT               0x0CF5
+	#define GL_TEXTURE_2D                     0x0DE1
+
+	#define GL_BYTE                           0x1400
+	#define GL_UNSIGNED_BYTE                  0x1401
+	#define GL_SHORT                          0x1402
+	#define GL_UNSIGNED_SHORT                 0x1403
+	#define GL_INT                            0x1404
+	#define GL_UNSIGNED_INT                   0x1405
+	#define GL_FLOAT                          0x1406
+
+	#define GL_RED                            0x1903
+	#define GL_GREEN                          0x1904
+	#define GL_RGB                            0x1907
+	#define GL_RGBA                           0x1908
+
+	#define GL_LINE                           0x1B01
+	#define GL_FILL                           0x1B02
+
+	#define GL_VENDOR                         0x1F00
+	#define GL_RENDERER                       0x1F01
+	#define GL_VERSION                        0x1F02
+	#define GL_EXTENSIONS                     0x1F03
+
+	#define GL_NEAREST                        0x2600
+	#define GL_LINEAR                         0x2601
+	#define GL_NEAREST_MIPMAP_NEAREST         0x2700
+	#define GL_LINEAR_MIPMAP_NEAREST          0x2701
+	#define GL_NEAREST_MIPMAP_LINEAR          0x2702
+	#define GL_LINEAR_MIPMAP_LINEAR           0x2703
+	#define GL_TEXTURE_MAG_FILTER             0x2800
+	#define GL_TEXTURE_MIN_FILTER             0x2801
+	#define GL_TEXTURE_WRAP_S                 0x2802
+	#define GL_TEXTURE_WRAP_T                 0x2803
+	#define GL_REPEAT                         0x2901
+	#define GL_RGB8                           0x8051
+	#define GL_RGBA8                          0x8058
+
+	typedef GLenum         glGetErrorProc     (void);
+	typedef const GLubyte *glGetStringProc    (GLenum name);
+	typedef void           glGetIntegervProc  (GLenum pname, GLint *data);
+	typedef void           glClearProc        (GLbitfield mask);
+	typedef void           glEnableProc       (GLenum cap);
+	typedef void           glDisableProc      (GLenum cap);
+	typedef void           glPolygonModeProc  (GLenum face, GLenum mode);
+	typedef void           glViewportProc     (GLint x, GLint y, GLsizei width, GLsizei height);
+	typedef void           glPixelStoreiProc  (GLenum pname, GLint param);
+	typedef void           glGenTexturesProc  (GLsizei n, GLuint *textures);
+	typedef void           glDeleteTexturesProc(GLsizei n, const GLuint *textures);
+	typedef void           glBindTextureProc  (GLenum target, GLuint texture);
+	typedef void           glTexParameteriProc(GLenum target, GLenum pname, GLint param);
+	typedef void           glTexImage2DProc   (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void *pixels);
+#endif /* GL_VERSION_1_1 */
+
+////////////////////////////////////////////////////////////////////////////////
+// #GLX X11 GL Extension
+////////////////////////////////////////////////////////////////////////////////
+// NOTE: Only the subset of <GL/glx.h> the platform layer uses, declared here
+// since glx.h drags in <GL/gl.h>.
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+
+#ifndef GLX_VERSION_1_3
+#define GLX_VERSION_1_3 1
+	typedef struct __GLXcontextRec  *GLXContext;
+	typedef struct __GLXFBConfigRec *GLXFBConfig;
+	typedef XID                      GLXDrawable;
+	typedef void                   (*GLXextFuncPtr)(void);
+
+	#define GLX_DOUBLEBUFFER                  5
+	#define GLX_RED_SIZE                      8
+	#define GLX_GREEN_SIZE                    9
+	#define GLX_BLUE_SIZE                     10
+	#define GLX_ALPHA_SIZE                    11
+	#define GLX_DEPTH_SIZE                    12
+	#define GLX_STENCIL_SIZE                  13
+	#define GLX_X_VISUAL_TYPE                 0x22
+	#define GLX_TRUE_COLOR                    0x8002
+	#define GLX_DRAWABLE_TYPE                 0x8010
+	#define GLX_RENDER_TYPE                   0x8011
+	#define GLX_X_RENDERABLE                  0x8012
+	#define GLX_WINDOW_BIT                    0x00000001
+	#define GLX_RGBA_BIT                      0x00000001
+	#define GLX_SAMPLE_BUFFERS                100000
+	#define GLX_SAMPLES                       100001
+
+	extern "C" GLXFBConfig  *glXChooseFBConfig       (Display *dpy, int screen, const int *attribList, int *nitems);
+	extern "C" XVisualInfo  *glXGetVisualFromFBConfig(Display *dpy, GLXFBConfig config);
+	extern "C" Bool          glXMakeCurrent          (Display *dpy, GLXDrawable drawable, GLXContext ctx);
+	extern "C" void          glXSwapBuffers          (Display *dpy, GLXDrawable drawable);
+	extern "C" void          glXDestroyContext       (Display *dpy, GLXContext ctx);
+	extern "C" GLXextFuncPtr glXGetProcAddressARB    (const GLubyte *procName);
+#endif /* GLX_VERSION_1_3 */
+
+#ifndef GLX_ARB_create_context
+#define GLX_ARB_create_context 1
+	#define GLX_CONTEXT_MAJOR_VERSION_ARB     0x2091
+	#define GLX_CONTEXT_MINOR_VERSION_ARB     0x2092
+	#define GLX_CONTEXT_PROFILE_MASK_ARB      0x9126
+	#define GLX_CONTEXT_CORE_PROFILE_BIT_ARB  0x00000001
+	typedef GLXContext glXCreateContextAttribsARBProc(Display *dpy, GLXFBConfig config, GLXContext shareContext, Bool direct, const int *attribList);
+#endif /* GLX_ARB_create_context */
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 // #OGL OpenGL Extension
 ////////////////////////////////////////////////////////////////////////////////
@@ -100,6 +251,7 @@ typedef void glDrawArraysProc(GLenum mode, GLint first, GLsizei count);
     #define GL_TEXTURE31                      0x84DF
 
     typedef void glActiveTextureProc(GLenum texture);
+    typedef void glCompressedTexImage2DProc(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void *data);
 #endif /* GL_VERSION_1_3 */
 
 #ifndef GL_VERSION_1_5
@@ -116,6 +268,8 @@ typedef void glDrawArraysProc(GLenum mode, GLint first, GLsizei count);
 	typedef void glGenBuffersProc(GLsizei n, GLuint *buffers);
 	typedef void glBindBufferProc(GLenum target, GLuint buffer);
 	typedef void glBufferDataProc(GLenum target, GLsizeiptr size, const void *data, GLenum usage);
+	typedef void glBufferSubDataProc(GLenum target, GLintptr offset, GLsizeiptr size, const void *data);
+	typedef GLboolean glUnmapBufferProc(GLenum target);
 #endif /* GL_VERSION_1_5 */
 
 #ifndef GL_VERSION_2_0
@@ -126,6 +280,7 @@ typedef void glDrawArraysProc(GLenum mode, GLint first, GLsizei count);
 	#define GL_VERTEX_SHADER                  0x8B31
 	#define GL_COMPILE_STATUS                 0x8B81
 	#define GL_LINK_STATUS                    0x8B82
+	#define GL_ACTIVE_UNIFORMS                0x8B86
 
 	typedef GLuint glCreateShaderProc      (GLenum type);
 	typedef void   glShaderSourceProc      (GLuint shader, GLsizei count, GLchar **string, const GLint *length);
@@ -137,8 +292,10 @@ typedef void glDrawArraysProc(GLenum mode, GLint first, GLsizei count);
 	typedef void   glLinkProgramProc       (GLuint program);
 	typedef void   glUseProgramProc        (GLuint program);
 	typedef void   glDeleteShaderProc      (GLuint shader);
+	typedef void   glDeleteProgramProc     (GLuint program);
 	typedef void   glGetProgramInfoLogProc (GLuint program, GLsizei bufSize, GLsizei *length, GLchar *infoLog);
 	typedef void   glGetProgramivProc      (GLuint program, GLenum pname, GLint *params);
+	typedef void   glGetActiveUniformProc  (GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name);
 
 	typedef GLint  glGetUniformLocationProc(GLuint program, const GLchar *name);
 	typedef void   glUniform1fProc         (GLint location, GLfloat v0);
@@ -153,34 +310,140 @@ typedef void glDrawArraysProc(GLenum mode, GLint first, GLsizei count);
 	typedef void glVertexAttribPointerProc     (GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer);
 #endif /* GL_VERSION_2_0 */
 
+#ifndef GL_VERSION_2_1
+#define GL_VERSION_2_1 1
+	#define GL_PIXEL_UNPACK_BUFFER            0x88EC
+#endif /* GL_VERSION_2_1 */
+
 #ifndef GL_VERSION_3_0
 #define GL_VERSION_3_0 1
 	typedef unsigned short GLhalf;
 
 	#define GL_INVALID_FRAMEBUFFER_OPERATION  0x0506
+	#define GL_HALF_FLOAT                     0x140B
+	#define GL_MAP_WRITE_BIT                  0x0002
+	#define GL_MAP_INVALIDATE_RANGE_BIT       0x0004
+	#define GL_MAP_INVALIDATE_BUFFER_BIT      0x0008
+	#define GL_MAP_UNSYNCHRONIZED_BIT         0x0020
+	#define GL_COMPRESSED_RED_RGTC1           0x8DBB
+	#define GL_COMPRESSED_RG_RGTC2            0x8DBD
+	#define GL_NUM_EXTENSIONS                 0x821D
+	#define GL_RG                             0x8227
+	#define GL_R8                             0x8229
+	#define GL_RG8                            0x822B
 
-	typedef void glGenVertexArraysProc(GLsizei n, GLuint *arrays);
-	typedef void glBindVertexArrayProc(GLuint array);
-	typedef void glGenerateMipmapProc (GLenum target);
+	typedef const GLubyte *glGetStringiProc(GLenum name, GLuint index);
+	typedef void  glGenVertexArraysProc(GLsizei n, GLuint *arrays);
+	typedef void  glBindVertexArrayProc(GLuint array);
+	typedef void  glGenerateMipmapProc (GLenum target);
+	typedef void  glBindBufferBaseProc (GLenum target, GLuint index, GLuint buffer);
+	typedef void *glMapBufferRangeProc (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
 #endif /* GL_VERSION_3_0 */
 
+#ifndef GL_VERSION_3_1
+#define GL_VERSION_3_1 1
+	#define GL_UNIFORM_BUFFER                 0x8A11
+	#define GL_INVALID_INDEX                  0xFFFFFFFFu
+
+	typedef GLuint glGetUniformBlockIndexProc (GLuint program, const GLchar *uniformBlockName);
+	typedef void   glUniformBlockBindingProc  (GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding);
+	typedef void   glDrawArraysInstancedProc  (GLenum mode, GLint first, GLsizei count, GLsizei instancecount);
+	typedef void   glDrawElementsInstancedProc(GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instancecount);
+#endif /* GL_VERSION_3_1 */
+
+#ifndef GL_VERSION_3_2
+#define GL_VERSION_3_2 1
+	typedef struct __GLsync     *GLsync;
+	typedef unsigned long long GLuint64;
+
+	#define GL_SYNC_GPU_COMMANDS_COMPLETE     0x9117
+	#define GL_ALREADY_SIGNALED               0x911A
+	#define GL_TIMEOUT_EXPIRED                0x911B
+	#define GL_CONDITION_SATISFIED            0x911C
+	#define GL_WAIT_FAILED                    0x911D
+	#define GL_SYNC_FLUSH_COMMANDS_BIT        0x00000001
+
+	typedef GLsync glFenceSyncProc     (GLenum condition, GLbitfield flags);
+	typedef GLenum glClientWaitSyncProc(GLsync sync, GLbitfield flags, GLuint64 timeout);
+	typedef void   glDeleteSyncProc    (GLsync sync);
+#endif /* GL_VERSION_3_2 */
+
+#ifndef GL_VERSION_3_3
+#define GL_VERSION_3_3 1
+	#define GL_INT_2_10_10_10_REV             0x8D9F
+	#define GL_TEXTURE_SWIZZLE_R              0x8E42
+	#define GL_TEXTURE_SWIZZLE_G              0x8E43
+	#define GL_TEXTURE_SWIZZLE_B              0x8E44
+	#define GL_TEXTURE_SWIZZLE_A              0x8E45
+
+	typedef void glVertexAttribDivisorProc(GLuint index, GLuint divisor);
+#endif /* GL_VERSION_3_3 */
+
+// NOTE: Also exposed by 3.3 drivers through ARB_get_program_binary under the same names
+#ifndef GL_VERSION_4_1
+#define GL_VERSION_4_1 1
+	#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+	#define GL_PROGRAM_BINARY_LENGTH           0x8741
+
+	typedef void glGetProgramBinaryProc (GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat, void *binary);
+	typedef void glProgramBinaryProc    (GLuint program, GLenum binaryFormat, const void *binary, GLsizei length);
+	typedef void glProgramParameteriProc(GLuint program, GLenum pname, GLint value);
+#endif /* GL_VERSION_4_1 */
+
+#ifndef GL_EXT_texture_compression_s3tc
+#define GL_EXT_texture_compression_s3tc 1
+	#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT   0x83F0
+	#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT  0x83F3
+#endif /* GL_EXT_texture_compression_s3tc */
+
+#ifndef GL_KHR_parallel_shader_compile
+#define GL_KHR_parallel_shader_compile 1
+	#define GL_COMPLETION_STATUS_KHR          0x91B1
+#endif /* GL_KHR_parallel_shader_compile */
+
 ////////////////////////////////////////////////////////////////////////////////
 // #GlobalGLFunctions
 ////////////////////////////////////////////////////////////////////////////////
 // Copy the following definitions to the platform layer and link to your OpenGL
 // functions at runtime.
 
+#if defined(_WIN32)
 // WinGL
 extern wglChoosePixelFormatARBProc    *wglChoosePixelFormatARB;
 extern wglCreateContextAttribsARBProc *wglCreateContextAttribsARB;
+#else
+// GLX
+extern glXCreateContextAttribsARBProc *glXCreateContextAttribsARB;
+
+// GL 1.1
+extern glGetErrorProc       *glGetError;
+extern glGetStringProc      *glGetString;
+extern glGetIntegervProc    *glGetIntegerv;
+extern glClearProc          *glClear;
+extern glClearColorProc     *glClearColor;
+extern glEnableProc         *glEnable;
+extern glDisableProc        *glDisable;
+extern glPolygonModeProc    *glPolygonMode;
+extern glViewportProc       *glViewport;
+extern glPixelStoreiProc    *glPixelStorei;
+extern glDrawArraysProc     *glDrawArrays;
+extern glGenTexturesProc    *glGenTextures;
+extern glDeleteTexturesProc *glDeleteTextures;
+extern glBindTextureProc    *glBindTexture;
+extern glTexParameteriProc  *glTexParameteri;
+extern glTexImage2DProc     *glTexImage2D;
+#endif
 
 // GL 1.3
-extern glActiveTextureProc *glActiveTexture;
+extern glActiveTextureProc        *glActiveTexture;
+extern glCompressedTexImage2DProc *glCompressedTexImage2D;
 
 // GL 1.5
-extern glGenBuffersProc *glGenBuffers;
-extern glBindBufferProc *glBindBuffer;
-extern glBufferDataProc *glBufferData;
+extern glGenBuffersProc    *glGenBuffers;
+extern glBindBufferProc    *glBindBuffer;
+extern glBufferDataProc    *glBufferData;
+extern glBufferSubDataProc *glBufferSubData;
+extern glUnmapBufferProc   *glUnmapBuffer;
 
 // GL 2.0
 extern glCreateShaderProc             *glCreateShader;
@@ -193,8 +456,10 @@ extern glAttachShaderProc             *glAttachShader;
 extern glLinkProgramProc              *glLinkProgram;
 extern glUseProgramProc               *glUseProgram;
 extern glDeleteShaderProc             *glDeleteShader;
+extern glDeleteProgramProc            *glDeleteProgram;
 extern glGetProgramInfoLogProc        *glGetProgramInfoLog;
 extern glGetProgramivProc             *glGetProgramiv;
+extern glGetActiveUniformProc         *glGetActiveUniform;
 
 extern glGetUniformLocationProc       *glGetUniformLocation;
 extern glUniform1fProc                *glUniform1f;
@@ -209,8 +474,30 @@ extern glDisableVertexAttribArrayProc *glDisableVertexAttribArray;
 extern glVertexAttribPointerProc      *glVertexAttribPointer;
 
 // GL 3.0
+extern glGetStringiProc      *glGetStringi;
 extern glGenVertexArraysProc *glGenVertexArrays;
 extern glBindVertexArrayProc *glBindVertexArray;
 extern glGenerateMipmapProc  *glGenerateMipmap;
+extern glBindBufferBaseProc  *glBindBufferBase;
+extern glMapBufferRangeProc  *glMapBufferRange;
+
+// GL 3.1
+extern glGetUniformBlockIndexProc  *glGetUniformBlockIndex;
+extern glUniformBlockBindingProc   *glUniformBlockBinding;
+extern glDrawArraysInstancedProc   *glDrawArraysInstanced;
+extern glDrawElementsInstancedProc *glDrawElementsInstanced;
+
+// GL 3.2
+extern glFenceSyncProc      *glFenceSync;
+extern glClientWaitSyncProc *glClientWaitSync;
+extern glDeleteSyncProc     *glDeleteSync;
+
+// GL 3.3
+extern glVertexAttribDivisorProc *glVertexAttribDivisor;
+
+// GL 4.1
+extern glGetProgramBinaryProc  *glGetProgramBinary;
+extern glProgramBinaryProc     *glProgramBinary;
+extern glProgramParameteriProc *glProgramParameteri;
 
 #endif // OPENGL_H
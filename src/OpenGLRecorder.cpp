@@ -0,0 +1,1946 @@
+#include "OpenGLRecorder.h"
+
+#include <stdio.h>  // For snprintf()
+#include <string.h> // For memcpy()
+
+#define GL_RECORDER_CMD_HEADER_SIZE (sizeof(u16) + sizeof(u32))
+#define GL_RECORDER_MAX_SHADER_SOURCE_STRINGS 16
+
+typedef struct GLRecorderCmdInfo
+{
+	const char *name;
+	bool        isStateChange;
+	bool        isDrawCall;
+} GLRecorderCmdInfo;
+
+// NOTE: Must match the order of enum GLRecorderCmd
+FILE_SCOPE const GLRecorderCmdInfo globalGLRecorderCmdInfo[] = {
+    {"Invalid",                    false, false},
+    {"FrameEnd",                   false, false},
+
+    {"glGetError",                 false, false},
+    {"glGetString",                false, false},
+    {"glGetIntegerv",              false, false},
+    {"glClear",                    false, false},
+    {"glClearColor",               true,  false},
+    {"glEnable",                   true,  false},
+    {"glDisable",                  true,  false},
+    {"glPolygonMode",              true,  false},
+    {"glViewport",                 true,  false},
+    {"glPixelStorei",              true,  false},
+    {"glDrawArrays",               false, true},
+    {"glGenTextures",              false, false},
+    {"glDeleteTextures",           false, false},
+    {"glBindTexture",              true,  false},
+    {"glTexParameteri",            true,  false},
+    {"glTexImage2D",               false, false},
+
+    {"glActiveTexture",            true,  false},
+    {"glCompressedTexImage2D",     false, false},
+
+    {"glGenBuffers",               false, false},
+    {"glBindBuffer",               true,  false},
+    {"glBufferData",               false, false},
+    {"glBufferSubData",            false, false},
+    {"glUnmapBuffer",              false, false},
+
+    {"glCreateShader",             false, false},
+    {"glShaderSource",             false, false},
+    {"glCompileShader",            false, false},
+    {"glGetShaderiv",              false, false},
+    {"glGetShaderInfoLog",         false, false},
+    {"glCreateProgram",            false, false},
+    {"glAttachShader",             false, false},
+    {"glLinkProgram",              false, false},
+    {"glUseProgram",               true,  false},
+    {"glDeleteShader",             false, false},
+    {"glDeleteProgram",            false, false},
+    {"glGetProgramInfoLog",        false, false},
+    {"glGetProgramiv",             false, false},
+    {"glGetActiveUniform",         false, false},
+
+    {"glGetUniformLocation",       false, false},
+    {"glUniform1f",                false, false},
+    {"glUniform1i",                false, false},
+    {"glUniform3f",                false, false},
+    {"glUniform4f",                false, false},
+    {"glUniform3fv",               false, false},
+    {"glUniformMatrix4fv",         false, false},
+
+    {"glEnableVertexAttribArray",  true,  false},
+    {"glDisableVertexAttribArray", true,  false},
+    {"glVertexAttribPointer",      true,  false},
+
+    {"glGetStringi",               false, false},
+    {"glGenVertexArrays",          false, false},
+    {"glBindVertexArray",          true,  false},
+    {"glGenerateMipmap",           false, false},
+    {"glBindBufferBase",           true,  false},
+    {"glMapBufferRange",           false, false},
+
+    {"glGetUniformBlockIndex",     false, false},
+    {"glUniformBlockBinding",      false, false},
+    {"glDrawArraysInstanced",      false, true},
+    {"glDrawElementsInstanced",    false, true},
+
+    {"glFenceSync",                false, false},
+    {"glClientWaitSync",           false, false},
+    {"glDeleteSync",               false, false},
+
+    {"glVertexAttribDivisor",      true,  false},
+
+    {"glGetProgramBinary",         false, false},
+    {"glProgramBinary",            false, false},
+    {"glProgramParameteri",        false, false},
+};
+DQN_COMPILE_ASSERT(DQN_ARRAY_COUNT(globalGLRecorderCmdInfo) == GLRecorderCmd_Count);
+
+const char *GLRecorder_CmdToStr(const enum GLRecorderCmd cmd)
+{
+	if (cmd < 0 || cmd >= GLRecorderCmd_Count) return "Unknown";
+	return globalGLRecorderCmdInfo[cmd].name;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Log Writing
+////////////////////////////////////////////////////////////////////////////////
+// NOTE: The thunks are plain function pointers with no user data, so the loaded
+// recorder is global.
+FILE_SCOPE GLRecorder *globalGLRecorder;
+
+template <typename T>
+FILE_SCOPE inline u8 *GLRecorderInternal_Put(u8 *ptr, const T val)
+{
+	memcpy(ptr, &val, sizeof(T));
+	return ptr + sizeof(T);
+}
+
+FILE_SCOPE inline u8 *GLRecorderInternal_PutBytes(u8 *ptr, const void *const src, const size_t size)
+{
+	if (size > 0) memcpy(ptr, src, size);
+	return ptr + size;
+}
+
+// Reserve a command in the log and count it towards the frame stats.
+// return: Pointer to payloadSize bytes in the log to write the command arguments into.
+FILE_SCOPE u8 *GLRecorderInternal_PushCmd(const enum GLRecorderCmd cmd, const size_t payloadSize)
+{
+	GLRecorder *recorder = globalGLRecorder;
+	DQN_ASSERT_HARD(recorder && payloadSize <= (u32)-1);
+
+	size_t cmdSize = GL_RECORDER_CMD_HEADER_SIZE + payloadSize;
+	if (recorder->logSize + cmdSize > recorder->logCapacity)
+	{
+		size_t newCapacity = DQN_MAX(recorder->logCapacity * 2, DQN_KILOBYTE(64));
+		while (newCapacity < recorder->logSize + cmdSize)
+			newCapacity *= 2;
+
+		u8 *newLog = (u8 *)DqnMem_Realloc(recorder->log, newCapacity);
+		DQN_ASSERT_HARD(newLog);
+		recorder->log         = newLog;
+		recorder->logCapacity = newCapacity;
+	}
+
+	u8 *result = recorder->log + recorder->logSize;
+	result     = GLRecorderInternal_Put(result, (u16)cmd);
+	result     = GLRecorderInternal_Put(result, (u32)payloadSize);
+	recorder->logSize += cmdSize;
+
+	const GLRecorderCmdInfo *info     = &globalGLRecorderCmdInfo[cmd];
+	GLRecorderFrameStats *frameStats  = &recorder->frameStats;
+	frameStats->numCalls++;
+	frameStats->numCallsPerCmd[cmd]++;
+	if (info->isStateChange) frameStats->numStateChanges++;
+	if (info->isDrawCall)    frameStats->numDrawCalls++;
+
+	return result;
+}
+
+FILE_SCOPE inline void GLRecorderInternal_CountUpload(const size_t numBytes)
+{
+	globalGLRecorder->frameStats.numBytesUploaded += numBytes;
+}
+
+// return: The size in bytes of the client memory glTexImage2D reads for the given image.
+FILE_SCOPE size_t GLRecorderInternal_TexImageSize(const GLsizei width, const GLsizei height,
+                                                  const GLenum format, const GLenum type)
+{
+	i32 numComponents = 0;
+	switch (format)
+	{
+		case GL_RED:  numComponents = 1; break;
+		case GL_RGB:  numComponents = 3; break;
+		case GL_RGBA: numComponents = 4; break;
+		default: DQN_ASSERT_MSG(DQN_INVALID_CODE_PATH, "Unhandled texture format: %d", format); break;
+	}
+
+	i32 componentSize = 0;
+	switch (type)
+	{
+		case GL_BYTE:
+		case GL_UNSIGNED_BYTE:  componentSize = 1; break;
+		case GL_SHORT:
+		case GL_UNSIGNED_SHORT: componentSize = 2; break;
+		case GL_INT:
+		case GL_UNSIGNED_INT:
+		case GL_FLOAT:          componentSize = 4; break;
+		default: DQN_ASSERT_MSG(DQN_INVALID_CODE_PATH, "Unhandled texture type: %d", type); break;
+	}
+
+	// NOTE: Each row starts on a multiple of GL_UNPACK_ALIGNMENT
+	size_t alignment = (size_t)globalGLRecorder->unpackAlignment;
+	size_t rowSize   = (size_t)(width * numComponents * componentSize);
+	rowSize          = (rowSize + alignment - 1) / alignment * alignment;
+	return rowSize * height;
+}
+
+FILE_SCOPE void GLRecorderInternal_GenIds(GLsizei n, GLuint *ids, const enum GLRecorderCmd cmd)
+{
+	for (GLsizei i = 0; i < n; i++)
+		ids[i] = globalGLRecorder->nextId++;
+
+	u8 *ptr = GLRecorderInternal_PushCmd(cmd, sizeof(n) + (sizeof(*ids) * n));
+	ptr     = GLRecorderInternal_Put(ptr, n);
+	ptr     = GLRecorderInternal_PutBytes(ptr, ids, sizeof(*ids) * n);
+}
+
+FILE_SCOPE void GLRecorderInternal_Object(GLuint object, const enum GLRecorderCmd cmd)
+{
+	u8 *ptr = GLRecorderInternal_PushCmd(cmd, sizeof(object));
+	ptr     = GLRecorderInternal_Put(ptr, object);
+}
+
+FILE_SCOPE void GLRecorderInternal_GetObjectiv(GLuint object, GLenum pname, GLint *params,
+                                               const enum GLRecorderCmd cmd)
+{
+	// NOTE: Report success for the compile and link status like the null GL. The recorder has no
+	// program binaries so the shader cache compiles from source, which keeps recordings replayable
+	// on any driver.
+	*params = (pname == GL_PROGRAM_BINARY_LENGTH) ? 0 : GL_TRUE;
+
+	u8 *ptr = GLRecorderInternal_PushCmd(cmd, sizeof(object) + sizeof(pname));
+	ptr     = GLRecorderInternal_Put(ptr, object);
+	ptr     = GLRecorderInternal_Put(ptr, pname);
+}
+
+FILE_SCOPE void GLRecorderInternal_GetObjectInfoLog(GLuint object, GLsizei bufSize, GLsizei *length,
+                                                    GLchar *infoLog, const enum GLRecorderCmd cmd)
+{
+	if (length) *length = 0;
+	if (infoLog && bufSize > 0) infoLog[0] = 0;
+
+	u8 *ptr = GLRecorderInternal_PushCmd(cmd, sizeof(object) + sizeof(bufSize));
+	ptr     = GLRecorderInternal_Put(ptr, object);
+	ptr     = GLRecorderInternal_Put(ptr, bufSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Reflection
+////////////////////////////////////////////////////////////////////////////////
+FILE_SCOPE GLRecorderShaderSource *GLRecorderInternal_FindShaderSource(const GLuint shader)
+{
+	for (u32 i = 0; i < GL_RECORDER_MAX_SHADERS; i++)
+	{
+		GLRecorderShaderSource *result = &globalGLRecorder->shaderSources[i];
+		if (result->shader == shader) return result;
+	}
+
+	return NULL;
+}
+
+// return: The program's slot, which is taken if create and it has none. NULL if there isn't one.
+FILE_SCOPE GLRecorderProgram *GLRecorderInternal_FindProgram(const GLuint program, const bool create)
+{
+	GLRecorderProgram *freeSlot = NULL;
+	for (u32 i = 0; i < GL_RECORDER_MAX_PROGRAMS; i++)
+	{
+		GLRecorderProgram *result = &globalGLRecorder->programs[i];
+		if (result->program == program) return result;
+		if (!freeSlot && result->program == 0) freeSlot = result;
+	}
+
+	if (!create || !freeSlot) return NULL;
+	*freeSlot         = {};
+	freeSlot->program = program;
+	return freeSlot;
+}
+
+struct GLRecorderToken
+{
+	const char *str;
+	i32         len; // 0 at the end of the source
+};
+
+// NOTE: Identifiers and numbers are one token, anything else is a token of one character. Comments
+// and preprocessor lines are skipped.
+FILE_SCOPE GLRecorderToken GLRecorderInternal_NextToken(const char **src)
+{
+	const char *ptr = *src;
+	for (;;)
+	{
+		while (*ptr == ' ' || *ptr == '\t' || *ptr == '\r' || *ptr == '\n') ptr++;
+		if ((ptr[0] == '/' && ptr[1] == '/') || ptr[0] == '#')
+		{
+			while (*ptr && *ptr != '\n') ptr++;
+		}
+		else if (ptr[0] == '/' && ptr[1] == '*')
+		{
+			ptr += 2;
+			while (*ptr && !(ptr[0] == '*' && ptr[1] == '/')) ptr++;
+			if (*ptr) ptr += 2;
+		}
+		else
+		{
+			break;
+		}
+	}
+
+	GLRecorderToken result = {ptr, 0};
+	if (*ptr)
+	{
+		while (DqnChar_IsAlpha(*ptr) || DqnChar_IsDigit(*ptr) || *ptr == '_') ptr++;
+		if (ptr == result.str) ptr++;
+		result.len = (i32)(ptr - result.str);
+	}
+
+	*src = ptr;
+	return result;
+}
+
+FILE_SCOPE bool GLRecorderInternal_TokenIs(const GLRecorderToken token, const char *const str)
+{
+	return (token.len == DqnStr_Len(str) && strncmp(token.str, str, token.len) == 0);
+}
+
+// Read an optional "[N]" after a name. Sizes that aren't a number, like a macro, are taken as 1.
+// return: The token after the array size.
+FILE_SCOPE GLRecorderToken GLRecorderInternal_ArraySize(const char **src, GLRecorderToken token, i32 *const size)
+{
+	*size = 1;
+	if (!GLRecorderInternal_TokenIs(token, "[")) return token;
+
+	token = GLRecorderInternal_NextToken(src);
+	if (token.len > 0 && DqnChar_IsDigit(token.str[0])) *size = DQN_MAX(1, (i32)Dqn_StrToI64(token.str, token.len));
+	while (token.len > 0 && !GLRecorderInternal_TokenIs(token, "]"))
+		token = GLRecorderInternal_NextToken(src);
+
+	return GLRecorderInternal_NextToken(src);
+}
+
+FILE_SCOPE void GLRecorderInternal_AddUniform(GLRecorderProgram *const program, const char *const name,
+                                              const i32 size)
+{
+	for (u32 i = 0; i < program->numUniforms; i++)
+	{
+		if (DqnStr_Cmp(program->uniforms[i].name, name) == 0) return;
+	}
+
+	if (program->numUniforms >= GL_RECORDER_MAX_UNIFORMS) return;
+	GLRecorderUniform *uniform = &program->uniforms[program->numUniforms++];
+	snprintf(uniform->name, sizeof(uniform->name), "%s", name);
+	uniform->size = size;
+}
+
+#define GL_RECORDER_MAX_STRUCTS        8
+#define GL_RECORDER_MAX_STRUCT_MEMBERS 16
+struct GLRecorderStruct
+{
+	GLRecorderToken name;
+	GLRecorderToken memberNames[GL_RECORDER_MAX_STRUCT_MEMBERS];
+	i32             memberSizes[GL_RECORDER_MAX_STRUCT_MEMBERS];
+	u32             numMembers;
+};
+
+// Add the default block uniforms declared in source to the program, expanding structs into a uniform
+// for each member like a driver's reflection does.
+FILE_SCOPE void GLRecorderInternal_ReflectSource(GLRecorderProgram *const program, const char *source)
+{
+	GLRecorderStruct structs[GL_RECORDER_MAX_STRUCTS];
+	u32 numStructs = 0;
+
+	GLRecorderToken token = GLRecorderInternal_NextToken(&source);
+	while (token.len > 0)
+	{
+		if (GLRecorderInternal_TokenIs(token, "struct") && numStructs < GL_RECORDER_MAX_STRUCTS)
+		{
+			GLRecorderStruct *glslStruct = &structs[numStructs++];
+			glslStruct->name             = GLRecorderInternal_NextToken(&source);
+			glslStruct->numMembers       = 0;
+
+			// NOTE: Members are "type name[N];", skip to the start of the body then read them until its end
+			token = GLRecorderInternal_NextToken(&source);
+			while (token.len > 0 && !GLRecorderInternal_TokenIs(token, "{"))
+				token = GLRecorderInternal_NextToken(&source);
+
+			token = GLRecorderInternal_NextToken(&source);
+			while (token.len > 0 && !GLRecorderInternal_TokenIs(token, "}"))
+			{
+				GLRecorderToken name = GLRecorderInternal_NextToken(&source);
+				i32 size;
+				token = GLRecorderInternal_ArraySize(&source, GLRecorderInternal_NextToken(&source), &size);
+				if (glslStruct->numMembers < GL_RECORDER_MAX_STRUCT_MEMBERS)
+				{
+					glslStruct->memberNames[glslStruct->numMembers] = name;
+					glslStruct->memberSizes[glslStruct->numMembers] = size;
+					glslStruct->numMembers++;
+				}
+
+				while (token.len > 0 && !GLRecorderInternal_TokenIs(token, ";"))
+					token = GLRecorderInternal_NextToken(&source);
+				token = GLRecorderInternal_NextToken(&source);
+			}
+		}
+		else if (GLRecorderInternal_TokenIs(token, "uniform"))
+		{
+			GLRecorderToken type = GLRecorderInternal_NextToken(&source);
+			while (GLRecorderInternal_TokenIs(type, "lowp") || GLRecorderInternal_TokenIs(type, "mediump") ||
+			       GLRecorderInternal_TokenIs(type, "highp"))
+			{
+				type = GLRecorderInternal_NextToken(&source);
+			}
+
+			GLRecorderToken name = GLRecorderInternal_NextToken(&source);
+			if (GLRecorderInternal_TokenIs(name, "{"))
+			{
+				// NOTE: A uniform block, its members aren't in the default block
+				while (token.len > 0 && !GLRecorderInternal_TokenIs(token, "}"))
+					token = GLRecorderInternal_NextToken(&source);
+			}
+			else if (name.len > 0)
+			{
+				i32 size;
+				token = GLRecorderInternal_ArraySize(&source, GLRecorderInternal_NextToken(&source), &size);
+
+				GLRecorderStruct *glslStruct = NULL;
+				for (u32 i = 0; i < numStructs && !glslStruct; i++)
+				{
+					if (structs[i].name.len == type.len && strncmp(structs[i].name.str, type.str, type.len) == 0)
+						glslStruct = &structs[i];
+				}
+
+				char uniformName[GL_RECORDER_MAX_UNIFORM_NAME];
+				if (glslStruct)
+				{
+					for (i32 element = 0; element < size; element++)
+					{
+						for (u32 i = 0; i < glslStruct->numMembers; i++)
+						{
+							GLRecorderToken member = glslStruct->memberNames[i];
+							i32 memberSize         = glslStruct->memberSizes[i];
+							const char *suffix     = (memberSize > 1) ? "[0]" : "";
+							if (size > 1)
+							{
+								snprintf(uniformName, sizeof(uniformName), "%.*s[%d].%.*s%s", name.len, name.str,
+								         element, member.len, member.str, suffix);
+							}
+							else
+							{
+								snprintf(uniformName, sizeof(uniformName), "%.*s.%.*s%s", name.len, name.str,
+								         member.len, member.str, suffix);
+							}
+							GLRecorderInternal_AddUniform(program, uniformName, memberSize);
+						}
+					}
+				}
+				else
+				{
+					snprintf(uniformName, sizeof(uniformName), "%.*s%s", name.len, name.str, (size > 1) ? "[0]" : "");
+					GLRecorderInternal_AddUniform(program, uniformName, size);
+				}
+				continue;
+			}
+		}
+
+		token = GLRecorderInternal_NextToken(&source);
+	}
+}
+
+FILE_SCOPE void GLRecorderInternal_ReflectProgram(GLRecorderProgram *const program)
+{
+	program->numUniforms = 0;
+	for (u32 i = 0; i < program->numShaders; i++)
+	{
+		GLRecorderShaderSource *shaderSource = GLRecorderInternal_FindShaderSource(program->shaders[i]);
+		if (shaderSource && shaderSource->source) GLRecorderInternal_ReflectSource(program, shaderSource->source);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Thunks
+////////////////////////////////////////////////////////////////////////////////
+// GL 1.1
+FILE_SCOPE GLenum GLRecorder_glGetError(void)
+{
+	GLRecorderInternal_PushCmd(GLRecorderCmd_glGetError, 0);
+	return GL_NO_ERROR;
+}
+
+FILE_SCOPE const GLubyte *GLRecorder_glGetString(GLenum name)
+{
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glGetString, sizeof(name));
+	ptr     = GLRecorderInternal_Put(ptr, name);
+	return (const GLubyte *)"GL Recorder";
+}
+
+// NOTE: Every integer is reported as 0, so the recorder has no extensions and recordings don't
+// depend on any
+FILE_SCOPE void GLRecorder_glGetIntegerv(GLenum pname, GLint *data)
+{
+	*data   = 0;
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glGetIntegerv, sizeof(pname));
+	ptr     = GLRecorderInternal_Put(ptr, pname);
+}
+
+FILE_SCOPE void GLRecorder_glClear(GLbitfield mask)
+{
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glClear, sizeof(mask));
+	ptr     = GLRecorderInternal_Put(ptr, mask);
+}
+
+FILE_SCOPE void GLRecorder_glClearColor(GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha)
+{
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glClearColor, sizeof(GLclampf) * 4);
+	ptr     = GLRecorderInternal_Put(ptr, red);
+	ptr     = GLRecorderInternal_Put(ptr, green);
+	ptr     = GLRecorderInternal_Put(ptr, blue);
+	ptr     = GLRecorderInternal_Put(ptr, alpha);
+}
+
+FILE_SCOPE void GLRecorder_glEnable(GLenum cap)
+{
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glEnable, sizeof(cap));
+	ptr     = GLRecorderInternal_Put(ptr, cap);
+}
+
+FILE_SCOPE void GLRecorder_glDisable(GLenum cap)
+{
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glDisable, sizeof(cap));
+	ptr     = GLRecorderInternal_Put(ptr, cap);
+}
+
+FILE_SCOPE void GLRecorder_glPolygonMode(GLenum face, GLenum mode)
+{
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glPolygonMode, sizeof(face) + sizeof(mode));
+	ptr     = GLRecorderInternal_Put(ptr, face);
+	ptr     = GLRecorderInternal_Put(ptr, mode);
+}
+
+FILE_SCOPE void GLRecorder_glViewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glViewport, sizeof(GLint) * 4);
+	ptr     = GLRecorderInternal_Put(ptr, x);
+	ptr     = GLRecorderInternal_Put(ptr, y);
+	ptr     = GLRecorderInternal_Put(ptr, width);
+	ptr     = GLRecorderInternal_Put(ptr, height);
+}
+
+FILE_SCOPE void GLRecorder_glPixelStorei(GLenum pname, GLint param)
+{
+	if (pname == GL_UNPACK_ALIGNMENT) globalGLRecorder->unpackAlignment = param;
+
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glPixelStorei, sizeof(pname) + sizeof(param));
+	ptr     = GLRecorderInternal_Put(ptr, pname);
+	ptr     = GLRecorderInternal_Put(ptr, param);
+}
+
+FILE_SCOPE void GLRecorder_glDrawArrays(GLenum mode, GLint first, GLsizei count)
+{
+	globalGLRecorder->frameStats.numInstances++;
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glDrawArrays, sizeof(mode) + sizeof(first) + sizeof(count));
+	ptr     = GLRecorderInternal_Put(ptr, mode);
+	ptr     = GLRecorderInternal_Put(ptr, first);
+	ptr     = GLRecorderInternal_Put(ptr, count);
+}
+
+FILE_SCOPE void GLRecorder_glGenTextures(GLsizei n, GLuint *textures)
+{
+	GLRecorderInternal_GenIds(n, textures, GLRecorderCmd_glGenTextures);
+}
+
+FILE_SCOPE void GLRecorder_glDeleteTextures(GLsizei n, const GLuint *textures)
+{
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glDeleteTextures, sizeof(n) + (sizeof(*textures) * n));
+	ptr     = GLRecorderInternal_Put(ptr, n);
+	ptr     = GLRecorderInternal_PutBytes(ptr, textures, sizeof(*textures) * n);
+}
+
+FILE_SCOPE void GLRecorder_glBindTexture(GLenum target, GLuint texture)
+{
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glBindTexture, sizeof(target) + sizeof(texture));
+	ptr     = GLRecorderInternal_Put(ptr, target);
+	ptr     = GLRecorderInternal_Put(ptr, texture);
+}
+
+FILE_SCOPE void GLRecorder_glTexParameteri(GLenum target, GLenum pname, GLint param)
+{
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glTexParameteri, sizeof(target) + sizeof(pname) + sizeof(param));
+	ptr     = GLRecorderInternal_Put(ptr, target);
+	ptr     = GLRecorderInternal_Put(ptr, pname);
+	ptr     = GLRecorderInternal_Put(ptr, param);
+}
+
+FILE_SCOPE void GLRecorder_glTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width,
+                                        GLsizei height, GLint border, GLenum format, GLenum type,
+                                        const void *pixels)
+{
+	// NOTE: Pixels sourced from a pixel unpack buffer were logged when the buffer was filled, only the
+	// offset into the buffer is needed to replay the call
+	u8  fromUnpackBuffer = (globalGLRecorder->pixelUnpackBuffer != 0);
+	u32 pixelsSize       = 0;
+	if (pixels && !fromUnpackBuffer) pixelsSize = (u32)GLRecorderInternal_TexImageSize(width, height, format, type);
+	GLRecorderInternal_CountUpload(pixelsSize);
+
+	size_t payloadSize = sizeof(target) + sizeof(level) + sizeof(internalformat) + sizeof(width) +
+	                     sizeof(height) + sizeof(border) + sizeof(format) + sizeof(type) +
+	                     sizeof(fromUnpackBuffer) + sizeof(i64) + sizeof(pixelsSize) + pixelsSize;
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glTexImage2D, payloadSize);
+	ptr     = GLRecorderInternal_Put(ptr, target);
+	ptr     = GLRecorderInternal_Put(ptr, level);
+	ptr     = GLRecorderInternal_Put(ptr, internalformat);
+	ptr     = GLRecorderInternal_Put(ptr, width);
+	ptr     = GLRecorderInternal_Put(ptr, height);
+	ptr     = GLRecorderInternal_Put(ptr, border);
+	ptr     = GLRecorderInternal_Put(ptr, format);
+	ptr     = GLRecorderInternal_Put(ptr, type);
+	ptr     = GLRecorderInternal_Put(ptr, fromUnpackBuffer);
+	ptr     = GLRecorderInternal_Put(ptr, (fromUnpackBuffer) ? (i64)(size_t)pixels : (i64)0);
+	ptr     = GLRecorderInternal_Put(ptr, pixelsSize);
+	ptr     = GLRecorderInternal_PutBytes(ptr, pixels, pixelsSize);
+}
+
+// GL 1.3
+FILE_SCOPE void GLRecorder_glActiveTexture(GLenum texture)
+{
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glActiveTexture, sizeof(texture));
+	ptr     = GLRecorderInternal_Put(ptr, texture);
+}
+
+FILE_SCOPE void GLRecorder_glCompressedTexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width,
+                                                  GLsizei height, GLint border, GLsizei imageSize, const void *data)
+{
+	// NOTE: Same as glTexImage2D(), data sourced from a pixel unpack buffer is an offset into it
+	u8  fromUnpackBuffer = (globalGLRecorder->pixelUnpackBuffer != 0);
+	u32 dataSize         = (data && !fromUnpackBuffer) ? (u32)imageSize : 0;
+	GLRecorderInternal_CountUpload(dataSize);
+
+	size_t payloadSize = sizeof(target) + sizeof(level) + sizeof(internalformat) + sizeof(width) +
+	                     sizeof(height) + sizeof(border) + sizeof(imageSize) + sizeof(fromUnpackBuffer) +
+	                     sizeof(i64) + sizeof(dataSize) + dataSize;
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glCompressedTexImage2D, payloadSize);
+	ptr     = GLRecorderInternal_Put(ptr, target);
+	ptr     = GLRecorderInternal_Put(ptr, level);
+	ptr     = GLRecorderInternal_Put(ptr, internalformat);
+	ptr     = GLRecorderInternal_Put(ptr, width);
+	ptr     = GLRecorderInternal_Put(ptr, height);
+	ptr     = GLRecorderInternal_Put(ptr, border);
+	ptr     = GLRecorderInternal_Put(ptr, imageSize);
+	ptr     = GLRecorderInternal_Put(ptr, fromUnpackBuffer);
+	ptr     = GLRecorderInternal_Put(ptr, (fromUnpackBuffer) ? (i64)(size_t)data : (i64)0);
+	ptr     = GLRecorderInternal_Put(ptr, dataSize);
+	ptr     = GLRecorderInternal_PutBytes(ptr, data, dataSize);
+}
+
+// GL 1.5
+FILE_SCOPE void GLRecorder_glGenBuffers(GLsizei n, GLuint *buffers)
+{
+	GLRecorderInternal_GenIds(n, buffers, GLRecorderCmd_glGenBuffers);
+}
+
+FILE_SCOPE void GLRecorder_glBindBuffer(GLenum target, GLuint buffer)
+{
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glBindBuffer, sizeof(target) + sizeof(buffer));
+	ptr     = GLRecorderInternal_Put(ptr, target);
+	ptr     = GLRecorderInternal_Put(ptr, buffer);
+
+	if (target == GL_PIXEL_UNPACK_BUFFER) globalGLRecorder->pixelUnpackBuffer = buffer;
+}
+
+FILE_SCOPE void GLRecorder_glBufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage)
+{
+	u8 hasData = (data != NULL);
+	size_t dataSize = (hasData) ? (size_t)size : 0;
+	GLRecorderInternal_CountUpload(dataSize);
+
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glBufferData, sizeof(target) + sizeof(i64) + sizeof(usage) +
+	                                                                  sizeof(hasData) + dataSize);
+	ptr     = GLRecorderInternal_Put(ptr, target);
+	ptr     = GLRecorderInternal_Put(ptr, (i64)size);
+	ptr     = GLRecorderInternal_Put(ptr, usage);
+	ptr     = GLRecorderInternal_Put(ptr, hasData);
+	ptr     = GLRecorderInternal_PutBytes(ptr, data, dataSize);
+}
+
+FILE_SCOPE void GLRecorder_glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void *data)
+{
+	GLRecorderInternal_CountUpload((size_t)size);
+
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glBufferSubData, sizeof(target) + sizeof(i64) + sizeof(i64) + size);
+	ptr     = GLRecorderInternal_Put(ptr, target);
+	ptr     = GLRecorderInternal_Put(ptr, (i64)offset);
+	ptr     = GLRecorderInternal_Put(ptr, (i64)size);
+	ptr     = GLRecorderInternal_PutBytes(ptr, data, (size_t)size);
+}
+
+FILE_SCOPE GLboolean GLRecorder_glUnmapBuffer(GLenum target)
+{
+	GLRecorder *recorder = globalGLRecorder;
+	if (!DQN_ASSERT_MSG(recorder->isMapped && recorder->mapTarget == target, "target: %x is not mapped", target))
+		return GL_FALSE;
+
+	// NOTE: The whole mapped range is logged, the recorder can't know which bytes were written
+	size_t size = recorder->mapSize;
+	GLRecorderInternal_CountUpload(size);
+
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glUnmapBuffer, sizeof(target) + sizeof(i64) + size);
+	ptr     = GLRecorderInternal_Put(ptr, target);
+	ptr     = GLRecorderInternal_Put(ptr, (i64)size);
+	ptr     = GLRecorderInternal_PutBytes(ptr, recorder->mapMemory, size);
+
+	recorder->isMapped = false;
+	return GL_TRUE;
+}
+
+// GL 2.0
+FILE_SCOPE GLuint GLRecorder_glCreateShader(GLenum type)
+{
+	GLuint result = globalGLRecorder->nextId++;
+	u8 *ptr       = GLRecorderInternal_PushCmd(GLRecorderCmd_glCreateShader, sizeof(type) + sizeof(result));
+	ptr           = GLRecorderInternal_Put(ptr, type);
+	ptr           = GLRecorderInternal_Put(ptr, result);
+	return result;
+}
+
+FILE_SCOPE void GLRecorder_glShaderSource(GLuint shader, GLsizei count, GLchar **string, const GLint *length)
+{
+	DQN_ASSERT_HARD(count <= GL_RECORDER_MAX_SHADER_SOURCE_STRINGS);
+
+	// NOTE: Strings are stored without their null terminator, prefixed by their length
+	size_t payloadSize = sizeof(shader) + sizeof(count);
+	for (GLsizei i = 0; i < count; i++)
+	{
+		u32 stringLen = (length && length[i] >= 0) ? (u32)length[i] : (u32)DqnStr_Len(string[i]);
+		payloadSize += sizeof(stringLen) + stringLen;
+	}
+
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glShaderSource, payloadSize);
+	ptr     = GLRecorderInternal_Put(ptr, shader);
+	ptr     = GLRecorderInternal_Put(ptr, count);
+	for (GLsizei i = 0; i < count; i++)
+	{
+		u32 stringLen = (length && length[i] >= 0) ? (u32)length[i] : (u32)DqnStr_Len(string[i]);
+		ptr           = GLRecorderInternal_Put(ptr, stringLen);
+		ptr           = GLRecorderInternal_PutBytes(ptr, string[i], stringLen);
+	}
+
+	// NOTE: Keep the source until the shader is deleted for glLinkProgram() to reflect
+	GLRecorderShaderSource *shaderSource = GLRecorderInternal_FindShaderSource(shader);
+	if (!shaderSource) shaderSource = GLRecorderInternal_FindShaderSource(0);
+	if (!shaderSource) return;
+
+	size_t sourceSize = payloadSize - sizeof(shader) - sizeof(count) - (sizeof(u32) * count) + 1;
+	char *source      = (char *)DqnMem_Realloc(shaderSource->source, sourceSize);
+	if (!source) return;
+
+	shaderSource->shader = shader;
+	shaderSource->source = source;
+	for (GLsizei i = 0; i < count; i++)
+	{
+		u32 stringLen = (length && length[i] >= 0) ? (u32)length[i] : (u32)DqnStr_Len(string[i]);
+		memcpy(source, string[i], stringLen);
+		source += stringLen;
+	}
+	*source = 0;
+}
+
+FILE_SCOPE void GLRecorder_glCompileShader(GLuint shader)
+{
+	GLRecorderInternal_Object(shader, GLRecorderCmd_glCompileShader);
+}
+
+FILE_SCOPE void GLRecorder_glGetShaderiv(GLuint shader, GLenum pname, GLint *params)
+{
+	GLRecorderInternal_GetObjectiv(shader, pname, params, GLRecorderCmd_glGetShaderiv);
+}
+
+FILE_SCOPE void GLRecorder_glGetShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *infoLog)
+{
+	GLRecorderInternal_GetObjectInfoLog(shader, bufSize, length, infoLog, GLRecorderCmd_glGetShaderInfoLog);
+}
+
+FILE_SCOPE GLuint GLRecorder_glCreateProgram(void)
+{
+	GLuint result = globalGLRecorder->nextId++;
+	GLRecorderInternal_Object(result, GLRecorderCmd_glCreateProgram);
+	return result;
+}
+
+FILE_SCOPE void GLRecorder_glAttachShader(GLuint program, GLuint shader)
+{
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glAttachShader, sizeof(program) + sizeof(shader));
+	ptr     = GLRecorderInternal_Put(ptr, program);
+	ptr     = GLRecorderInternal_Put(ptr, shader);
+
+	GLRecorderProgram *recorderProgram = GLRecorderInternal_FindProgram(program, true);
+	if (recorderProgram && recorderProgram->numShaders < GL_RECORDER_MAX_PROGRAM_SHADERS)
+		recorderProgram->shaders[recorderProgram->numShaders++] = shader;
+}
+
+FILE_SCOPE void GLRecorder_glLinkProgram(GLuint program)
+{
+	GLRecorderInternal_Object(program, GLRecorderCmd_glLinkProgram);
+
+	GLRecorderProgram *recorderProgram = GLRecorderInternal_FindProgram(program, false);
+	if (recorderProgram) GLRecorderInternal_ReflectProgram(recorderProgram);
+}
+
+FILE_SCOPE void GLRecorder_glUseProgram(GLuint program)
+{
+	GLRecorderInternal_Object(program, GLRecorderCmd_glUseProgram);
+}
+
+FILE_SCOPE void GLRecorder_glDeleteShader(GLuint shader)
+{
+	GLRecorderInternal_Object(shader, GLRecorderCmd_glDeleteShader);
+
+	GLRecorderShaderSource *shaderSource = (shader != 0) ? GLRecorderInternal_FindShaderSource(shader) : NULL;
+	if (shaderSource)
+	{
+		DqnMem_Free(shaderSource->source);
+		*shaderSource = {};
+	}
+}
+
+FILE_SCOPE void GLRecorder_glDeleteProgram(GLuint program)
+{
+	GLRecorderInternal_Object(program, GLRecorderCmd_glDeleteProgram);
+
+	GLRecorderProgram *recorderProgram = (program != 0) ? GLRecorderInternal_FindProgram(program, false) : NULL;
+	if (recorderProgram) *recorderProgram = {};
+}
+
+FILE_SCOPE void GLRecorder_glGetProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei *length, GLchar *infoLog)
+{
+	GLRecorderInternal_GetObjectInfoLog(program, bufSize, length, infoLog, GLRecorderCmd_glGetProgramInfoLog);
+}
+
+FILE_SCOPE void GLRecorder_glGetProgramiv(GLuint program, GLenum pname, GLint *params)
+{
+	GLRecorderInternal_GetObjectiv(program, pname, params, GLRecorderCmd_glGetProgramiv);
+	if (pname == GL_ACTIVE_UNIFORMS)
+	{
+		GLRecorderProgram *recorderProgram = GLRecorderInternal_FindProgram(program, false);
+		*params                            = recorderProgram ? (GLint)recorderProgram->numUniforms : 0;
+	}
+}
+
+// NOTE: The type isn't reflected, it's reported as 0
+FILE_SCOPE void GLRecorder_glGetActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei *length,
+                                              GLint *size, GLenum *type, GLchar *name)
+{
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glGetActiveUniform,
+	                                     sizeof(program) + sizeof(index) + sizeof(bufSize));
+	ptr     = GLRecorderInternal_Put(ptr, program);
+	ptr     = GLRecorderInternal_Put(ptr, index);
+	ptr     = GLRecorderInternal_Put(ptr, bufSize);
+
+	GLRecorderProgram *recorderProgram = GLRecorderInternal_FindProgram(program, false);
+	const GLRecorderUniform *uniform   = NULL;
+	if (recorderProgram && index < recorderProgram->numUniforms) uniform = &recorderProgram->uniforms[index];
+
+	GLsizei nameLen = 0;
+	if (uniform && bufSize > 0) nameLen = (GLsizei)snprintf(name, bufSize, "%s", uniform->name);
+	else if (bufSize > 0)       name[0] = 0;
+
+	if (length) *length = DQN_MIN(nameLen, DQN_MAX(0, bufSize - 1));
+	*size = uniform ? uniform->size : 0;
+	*type = 0;
+}
+
+FILE_SCOPE GLint GLRecorder_glGetUniformLocation(GLuint program, const GLchar *name)
+{
+	GLint result   = (GLint)globalGLRecorder->nextId++;
+	u32 nameLen    = (u32)DqnStr_Len(name);
+
+	// NOTE: Name is stored with its null terminator so replay can pass it straight from the log
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glGetUniformLocation,
+	                                     sizeof(program) + sizeof(result) + nameLen + 1);
+	ptr     = GLRecorderInternal_Put(ptr, program);
+	ptr     = GLRecorderInternal_Put(ptr, result);
+	ptr     = GLRecorderInternal_PutBytes(ptr, name, nameLen + 1);
+	return result;
+}
+
+FILE_SCOPE void GLRecorder_glUniform1f(GLint location, GLfloat v0)
+{
+	GLRecorderInternal_CountUpload(sizeof(v0));
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glUniform1f, sizeof(location) + sizeof(v0));
+	ptr     = GLRecorderInternal_Put(ptr, location);
+	ptr     = GLRecorderInternal_Put(ptr, v0);
+}
+
+FILE_SCOPE void GLRecorder_glUniform1i(GLint location, GLint v0)
+{
+	GLRecorderInternal_CountUpload(sizeof(v0));
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glUniform1i, sizeof(location) + sizeof(v0));
+	ptr     = GLRecorderInternal_Put(ptr, location);
+	ptr     = GLRecorderInternal_Put(ptr, v0);
+}
+
+FILE_SCOPE void GLRecorder_glUniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2)
+{
+	GLRecorderInternal_CountUpload(sizeof(GLfloat) * 3);
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glUniform3f, sizeof(location) + (sizeof(GLfloat) * 3));
+	ptr     = GLRecorderInternal_Put(ptr, location);
+	ptr     = GLRecorderInternal_Put(ptr, v0);
+	ptr     = GLRecorderInternal_Put(ptr, v1);
+	ptr     = GLRecorderInternal_Put(ptr, v2);
+}
+
+FILE_SCOPE void GLRecorder_glUniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3)
+{
+	GLRecorderInternal_CountUpload(sizeof(GLfloat) * 4);
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glUniform4f, sizeof(location) + (sizeof(GLfloat) * 4));
+	ptr     = GLRecorderInternal_Put(ptr, location);
+	ptr     = GLRecorderInternal_Put(ptr, v0);
+	ptr     = GLRecorderInternal_Put(ptr, v1);
+	ptr     = GLRecorderInternal_Put(ptr, v2);
+	ptr     = GLRecorderInternal_Put(ptr, v3);
+}
+
+FILE_SCOPE void GLRecorder_glUniform3fv(GLint location, GLsizei count, const GLfloat *value)
+{
+	size_t valueSize = sizeof(GLfloat) * 3 * count;
+	GLRecorderInternal_CountUpload(valueSize);
+
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glUniform3fv, sizeof(location) + sizeof(count) + valueSize);
+	ptr     = GLRecorderInternal_Put(ptr, location);
+	ptr     = GLRecorderInternal_Put(ptr, count);
+	ptr     = GLRecorderInternal_PutBytes(ptr, value, valueSize);
+}
+
+FILE_SCOPE void GLRecorder_glUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+{
+	size_t valueSize = sizeof(GLfloat) * 16 * count;
+	GLRecorderInternal_CountUpload(valueSize);
+
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glUniformMatrix4fv,
+	                                     sizeof(location) + sizeof(count) + sizeof(transpose) + valueSize);
+	ptr     = GLRecorderInternal_Put(ptr, location);
+	ptr     = GLRecorderInternal_Put(ptr, count);
+	ptr     = GLRecorderInternal_Put(ptr, transpose);
+	ptr     = GLRecorderInternal_PutBytes(ptr, value, valueSize);
+}
+
+FILE_SCOPE void GLRecorder_glEnableVertexAttribArray(GLuint index)
+{
+	GLRecorderInternal_Object(index, GLRecorderCmd_glEnableVertexAttribArray);
+}
+
+FILE_SCOPE void GLRecorder_glDisableVertexAttribArray(GLuint index)
+{
+	GLRecorderInternal_Object(index, GLRecorderCmd_glDisableVertexAttribArray);
+}
+
+FILE_SCOPE void GLRecorder_glVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized,
+                                                 GLsizei stride, const void *pointer)
+{
+	// NOTE: With a buffer bound pointer is an offset into it, client side arrays aren't supported
+	u64 offset = (u64)(uintptr_t)pointer;
+
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glVertexAttribPointer,
+	                                     sizeof(index) + sizeof(size) + sizeof(type) + sizeof(normalized) +
+	                                         sizeof(stride) + sizeof(offset));
+	ptr     = GLRecorderInternal_Put(ptr, index);
+	ptr     = GLRecorderInternal_Put(ptr, size);
+	ptr     = GLRecorderInternal_Put(ptr, type);
+	ptr     = GLRecorderInternal_Put(ptr, normalized);
+	ptr     = GLRecorderInternal_Put(ptr, stride);
+	ptr     = GLRecorderInternal_Put(ptr, offset);
+}
+
+// GL 3.0
+FILE_SCOPE const GLubyte *GLRecorder_glGetStringi(GLenum name, GLuint index)
+{
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glGetStringi, sizeof(name) + sizeof(index));
+	ptr     = GLRecorderInternal_Put(ptr, name);
+	ptr     = GLRecorderInternal_Put(ptr, index);
+	return NULL;
+}
+
+FILE_SCOPE void GLRecorder_glGenVertexArrays(GLsizei n, GLuint *arrays)
+{
+	GLRecorderInternal_GenIds(n, arrays, GLRecorderCmd_glGenVertexArrays);
+}
+
+FILE_SCOPE void GLRecorder_glBindVertexArray(GLuint array)
+{
+	GLRecorderInternal_Object(array, GLRecorderCmd_glBindVertexArray);
+}
+
+FILE_SCOPE void GLRecorder_glGenerateMipmap(GLenum target)
+{
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glGenerateMipmap, sizeof(target));
+	ptr     = GLRecorderInternal_Put(ptr, target);
+}
+
+FILE_SCOPE void GLRecorder_glBindBufferBase(GLenum target, GLuint index, GLuint buffer)
+{
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glBindBufferBase, sizeof(target) + sizeof(index) + sizeof(buffer));
+	ptr     = GLRecorderInternal_Put(ptr, target);
+	ptr     = GLRecorderInternal_Put(ptr, index);
+	ptr     = GLRecorderInternal_Put(ptr, buffer);
+}
+
+FILE_SCOPE void *GLRecorder_glMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+	GLRecorder *recorder = globalGLRecorder;
+	if (!DQN_ASSERT_MSG(!recorder->isMapped, "Only one buffer can be mapped at a time")) return NULL;
+
+	if ((size_t)length > recorder->mapCapacity)
+	{
+		u8 *newMemory = (u8 *)DqnMem_Realloc(recorder->mapMemory, (size_t)length);
+		if (!newMemory) return NULL;
+
+		recorder->mapMemory   = newMemory;
+		recorder->mapCapacity = (size_t)length;
+	}
+
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glMapBufferRange, sizeof(target) + sizeof(i64) + sizeof(i64) + sizeof(access));
+	ptr     = GLRecorderInternal_Put(ptr, target);
+	ptr     = GLRecorderInternal_Put(ptr, (i64)offset);
+	ptr     = GLRecorderInternal_Put(ptr, (i64)length);
+	ptr     = GLRecorderInternal_Put(ptr, access);
+
+	recorder->mapSize   = (size_t)length;
+	recorder->mapTarget = target;
+	recorder->isMapped  = true;
+	return recorder->mapMemory;
+}
+
+// GL 3.1
+FILE_SCOPE GLuint GLRecorder_glGetUniformBlockIndex(GLuint program, const GLchar *uniformBlockName)
+{
+	GLuint result = globalGLRecorder->nextId++;
+	u32 nameLen   = (u32)DqnStr_Len(uniformBlockName);
+
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glGetUniformBlockIndex,
+	                                     sizeof(program) + sizeof(result) + nameLen + 1);
+	ptr     = GLRecorderInternal_Put(ptr, program);
+	ptr     = GLRecorderInternal_Put(ptr, result);
+	ptr     = GLRecorderInternal_PutBytes(ptr, uniformBlockName, nameLen + 1);
+	return result;
+}
+
+FILE_SCOPE void GLRecorder_glUniformBlockBinding(GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding)
+{
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glUniformBlockBinding,
+	                                     sizeof(program) + sizeof(uniformBlockIndex) + sizeof(uniformBlockBinding));
+	ptr     = GLRecorderInternal_Put(ptr, program);
+	ptr     = GLRecorderInternal_Put(ptr, uniformBlockIndex);
+	ptr     = GLRecorderInternal_Put(ptr, uniformBlockBinding);
+}
+
+FILE_SCOPE void GLRecorder_glDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instancecount)
+{
+	globalGLRecorder->frameStats.numInstances += instancecount;
+
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glDrawArraysInstanced,
+	                                     sizeof(mode) + sizeof(first) + sizeof(count) + sizeof(instancecount));
+	ptr     = GLRecorderInternal_Put(ptr, mode);
+	ptr     = GLRecorderInternal_Put(ptr, first);
+	ptr     = GLRecorderInternal_Put(ptr, count);
+	ptr     = GLRecorderInternal_Put(ptr, instancecount);
+}
+
+FILE_SCOPE void GLRecorder_glDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void *indices,
+                                                   GLsizei instancecount)
+{
+	globalGLRecorder->frameStats.numInstances += instancecount;
+
+	// NOTE: With an element buffer bound indices is an offset into it, client side arrays aren't supported
+	u64 offset = (u64)(uintptr_t)indices;
+
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glDrawElementsInstanced,
+	                                     sizeof(mode) + sizeof(count) + sizeof(type) + sizeof(offset) + sizeof(instancecount));
+	ptr     = GLRecorderInternal_Put(ptr, mode);
+	ptr     = GLRecorderInternal_Put(ptr, count);
+	ptr     = GLRecorderInternal_Put(ptr, type);
+	ptr     = GLRecorderInternal_Put(ptr, offset);
+	ptr     = GLRecorderInternal_Put(ptr, instancecount);
+}
+
+// GL 3.2
+// NOTE: Fences are handed out from the id counter, the GPU has always finished by the time they're
+// waited on
+FILE_SCOPE GLsync GLRecorder_glFenceSync(GLenum condition, GLbitfield flags)
+{
+	GLuint id = globalGLRecorder->nextId++;
+	u8 *ptr   = GLRecorderInternal_PushCmd(GLRecorderCmd_glFenceSync, sizeof(id) + sizeof(condition) + sizeof(flags));
+	ptr       = GLRecorderInternal_Put(ptr, id);
+	ptr       = GLRecorderInternal_Put(ptr, condition);
+	ptr       = GLRecorderInternal_Put(ptr, flags);
+	return (GLsync)(uintptr_t)id;
+}
+
+FILE_SCOPE GLenum GLRecorder_glClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout)
+{
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glClientWaitSync, sizeof(GLuint) + sizeof(flags) + sizeof(u64));
+	ptr     = GLRecorderInternal_Put(ptr, (GLuint)(uintptr_t)sync);
+	ptr     = GLRecorderInternal_Put(ptr, flags);
+	ptr     = GLRecorderInternal_Put(ptr, (u64)timeout);
+	return GL_ALREADY_SIGNALED;
+}
+
+FILE_SCOPE void GLRecorder_glDeleteSync(GLsync sync)
+{
+	GLRecorderInternal_Object((GLuint)(uintptr_t)sync, GLRecorderCmd_glDeleteSync);
+}
+
+// GL 3.3
+FILE_SCOPE void GLRecorder_glVertexAttribDivisor(GLuint index, GLuint divisor)
+{
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glVertexAttribDivisor, sizeof(index) + sizeof(divisor));
+	ptr     = GLRecorderInternal_Put(ptr, index);
+	ptr     = GLRecorderInternal_Put(ptr, divisor);
+}
+
+// GL 4.1
+FILE_SCOPE void GLRecorder_glGetProgramBinary(GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat,
+                                              void *)
+{
+	if (length) *length = 0;
+	*binaryFormat = 0;
+
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glGetProgramBinary, sizeof(program) + sizeof(bufSize));
+	ptr     = GLRecorderInternal_Put(ptr, program);
+	ptr     = GLRecorderInternal_Put(ptr, bufSize);
+}
+
+FILE_SCOPE void GLRecorder_glProgramBinary(GLuint program, GLenum binaryFormat, const void *binary, GLsizei length)
+{
+	size_t payloadSize = sizeof(program) + sizeof(binaryFormat) + sizeof(length) + length;
+	u8 *ptr            = GLRecorderInternal_PushCmd(GLRecorderCmd_glProgramBinary, payloadSize);
+	ptr                = GLRecorderInternal_Put(ptr, program);
+	ptr                = GLRecorderInternal_Put(ptr, binaryFormat);
+	ptr                = GLRecorderInternal_Put(ptr, length);
+	ptr                = GLRecorderInternal_PutBytes(ptr, binary, length);
+}
+
+FILE_SCOPE void GLRecorder_glProgramParameteri(GLuint program, GLenum pname, GLint value)
+{
+	u8 *ptr = GLRecorderInternal_PushCmd(GLRecorderCmd_glProgramParameteri, sizeof(program) + sizeof(pname) + sizeof(value));
+	ptr     = GLRecorderInternal_Put(ptr, program);
+	ptr     = GLRecorderInternal_Put(ptr, pname);
+	ptr     = GLRecorderInternal_Put(ptr, value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// GLRecorder Implementation
+////////////////////////////////////////////////////////////////////////////////
+bool GLRecorder_Init(GLRecorder *const recorder, const size_t initialLogSize)
+{
+	if (!recorder) return false;
+
+	recorder->log = (u8 *)DqnMem_Calloc(initialLogSize);
+	if (!recorder->log) return false;
+
+	recorder->logSize         = 0;
+	recorder->logCapacity     = initialLogSize;
+	recorder->nextId          = 1;
+	recorder->unpackAlignment = 4;
+	recorder->frameStats      = {};
+	return true;
+}
+
+void GLRecorder_Free(GLRecorder *const recorder)
+{
+	if (!recorder) return;
+	if (globalGLRecorder == recorder) globalGLRecorder = NULL;
+
+	DqnMem_Free(recorder->log);
+	DqnMem_Free(recorder->mapMemory);
+	for (u32 i = 0; i < GL_RECORDER_MAX_SHADERS; i++)
+		DqnMem_Free(recorder->shaderSources[i].source);
+	*recorder = {};
+}
+
+void GLRecorder_LoadFunctions(GLRecorder *const recorder)
+{
+	DQN_ASSERT(recorder && recorder->log);
+	globalGLRecorder = recorder;
+
+	glGetError       = GLRecorder_glGetError;
+	glGetString      = GLRecorder_glGetString;
+	glGetIntegerv    = GLRecorder_glGetIntegerv;
+	glClear          = GLRecorder_glClear;
+	glClearColor     = GLRecorder_glClearColor;
+	glEnable         = GLRecorder_glEnable;
+	glDisable        = GLRecorder_glDisable;
+	glPolygonMode    = GLRecorder_glPolygonMode;
+	glViewport       = GLRecorder_glViewport;
+	glPixelStorei    = GLRecorder_glPixelStorei;
+	glDrawArrays     = GLRecorder_glDrawArrays;
+	glGenTextures    = GLRecorder_glGenTextures;
+	glDeleteTextures = GLRecorder_glDeleteTextures;
+	glBindTexture    = GLRecorder_glBindTexture;
+	glTexParameteri  = GLRecorder_glTexParameteri;
+	glTexImage2D     = GLRecorder_glTexImage2D;
+
+	glActiveTexture        = GLRecorder_glActiveTexture;
+	glCompressedTexImage2D = GLRecorder_glCompressedTexImage2D;
+
+	glGenBuffers    = GLRecorder_glGenBuffers;
+	glBindBuffer    = GLRecorder_glBindBuffer;
+	glBufferData    = GLRecorder_glBufferData;
+	glBufferSubData = GLRecorder_glBufferSubData;
+	glUnmapBuffer   = GLRecorder_glUnmapBuffer;
+
+	glCreateShader      = GLRecorder_glCreateShader;
+	glShaderSource      = GLRecorder_glShaderSource;
+	glCompileShader     = GLRecorder_glCompileShader;
+	glGetShaderiv       = GLRecorder_glGetShaderiv;
+	glGetShaderInfoLog  = GLRecorder_glGetShaderInfoLog;
+	glCreateProgram     = GLRecorder_glCreateProgram;
+	glAttachShader      = GLRecorder_glAttachShader;
+	glLinkProgram       = GLRecorder_glLinkProgram;
+	glUseProgram        = GLRecorder_glUseProgram;
+	glDeleteShader      = GLRecorder_glDeleteShader;
+	glDeleteProgram     = GLRecorder_glDeleteProgram;
+	glGetProgramInfoLog = GLRecorder_glGetProgramInfoLog;
+	glGetProgramiv      = GLRecorder_glGetProgramiv;
+	glGetActiveUniform  = GLRecorder_glGetActiveUniform;
+
+	glGetUniformLocation = GLRecorder_glGetUniformLocation;
+	glUniform1f          = GLRecorder_glUniform1f;
+	glUniform1i          = GLRecorder_glUniform1i;
+	glUniform3f          = GLRecorder_glUniform3f;
+	glUniform4f          = GLRecorder_glUniform4f;
+	glUniform3fv         = GLRecorder_glUniform3fv;
+	glUniformMatrix4fv   = GLRecorder_glUniformMatrix4fv;
+
+	glEnableVertexAttribArray  = GLRecorder_glEnableVertexAttribArray;
+	glDisableVertexAttribArray = GLRecorder_glDisableVertexAttribArray;
+	glVertexAttribPointer      = GLRecorder_glVertexAttribPointer;
+
+	glGetStringi      = GLRecorder_glGetStringi;
+	glGenVertexArrays = GLRecorder_glGenVertexArrays;
+	glBindVertexArray = GLRecorder_glBindVertexArray;
+	glGenerateMipmap  = GLRecorder_glGenerateMipmap;
+	glBindBufferBase  = GLRecorder_glBindBufferBase;
+	glMapBufferRange  = GLRecorder_glMapBufferRange;
+
+	glGetUniformBlockIndex  = GLRecorder_glGetUniformBlockIndex;
+	glUniformBlockBinding   = GLRecorder_glUniformBlockBinding;
+	glDrawArraysInstanced   = GLRecorder_glDrawArraysInstanced;
+	glDrawElementsInstanced = GLRecorder_glDrawElementsInstanced;
+
+	glFenceSync      = GLRecorder_glFenceSync;
+	glClientWaitSync = GLRecorder_glClientWaitSync;
+	glDeleteSync     = GLRecorder_glDeleteSync;
+
+	glVertexAttribDivisor = GLRecorder_glVertexAttribDivisor;
+
+	glGetProgramBinary  = GLRecorder_glGetProgramBinary;
+	glProgramBinary     = GLRecorder_glProgramBinary;
+	glProgramParameteri = GLRecorder_glProgramParameteri;
+}
+
+GLRecorderFrameStats GLRecorder_EndFrame(GLRecorder *const recorder, const bool keepLog)
+{
+	GLRecorderFrameStats result = {};
+	if (!recorder) return result;
+
+	// NOTE: The frame marker doesn't count as a call, push it with the stats already taken
+	GLRecorder *prevRecorder = globalGLRecorder;
+	globalGLRecorder         = recorder;
+	result                   = recorder->frameStats;
+	GLRecorderInternal_PushCmd(GLRecorderCmd_FrameEnd, 0);
+	globalGLRecorder         = prevRecorder;
+
+	recorder->frameStats = {};
+	if (!keepLog) recorder->logSize = 0;
+	return result;
+}
+
+bool GLRecorder_WriteToFile(const GLRecorder *const recorder, const char *const path)
+{
+	if (!recorder || !path) return false;
+
+	DqnFile file = {};
+	if (!DqnFile_Open(path, &file, DqnFilePermissionFlag_Write, DqnFileAction_ClearIfExist))
+	{
+		if (!DqnFile_Open(path, &file, DqnFilePermissionFlag_Write, DqnFileAction_CreateIfNotExist))
+			return false;
+	}
+
+	GLRecorderFileHeader header = {};
+	header.magic                = GL_RECORDER_FILE_MAGIC;
+	header.version              = GL_RECORDER_FILE_VERSION;
+	header.logSize              = recorder->logSize;
+
+	// NOTE: DqnFile_Write() doesn't support writing at an offset yet, so write it all in one call
+	size_t fileSize = sizeof(header) + recorder->logSize;
+	u8 *fileBuffer  = (u8 *)DqnMem_Calloc(fileSize);
+	if (!fileBuffer)
+	{
+		DqnFile_Close(&file);
+		return false;
+	}
+
+	memcpy(fileBuffer, &header, sizeof(header));
+	memcpy(fileBuffer + sizeof(header), recorder->log, recorder->logSize);
+	size_t bytesWritten = DqnFile_Write(&file, fileBuffer, fileSize, 0);
+	DqnFile_Close(&file);
+	DqnMem_Free(fileBuffer);
+
+	return (bytesWritten == fileSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// GLRecorderReplay Implementation
+////////////////////////////////////////////////////////////////////////////////
+template <typename T>
+FILE_SCOPE inline T GLRecorderInternal_Get(const u8 **ptr)
+{
+	T result;
+	memcpy(&result, *ptr, sizeof(T));
+	*ptr += sizeof(T);
+	return result;
+}
+
+FILE_SCOPE void GLRecorderInternal_ReplayMapId(GLRecorderReplay *const replay, const u32 recordedId, const u32 id)
+{
+	if (recordedId >= replay->idRemapSize)
+	{
+		u32 newSize = DQN_MAX(replay->idRemapSize * 2, 256);
+		while (newSize <= recordedId)
+			newSize *= 2;
+
+		u32 *newRemap = (u32 *)DqnMem_Realloc(replay->idRemap, sizeof(*newRemap) * newSize);
+		DQN_ASSERT_HARD(newRemap);
+		for (u32 i = replay->idRemapSize; i < newSize; i++)
+			newRemap[i] = i;
+
+		replay->idRemap     = newRemap;
+		replay->idRemapSize = newSize;
+	}
+
+	replay->idRemap[recordedId] = id;
+}
+
+// return: The id the object or uniform location has in the GL being replayed to.
+FILE_SCOPE inline u32 GLRecorderInternal_ReplayGetId(const GLRecorderReplay *const replay, const u32 recordedId)
+{
+	if (recordedId < replay->idRemapSize) return replay->idRemap[recordedId];
+	return recordedId;
+}
+
+FILE_SCOPE inline GLint GLRecorderInternal_ReplayGetLocation(const GLRecorderReplay *const replay,
+                                                             const GLint recordedLocation)
+{
+	if (recordedLocation < 0) return recordedLocation;
+	return (GLint)GLRecorderInternal_ReplayGetId(replay, (u32)recordedLocation);
+}
+
+// return: The slot of the fence that had recordedId, or a free slot if recordedId is 0. NULL if there's none.
+FILE_SCOPE GLRecorderReplaySync *GLRecorderInternal_ReplayFindSync(GLRecorderReplay *const replay, const u32 recordedId)
+{
+	for (u32 i = 0; i < GL_RECORDER_MAX_SYNCS; i++)
+	{
+		if (replay->syncs[i].recordedId == recordedId) return &replay->syncs[i];
+	}
+
+	return NULL;
+}
+
+FILE_SCOPE void GLRecorderInternal_ReplayGenIds(GLRecorderReplay *const replay, const u8 *ptr,
+                                                glGenTexturesProc *const genFunction)
+{
+	GLsizei n = GLRecorderInternal_Get<GLsizei>(&ptr);
+	for (GLsizei i = 0; i < n; i++)
+	{
+		GLuint recordedId = GLRecorderInternal_Get<GLuint>(&ptr);
+		GLuint id;
+		genFunction(1, &id);
+		GLRecorderInternal_ReplayMapId(replay, recordedId, id);
+	}
+}
+
+bool GLRecorderReplay_Open(GLRecorderReplay *const replay, const char *const path)
+{
+	if (!replay || !path) return false;
+	*replay = {};
+
+	size_t fileSize;
+	if (!DqnFile_GetFileSize(path, &fileSize) || fileSize < sizeof(GLRecorderFileHeader))
+		return false;
+
+	replay->file = (u8 *)DqnMem_Calloc(fileSize);
+	if (!replay->file) return false;
+
+	size_t bytesRead;
+	if (!DqnFile_ReadEntireFile(path, replay->file, fileSize, &bytesRead) || bytesRead != fileSize)
+	{
+		GLRecorderReplay_Close(replay);
+		return false;
+	}
+
+	GLRecorderFileHeader header;
+	memcpy(&header, replay->file, sizeof(header));
+	if (header.magic != GL_RECORDER_FILE_MAGIC || header.version != GL_RECORDER_FILE_VERSION ||
+	    header.logSize > fileSize - sizeof(header))
+	{
+		GLRecorderReplay_Close(replay);
+		return false;
+	}
+
+	replay->log     = replay->file + sizeof(header);
+	replay->logSize = (size_t)header.logSize;
+	return true;
+}
+
+void GLRecorderReplay_Close(GLRecorderReplay *const replay)
+{
+	if (!replay) return;
+	DqnMem_Free(replay->file);
+	DqnMem_Free(replay->idRemap);
+	*replay = {};
+}
+
+bool GLRecorderReplay_Frame(GLRecorderReplay *const replay)
+{
+	if (!replay || !replay->log) return false;
+
+	while (replay->offset + GL_RECORDER_CMD_HEADER_SIZE <= replay->logSize)
+	{
+		const u8 *ptr   = replay->log + replay->offset;
+		u16 cmd         = GLRecorderInternal_Get<u16>(&ptr);
+		u32 payloadSize = GLRecorderInternal_Get<u32>(&ptr);
+		if (cmd >= GLRecorderCmd_Count || replay->offset + GL_RECORDER_CMD_HEADER_SIZE + payloadSize > replay->logSize)
+		{
+			DQN_ASSERT_MSG(DQN_INVALID_CODE_PATH, "Malformed command at offset %zu", replay->offset);
+			return false;
+		}
+		replay->offset += GL_RECORDER_CMD_HEADER_SIZE + payloadSize;
+
+		switch (cmd)
+		{
+			case GLRecorderCmd_FrameEnd:
+			{
+				replay->numFramesReplayed++;
+				return true;
+			}
+
+			// GL 1.1
+			case GLRecorderCmd_glGetError: glGetError(); break;
+			case GLRecorderCmd_glGetString: glGetString(GLRecorderInternal_Get<GLenum>(&ptr)); break;
+
+			case GLRecorderCmd_glGetIntegerv:
+			{
+				GLint data;
+				glGetIntegerv(GLRecorderInternal_Get<GLenum>(&ptr), &data);
+			}
+			break;
+
+			case GLRecorderCmd_glClear: glClear(GLRecorderInternal_Get<GLbitfield>(&ptr)); break;
+
+			case GLRecorderCmd_glClearColor:
+			{
+				GLclampf red   = GLRecorderInternal_Get<GLclampf>(&ptr);
+				GLclampf green = GLRecorderInternal_Get<GLclampf>(&ptr);
+				GLclampf blue  = GLRecorderInternal_Get<GLclampf>(&ptr);
+				GLclampf alpha = GLRecorderInternal_Get<GLclampf>(&ptr);
+				glClearColor(red, green, blue, alpha);
+			}
+			break;
+
+			case GLRecorderCmd_glEnable:  glEnable(GLRecorderInternal_Get<GLenum>(&ptr));  break;
+			case GLRecorderCmd_glDisable: glDisable(GLRecorderInternal_Get<GLenum>(&ptr)); break;
+
+			case GLRecorderCmd_glPolygonMode:
+			{
+				GLenum face = GLRecorderInternal_Get<GLenum>(&ptr);
+				GLenum mode = GLRecorderInternal_Get<GLenum>(&ptr);
+				glPolygonMode(face, mode);
+			}
+			break;
+
+			case GLRecorderCmd_glViewport:
+			{
+				GLint x        = GLRecorderInternal_Get<GLint>(&ptr);
+				GLint y        = GLRecorderInternal_Get<GLint>(&ptr);
+				GLsizei width  = GLRecorderInternal_Get<GLsizei>(&ptr);
+				GLsizei height = GLRecorderInternal_Get<GLsizei>(&ptr);
+				glViewport(x, y, width, height);
+			}
+			break;
+
+			case GLRecorderCmd_glPixelStorei:
+			{
+				GLenum pname = GLRecorderInternal_Get<GLenum>(&ptr);
+				GLint param  = GLRecorderInternal_Get<GLint>(&ptr);
+				glPixelStorei(pname, param);
+			}
+			break;
+
+			case GLRecorderCmd_glDrawArrays:
+			{
+				GLenum mode   = GLRecorderInternal_Get<GLenum>(&ptr);
+				GLint first   = GLRecorderInternal_Get<GLint>(&ptr);
+				GLsizei count = GLRecorderInternal_Get<GLsizei>(&ptr);
+				glDrawArrays(mode, first, count);
+			}
+			break;
+
+			case GLRecorderCmd_glGenTextures: GLRecorderInternal_ReplayGenIds(replay, ptr, glGenTextures); break;
+
+			case GLRecorderCmd_glDeleteTextures:
+			{
+				GLsizei n = GLRecorderInternal_Get<GLsizei>(&ptr);
+				for (GLsizei i = 0; i < n; i++)
+				{
+					GLuint texture = GLRecorderInternal_ReplayGetId(replay, GLRecorderInternal_Get<GLuint>(&ptr));
+					glDeleteTextures(1, &texture);
+				}
+			}
+			break;
+
+			case GLRecorderCmd_glBindTexture:
+			{
+				GLenum target  = GLRecorderInternal_Get<GLenum>(&ptr);
+				GLuint texture = GLRecorderInternal_ReplayGetId(replay, GLRecorderInternal_Get<GLuint>(&ptr));
+				glBindTexture(target, texture);
+			}
+			break;
+
+			case GLRecorderCmd_glTexParameteri:
+			{
+				GLenum target = GLRecorderInternal_Get<GLenum>(&ptr);
+				GLenum pname  = GLRecorderInternal_Get<GLenum>(&ptr);
+				GLint param   = GLRecorderInternal_Get<GLint>(&ptr);
+				glTexParameteri(target, pname, param);
+			}
+			break;
+
+			case GLRecorderCmd_glTexImage2D:
+			{
+				GLenum target        = GLRecorderInternal_Get<GLenum>(&ptr);
+				GLint level          = GLRecorderInternal_Get<GLint>(&ptr);
+				GLint internalformat = GLRecorderInternal_Get<GLint>(&ptr);
+				GLsizei width        = GLRecorderInternal_Get<GLsizei>(&ptr);
+				GLsizei height       = GLRecorderInternal_Get<GLsizei>(&ptr);
+				GLint border         = GLRecorderInternal_Get<GLint>(&ptr);
+				GLenum format        = GLRecorderInternal_Get<GLenum>(&ptr);
+				GLenum type          = GLRecorderInternal_Get<GLenum>(&ptr);
+				u8 fromUnpackBuffer  = GLRecorderInternal_Get<u8>(&ptr);
+				i64 unpackOffset     = GLRecorderInternal_Get<i64>(&ptr);
+				u32 pixelsSize       = GLRecorderInternal_Get<u32>(&ptr);
+				const void *pixels   = (pixelsSize > 0) ? ptr : NULL;
+				if (fromUnpackBuffer) pixels = (const void *)(size_t)unpackOffset;
+				glTexImage2D(target, level, internalformat, width, height, border, format, type, pixels);
+			}
+			break;
+
+			// GL 1.3
+			case GLRecorderCmd_glActiveTexture: glActiveTexture(GLRecorderInternal_Get<GLenum>(&ptr)); break;
+
+			case GLRecorderCmd_glCompressedTexImage2D:
+			{
+				GLenum target         = GLRecorderInternal_Get<GLenum>(&ptr);
+				GLint level           = GLRecorderInternal_Get<GLint>(&ptr);
+				GLenum internalformat = GLRecorderInternal_Get<GLenum>(&ptr);
+				GLsizei width         = GLRecorderInternal_Get<GLsizei>(&ptr);
+				GLsizei height        = GLRecorderInternal_Get<GLsizei>(&ptr);
+				GLint border          = GLRecorderInternal_Get<GLint>(&ptr);
+				GLsizei imageSize     = GLRecorderInternal_Get<GLsizei>(&ptr);
+				u8 fromUnpackBuffer   = GLRecorderInternal_Get<u8>(&ptr);
+				i64 unpackOffset      = GLRecorderInternal_Get<i64>(&ptr);
+				u32 dataSize          = GLRecorderInternal_Get<u32>(&ptr);
+				const void *data      = (dataSize > 0) ? ptr : NULL;
+				if (fromUnpackBuffer) data = (const void *)(size_t)unpackOffset;
+				glCompressedTexImage2D(target, level, internalformat, width, height, border, imageSize, data);
+			}
+			break;
+
+			// GL 1.5
+			case GLRecorderCmd_glGenBuffers: GLRecorderInternal_ReplayGenIds(replay, ptr, glGenBuffers); break;
+
+			case GLRecorderCmd_glBindBuffer:
+			{
+				GLenum target = GLRecorderInternal_Get<GLenum>(&ptr);
+				GLuint buffer = GLRecorderInternal_ReplayGetId(replay, GLRecorderInternal_Get<GLuint>(&ptr));
+				glBindBuffer(target, buffer);
+			}
+			break;
+
+			case GLRecorderCmd_glBufferData:
+			{
+				GLenum target   = GLRecorderInternal_Get<GLenum>(&ptr);
+				GLsizeiptr size = (GLsizeiptr)GLRecorderInternal_Get<i64>(&ptr);
+				GLenum usage    = GLRecorderInternal_Get<GLenum>(&ptr);
+				u8 hasData      = GLRecorderInternal_Get<u8>(&ptr);
+				glBufferData(target, size, (hasData) ? ptr : NULL, usage);
+			}
+			break;
+
+			case GLRecorderCmd_glBufferSubData:
+			{
+				GLenum target   = GLRecorderInternal_Get<GLenum>(&ptr);
+				GLintptr offset = (GLintptr)GLRecorderInternal_Get<i64>(&ptr);
+				GLsizeiptr size = (GLsizeiptr)GLRecorderInternal_Get<i64>(&ptr);
+				glBufferSubData(target, offset, size, ptr);
+			}
+			break;
+
+			case GLRecorderCmd_glUnmapBuffer:
+			{
+				GLenum target = GLRecorderInternal_Get<GLenum>(&ptr);
+				size_t size   = (size_t)GLRecorderInternal_Get<i64>(&ptr);
+				if (replay->mapped) memcpy(replay->mapped, ptr, size);
+				glUnmapBuffer(target);
+				replay->mapped = NULL;
+			}
+			break;
+
+			// GL 2.0
+			case GLRecorderCmd_glCreateShader:
+			{
+				GLenum type       = GLRecorderInternal_Get<GLenum>(&ptr);
+				GLuint recordedId = GLRecorderInternal_Get<GLuint>(&ptr);
+				GLRecorderInternal_ReplayMapId(replay, recordedId, glCreateShader(type));
+			}
+			break;
+
+			case GLRecorderCmd_glShaderSource:
+			{
+				GLuint shader = GLRecorderInternal_ReplayGetId(replay, GLRecorderInternal_Get<GLuint>(&ptr));
+				GLsizei count = GLRecorderInternal_Get<GLsizei>(&ptr);
+				if (count > GL_RECORDER_MAX_SHADER_SOURCE_STRINGS) return false;
+
+				GLchar *strings[GL_RECORDER_MAX_SHADER_SOURCE_STRINGS];
+				GLint lengths[GL_RECORDER_MAX_SHADER_SOURCE_STRINGS];
+				for (GLsizei i = 0; i < count; i++)
+				{
+					lengths[i] = (GLint)GLRecorderInternal_Get<u32>(&ptr);
+					strings[i] = (GLchar *)ptr;
+					ptr += lengths[i];
+				}
+				glShaderSource(shader, count, strings, lengths);
+			}
+			break;
+
+			case GLRecorderCmd_glCompileShader:
+				glCompileShader(GLRecorderInternal_ReplayGetId(replay, GLRecorderInternal_Get<GLuint>(&ptr)));
+				break;
+
+			case GLRecorderCmd_glGetShaderiv:
+			case GLRecorderCmd_glGetProgramiv:
+			{
+				GLuint object = GLRecorderInternal_ReplayGetId(replay, GLRecorderInternal_Get<GLuint>(&ptr));
+				GLenum pname  = GLRecorderInternal_Get<GLenum>(&ptr);
+				GLint params;
+				if (cmd == GLRecorderCmd_glGetShaderiv) glGetShaderiv(object, pname, &params);
+				else                                    glGetProgramiv(object, pname, &params);
+			}
+			break;
+
+			case GLRecorderCmd_glGetActiveUniform:
+			{
+				GLuint program  = GLRecorderInternal_ReplayGetId(replay, GLRecorderInternal_Get<GLuint>(&ptr));
+				GLuint index    = GLRecorderInternal_Get<GLuint>(&ptr);
+				GLsizei bufSize = GLRecorderInternal_Get<GLsizei>(&ptr);
+				GLchar name[GL_RECORDER_MAX_UNIFORM_NAME];
+				GLint size;
+				GLenum type;
+				glGetActiveUniform(program, index, DQN_MIN(bufSize, (GLsizei)sizeof(name)), NULL, &size, &type, name);
+			}
+			break;
+
+			case GLRecorderCmd_glGetShaderInfoLog:
+			case GLRecorderCmd_glGetProgramInfoLog:
+			{
+				GLuint object = GLRecorderInternal_ReplayGetId(replay, GLRecorderInternal_Get<GLuint>(&ptr));
+				GLsizei bufSize = GLRecorderInternal_Get<GLsizei>(&ptr);
+				GLchar infoLog[512];
+				bufSize = DQN_MIN(bufSize, (GLsizei)DQN_ARRAY_COUNT(infoLog));
+				if (cmd == GLRecorderCmd_glGetShaderInfoLog) glGetShaderInfoLog(object, bufSize, NULL, infoLog);
+				else                                         glGetProgramInfoLog(object, bufSize, NULL, infoLog);
+			}
+			break;
+
+			case GLRecorderCmd_glCreateProgram:
+			{
+				GLuint recordedId = GLRecorderInternal_Get<GLuint>(&ptr);
+				GLRecorderInternal_ReplayMapId(replay, recordedId, glCreateProgram());
+			}
+			break;
+
+			case GLRecorderCmd_glAttachShader:
+			{
+				GLuint program = GLRecorderInternal_ReplayGetId(replay, GLRecorderInternal_Get<GLuint>(&ptr));
+				GLuint shader  = GLRecorderInternal_ReplayGetId(replay, GLRecorderInternal_Get<GLuint>(&ptr));
+				glAttachShader(program, shader);
+			}
+			break;
+
+			case GLRecorderCmd_glLinkProgram:
+				glLinkProgram(GLRecorderInternal_ReplayGetId(replay, GLRecorderInternal_Get<GLuint>(&ptr)));
+				break;
+
+			case GLRecorderCmd_glUseProgram:
+				glUseProgram(GLRecorderInternal_ReplayGetId(replay, GLRecorderInternal_Get<GLuint>(&ptr)));
+				break;
+
+			case GLRecorderCmd_glDeleteShader:
+				glDeleteShader(GLRecorderInternal_ReplayGetId(replay, GLRecorderInternal_Get<GLuint>(&ptr)));
+				break;
+
+			case GLRecorderCmd_glDeleteProgram:
+				glDeleteProgram(GLRecorderInternal_ReplayGetId(replay, GLRecorderInternal_Get<GLuint>(&ptr)));
+				break;
+
+			case GLRecorderCmd_glGetUniformLocation:
+			{
+				GLuint program         = GLRecorderInternal_ReplayGetId(replay, GLRecorderInternal_Get<GLuint>(&ptr));
+				GLint recordedLocation = GLRecorderInternal_Get<GLint>(&ptr);
+				GLint location         = glGetUniformLocation(program, (const GLchar *)ptr);
+				GLRecorderInternal_ReplayMapId(replay, (u32)recordedLocation, (u32)location);
+			}
+			break;
+
+			case GLRecorderCmd_glUniform1f:
+			{
+				GLint location = GLRecorderInternal_ReplayGetLocation(replay, GLRecorderInternal_Get<GLint>(&ptr));
+				glUniform1f(location, GLRecorderInternal_Get<GLfloat>(&ptr));
+			}
+			break;
+
+			case GLRecorderCmd_glUniform1i:
+			{
+				GLint location = GLRecorderInternal_ReplayGetLocation(replay, GLRecorderInternal_Get<GLint>(&ptr));
+				glUniform1i(location, GLRecorderInternal_Get<GLint>(&ptr));
+			}
+			break;
+
+			case GLRecorderCmd_glUniform3f:
+			{
+				GLint location = GLRecorderInternal_ReplayGetLocation(replay, GLRecorderInternal_Get<GLint>(&ptr));
+				GLfloat v0     = GLRecorderInternal_Get<GLfloat>(&ptr);
+				GLfloat v1     = GLRecorderInternal_Get<GLfloat>(&ptr);
+				GLfloat v2     = GLRecorderInternal_Get<GLfloat>(&ptr);
+				glUniform3f(location, v0, v1, v2);
+			}
+			break;
+
+			case GLRecorderCmd_glUniform4f:
+			{
+				GLint location = GLRecorderInternal_ReplayGetLocation(replay, GLRecorderInternal_Get<GLint>(&ptr));
+				GLfloat v0     = GLRecorderInternal_Get<GLfloat>(&ptr);
+				GLfloat v1     = GLRecorderInternal_Get<GLfloat>(&ptr);
+				GLfloat v2     = GLRecorderInternal_Get<GLfloat>(&ptr);
+				GLfloat v3     = GLRecorderInternal_Get<GLfloat>(&ptr);
+				glUniform4f(location, v0, v1, v2, v3);
+			}
+			break;
+
+			// NOTE: Payloads aren't aligned, copy the values out before handing them to GL
+			case GLRecorderCmd_glUniform3fv:
+			{
+				GLint location = GLRecorderInternal_ReplayGetLocation(replay, GLRecorderInternal_Get<GLint>(&ptr));
+				GLsizei count  = GLRecorderInternal_Get<GLsizei>(&ptr);
+				for (GLsizei i = 0; i < count; i++)
+				{
+					GLfloat value[3];
+					memcpy(value, ptr, sizeof(value));
+					ptr += sizeof(value);
+					glUniform3fv(location + i, 1, value);
+				}
+			}
+			break;
+
+			case GLRecorderCmd_glUniformMatrix4fv:
+			{
+				GLint location      = GLRecorderInternal_ReplayGetLocation(replay, GLRecorderInternal_Get<GLint>(&ptr));
+				GLsizei count       = GLRecorderInternal_Get<GLsizei>(&ptr);
+				GLboolean transpose = GLRecorderInternal_Get<GLboolean>(&ptr);
+				for (GLsizei i = 0; i < count; i++)
+				{
+					GLfloat value[16];
+					memcpy(value, ptr, sizeof(value));
+					ptr += sizeof(value);
+					glUniformMatrix4fv(location + i, 1, transpose, value);
+				}
+			}
+			break;
+
+			case GLRecorderCmd_glEnableVertexAttribArray:
+				glEnableVertexAttribArray(GLRecorderInternal_Get<GLuint>(&ptr));
+				break;
+
+			case GLRecorderCmd_glDisableVertexAttribArray:
+				glDisableVertexAttribArray(GLRecorderInternal_Get<GLuint>(&ptr));
+				break;
+
+			case GLRecorderCmd_glVertexAttribPointer:
+			{
+				GLuint index         = GLRecorderInternal_Get<GLuint>(&ptr);
+				GLint size           = GLRecorderInternal_Get<GLint>(&ptr);
+				GLenum type          = GLRecorderInternal_Get<GLenum>(&ptr);
+				GLboolean normalized = GLRecorderInternal_Get<GLboolean>(&ptr);
+				GLsizei stride       = GLRecorderInternal_Get<GLsizei>(&ptr);
+				u64 offset           = GLRecorderInternal_Get<u64>(&ptr);
+				glVertexAttribPointer(index, size, type, normalized, stride, (const void *)(uintptr_t)offset);
+			}
+			break;
+
+			// GL 3.0
+			case GLRecorderCmd_glGetStringi:
+			{
+				GLenum name  = GLRecorderInternal_Get<GLenum>(&ptr);
+				GLuint index = GLRecorderInternal_Get<GLuint>(&ptr);
+				glGetStringi(name, index);
+			}
+			break;
+
+			case GLRecorderCmd_glGenVertexArrays: GLRecorderInternal_ReplayGenIds(replay, ptr, glGenVertexArrays); break;
+
+			case GLRecorderCmd_glBindVertexArray:
+				glBindVertexArray(GLRecorderInternal_ReplayGetId(replay, GLRecorderInternal_Get<GLuint>(&ptr)));
+				break;
+
+			case GLRecorderCmd_glGenerateMipmap: glGenerateMipmap(GLRecorderInternal_Get<GLenum>(&ptr)); break;
+
+			case GLRecorderCmd_glBindBufferBase:
+			{
+				GLenum target = GLRecorderInternal_Get<GLenum>(&ptr);
+				GLuint index  = GLRecorderInternal_Get<GLuint>(&ptr);
+				GLuint buffer = GLRecorderInternal_ReplayGetId(replay, GLRecorderInternal_Get<GLuint>(&ptr));
+				glBindBufferBase(target, index, buffer);
+			}
+			break;
+
+			case GLRecorderCmd_glMapBufferRange:
+			{
+				GLenum target     = GLRecorderInternal_Get<GLenum>(&ptr);
+				GLintptr offset   = (GLintptr)GLRecorderInternal_Get<i64>(&ptr);
+				GLsizeiptr length = (GLsizeiptr)GLRecorderInternal_Get<i64>(&ptr);
+				GLbitfield access = GLRecorderInternal_Get<GLbitfield>(&ptr);
+				replay->mapped    = glMapBufferRange(target, offset, length, access);
+			}
+			break;
+
+			// GL 3.1
+			case GLRecorderCmd_glGetUniformBlockIndex:
+			{
+				GLuint program    = GLRecorderInternal_ReplayGetId(replay, GLRecorderInternal_Get<GLuint>(&ptr));
+				GLuint recordedId = GLRecorderInternal_Get<GLuint>(&ptr);
+				GLRecorderInternal_ReplayMapId(replay, recordedId, glGetUniformBlockIndex(program, (const GLchar *)ptr));
+			}
+			break;
+
+			case GLRecorderCmd_glUniformBlockBinding:
+			{
+				GLuint program    = GLRecorderInternal_ReplayGetId(replay, GLRecorderInternal_Get<GLuint>(&ptr));
+				GLuint blockIndex = GLRecorderInternal_ReplayGetId(replay, GLRecorderInternal_Get<GLuint>(&ptr));
+				GLuint binding    = GLRecorderInternal_Get<GLuint>(&ptr);
+				glUniformBlockBinding(program, blockIndex, binding);
+			}
+			break;
+
+			case GLRecorderCmd_glDrawArraysInstanced:
+			{
+				GLenum mode           = GLRecorderInternal_Get<GLenum>(&ptr);
+				GLint first           = GLRecorderInternal_Get<GLint>(&ptr);
+				GLsizei count         = GLRecorderInternal_Get<GLsizei>(&ptr);
+				GLsizei instancecount = GLRecorderInternal_Get<GLsizei>(&ptr);
+				glDrawArraysInstanced(mode, first, count, instancecount);
+			}
+			break;
+
+			case GLRecorderCmd_glDrawElementsInstanced:
+			{
+				GLenum mode           = GLRecorderInternal_Get<GLenum>(&ptr);
+				GLsizei count         = GLRecorderInternal_Get<GLsizei>(&ptr);
+				GLenum type           = GLRecorderInternal_Get<GLenum>(&ptr);
+				u64 offset            = GLRecorderInternal_Get<u64>(&ptr);
+				GLsizei instancecount = GLRecorderInternal_Get<GLsizei>(&ptr);
+				glDrawElementsInstanced(mode, count, type, (const void *)(uintptr_t)offset, instancecount);
+			}
+			break;
+
+			// GL 3.2
+			case GLRecorderCmd_glFenceSync:
+			{
+				GLuint recordedId          = GLRecorderInternal_Get<GLuint>(&ptr);
+				GLenum condition           = GLRecorderInternal_Get<GLenum>(&ptr);
+				GLbitfield flags           = GLRecorderInternal_Get<GLbitfield>(&ptr);
+				GLRecorderReplaySync *slot = GLRecorderInternal_ReplayFindSync(replay, 0);
+				if (!DQN_ASSERT_MSG(slot, "More than %d fences alive at once", GL_RECORDER_MAX_SYNCS)) return false;
+
+				slot->recordedId = recordedId;
+				slot->sync       = glFenceSync(condition, flags);
+			}
+			break;
+
+			case GLRecorderCmd_glClientWaitSync:
+			{
+				GLuint recordedId          = GLRecorderInternal_Get<GLuint>(&ptr);
+				GLbitfield flags           = GLRecorderInternal_Get<GLbitfield>(&ptr);
+				GLuint64 timeout           = GLRecorderInternal_Get<u64>(&ptr);
+				GLRecorderReplaySync *slot = GLRecorderInternal_ReplayFindSync(replay, recordedId);
+				if (slot) glClientWaitSync(slot->sync, flags, timeout);
+			}
+			break;
+
+			case GLRecorderCmd_glDeleteSync:
+			{
+				GLRecorderReplaySync *slot = GLRecorderInternal_ReplayFindSync(replay, GLRecorderInternal_Get<GLuint>(&ptr));
+				if (slot)
+				{
+					glDeleteSync(slot->sync);
+					*slot = {};
+				}
+			}
+			break;
+
+			// GL 3.3
+			case GLRecorderCmd_glVertexAttribDivisor:
+			{
+				GLuint index   = GLRecorderInternal_Get<GLuint>(&ptr);
+				GLuint divisor = GLRecorderInternal_Get<GLuint>(&ptr);
+				glVertexAttribDivisor(index, divisor);
+			}
+			break;
+
+			// GL 4.1
+			// NOTE: The recorder never hands out a binary, there's nothing to read back
+			case GLRecorderCmd_glGetProgramBinary: break;
+
+			case GLRecorderCmd_glProgramBinary:
+			{
+				GLuint program      = GLRecorderInternal_ReplayGetId(replay, GLRecorderInternal_Get<GLuint>(&ptr));
+				GLenum binaryFormat = GLRecorderInternal_Get<GLenum>(&ptr);
+				GLsizei length      = GLRecorderInternal_Get<GLsizei>(&ptr);
+				glProgramBinary(program, binaryFormat, ptr, length);
+			}
+			break;
+
+			case GLRecorderCmd_glProgramParameteri:
+			{
+				GLuint program = GLRecorderInternal_ReplayGetId(replay, GLRecorderInternal_Get<GLuint>(&ptr));
+				GLenum pname   = GLRecorderInternal_Get<GLenum>(&ptr);
+				GLint value    = GLRecorderInternal_Get<GLint>(&ptr);
+				glProgramParameteri(program, pname, value);
+			}
+			break;
+
+			default:
+			{
+				DQN_ASSERT_MSG(DQN_INVALID_CODE_PATH, "Unhandled command: %d", cmd);
+				return false;
+			}
+		}
+	}
+
+	return false;
+}
@@ -0,0 +1,248 @@
+#ifndef OPENGL_RECORDER_H
+#define OPENGL_RECORDER_H
+////////////////////////////////////////////////////////////////////////////////
+// Usage
+////////////////////////////////////////////////////////////////////////////////
+// A CPU side GL backend. GLRecorder_LoadFunctions() points the OpenGL.h function
+// pointer table at the recorder, which captures every call and its arguments
+// into a packed binary command log and hands out ids like a real driver would.
+// Only available where GL 1.1 is exposed through function pointers (Unix).
+
+// 1. Zero-clear a GLRecorder and call GLRecorder_Init().
+// 2. GLRecorder_LoadFunctions() to install it, then issue GL calls as normal.
+// 3. GLRecorder_EndFrame() at the end of each frame to get the frame's stats.
+// 4. Optionally GLRecorder_WriteToFile() the log, then GLRecorderReplay_Open()
+//    and GLRecorderReplay_Frame() to play it back later against whatever GL
+//    functions are loaded at the time.
+
+// Log Format
+// Header: GLRecorderFileHeader
+// Then a stream of commands, each: u16 cmd, u32 payloadSize, u8 payload[payloadSize]
+// where the payload is the call arguments packed in declaration order with no
+// padding. Pointers to client memory are replaced by the bytes they point to.
+
+#include "OpenGL.h"
+#include "dqn.h"
+
+enum GLRecorderCmd
+{
+	GLRecorderCmd_Invalid,
+	GLRecorderCmd_FrameEnd,
+
+	// GL 1.1
+	GLRecorderCmd_glGetError,
+	GLRecorderCmd_glGetString,
+	GLRecorderCmd_glGetIntegerv,
+	GLRecorderCmd_glClear,
+	GLRecorderCmd_glClearColor,
+	GLRecorderCmd_glEnable,
+	GLRecorderCmd_glDisable,
+	GLRecorderCmd_glPolygonMode,
+	GLRecorderCmd_glViewport,
+	GLRecorderCmd_glPixelStorei,
+	GLRecorderCmd_glDrawArrays,
+	GLRecorderCmd_glGenTextures,
+	GLRecorderCmd_glDeleteTextures,
+	GLRecorderCmd_glBindTexture,
+	GLRecorderCmd_glTexParameteri,
+	GLRecorderCmd_glTexImage2D,
+
+	// GL 1.3
+	GLRecorderCmd_glActiveTexture,
+	GLRecorderCmd_glCompressedTexImage2D,
+
+	// GL 1.5
+	GLRecorderCmd_glGenBuffers,
+	GLRecorderCmd_glBindBuffer,
+	GLRecorderCmd_glBufferData,
+	GLRecorderCmd_glBufferSubData,
+	GLRecorderCmd_glUnmapBuffer,
+
+	// GL 2.0
+	GLRecorderCmd_glCreateShader,
+	GLRecorderCmd_glShaderSource,
+	GLRecorderCmd_glCompileShader,
+	GLRecorderCmd_glGetShaderiv,
+	GLRecorderCmd_glGetShaderInfoLog,
+	GLRecorderCmd_glCreateProgram,
+	GLRecorderCmd_glAttachShader,
+	GLRecorderCmd_glLinkProgram,
+	GLRecorderCmd_glUseProgram,
+	GLRecorderCmd_glDeleteShader,
+	GLRecorderCmd_glDeleteProgram,
+	GLRecorderCmd_glGetProgramInfoLog,
+	GLRecorderCmd_glGetProgramiv,
+	GLRecorderCmd_glGetActiveUniform,
+
+	GLRecorderCmd_glGetUniformLocation,
+	GLRecorderCmd_glUniform1f,
+	GLRecorderCmd_glUniform1i,
+	GLRecorderCmd_glUniform3f,
+	GLRecorderCmd_glUniform4f,
+	GLRecorderCmd_glUniform3fv,
+	GLRecorderCmd_glUniformMatrix4fv,
+
+	GLRecorderCmd_glEnableVertexAttribArray,
+	GLRecorderCmd_glDisableVertexAttribArray,
+	GLRecorderCmd_glVertexAttribPointer,
+
+	// GL 3.0
+	GLRecorderCmd_glGetStringi,
+	GLRecorderCmd_glGenVertexArrays,
+	GLRecorderCmd_glBindVertexArray,
+	GLRecorderCmd_glGenerateMipmap,
+	GLRecorderCmd_glBindBufferBase,
+	GLRecorderCmd_glMapBufferRange,
+
+	// GL 3.1
+	GLRecorderCmd_glGetUniformBlockIndex,
+	GLRecorderCmd_glUniformBlockBinding,
+	GLRecorderCmd_glDrawArraysInstanced,
+	GLRecorderCmd_glDrawElementsInstanced,
+
+	// GL 3.2
+	GLRecorderCmd_glFenceSync,
+	GLRecorderCmd_glClientWaitSync,
+	GLRecorderCmd_glDeleteSync,
+
+	// GL 3.3
+	GLRecorderCmd_glVertexAttribDivisor,
+
+	// GL 4.1
+	GLRecorderCmd_glGetProgramBinary,
+	GLRecorderCmd_glProgramBinary,
+	GLRecorderCmd_glProgramParameteri,
+
+	GLRecorderCmd_Count,
+};
+
+typedef struct GLRecorderFrameStats
+{
+	u32 numCalls;
+	u32 numDrawCalls;
+	u64 numInstances;    // Instances submitted by draw calls, 1 for each non-instanced draw
+	u32 numStateChanges; // Binds, enables and other fixed function state, not including uniforms
+	u64 numBytesUploaded; // Buffer, texture and uniform data sent to GL
+	u32 numCallsPerCmd[GLRecorderCmd_Count];
+} GLRecorderFrameStats;
+
+// Program reflection without a driver, the recorder scans the GLSL given to glShaderSource() for the
+// uniforms a linked program would report. Only declarations of the form "uniform type name[N];" are
+// understood, where type may be a struct declared before it in the same shader. Uniform blocks are
+// skipped like the default block reflection of a driver.
+#define GL_RECORDER_MAX_SHADERS         16
+#define GL_RECORDER_MAX_PROGRAMS        8
+#define GL_RECORDER_MAX_PROGRAM_SHADERS 4
+#define GL_RECORDER_MAX_UNIFORMS        32
+#define GL_RECORDER_MAX_UNIFORM_NAME    64
+
+typedef struct GLRecorderShaderSource
+{
+	GLuint shader; // 0 if the slot is free
+	char  *source; // Null terminated, the strings of glShaderSource() joined
+} GLRecorderShaderSource;
+
+typedef struct GLRecorderUniform
+{
+	char  name[GL_RECORDER_MAX_UNIFORM_NAME]; // Arrays are named by their first element, "name[0]"
+	GLint size;                               // Elements in an array, 1 otherwise
+} GLRecorderUniform;
+
+typedef struct GLRecorderProgram
+{
+	GLuint            program; // 0 if the slot is free
+	GLuint            shaders[GL_RECORDER_MAX_PROGRAM_SHADERS];
+	u32               numShaders;
+	GLRecorderUniform uniforms[GL_RECORDER_MAX_UNIFORMS]; // As of the last glLinkProgram()
+	u32               numUniforms;
+} GLRecorderProgram;
+
+typedef struct GLRecorder
+{
+	// Command log, grows with DqnMem_Realloc()
+	u8     *log;
+	size_t  logSize;
+	size_t  logCapacity;
+
+	// Ids are handed out from one counter for all object types and uniform
+	// locations, so replay can remap them with a single table.
+	u32    nextId;
+	i32    unpackAlignment;
+	GLuint pixelUnpackBuffer; // When bound glTexImage2D() and glCompressedTexImage2D() read from it, their pixels arg is an offset into the buffer
+
+	// glMapBufferRange() hands out this staging memory, what was written to it is logged on
+	// glUnmapBuffer(). Only one buffer can be mapped at a time.
+	u8    *mapMemory;
+	size_t mapCapacity;
+	size_t mapSize;
+	GLenum mapTarget;
+	bool   isMapped;
+
+	GLRecorderShaderSource shaderSources[GL_RECORDER_MAX_SHADERS];
+	GLRecorderProgram      programs[GL_RECORDER_MAX_PROGRAMS];
+
+	GLRecorderFrameStats frameStats;
+} GLRecorder;
+
+typedef struct GLRecorderFileHeader
+{
+	u32 magic;   // GL_RECORDER_FILE_MAGIC
+	u32 version; // GL_RECORDER_FILE_VERSION
+	u64 logSize; // Bytes of command log following the header
+} GLRecorderFileHeader;
+
+#define GL_RECORDER_FILE_MAGIC   0x4C474F4C // 'LOGL'
+#define GL_RECORDER_FILE_VERSION 11
+
+#define GL_RECORDER_MAX_SYNCS 16 // Fences that can be alive at once during replay
+
+typedef struct GLRecorderReplaySync
+{
+	u32    recordedId;
+	GLsync sync;
+} GLRecorderReplaySync;
+
+typedef struct GLRecorderReplay
+{
+	u8     *file;     // Entire file, the header followed by the log
+	u8     *log;
+	size_t  logSize;
+	size_t  offset;   // Byte offset of the next command in the log to replay
+	u32     numFramesReplayed;
+
+	// Maps the ids in the log to the ids returned by the GL it is replayed against
+	u32    *idRemap;
+	u32     idRemapSize;
+
+	void   *mapped; // Returned by the last glMapBufferRange() replayed, written to on its glUnmapBuffer()
+
+	// Fences are pointers, not ids, so they're mapped separately. A recorded id of 0 is a free slot.
+	GLRecorderReplaySync syncs[GL_RECORDER_MAX_SYNCS];
+} GLRecorderReplay;
+
+// return: FALSE if the initial log could not be allocated.
+bool GLRecorder_Init         (GLRecorder *const recorder, const size_t initialLogSize);
+void GLRecorder_Free         (GLRecorder *const recorder);
+
+// Points every OpenGL.h function pointer at the recorder. Only one recorder can be loaded at a time.
+void GLRecorder_LoadFunctions(GLRecorder *const recorder);
+
+// Appends a frame marker and returns the stats for the commands recorded since the last call.
+// keepLog: FALSE to discard the command log so memory stays bounded when only stats are wanted.
+GLRecorderFrameStats GLRecorder_EndFrame(GLRecorder *const recorder, const bool keepLog);
+
+// return: FALSE if the file could not be created or fully written.
+bool GLRecorder_WriteToFile(const GLRecorder *const recorder, const char *const path);
+
+// return: FALSE if the file could not be read or is not a recording of this version.
+bool GLRecorderReplay_Open (GLRecorderReplay *const replay, const char *const path);
+void GLRecorderReplay_Close(GLRecorderReplay *const replay);
+
+// Replay the commands up to and including the next frame marker using the currently loaded GL
+// functions. Ids created during replay are mapped to the ids they had in the recording.
+// return: FALSE if the end of the log has been reached or a malformed command was found.
+bool GLRecorderReplay_Frame(GLRecorderReplay *const replay);
+
+const char *GLRecorder_CmdToStr(const enum GLRecorderCmd cmd);
+
+#endif // OPENGL_RECORDER_H
@@ -1,2 +1,16 @@
 #include "LOGL.cpp"
+#include "LOGLCull.cpp"
+#include "LOGLMip.cpp"
+#include "LOGLBC.cpp"
+#include "LOGLPack.cpp"
+#include "LOGLShader.cpp"
+#include "LOGLStateCache.cpp"
+#include "LOGLRenderQueue.cpp"
+#include "LOGLFrameArena.cpp"
+#include "LOGLBench.cpp"
+#if defined(_WIN32)
 #include "Win32.cpp"
+#else
+#include "OpenGLRecorder.cpp"
+#include "Linux.cpp"
+#endif
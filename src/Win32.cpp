@@ -18,12 +18,15 @@ wglChoosePixelFormatARBProc    *wglChoosePixelFormatARB;
 wglCreateContextAttribsARBProc *wglCreateContextAttribsARB;
 
 // GL 1.3
-glActiveTextureProc *glActiveTexture;
+glActiveTextureProc        *glActiveTexture;
+glCompressedTexImage2DProc *glCompressedTexImage2D;
 
 // GL 1.5
-glGenBuffersProc *glGenBuffers;
-glBindBufferProc *glBindBuffer;
-glBufferDataProc *glBufferData;
+glGenBuffersProc    *glGenBuffers;
+glBindBufferProc    *glBindBuffer;
+glBufferDataProc    *glBufferData;
+glBufferSubDataProc *glBufferSubData;
+glUnmapBufferProc   *glUnmapBuffer;
 
 // GL 2.0
 glCreateShaderProc             *glCreateShader;
@@ -36,8 +39,10 @@ glAttachShaderProc             *glAttachShader;
 glLinkProgramProc              *glLinkProgram;
 glUseProgramProc               *glUseProgram;
 glDeleteShaderProc             *glDeleteShader;
+glDeleteProgramProc            *glDeleteProgram;
 glGetProgramInfoLogProc        *glGetProgramInfoLog;
 glGetProgramivProc             *glGetProgramiv;
+glGetActiveUniformProc         *glGetActiveUniform;
 
 glGetUniformLocationProc       *glGetUniformLocation;
 glUniform1fProc                *glUniform1f;
@@ -52,9 +57,31 @@ glDisableVertexAttribArrayProc *glDisableVertexAttribArray;
 glVertexAttribPointerProc      *glVertexAttribPointer;
 
 // GL 3.0
+glGetStringiProc      *glGetStringi;
 glGenVertexArraysProc *glGenVertexArrays;
 glBindVertexArrayProc *glBindVertexArray;
 glGenerateMipmapProc  *glGenerateMipmap;
+glBindBufferBaseProc  *glBindBufferBase;
+glMapBufferRangeProc  *glMapBufferRange;
+
+// GL 3.1
+glGetUniformBlockIndexProc  *glGetUniformBlockIndex;
+glUniformBlockBindingProc   *glUniformBlockBinding;
+glDrawArraysInstancedProc   *glDrawArraysInstanced;
+glDrawElementsInstancedProc *glDrawElementsInstanced;
+
+// GL 3.2
+glFenceSyncProc      *glFenceSync;
+glClientWaitSyncProc *glClientWaitSync;
+glDeleteSyncProc     *glDeleteSync;
+
+// GL 3.3
+glVertexAttribDivisorProc *glVertexAttribDivisor;
+
+// GL 4.1
+glGetProgramBinaryProc  *glGetProgramBinary;
+glProgramBinaryProc     *glProgramBinary;
+glProgramParameteriProc *glProgramParameteri;
 
 FILE_SCOPE bool globalRunning = true;
 
@@ -216,6 +243,42 @@ FILE_SCOPE void Win32ProcessInputSeparately(HWND window, PlatformInput *const in
 		DQN_ASSERT(glFunction);                                                                    \
 	} while (0)
 
+// NOTE: For functions the app runs without, left NULL when the driver doesn't have them. Some
+// drivers return 1, 2, 3 or -1 instead of NULL for those.
+#define WIN32_GL_LOAD_OPTIONAL_FUNCTION(glFunction)                                                \
+	do                                                                                             \
+	{                                                                                              \
+		void *proc_    = (void *)wglGetProcAddress(#glFunction);                                   \
+		intptr_t code_ = (intptr_t)proc_;                                                          \
+		if (code_ >= -1 && code_ <= 3) proc_ = NULL;                                               \
+		glFunction = (glFunction##Proc *)proc_;                                                    \
+	} while (0)
+
+// Map the whole file at path read only.
+// return: NULL if the file could not be opened, is empty or could not be mapped.
+FILE_SCOPE const u8 *Win32MapFile(const char *const path, size_t *const size)
+{
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE) return NULL;
+
+	// NOTE: The view keeps the file and mapping alive, the handles aren't needed after mapping it
+	const u8 *result = NULL;
+	LARGE_INTEGER fileSize;
+	if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+	{
+		HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (mapping)
+		{
+			result = (const u8 *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			if (result) *size = (size_t)fileSize.QuadPart;
+			CloseHandle(mapping);
+		}
+	}
+
+	CloseHandle(file);
+	return result;
+}
+
 int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPWSTR lpCmdLine, int nShowCmd)
 {
 	////////////////////////////////////////////////////////////////////////////
@@ -422,10 +485,13 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPWSTR lpCmdLi
 		}
 
 		WIN32_GL_LOAD_FUNCTION(glActiveTexture);
+		WIN32_GL_LOAD_FUNCTION(glCompressedTexImage2D);
 
 		WIN32_GL_LOAD_FUNCTION(glGenBuffers);
 		WIN32_GL_LOAD_FUNCTION(glBindBuffer);
 		WIN32_GL_LOAD_FUNCTION(glBufferData);
+		WIN32_GL_LOAD_FUNCTION(glBufferSubData);
+		WIN32_GL_LOAD_FUNCTION(glUnmapBuffer);
 		WIN32_GL_LOAD_FUNCTION(glCreateShader);
 		WIN32_GL_LOAD_FUNCTION(glShaderSource);
 		WIN32_GL_LOAD_FUNCTION(glCompileShader);
@@ -436,8 +502,10 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPWSTR lpCmdLi
 		WIN32_GL_LOAD_FUNCTION(glLinkProgram);
 		WIN32_GL_LOAD_FUNCTION(glUseProgram);
 		WIN32_GL_LOAD_FUNCTION(glDeleteShader);
+		WIN32_GL_LOAD_FUNCTION(glDeleteProgram);
 		WIN32_GL_LOAD_FUNCTION(glGetProgramInfoLog);
 		WIN32_GL_LOAD_FUNCTION(glGetProgramiv);
+		WIN32_GL_LOAD_FUNCTION(glGetActiveUniform);
 
 		WIN32_GL_LOAD_FUNCTION(glGetUniformLocation);
 		WIN32_GL_LOAD_FUNCTION(glUniform1f);
@@ -451,9 +519,28 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPWSTR lpCmdLi
 		WIN32_GL_LOAD_FUNCTION(glDisableVertexAttribArray);
 		WIN32_GL_LOAD_FUNCTION(glVertexAttribPointer);
 
+		WIN32_GL_LOAD_FUNCTION(glGetStringi);
 		WIN32_GL_LOAD_FUNCTION(glGenVertexArrays);
 		WIN32_GL_LOAD_FUNCTION(glBindVertexArray);
 		WIN32_GL_LOAD_FUNCTION(glGenerateMipmap);
+		WIN32_GL_LOAD_FUNCTION(glBindBufferBase);
+		WIN32_GL_LOAD_FUNCTION(glMapBufferRange);
+
+		WIN32_GL_LOAD_FUNCTION(glGetUniformBlockIndex);
+		WIN32_GL_LOAD_FUNCTION(glUniformBlockBinding);
+		WIN32_GL_LOAD_FUNCTION(glDrawArraysInstanced);
+		WIN32_GL_LOAD_FUNCTION(glDrawElementsInstanced);
+
+		WIN32_GL_LOAD_FUNCTION(glFenceSync);
+		WIN32_GL_LOAD_FUNCTION(glClientWaitSync);
+		WIN32_GL_LOAD_FUNCTION(glDeleteSync);
+
+		WIN32_GL_LOAD_FUNCTION(glVertexAttribDivisor);
+
+		// NOTE: GL 4.1, LOGLShader compiles from source when a 3.3 driver doesn't have them
+		WIN32_GL_LOAD_OPTIONAL_FUNCTION(glGetProgramBinary);
+		WIN32_GL_LOAD_OPTIONAL_FUNCTION(glProgramBinary);
+		WIN32_GL_LOAD_OPTIONAL_FUNCTION(glProgramParameteri);
 
 		glViewport(0, 0, BUFFER_WIDTH, BUFFER_HEIGHT);
 	}
@@ -469,9 +556,35 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPWSTR lpCmdLi
 
 	PlatformMemory memory = {};
 	bool memInitResult    = (memory.mainStack.Init(DQN_MEGABYTE(16), true, 4) &&
-	                         memory.tempStack.Init(DQN_MEGABYTE(16), true, 4));
+	                         memory.tempStack.Init(DQN_MEGABYTE(16), true, 4) &&
+	                         LOGLFrameArena_Init(&memory.frameArena, DQN_MEGABYTE(1)));
 	if (!DQN_ASSERT(memInitResult)) return -1;
 
+	// Job queue, the main thread helps complete jobs so it gets one less worker than there are threads
+	LOCAL_PERSIST DqnJobQueue jobQueue;
+	{
+		u32 numCores, numThreadsPerCore;
+		DqnPlatform_GetNumThreadsAndCores(&numCores, &numThreadsPerCore);
+		u32 numJobThreads = (numCores * numThreadsPerCore > 1) ? (numCores * numThreadsPerCore) - 1 : 0;
+		if (numJobThreads > 0 && DqnJobQueue_Init(&jobQueue, numJobThreads))
+		{
+			memory.jobQueue      = &jobQueue;
+			memory.numJobThreads = numJobThreads;
+		}
+	}
+
+	// NOTE: LOGL decodes the source images of any texture that isn't in the pack, so it's optional
+	memory.assetPack = Win32MapFile("textures.pack", &memory.assetPackSize);
+
+	// NOTE: Without a directory the shaders are compiled from source every run
+	if (CreateDirectoryA("shadercache", NULL) || GetLastError() == ERROR_ALREADY_EXISTS)
+		memory.shaderCacheDir = "shadercache";
+
+	// NOTE: Shaders are rebuilt when a file in their directory is written, if it can't be watched
+	// they're only built on init
+	HANDLE shaderWatch = FindFirstChangeNotificationA(LOGL_SHADER_DIR, FALSE, FILE_NOTIFY_CHANGE_LAST_WRITE |
+	                                                                          FILE_NOTIFY_CHANGE_FILE_NAME);
+
 	while (globalRunning)
 	{
 		f64 startFrameTimeInS = DqnTimer_NowInS();
@@ -481,6 +594,13 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPWSTR lpCmdLi
 		////////////////////////////////////////////////////////////////////////
 		// Update and Render
 		////////////////////////////////////////////////////////////////////////
+		input.shadersChanged = false;
+		if (shaderWatch != INVALID_HANDLE_VALUE && WaitForSingleObject(shaderWatch, 0) == WAIT_OBJECT_0)
+		{
+			input.shadersChanged = true;
+			FindNextChangeNotification(shaderWatch);
+		}
+
 		LOGL_Update(&input, &memory);
 		if (1)
 		{
@@ -525,14 +645,16 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPWSTR lpCmdLi
 				GetProcessMemoryInfo(GetCurrentProcess(), &memCounter, sizeof(memCounter));
 
 				// Create UTF-8 buffer string
-				const char formatStr[]       = "%s - dev - %5.2f ms/f - %5.2f fps - working set mem %'dkb - page file touched mem %'dkb";
-				const u32 windowTitleBufSize = DQN_ARRAY_COUNT(formatStr) + DQN_ARRAY_COUNT(WINDOW_TITLE_A) + 32;
+				const char formatStr[]       = "%s - dev - %5.2f ms/f - %5.2f fps - working set mem %'dkb - page file touched mem %'dkb - frame mem %'dkb (peak %'dkb)";
+				const u32 windowTitleBufSize = DQN_ARRAY_COUNT(formatStr) + DQN_ARRAY_COUNT(WINDOW_TITLE_A) + 64;
 				char windowTitleBufA[windowTitleBufSize] = {};
 
 				// Form UTF-8 buffer string
+				const LOGLFrameArenaStats *arenaStats = &memory.frameArena.stats;
 				Dqn_sprintf(windowTitleBufA, formatStr, WINDOW_TITLE_A, msPerFrame, framesPerSecond,
 				            (u32)(memCounter.WorkingSetSize / 1024.0f),
-				            (u32)(memCounter.PagefileUsage / 1024.0f));
+				            (u32)(memCounter.PagefileUsage / 1024.0f), (u32)(arenaStats->used / 1024),
+				            (u32)(arenaStats->highWaterMark / 1024));
 
 				// Convert to wchar_t for windows
 				wchar_t windowTitleBufW[windowTitleBufSize] = {};
@@ -542,5 +664,10 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPWSTR lpCmdLi
 		}
 	}
 
+	LOGL_Shutdown(&memory);
+	DqnJobQueue_Free(memory.jobQueue);
+	LOGLFrameArena_Free(&memory.frameArena);
+	if (memory.assetPack) UnmapViewOfFile(memory.assetPack);
+	if (shaderWatch != INVALID_HANDLE_VALUE) FindCloseChangeNotification(shaderWatch);
 	return 0;
 }
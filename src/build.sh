@@ -0,0 +1,54 @@
+#!/bin/bash
+
+# Build for GCC/Clang on Linux. Run from the src directory.
+
+# Check if build tool is on path
+if ! command -v g++ >/dev/null 2>&1; then
+	echo "g++ not on path, please install it to build by command line."
+	exit 1
+fi
+
+# Build tags file if you have ctags in path
+if command -v ctags >/dev/null 2>&1; then
+	ctags -R
+fi
+
+ProjectName=LearnOpenGL
+SrcDir="$(cd "$(dirname "$0")" && pwd)"
+
+mkdir -p "$SrcDir/../bin"
+pushd "$SrcDir/../bin" >/dev/null
+
+################################################################################
+# Compile Switches
+################################################################################
+# fno-exceptions disable exception handling
+# fno-rtti       disable c runtime type information (we don't use) (i.e. typeof, dynamic cast)
+# g              enables debug data
+# Wall           warning level
+# Wno-*          warnings disabled to match the MSVC W4 set used by build.bat, i.e. nameless
+#                struct/union, unused functions/variables and string literal to char * conversion
+# mavx           (not set) enables the AVX DqnMat4 paths in dqn.h, SSE2 is used otherwise so the exe
+#                runs on any x64 CPU. -DDQN_NO_SIMD forces the scalar paths.
+CompileFlags="-std=c++14 -fno-exceptions -fno-rtti -g -Wall -Wno-unused-function -Wno-unused-variable
+              -Wno-unused-but-set-variable -Wno-write-strings -Wno-sign-compare -Wno-missing-braces
+              -Wno-unknown-pragmas"
+
+# Link libraries
+LinkLibraries="-lX11 -lGL -lpthread -lm"
+
+DebugMode=1
+if [ $DebugMode -eq 1 ]; then
+	CompileFlags="$CompileFlags -O0"
+else
+	CompileFlags="$CompileFlags -O2"
+fi
+
+################################################################################
+# Compile
+################################################################################
+g++ $CompileFlags "$SrcDir/UnityBuild.cpp" -o ${ProjectName}Linux $LinkLibraries
+LastError=$?
+
+popd >/dev/null
+exit $LastError
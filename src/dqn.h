@@ -46,15 +46,16 @@
 // #DqnWChar     WChar Operations (IsDigit(), IsAlpha() etc)
 // #DqnWStr      WStr  Operations (WStr_Len() etc)
 // #DqnRnd       Random Number Generator (ints and floats)
-// #Dqn_*        Dqn_QuickSort
+// #Dqn_*        Dqn_IntroSort, Dqn_RadixSort (Dqn_QuickSort)
 
 // #XPlatform (Win32 & Unix)
 // #DqnFile      File I/O (Read, Write, Delete)
 // #DqnDir       Directory Querying
 // #DqnTimer     High Resolution Timer
 // #DqnLock      Mutex Synchronisation
-// #DqnJobQueue  Multithreaded Job Queue
+// #DqnJobQueue  Multithreaded Job Queue, Parallel Sort
 // #DqnAtomic    Interlocks/Atomic Operations
+// #DqnMemStackShared Lock-free Memory Stack for Multiple Threads
 // #DqnPlatform  Common Platform API helpers
 
 // #Platform
@@ -100,6 +101,18 @@
 	#define DQN_CPP_MODE 1
 #endif
 
+// SIMD paths for DqnV4/DqnMat4 are picked from what the compiler is targeting. SSE2 is always
+// available on x64, AVX needs -mavx or /arch:AVX. Define DQN_NO_SIMD to force the scalar code.
+#if !defined(DQN_NO_SIMD)
+	#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define DQN_SSE2 1
+	#endif
+
+	#if defined(DQN_SSE2) && defined(__AVX__)
+		#define DQN_AVX 1
+	#endif
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 // #Portable Code
 ////////////////////////////////////////////////////////////////////////////////
@@ -116,9 +129,22 @@
 #include <stddef.h> // For standard types
 #include <string.h> // memmove
 #include <float.h>
+
+#if defined(DQN_AVX)
+	#include <immintrin.h>
+#elif defined(DQN_SSE2)
+	#include <emmintrin.h>
+#endif
+
 #define LOCAL_PERSIST static
 #define FILE_SCOPE    static
 
+#if defined(_MSC_VER)
+	#define DQN_THREAD_LOCAL __declspec(thread)
+#else
+	#define DQN_THREAD_LOCAL __thread
+#endif
+
 typedef uint64_t u64;
 typedef uint32_t u32;
 typedef uint16_t u16;
@@ -893,6 +919,18 @@ DQN_FILE_SCOPE DqnMat4 DqnMat4_ScaleV3     (DqnV3 scale);
 DQN_FILE_SCOPE DqnMat4 DqnMat4_Mul         (DqnMat4 a, DqnMat4 b);
 DQN_FILE_SCOPE DqnV4   DqnMat4_MulV4       (DqnMat4 a, DqnV4 b);
 
+// Transform arrays, result[i] = a * b[i]. result may be the same array as b.
+DQN_FILE_SCOPE void    DqnMat4_MulBatch    (DqnMat4 a, const DqnMat4 *b, DqnMat4 *result, u32 count);
+DQN_FILE_SCOPE void    DqnMat4_MulV4Batch  (DqnMat4 a, const DqnV4   *b, DqnV4   *result, u32 count);
+
+DQN_FILE_SCOPE DqnMat4 DqnMat4_Transpose   (DqnMat4 a);
+// return: The zero matrix if a is singular.
+DQN_FILE_SCOPE DqnMat4 DqnMat4_Inverse     (DqnMat4 a);
+// The inverse transpose of the upper 3x3 of a in the upper 3x3 of the result, the rest is identity.
+// Transforms normals by a model matrix with non uniform scale. Cheaper than Transpose(Inverse(a)) as
+// the translation is ignored. return: The zero matrix if the upper 3x3 is singular.
+DQN_FILE_SCOPE DqnMat4 DqnMat4_NormalMatrix(DqnMat4 a);
+
 ////////////////////////////////////////////////////////////////////////////////
 // #DqnRect Public API - Rectangles
 ////////////////////////////////////////////////////////////////////////////////
@@ -996,84 +1034,164 @@ DQN_FILE_SCOPE i32  DqnRnd_PCGRange(DqnRandPCGState *pcg, i32 min, i32 max);
 ////////////////////////////////////////////////////////////////////////////////
 // #Dqn_* Public API
 ////////////////////////////////////////////////////////////////////////////////
+// Dqn_IntroSort is a quicksort with median of three pivots that recurses into the smaller partition
+// and loops on the larger, so the stack is at most log2(n) deep. Partitions of up to
+// DQN_SORT_INSERTION_THRESHOLD items are insertion sorted and ones split more than 2 * log2(n) times
+// deep are heap sorted, which bounds any input to O(n log n). Items equal to the pivot stop both
+// scans so runs of duplicates split evenly. Not stable. Dqn_QuickSort() and Dqn_QuickSortC() are the
+// same sort through callbacks.
+#define DQN_SORT_INSERTION_THRESHOLD 16
+
 typedef bool Dqn_QuickSortLessThanCallback(const void *const val1, const void *const val2);
 typedef void Dqn_QuickSortSwapCallback    (void *const val1, void *const val2);
 DQN_FILE_SCOPE void Dqn_QuickSortC(void *const array, const u32 itemSize, const u32 size,
                                    Dqn_QuickSortLessThanCallback *const IsLessThan,
                                    Dqn_QuickSortSwapCallback *const Swap);
 
+// IsLessThan: Called as bool IsLessThan(const T &a, const T &b), a lambda or functor is inlined.
+template <typename T, typename LessThan>
+DQN_FILE_SCOPE void Dqn_IntroSort(T *const array, const u32 size, LessThan IsLessThan);
+
+// Sort with T's operator <
+template <typename T>
+DQN_FILE_SCOPE void Dqn_IntroSort(T *const array, const u32 size);
+
 template <typename T>
 DQN_FILE_SCOPE void Dqn_QuickSort(T *const array, const u32 size,
-                                  Dqn_QuickSortLessThanCallback *const IsLessThan)
-{
-	if (!array || size == 0 || size == 1 || !IsLessThan) return;
+                                  Dqn_QuickSortLessThanCallback *const IsLessThan);
+
+// A key and the index of what it orders, i.e. into the caller's array
+typedef struct DqnSortKeyU32 { u32 key; u32 index; } DqnSortKeyU32;
+typedef struct DqnSortKeyU64 { u64 key; u32 index; } DqnSortKeyU64;
+typedef struct DqnSortKeyF32 { f32 key; u32 index; } DqnSortKeyF32;
 
-	// Insertion Sort, under 24->32 is an optimal amount
-	const u32 QUICK_SORT_THRESHOLD = 24;
-	if (size < QUICK_SORT_THRESHOLD)
+// Stable least significant digit radix sort, 8 bits a pass. Every digit is counted in one pass over
+// the keys and a pass where every key has the same digit is skipped. Floats sort by value with -0
+// before +0, NaNs go to the end or the start by their sign bit.
+// scratch: Room for size pairs, its contents on return are undefined.
+DQN_FILE_SCOPE void Dqn_RadixSort(DqnSortKeyU32 *const array, const u32 size, DqnSortKeyU32 *const scratch);
+DQN_FILE_SCOPE void Dqn_RadixSort(DqnSortKeyU64 *const array, const u32 size, DqnSortKeyU64 *const scratch);
+DQN_FILE_SCOPE void Dqn_RadixSort(DqnSortKeyF32 *const array, const u32 size, DqnSortKeyF32 *const scratch);
+
+////////////////////////////////////////////////////////////////////////////////
+// #Dqn_* Template Implementation
+////////////////////////////////////////////////////////////////////////////////
+template <typename T, typename LessThan>
+FILE_SCOPE void DqnInternal_InsertionSort(T *const array, const u32 size, LessThan &IsLessThan)
+{
+	for (u32 i = 1; i < size; i++)
 	{
-		u32 itemToInsertIndex = 1;
-		while (itemToInsertIndex < size)
-		{
-			for (u32 checkIndex = 0; checkIndex < itemToInsertIndex; checkIndex++)
-			{
-				if (!IsLessThan(&array[checkIndex], &array[itemToInsertIndex]))
-				{
-					T itemToInsert = array[itemToInsertIndex];
-					for (u32 i   = itemToInsertIndex; i > checkIndex; i--)
-						array[i] = array[i - 1];
+		T item = array[i];
+		u32 j  = i;
+		for (; j > 0 && IsLessThan(item, array[j - 1]); j--)
+			array[j] = array[j - 1];
+		array[j] = item;
+	}
+}
 
-					array[checkIndex] = itemToInsert;
-					break;
-				}
-			}
-			itemToInsertIndex++;
+template <typename T, typename LessThan>
+FILE_SCOPE void DqnInternal_HeapSort(T *const array, const u32 size, LessThan &IsLessThan)
+{
+	auto SiftDown = [&](u32 root, const u32 end) {
+		for (u32 child = (root * 2) + 1; child < end; root = child, child = (root * 2) + 1)
+		{
+			if (child + 1 < end && IsLessThan(array[child], array[child + 1])) child++;
+			if (!IsLessThan(array[root], array[child])) return;
+			DQN_SWAP(T, array[root], array[child]);
 		}
+	};
 
-		return;
+	for (u32 i = size / 2; i-- > 0;)
+		SiftDown(i, size);
+
+	for (u32 end = size - 1; end > 0; end--)
+	{
+		DQN_SWAP(T, array[0], array[end]);
+		SiftDown(0, end);
 	}
+}
 
-	DqnRandPCGState state = {};
-	DqnRnd_PCGInit(&state);
+// Order the first, middle and last items, park the median before the last as the pivot then
+// partition between them. The ends bound both scans so they need no range checks.
+// return: The index the pivot ends up at, every item before it is <= and every item after is >=.
+template <typename T, typename LessThan>
+FILE_SCOPE u32 DqnInternal_Partition(T *const array, const u32 size, LessThan &IsLessThan)
+{
+	const u32 mid  = size / 2;
+	const u32 last = size - 1;
+	if (IsLessThan(array[mid],  array[0]))   DQN_SWAP(T, array[mid],  array[0]);
+	if (IsLessThan(array[last], array[0]))   DQN_SWAP(T, array[last], array[0]);
+	if (IsLessThan(array[last], array[mid])) DQN_SWAP(T, array[last], array[mid]);
 
-	u32 pivotIndex     = DqnRnd_PCGRange(&state, 0, size - 1);
-	u32 partitionIndex = 0;
-	u32 startIndex     = 0;
+	const u32 pivot = last - 1;
+	DQN_SWAP(T, array[mid], array[pivot]);
 
-	// Swap pivot with last index, so pivot is always at the end of the array.
-	// This makes logic much simpler.
+	u32 i = 0, j = pivot;
+	for (;;)
 	{
-		u32 lastIndex = size - 1;
-		DQN_SWAP(T, array[lastIndex], array[pivotIndex]);
-		pivotIndex = lastIndex;
+		while (IsLessThan(array[++i], array[pivot])) {}
+		while (IsLessThan(array[pivot], array[--j])) {}
+		if (i >= j) break;
+		DQN_SWAP(T, array[i], array[j]);
 	}
 
-	// 4^, 8, 7, 5, 2, 3, 6
-	if (IsLessThan(&array[startIndex], &array[pivotIndex])) partitionIndex++;
-	startIndex++;
+	DQN_SWAP(T, array[i], array[pivot]);
+	return i;
+}
 
-	// 4, |8, 7, 5^, 2, 3, 6*
-	// 4, 5, |7, 8, 2^, 3, 6*
-	// 4, 5, 2, |8, 7, ^3, 6*
-	// 4, 5, 2, 3, |7, 8, ^6*
-	for (u32 checkIndex = startIndex; checkIndex < size; checkIndex++)
+template <typename T, typename LessThan>
+FILE_SCOPE void DqnInternal_IntroSort(T *array, u32 size, LessThan &IsLessThan, u32 depthLimit)
+{
+	while (size > DQN_SORT_INSERTION_THRESHOLD)
 	{
-		if (IsLessThan(&array[checkIndex], &array[pivotIndex]))
+		if (depthLimit-- == 0)
+		{
+			DqnInternal_HeapSort(array, size, IsLessThan);
+			return;
+		}
+
+		u32 pivot     = DqnInternal_Partition(array, size, IsLessThan);
+		u32 rightSize = size - (pivot + 1);
+		if (pivot < rightSize)
+		{
+			DqnInternal_IntroSort(array, pivot, IsLessThan, depthLimit);
+			array += pivot + 1;
+			size   = rightSize;
+		}
+		else
 		{
-			DQN_SWAP(T, array[partitionIndex], array[checkIndex]);
-			partitionIndex++;
+			DqnInternal_IntroSort(array + pivot + 1, rightSize, IsLessThan, depthLimit);
+			size = pivot;
 		}
 	}
 
-	// Move pivot to right of partition
-	// 4, 5, 2, 3, |6, 8, ^7*
-	DQN_SWAP(T, array[partitionIndex], array[pivotIndex]);
-	Dqn_QuickSort(array, partitionIndex, IsLessThan);
+	DqnInternal_InsertionSort(array, size, IsLessThan);
+}
+
+template <typename T, typename LessThan>
+DQN_FILE_SCOPE void Dqn_IntroSort(T *const array, const u32 size, LessThan IsLessThan)
+{
+	if (!array || size < 2) return;
+
+	u32 depthLimit = 0;
+	for (u32 n = size; n > 1; n >>= 1)
+		depthLimit += 2;
+
+	DqnInternal_IntroSort(array, size, IsLessThan, depthLimit);
+}
+
+template <typename T>
+DQN_FILE_SCOPE void Dqn_IntroSort(T *const array, const u32 size)
+{
+	Dqn_IntroSort(array, size, [](const T &a, const T &b) { return a < b; });
+}
 
-	// Skip the value at partion index since that is guaranteed to be sorted.
-	// 4, 5, 2, 3, (x), 8, 7
-	u32 oneAfterPartitionIndex = partitionIndex + 1;
-	Dqn_QuickSort(array + oneAfterPartitionIndex, (size - oneAfterPartitionIndex), IsLessThan);
+template <typename T>
+DQN_FILE_SCOPE void Dqn_QuickSort(T *const array, const u32 size,
+                                  Dqn_QuickSortLessThanCallback *const IsLessThan)
+{
+	if (!IsLessThan) return;
+	Dqn_IntroSort(array, size, [IsLessThan](const T &a, const T &b) { return IsLessThan(&a, &b); });
 }
 
 #endif  /* DQN_H */
@@ -1259,38 +1377,95 @@ DQN_FILE_SCOPE void DqnLock_Delete (DqnLock *const lock);
 ////////////////////////////////////////////////////////////////////////////////
 // XPlatform > #DqnJobQueue Public API - Multithreaded Job Queue
 ////////////////////////////////////////////////////////////////////////////////
-// DqnJobQueue is a platform abstracted "lockless" multithreaded work queue. It will create threads
-// and assign threads to complete the job via the job "callback" using the "userData" supplied.
+// DqnJobQueue is a platform abstracted "lockless" work stealing job scheduler. It will create
+// threads and assign threads to complete the job via the job "callback" using the "userData" supplied.
 
 // Usage
 // 1. Prepare your callback function for threads to execute following the 'DqnJob_Callback' function
 //    signature.
-// 2. Create a job queue with DqnJobQueue_InitWithMem()
+// 2. Create a job queue with DqnJobQueue_Init()
 // 3. Add jobs with DqnJobQueue_AddJob() and threads will be dispatched automatically.
+// 4. DqnJobQueue_Free() completes the remaining jobs and joins the threads.
 
 // When all jobs are sent you can also utilise the main executing thread to complete jobs whilst you
 // wait for all jobs to complete using DqnJobQueue_TryExecuteNextJob() or spinlock on
 // DqnJobQueue_AllJobsComplete(). Alternatively you can combine both for the main thread to help
 // complete work and not move on until all tasks are complete.
 
+// Scheduling
+// Every thread owns a Chase-Lev deque, the thread that called Init() and each worker. Jobs are
+// pushed to and popped from the bottom of the adding thread's own deque without contention, idle
+// threads steal from the top of the others. Deques grow when full so adding a job never fails.
+// Only the thread that called Init() and jobs running on the queue's threads may add jobs.
+// NOTE: This differs from the old shared ring buffer queue, where any thread could add jobs and
+// AddJob() only failed when the ring was full. AddJob() now never fails for being full, but returns
+// FALSE without running the job when the calling thread doesn't belong to the queue. Callers on
+// other threads have to run the job themselves or hand it to a thread that belongs.
+
+// Counters and Dependencies
+// A DqnJobCounter counts the jobs using it that have not completed. Wait on it with
+// DqnJobQueue_WaitForCounter(), the waiting thread completes other jobs in the meantime. A job
+// with a dependency doesn't start until the dependency's counter reaches 0, the thread that takes
+// it completes other jobs until then. Dependencies must not form a cycle.
+// A job can add child jobs with DqnJobQueue_AddChildJob(), the children use the parent's counter
+// so waiting on it waits on the parent and everything it spawned.
+
+// Scratch Memory
+// Every thread of the queue, the thread that called Init() included, owns a DqnMemStack that
+// DqnJobQueue_GetScratch() returns. Each job runs in a temp region of its thread's stack so what it
+// pushes is released when it returns, nothing needs popping and no other thread touches it. The
+// thread that called Init() must begin its own region to use its stack outside of a job.
+// A thread that doesn't belong to the queue can still run jobs with DqnJobQueue_TryExecuteNextJob(),
+// they get NULL from GetScratch() so a job that may be run that way must fall back to other memory.
+
+// Size of the first block of each thread's scratch stack
+#define DQN_JOB_QUEUE_SCRATCH_SIZE DQN_KILOBYTE(256)
+
 typedef struct DqnJobQueue DqnJobQueue;
 
+typedef struct DqnJobCounter
+{
+	i32 volatile numJobs; // Jobs added with this counter that have not completed
+} DqnJobCounter;
+
 typedef void   DqnJob_Callback(DqnJobQueue *const queue, void *const userData);
 typedef struct DqnJob
 {
 	DqnJob_Callback *callback;
 	void            *userData;
+	DqnJobCounter   *counter;    // Optional, counts the job from when it's added until it completes
+	DqnJobCounter   *dependency; // Optional, the job starts once this counter reaches 0
 } DqnJob;
 
+// NOTE: top and bottom are padded apart, thieves write top and the owner bottom
+typedef struct DqnJobDeque
+{
+	i64 volatile top;
+	u8           pad0[56];
+	i64 volatile bottom;
+
+	struct DqnJobDequeInternalArray *volatile array;
+	struct DqnJobDequeInternalArray *retired; // Arrays replaced when growing, freed in DqnJobQueue_Free()
+	u8                               pad1[40];
+} DqnJobDeque;
+
 typedef struct DqnJobQueue
 {
-	// JobList Circular Array, is setup in Init()
-	DqnJob *jobList;
-	u32     size;
+	// deques[0] belongs to the thread that called Init(), deques[i + 1] to worker i
+	DqnJobDeque *deques;
+	u32          numDeques;
+
+	struct DqnJobQueueInternalWorker *workers;
+	u32                               numThreads;
+	u64                               ownerThreadId; // Thread that called Init()
+
+	DqnMemStack *scratch; // scratch[i] belongs to the thread of deques[i]
 
 	// NOTE(doyle): Modified by main+worker threads
-	i32   volatile jobToExecuteIndex;
-	i32   volatile numJobsToComplete;
+	i32 volatile numJobsToComplete;
+	i32 volatile numThreadsSleeping; // Adding a job only wakes a thread when there's one asleep
+	i32 volatile numWakesPending;    // Semaphore signals no thread has woken from yet
+	i32 volatile isShuttingDown;
 
 #if defined(DQN_IS_WIN32)
 	void *semaphore;
@@ -1303,36 +1478,47 @@ typedef struct DqnJobQueue
 
 #endif
 
-	// NOTE: Modified by main thread ONLY
-	i32 volatile jobInsertIndex;
-
 #if defined(DQN_CPP_MODE)
-	bool Init             (DqnJob *const jobList_, const u32 jobListSize, const u32 numThreads);
+	bool Init             (const u32 numThreads);
+	void Free             ();
 	bool AddJob           (const DqnJob job);
+	bool AddChildJob      (const DqnJob job);
 
-    void BlockAndCompleteAllJobs();
+	void BlockAndCompleteAllJobs();
+	void WaitForCounter   (DqnJobCounter *const counter);
 	bool TryExecuteNextJob();
 	bool AllJobsComplete  ();
+
+	DqnMemStack *GetScratch();
 #endif
 } DqnJobQueue;
 
-// TODO(doyle): Queue delete, thread delete
+// queue:      Pass a pointer to a zero cleared DqnJobQueue struct
+// numThreads: The number of threads the queue should request from the OS for working on the queue
+// return:     FALSE if invalid args i.e. NULL ptrs or numThreads == 0, or out of memory
+DQN_FILE_SCOPE bool DqnJobQueue_Init(DqnJobQueue *const queue, const u32 numThreads);
 
-// queue:       Pass a pointer to a zero cleared DqnJobQueue struct
-// jobList:     Pass in a pointer to an array of DqnJob's
-// jobListSize: The number of elements in the jobList array
-// numThreads:  The number of threads the queue should request from the OS for working on the queue
-// return:      FALSE if invalid args i.e. NULL ptrs or jobListSize & numThreads == 0
-DQN_FILE_SCOPE bool DqnJobQueue_Init(DqnJobQueue *const queue, const DqnJob *const jobList,
-                                     const u32 jobListSize, const u32 numThreads);
+// Completes all outstanding jobs, then stops and joins the threads and frees the queue's memory.
+// Must be called from the thread that called Init().
+DQN_FILE_SCOPE void DqnJobQueue_Free(DqnJobQueue *const queue);
 
-// return: FALSE if the job is not able to be added, this occurs if the queue is full.
+// Push the job onto the calling thread's deque, growing it if it's full. If the deque could not
+// grow the job is run on the calling thread before returning.
+// return: FALSE if the queue is NULL or the calling thread does not belong to the queue, the job is
+//         then not run. See Scheduling above.
 DQN_FILE_SCOPE bool DqnJobQueue_AddJob(DqnJobQueue *const queue, const DqnJob job);
 
+// Add a job that counts towards the counter of the job the calling thread is executing, job.counter
+// is ignored. Must be called from inside a job's callback.
+DQN_FILE_SCOPE bool DqnJobQueue_AddChildJob(DqnJobQueue *const queue, DqnJob job);
+
 // Helper function that combines TryExecuteNextJob() and AllJobsComplete(), i.e.
 // complete all work before moving on. Does nothing if queue is NULL.
 DQN_FILE_SCOPE void DqnJobQueue_BlockAndCompleteAllJobs(DqnJobQueue *const queue);
 
+// Complete other jobs until the counter reaches 0. Does nothing if counter is NULL.
+DQN_FILE_SCOPE void DqnJobQueue_WaitForCounter(DqnJobQueue *const queue, DqnJobCounter *const counter);
+
 // return: TRUE if there was a job to execute (the calling thread executes it). FALSE if it could
 //         not get a job. It may return FALSE whilst there are still jobs, this means that another thread
 //         has taken the job before the calling thread could and should NOT be used to determine if there
@@ -1343,6 +1529,28 @@ DQN_FILE_SCOPE void DqnJobQueue_BlockAndCompleteAllJobs(DqnJobQueue *const queue
 DQN_FILE_SCOPE bool DqnJobQueue_TryExecuteNextJob(DqnJobQueue *const queue);
 DQN_FILE_SCOPE bool DqnJobQueue_AllJobsComplete  (DqnJobQueue *const queue);
 
+// The calling thread's scratch stack, see Scratch Memory above. It starts at
+// DQN_JOB_QUEUE_SCRATCH_SIZE and grows when a job needs more, the extra blocks are freed when the job
+// returns.
+// return: NULL if the queue is NULL or the calling thread does not belong to the queue.
+DQN_FILE_SCOPE DqnMemStack *DqnJobQueue_GetScratch(DqnJobQueue *const queue);
+
+// Parallel Sort
+// Dqn_RadixSort() spread over the queue's threads. The array is cut into chunks that jobs radix sort,
+// then pairs of sorted runs are merged in log2(chunks) rounds. Each merge is split at even points of
+// its output so the last rounds, with few runs left, still have a job per chunk. Stable, so the result
+// is the same as Dqn_RadixSort() for any number of threads or order the jobs run in.
+// Like DqnJobQueue_AddJob() it must be called from the thread that called Init() or from a job, the
+// calling thread completes jobs until the sort is done.
+// stack:  Scratch for a copy of the array and the jobs, popped before returning.
+// return: FALSE if the args are invalid or stack ran out of memory, the array is then unchanged.
+DQN_FILE_SCOPE bool DqnJobQueue_ParallelSort(DqnJobQueue *const queue, DqnMemStack *const stack,
+                                             DqnSortKeyU32 *const array, const u32 size);
+DQN_FILE_SCOPE bool DqnJobQueue_ParallelSort(DqnJobQueue *const queue, DqnMemStack *const stack,
+                                             DqnSortKeyU64 *const array, const u32 size);
+DQN_FILE_SCOPE bool DqnJobQueue_ParallelSort(DqnJobQueue *const queue, DqnMemStack *const stack,
+                                             DqnSortKeyF32 *const array, const u32 size);
+
 ////////////////////////////////////////////////////////////////////////////////
 // XPlatform > #DqnAtomic Public API - Interlocks/Atomic Operations
 ////////////////////////////////////////////////////////////////////////////////
@@ -1358,6 +1566,75 @@ DQN_FILE_SCOPE i32 DqnAtomic_CompareSwap32(i32 volatile *const dest, const i32 s
 // return: The new value at src
 DQN_FILE_SCOPE i32 DqnAtomic_Add32(i32 volatile *const src, const i32 value);
 
+// 64 bit versions of the above
+DQN_FILE_SCOPE i64 DqnAtomic_CompareSwap64(i64 volatile *const dest, const i64 swapVal, const i64 compareVal);
+DQN_FILE_SCOPE i64 DqnAtomic_Add64        (i64 volatile *const src,  const i64 value);
+
+// Pointer sized version of CompareSwap32()
+DQN_FILE_SCOPE void *DqnAtomic_CompareSwapPtr(void *volatile *const dest, void *const swapVal, void *const compareVal);
+
+// Read or write a value other threads access at the same time. Plain 64 bit loads and stores can tear
+// on 32 bit targets and plain pointer ones aren't ordered, these are atomic on every target.
+DQN_FILE_SCOPE i64   DqnAtomic_Load64  (i64 volatile *const src);
+DQN_FILE_SCOPE void  DqnAtomic_Store64 (i64 volatile *const dest, const i64 value);
+DQN_FILE_SCOPE void *DqnAtomic_LoadPtr (void *volatile *const src);
+DQN_FILE_SCOPE void  DqnAtomic_StorePtr(void *volatile *const dest, void *const value);
+
+// Full read/write barrier with no other effect, for lockless code that mixes plain loads and stores
+DQN_FILE_SCOPE void DqnAtomic_MemoryBarrier();
+
+////////////////////////////////////////////////////////////////////////////////
+// XPlatform > #DqnMemStackShared Public API - Lock-free Memory Stack for Multiple Threads
+////////////////////////////////////////////////////////////////////////////////
+// A push only DqnMemStack that any number of threads can push to at once without a lock. A push is
+// an atomic add to the used count of the current block. Pushes that overflow it race to chain a new
+// block with a compare and swap, the winner's becomes the current block and the others free theirs
+// and push again. Memory is only released all at once by DqnMemStackShared_Clear().
+// The end of a block that a push overflows is left unused, so up to the largest push is wasted per
+// block. Keep pushes small next to the block size.
+// Init(), Clear() and Free() must not overlap any other call on the stack.
+
+typedef struct DqnMemStackSharedBlock
+{
+	u8                            *memory;
+	size_t                         size;
+	i64 volatile                   used;      // Passes size once the block is full, every push that overflows it still adds
+	struct DqnMemStackSharedBlock *prevBlock;
+} DqnMemStackSharedBlock;
+
+typedef struct DqnMemStackShared
+{
+	DqnMemStackSharedBlock *volatile block;
+	size_t                           blockSize; // Size of chained blocks, a push larger than this gets a block of its own size
+	u32                              byteAlign;
+	bool                             zeroClear;
+	i32 volatile                     numBlocks;
+
+#if defined(DQN_CPP_MODE)
+	bool  Init (const size_t size, const bool zeroClear, const u32 byteAlignment = 4);
+	void *Push (const size_t size);
+	void  Clear();
+	void  Free ();
+#endif
+} DqnMemStackShared;
+
+// stack:     Pass a pointer to a zero cleared DqnMemStackShared struct.
+// size:      Of the first block and the blocks chained after it, aligned to byteAlign.
+// byteAlign: Must be a power of 2.
+// return:    FALSE if args are invalid or out of memory.
+DQN_FILE_SCOPE bool  DqnMemStackShared_Init(DqnMemStackShared *const stack, const size_t size, const bool zeroClear,
+                                            const u32 byteAlign = 4);
+
+// Safe to call from any number of threads at once. A push that doesn't fit in what's left of the
+// current block goes to a new block, the rest of the old one is never used.
+// return: NULL if size is 0 or a block to chain could not be allocated.
+DQN_FILE_SCOPE void *DqnMemStackShared_Push(DqnMemStackShared *const stack, const size_t size);
+
+// Release everything pushed. When blocks were chained they're all freed and replaced with one block
+// the size of them all, so the same pushes fit in a single block next time.
+DQN_FILE_SCOPE void  DqnMemStackShared_Clear(DqnMemStackShared *const stack);
+DQN_FILE_SCOPE void  DqnMemStackShared_Free (DqnMemStackShared *const stack);
+
 ////////////////////////////////////////////////////////////////////////////////
 // XPlatform > #DqnPlatform Public API - Common Platform API Helpers
 ////////////////////////////////////////////////////////////////////////////////
@@ -2996,8 +3273,12 @@ DQN_FILE_SCOPE DqnV4 DqnV4_V3(DqnV3 a, f32 w)
 DQN_FILE_SCOPE DqnV4 DqnV4_Add(DqnV4 a, DqnV4 b)
 {
 	DqnV4 result = {0};
+#if defined(DQN_SSE2)
+	_mm_storeu_ps(result.e, _mm_add_ps(_mm_loadu_ps(a.e), _mm_loadu_ps(b.e)));
+#else
 	for (u32 i = 0; i < DQN_ARRAY_COUNT(a.e); i++)
 		result.e[i] = a.e[i] + b.e[i];
+#endif
 
 	return result;
 }
@@ -3005,8 +3286,12 @@ DQN_FILE_SCOPE DqnV4 DqnV4_Add(DqnV4 a, DqnV4 b)
 DQN_FILE_SCOPE DqnV4 DqnV4_Sub(DqnV4 a, DqnV4 b)
 {
 	DqnV4 result = {0};
+#if defined(DQN_SSE2)
+	_mm_storeu_ps(result.e, _mm_sub_ps(_mm_loadu_ps(a.e), _mm_loadu_ps(b.e)));
+#else
 	for (u32 i = 0; i < DQN_ARRAY_COUNT(a.e); i++)
 		result.e[i] = a.e[i] - b.e[i];
+#endif
 
 	return result;
 }
@@ -3023,8 +3308,12 @@ DQN_FILE_SCOPE DqnV4 DqnV4_Scalei(DqnV4 a, i32 b)
 DQN_FILE_SCOPE DqnV4 DqnV4_Scalef(DqnV4 a, f32 b)
 {
 	DqnV4 result = {0};
+#if defined(DQN_SSE2)
+	_mm_storeu_ps(result.e, _mm_mul_ps(_mm_loadu_ps(a.e), _mm_set1_ps(b)));
+#else
 	for (u32 i = 0; i < DQN_ARRAY_COUNT(a.e); i++)
 		result.e[i] = a.e[i] * b;
+#endif
 
 	return result;
 }
@@ -3032,8 +3321,12 @@ DQN_FILE_SCOPE DqnV4 DqnV4_Scalef(DqnV4 a, f32 b)
 DQN_FILE_SCOPE DqnV4 DqnV4_Hadamard(DqnV4 a, DqnV4 b)
 {
 	DqnV4 result = {0};
+#if defined(DQN_SSE2)
+	_mm_storeu_ps(result.e, _mm_mul_ps(_mm_loadu_ps(a.e), _mm_loadu_ps(b.e)));
+#else
 	for (u32 i = 0; i < DQN_ARRAY_COUNT(a.e); i++)
 		result.e[i] = a.e[i] * b.e[i];
+#endif
 
 	return result;
 }
@@ -3048,8 +3341,15 @@ DQN_FILE_SCOPE f32 DqnV4_Dot(DqnV4 a, DqnV4 b)
 	   |c|   |f|
 	 */
 	f32 result = 0;
+#if defined(DQN_SSE2)
+	__m128 mul = _mm_mul_ps(_mm_loadu_ps(a.e), _mm_loadu_ps(b.e));
+	__m128 sum = _mm_add_ps(mul, _mm_shuffle_ps(mul, mul, _MM_SHUFFLE(1, 0, 3, 2))); // (x+z, y+w, ..)
+	sum        = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(0, 0, 0, 1)));  // (x+z+y+w, ..)
+	result     = _mm_cvtss_f32(sum);
+#else
 	for (u32 i = 0; i < DQN_ARRAY_COUNT(a.e); i++)
 		result += (a.e[i] * b.e[i]);
+#endif
 
 	return result;
 }
@@ -3197,9 +3497,59 @@ DQN_FILE_SCOPE DqnMat4 DqnMat4_ScaleV3(DqnV3 scale)
 	return result;
 }
 
+#if defined(DQN_SSE2)
+// NOTE: Column major, so a matrix times a column is the sum of a's columns each scaled by one
+// component of the column. The same goes for a matrix times a vector.
+FILE_SCOPE inline __m128 DqnMat4Internal_MulColSSE2(const __m128 *const aCol, const f32 *const bCol)
+{
+	__m128 result = _mm_mul_ps(aCol[0], _mm_set1_ps(bCol[0]));
+	result        = _mm_add_ps(result, _mm_mul_ps(aCol[1], _mm_set1_ps(bCol[1])));
+	result        = _mm_add_ps(result, _mm_mul_ps(aCol[2], _mm_set1_ps(bCol[2])));
+	result        = _mm_add_ps(result, _mm_mul_ps(aCol[3], _mm_set1_ps(bCol[3])));
+	return result;
+}
+
+FILE_SCOPE inline void DqnMat4Internal_LoadColsSSE2(const DqnMat4 *const a, __m128 *const aCol)
+{
+	for (u32 i = 0; i < 4; i++)
+		aCol[i] = _mm_loadu_ps(a->e[i]);
+}
+#endif
+
+#if defined(DQN_AVX)
+// Same as DqnMat4Internal_MulColSSE2() but 2 consecutive columns at a time. aCol has each column of
+// a duplicated into both 128 bit lanes and the shuffle broadcasts a component within each lane.
+FILE_SCOPE inline __m256 DqnMat4Internal_MulCol2AVX(const __m256 *const aCol, const f32 *const bCols)
+{
+	__m256 b      = _mm256_loadu_ps(bCols);
+	__m256 result = _mm256_mul_ps(aCol[0], _mm256_shuffle_ps(b, b, _MM_SHUFFLE(0, 0, 0, 0)));
+	result        = _mm256_add_ps(result, _mm256_mul_ps(aCol[1], _mm256_shuffle_ps(b, b, _MM_SHUFFLE(1, 1, 1, 1))));
+	result        = _mm256_add_ps(result, _mm256_mul_ps(aCol[2], _mm256_shuffle_ps(b, b, _MM_SHUFFLE(2, 2, 2, 2))));
+	result        = _mm256_add_ps(result, _mm256_mul_ps(aCol[3], _mm256_shuffle_ps(b, b, _MM_SHUFFLE(3, 3, 3, 3))));
+	return result;
+}
+
+FILE_SCOPE inline void DqnMat4Internal_LoadColsAVX(const DqnMat4 *const a, __m256 *const aCol)
+{
+	for (u32 i = 0; i < 4; i++)
+		aCol[i] = _mm256_broadcast_ps((const __m128 *)a->e[i]);
+}
+#endif
+
 DQN_FILE_SCOPE DqnMat4 DqnMat4_Mul(DqnMat4 a, DqnMat4 b)
 {
 	DqnMat4 result = {0};
+#if defined(DQN_AVX)
+	__m256 aCol[4];
+	DqnMat4Internal_LoadColsAVX(&a, aCol);
+	_mm256_storeu_ps(result.e[0], DqnMat4Internal_MulCol2AVX(aCol, b.e[0]));
+	_mm256_storeu_ps(result.e[2], DqnMat4Internal_MulCol2AVX(aCol, b.e[2]));
+#elif defined(DQN_SSE2)
+	__m128 aCol[4];
+	DqnMat4Internal_LoadColsSSE2(&a, aCol);
+	for (u32 j = 0; j < 4; j++)
+		_mm_storeu_ps(result.e[j], DqnMat4Internal_MulColSSE2(aCol, b.e[j]));
+#else
 	for (u32 j = 0; j < 4; j++) {
 		for (u32 i = 0; i < 4; i++)
 		{
@@ -3209,6 +3559,7 @@ DQN_FILE_SCOPE DqnMat4 DqnMat4_Mul(DqnMat4 a, DqnMat4 b)
 			               + a.e[3][i] * b.e[j][3];
 		}
 	}
+#endif
 
 	return result;
 }
@@ -3216,11 +3567,165 @@ DQN_FILE_SCOPE DqnMat4 DqnMat4_Mul(DqnMat4 a, DqnMat4 b)
 DQN_FILE_SCOPE DqnV4 DqnMat4_MulV4(DqnMat4 a, DqnV4 b)
 {
 	DqnV4 result = {0};
+#if defined(DQN_SSE2)
+	__m128 aCol[4];
+	DqnMat4Internal_LoadColsSSE2(&a, aCol);
+	_mm_storeu_ps(result.e, DqnMat4Internal_MulColSSE2(aCol, b.e));
+#else
 	result.x = (a.e[0][0] * b.x) + (a.e[1][0] * b.y) + (a.e[2][0] * b.z) + (a.e[3][0] * b.w);
 	result.y = (a.e[0][1] * b.x) + (a.e[1][1] * b.y) + (a.e[2][1] * b.z) + (a.e[3][1] * b.w);
 	result.z = (a.e[0][2] * b.x) + (a.e[1][2] * b.y) + (a.e[2][2] * b.z) + (a.e[3][2] * b.w);
 	result.w = (a.e[0][3] * b.x) + (a.e[1][3] * b.y) + (a.e[2][3] * b.z) + (a.e[3][3] * b.w);
+#endif
+
+	return result;
+}
+
+// NOTE: The batch versions load a once and keep it in registers for the whole array. Each
+// b[i] is fully read before result[i] is written so they can transform in place.
+DQN_FILE_SCOPE void DqnMat4_MulBatch(DqnMat4 a, const DqnMat4 *b, DqnMat4 *result, u32 count)
+{
+	if (!b || !result) return;
 
+#if defined(DQN_AVX)
+	__m256 aCol[4];
+	DqnMat4Internal_LoadColsAVX(&a, aCol);
+	for (u32 i = 0; i < count; i++)
+	{
+		__m256 cols01 = DqnMat4Internal_MulCol2AVX(aCol, b[i].e[0]);
+		__m256 cols23 = DqnMat4Internal_MulCol2AVX(aCol, b[i].e[2]);
+		_mm256_storeu_ps(result[i].e[0], cols01);
+		_mm256_storeu_ps(result[i].e[2], cols23);
+	}
+#elif defined(DQN_SSE2)
+	__m128 aCol[4];
+	DqnMat4Internal_LoadColsSSE2(&a, aCol);
+	for (u32 i = 0; i < count; i++)
+	{
+		__m128 col0 = DqnMat4Internal_MulColSSE2(aCol, b[i].e[0]);
+		__m128 col1 = DqnMat4Internal_MulColSSE2(aCol, b[i].e[1]);
+		__m128 col2 = DqnMat4Internal_MulColSSE2(aCol, b[i].e[2]);
+		__m128 col3 = DqnMat4Internal_MulColSSE2(aCol, b[i].e[3]);
+		_mm_storeu_ps(result[i].e[0], col0);
+		_mm_storeu_ps(result[i].e[1], col1);
+		_mm_storeu_ps(result[i].e[2], col2);
+		_mm_storeu_ps(result[i].e[3], col3);
+	}
+#else
+	for (u32 i = 0; i < count; i++)
+		result[i] = DqnMat4_Mul(a, b[i]);
+#endif
+}
+
+DQN_FILE_SCOPE void DqnMat4_MulV4Batch(DqnMat4 a, const DqnV4 *b, DqnV4 *result, u32 count)
+{
+	if (!b || !result) return;
+
+	u32 i = 0;
+#if defined(DQN_AVX)
+	__m256 aCol2[4];
+	DqnMat4Internal_LoadColsAVX(&a, aCol2);
+	for (; i + 1 < count; i += 2)
+		_mm256_storeu_ps(result[i].e, DqnMat4Internal_MulCol2AVX(aCol2, b[i].e));
+#endif
+
+#if defined(DQN_SSE2)
+	__m128 aCol[4];
+	DqnMat4Internal_LoadColsSSE2(&a, aCol);
+	for (; i < count; i++)
+		_mm_storeu_ps(result[i].e, DqnMat4Internal_MulColSSE2(aCol, b[i].e));
+#else
+	for (; i < count; i++)
+		result[i] = DqnMat4_MulV4(a, b[i]);
+#endif
+}
+
+DQN_FILE_SCOPE DqnMat4 DqnMat4_Transpose(DqnMat4 a)
+{
+	DqnMat4 result;
+	for (u32 j = 0; j < 4; j++)
+		for (u32 i = 0; i < 4; i++)
+			result.e[j][i] = a.e[i][j];
+
+	return result;
+}
+
+DQN_FILE_SCOPE DqnMat4 DqnMat4_Inverse(DqnMat4 a)
+{
+	// NOTE: Cofactor expansion, each cofactor is built from the 2x2 determinants of the
+	// bottom and top half of the matrix so they're only computed once. Works on either storage order
+	// since inverse(transpose(a)) == transpose(inverse(a)).
+	const f32 *m = &a.e[0][0];
+	f32 s0 = m[0]  * m[5]  - m[4]  * m[1];
+	f32 s1 = m[0]  * m[6]  - m[4]  * m[2];
+	f32 s2 = m[0]  * m[7]  - m[4]  * m[3];
+	f32 s3 = m[1]  * m[6]  - m[5]  * m[2];
+	f32 s4 = m[1]  * m[7]  - m[5]  * m[3];
+	f32 s5 = m[2]  * m[7]  - m[6]  * m[3];
+
+	f32 c5 = m[10] * m[15] - m[14] * m[11];
+	f32 c4 = m[9]  * m[15] - m[13] * m[11];
+	f32 c3 = m[9]  * m[14] - m[13] * m[10];
+	f32 c2 = m[8]  * m[15] - m[12] * m[11];
+	f32 c1 = m[8]  * m[14] - m[12] * m[10];
+	f32 c0 = m[8]  * m[13] - m[12] * m[9];
+
+	DqnMat4 result = {0};
+	f32 det        = (s0 * c5) - (s1 * c4) + (s2 * c3) + (s3 * c2) - (s4 * c1) + (s5 * c0);
+	if (det == 0) return result;
+
+	f32 invDet = 1.0f / det;
+	f32 *r     = &result.e[0][0];
+	r[0]  = ( m[5]  * c5 - m[6]  * c4 + m[7]  * c3) * invDet;
+	r[1]  = (-m[1]  * c5 + m[2]  * c4 - m[3]  * c3) * invDet;
+	r[2]  = ( m[13] * s5 - m[14] * s4 + m[15] * s3) * invDet;
+	r[3]  = (-m[9]  * s5 + m[10] * s4 - m[11] * s3) * invDet;
+
+	r[4]  = (-m[4]  * c5 + m[6]  * c2 - m[7]  * c1) * invDet;
+	r[5]  = ( m[0]  * c5 - m[2]  * c2 + m[3]  * c1) * invDet;
+	r[6]  = (-m[12] * s5 + m[14] * s2 - m[15] * s1) * invDet;
+	r[7]  = ( m[8]  * s5 - m[10] * s2 + m[11] * s1) * invDet;
+
+	r[8]  = ( m[4]  * c4 - m[5]  * c2 + m[7]  * c0) * invDet;
+	r[9]  = (-m[0]  * c4 + m[1]  * c2 - m[3]  * c0) * invDet;
+	r[10] = ( m[12] * s4 - m[13] * s2 + m[15] * s0) * invDet;
+	r[11] = (-m[8]  * s4 + m[9]  * s2 - m[11] * s0) * invDet;
+
+	r[12] = (-m[4]  * c3 + m[5]  * c1 - m[6]  * c0) * invDet;
+	r[13] = ( m[0]  * c3 - m[1]  * c1 + m[2]  * c0) * invDet;
+	r[14] = (-m[12] * s3 + m[13] * s1 - m[14] * s0) * invDet;
+	r[15] = ( m[8]  * s3 - m[9]  * s1 + m[10] * s0) * invDet;
+
+	return result;
+}
+
+DQN_FILE_SCOPE DqnMat4 DqnMat4_NormalMatrix(DqnMat4 a)
+{
+	// NOTE: The inverse transpose of a 3x3 with columns (c0, c1, c2) is its cofactor matrix
+	// over the determinant, whose columns are the cross products of the other two columns.
+	const f32 (*c)[4] = a.e;
+	f32 cross12[3] = {(c[1][1] * c[2][2]) - (c[1][2] * c[2][1]),
+	                  (c[1][2] * c[2][0]) - (c[1][0] * c[2][2]),
+	                  (c[1][0] * c[2][1]) - (c[1][1] * c[2][0])};
+
+	DqnMat4 result = {0};
+	f32 det        = (c[0][0] * cross12[0]) + (c[0][1] * cross12[1]) + (c[0][2] * cross12[2]);
+	if (det == 0) return result;
+
+	f32 invDet = 1.0f / det;
+	result.e[0][0] = cross12[0] * invDet;
+	result.e[0][1] = cross12[1] * invDet;
+	result.e[0][2] = cross12[2] * invDet;
+
+	result.e[1][0] = ((c[2][1] * c[0][2]) - (c[2][2] * c[0][1])) * invDet;
+	result.e[1][1] = ((c[2][2] * c[0][0]) - (c[2][0] * c[0][2])) * invDet;
+	result.e[1][2] = ((c[2][0] * c[0][1]) - (c[2][1] * c[0][0])) * invDet;
+
+	result.e[2][0] = ((c[0][1] * c[1][2]) - (c[0][2] * c[1][1])) * invDet;
+	result.e[2][1] = ((c[0][2] * c[1][0]) - (c[0][0] * c[1][2])) * invDet;
+	result.e[2][2] = ((c[0][0] * c[1][1]) - (c[0][1] * c[1][0])) * invDet;
+
+	result.e[3][3] = 1.0f;
 	return result;
 }
 
@@ -4077,60 +4582,191 @@ DQN_FILE_SCOPE i32 DqnRnd_PCGRange(DqnRandPCGState *pcg, i32 min, i32 max)
 ////////////////////////////////////////////////////////////////////////////////
 // #Dqn_* Implementation
 ////////////////////////////////////////////////////////////////////////////////
-FILE_SCOPE void *DqnInternal_QuickSortGetArrayItemPtr(void *const array, const u32 index,
-                                                      const u32 size)
+// NOTE: The same sort as the template Dqn_IntroSort(), but items can only be moved through Swap so
+// the insertion sort swaps down instead of shifting.
+struct DqnInternal_QuickSortC
 {
-	u8 *byteArray = (u8 *)array;
-	void *result = (void *)(byteArray + (index * size));
-	return result;
+	u8                            *array;
+	u32                            itemSize;
+	Dqn_QuickSortLessThanCallback *IsLessThan;
+	Dqn_QuickSortSwapCallback     *Swap;
+
+	void *Item    (const u32 index)          { return array + ((size_t)index * itemSize); }
+	bool  LessThan(const u32 a, const u32 b) { return IsLessThan(Item(a), Item(b)); }
+	void  SwapItem(const u32 a, const u32 b) { if (a != b) Swap(Item(a), Item(b)); }
+};
+
+FILE_SCOPE void DqnInternal_QuickSortCInsertion(DqnInternal_QuickSortC *const sort, const u32 start, const u32 size)
+{
+	for (u32 i = start + 1; i < start + size; i++)
+	{
+		for (u32 j = i; j > start && sort->LessThan(j, j - 1); j--)
+			sort->SwapItem(j, j - 1);
+	}
+}
+
+FILE_SCOPE void DqnInternal_QuickSortCHeap(DqnInternal_QuickSortC *const sort, const u32 start, const u32 size)
+{
+	auto SiftDown = [&](u32 root, const u32 end) {
+		for (u32 child = (root * 2) + 1; child < end; root = child, child = (root * 2) + 1)
+		{
+			if (child + 1 < end && sort->LessThan(start + child, start + child + 1)) child++;
+			if (!sort->LessThan(start + root, start + child)) return;
+			sort->SwapItem(start + root, start + child);
+		}
+	};
+
+	for (u32 i = size / 2; i-- > 0;)
+		SiftDown(i, size);
+
+	for (u32 end = size - 1; end > 0; end--)
+	{
+		sort->SwapItem(start, start + end);
+		SiftDown(0, end);
+	}
+}
+
+FILE_SCOPE u32 DqnInternal_QuickSortCPartition(DqnInternal_QuickSortC *const sort, const u32 start, const u32 size)
+{
+	const u32 first = start;
+	const u32 mid   = start + (size / 2);
+	const u32 last  = start + size - 1;
+	if (sort->LessThan(mid,  first)) sort->SwapItem(mid,  first);
+	if (sort->LessThan(last, first)) sort->SwapItem(last, first);
+	if (sort->LessThan(last, mid))   sort->SwapItem(last, mid);
+
+	const u32 pivot = last - 1;
+	sort->SwapItem(mid, pivot);
+
+	u32 i = first, j = pivot;
+	for (;;)
+	{
+		while (sort->LessThan(++i, pivot)) {}
+		while (sort->LessThan(pivot, --j)) {}
+		if (i >= j) break;
+		sort->SwapItem(i, j);
+	}
+
+	sort->SwapItem(i, pivot);
+	return i;
+}
+
+FILE_SCOPE void DqnInternal_QuickSortCRecurse(DqnInternal_QuickSortC *const sort, u32 start, u32 size, u32 depthLimit)
+{
+	while (size > DQN_SORT_INSERTION_THRESHOLD)
+	{
+		if (depthLimit-- == 0)
+		{
+			DqnInternal_QuickSortCHeap(sort, start, size);
+			return;
+		}
+
+		u32 pivot     = DqnInternal_QuickSortCPartition(sort, start, size);
+		u32 leftSize  = pivot - start;
+		u32 rightSize = size - (leftSize + 1);
+		if (leftSize < rightSize)
+		{
+			DqnInternal_QuickSortCRecurse(sort, start, leftSize, depthLimit);
+			start = pivot + 1;
+			size  = rightSize;
+		}
+		else
+		{
+			DqnInternal_QuickSortCRecurse(sort, pivot + 1, rightSize, depthLimit);
+			size = leftSize;
+		}
+	}
+
+	DqnInternal_QuickSortCInsertion(sort, start, size);
 }
 
 DQN_FILE_SCOPE void Dqn_QuickSortC(void *const array, const u32 itemSize, const u32 size,
                                    Dqn_QuickSortLessThanCallback *const IsLessThan,
                                    Dqn_QuickSortSwapCallback *const Swap)
 {
-	// NOTE: See <template> version for better implementation comments since here we need to use
-	// void * for generics in C making it harder in general to comprehend.
-	if (!array || size == 0 || size == 1) return;
+	if (!array || size < 2 || !IsLessThan || !Swap) return;
+
+	DqnInternal_QuickSortC sort = {};
+	sort.array                  = (u8 *)array;
+	sort.itemSize               = itemSize;
+	sort.IsLessThan             = IsLessThan;
+	sort.Swap                   = Swap;
 
-	DqnRandPCGState state = {};
-	DqnRnd_PCGInit(&state);
+	u32 depthLimit = 0;
+	for (u32 n = size; n > 1; n >>= 1)
+		depthLimit += 2;
 
-	u32 pivotIndex     = DqnRnd_PCGRange(&state, 0, size - 1);
-	u32 partitionIndex = 0;
-	u32 startIndex     = 0;
+	DqnInternal_QuickSortCRecurse(&sort, 0, size, depthLimit);
+}
+
+// return: The key as an unsigned integer that orders the same, radix sorts are over its bytes.
+FILE_SCOPE inline u32 DqnInternal_SortKeyBits(const u32 key) { return key; }
+FILE_SCOPE inline u64 DqnInternal_SortKeyBits(const u64 key) { return key; }
+FILE_SCOPE inline u32 DqnInternal_SortKeyBits(const f32 key)
+{
+	// NOTE: Flipping the sign bit of positives puts them above the negatives, flipping every bit of
+	// negatives reverses them so larger magnitudes sort lower
+	u32 bits;
+	memcpy(&bits, &key, sizeof(bits));
+	u32 mask = (bits & 0x80000000) ? 0xFFFFFFFF : 0x80000000;
+	return bits ^ mask;
+}
 
+template <typename T>
+FILE_SCOPE void DqnInternal_RadixSort(T *const array, const u32 size, T *const scratch)
+{
+	typedef decltype(DqnInternal_SortKeyBits(array->key)) KeyBits;
+	if (!array || size < 2 || !DQN_ASSERT(scratch)) return;
+
+	// NOTE: Count every digit in one pass over the keys, instead of a pass per digit
+	const u32 NUM_DIGITS = sizeof(KeyBits);
+	u32 counts[NUM_DIGITS][256];
+	memset(counts, 0, sizeof(counts));
+	for (u32 i = 0; i < size; i++)
 	{
-		void *lastItemPtr = DqnInternal_QuickSortGetArrayItemPtr(array, size - 1, itemSize);
-		void *pivotItemPtr = DqnInternal_QuickSortGetArrayItemPtr(array, pivotIndex, itemSize);
-		Swap(lastItemPtr, pivotItemPtr);
-		pivotIndex = size - 1;
+		KeyBits bits = DqnInternal_SortKeyBits(array[i].key);
+		for (u32 digit = 0; digit < NUM_DIGITS; digit++)
+			counts[digit][(bits >> (digit * 8)) & 0xFF]++;
 	}
 
-	void *startItemPtr = DqnInternal_QuickSortGetArrayItemPtr(array, startIndex, itemSize);
-	void *pivotItemPtr = DqnInternal_QuickSortGetArrayItemPtr(array, pivotIndex, itemSize);
-	if (IsLessThan(startItemPtr, pivotItemPtr)) partitionIndex++;
-	startIndex++;
-
-	for (u32 checkIndex = startIndex; checkIndex < size; checkIndex++)
+	T *src  = array;
+	T *dest = scratch;
+	for (u32 digit = 0; digit < NUM_DIGITS; digit++)
 	{
-		void *checkItemPtr = DqnInternal_QuickSortGetArrayItemPtr(array, checkIndex, itemSize);
-		if (IsLessThan(checkItemPtr, pivotItemPtr))
+		u32 *digitCounts = counts[digit];
+		const u32 shift  = digit * 8;
+		if (digitCounts[(DqnInternal_SortKeyBits(src[0].key) >> shift) & 0xFF] == size) continue;
+
+		u32 offsets[256];
+		u32 offset = 0;
+		for (u32 i = 0; i < 256; i++)
 		{
-			void *partitionItemPtr = DqnInternal_QuickSortGetArrayItemPtr(array, partitionIndex, itemSize);
-			Swap(partitionItemPtr, checkItemPtr);
-			partitionIndex++;
+			offsets[i] = offset;
+			offset    += digitCounts[i];
 		}
+
+		for (u32 i = 0; i < size; i++)
+			dest[offsets[(DqnInternal_SortKeyBits(src[i].key) >> shift) & 0xFF]++] = src[i];
+
+		DQN_SWAP(T *, src, dest);
 	}
 
-	void *partitionItemPtr = DqnInternal_QuickSortGetArrayItemPtr(array, partitionIndex, itemSize);
-	Swap(partitionItemPtr, pivotItemPtr);
+	if (src != array) memcpy(array, src, sizeof(*array) * size);
+}
+
+DQN_FILE_SCOPE void Dqn_RadixSort(DqnSortKeyU32 *const array, const u32 size, DqnSortKeyU32 *const scratch)
+{
+	DqnInternal_RadixSort(array, size, scratch);
+}
 
-	Dqn_QuickSortC(array, itemSize, partitionIndex, IsLessThan, Swap);
+DQN_FILE_SCOPE void Dqn_RadixSort(DqnSortKeyU64 *const array, const u32 size, DqnSortKeyU64 *const scratch)
+{
+	DqnInternal_RadixSort(array, size, scratch);
+}
 
-	u32 oneAfterPartitionIndex = partitionIndex + 1;
-	void *oneAfterPartionIndexPtr = DqnInternal_QuickSortGetArrayItemPtr(array, oneAfterPartitionIndex, itemSize);
-	Dqn_QuickSortC(oneAfterPartionIndexPtr, itemSize, (size - oneAfterPartitionIndex), IsLessThan, Swap);
+DQN_FILE_SCOPE void Dqn_RadixSort(DqnSortKeyF32 *const array, const u32 size, DqnSortKeyF32 *const scratch)
+{
+	DqnInternal_RadixSort(array, size, scratch);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -6521,7 +7157,7 @@ DQN_FILE_SCOPE f64 DqnTimer_NowInMs()
 	}
 	else
 	{
-		result = (f64)((timeSpec.tv_sec * 1000.0f) + (timeSpec.tv_nsec / 1000000.0f));
+		result = ((f64)timeSpec.tv_sec * 1000.0) + ((f64)timeSpec.tv_nsec / 1000000.0);
 	}
 
 #else
@@ -6654,74 +7290,106 @@ DqnLockGuard::~DqnLockGuard()
 typedef void *DqnThreadCallbackInternal(void *threadParam);
 size_t DQN_JOB_QUEUE_INTERNAL_THREAD_DEFAULT_STACK_SIZE = 0;
 
-FILE_SCOPE u32 DqnJobQueueInternal_ThreadCreate(const size_t stackSize,
-                                                DqnThreadCallbackInternal *const threadCallback,
-                                                void *const threadParam, const u32 numThreads)
+// NOTE: Must be a power of 2, deques double from here when full
+#define DQN_JOB_DEQUE_INTERNAL_INITIAL_SIZE 256
+
+typedef struct DqnJobDequeInternalArray
+{
+	i64                              size; // Power of 2 so indexes wrap with a mask
+	struct DqnJobDequeInternalArray *next; // Next retired array, see DqnJobDeque
+	DqnJob                           jobs[1];
+} DqnJobDequeInternalArray;
+
+typedef struct DqnJobQueueInternalWorker
 {
-	u32 numThreadsCreated = 0;
+	DqnJobQueue *queue;
+	u32          dequeIndex;
 
 #if defined(DQN_WIN32_PLATFORM)
-	DQN_ASSERT_HARD(stackSize == 0 || !threadCallback);
-	for (u32 i = 0; i < numThreads; i++)
-	{
-		HANDLE handle = CreateThread(NULL, stackSize, (LPTHREAD_START_ROUTINE)threadCallback,
-		                             threadParam, 0, NULL);
-		CloseHandle(handle);
-		numThreadsCreated++;
-	}
+	HANDLE handle;
 
 #elif defined(DQN_UNIX_PLATFORM)
-	// TODO(doyle): Better error handling
-	pthread_attr_t attribute = {};
-	DQN_ASSERT(pthread_attr_init(&attribute) == 0);
-
-	// Allows us to use pthread_join() which lets us wait till a thread finishes execution
-	DQN_ASSERT(pthread_attr_setdetachstate(&attribute, PTHREAD_CREATE_JOINABLE) == 0);
-
-	// TODO(doyle): Persist thread handles
-	for (u32 i = 0; i < numThreads; i++)
-	{
-		pthread_t thread = {};
-		pthread_create(&thread, &attribute, threadCallback, threadParam);
-		numThreadsCreated++;
-	}
-
-	DQN_ASSERT(pthread_attr_destroy(&attribute) == 0);
+	pthread_t handle;
 
 #else
 	#error Unsupported platform
 
 #endif
+} DqnJobQueueInternalWorker;
 
-	DQN_ASSERT(numThreadsCreated == numThreads);
-	return numThreadsCreated;
-}
+// NOTE: Workers belong to one queue for their lifetime so they find their deque here, the thread
+// that called Init() is found by DqnJobQueue.ownerThreadId instead as it can own several queues.
+typedef struct DqnJobQueueInternalThreadContext
+{
+	DqnJobQueue   *queue;
+	u32            dequeIndex;
+	u32            rngState; // Picks the first deque to steal from
+	DqnJobCounter *counter;  // Counter of the job the thread is executing, for AddChildJob()
+} DqnJobQueueInternalThreadContext;
 
+FILE_SCOPE DQN_THREAD_LOCAL DqnJobQueueInternalThreadContext dqnJobQueueInternalThread;
 
-FILE_SCOPE void *DqnJobQueueInternal_ThreadCallback(void *threadParam)
+FILE_SCOPE u64 DqnJobQueueInternal_GetThreadId()
 {
-	DqnJobQueue *queue = (DqnJobQueue *)threadParam;
-	for (;;)
-	{
-		if (!DqnJobQueue_TryExecuteNextJob(queue))
-		{
 #if defined(DQN_WIN32_PLATFORM)
-			WaitForSingleObjectEx(queue->semaphore, INFINITE, false);
+	u64 result = (u64)GetCurrentThreadId();
 
 #elif defined(DQN_UNIX_PLATFORM)
-			sem_wait(&queue->semaphore);
+	u64 result = (u64)pthread_self();
 
 #else
 	#error Unsupported platform
 
 #endif
-		}
-	}
+	return result;
 }
 
-FILE_SCOPE bool DqnJobQueueInternal_CreateSemaphore(DqnJobQueue *const queue, const u32 initSignalCount, const u32 maxSignalCount)
+FILE_SCOPE bool DqnJobQueueInternal_ThreadCreate(DqnJobQueueInternalWorker *const worker, const size_t stackSize,
+                                                 DqnThreadCallbackInternal *const threadCallback)
 {
-	if (!queue) return false;
+	bool result = false;
+
+#if defined(DQN_WIN32_PLATFORM)
+	worker->handle = CreateThread(NULL, stackSize, (LPTHREAD_START_ROUTINE)threadCallback, (void *)worker, 0, NULL);
+	result         = (worker->handle != NULL);
+
+#elif defined(DQN_UNIX_PLATFORM)
+	pthread_attr_t attribute = {};
+	if (pthread_attr_init(&attribute) != 0) return false;
+
+	// Allows us to use pthread_join() which lets us wait till a thread finishes execution
+	DQN_ASSERT(pthread_attr_setdetachstate(&attribute, PTHREAD_CREATE_JOINABLE) == 0);
+	if (stackSize > 0) DQN_ASSERT(pthread_attr_setstacksize(&attribute, stackSize) == 0);
+
+	result = (pthread_create(&worker->handle, &attribute, threadCallback, (void *)worker) == 0);
+	DQN_ASSERT(pthread_attr_destroy(&attribute) == 0);
+
+#else
+	#error Unsupported platform
+
+#endif
+
+	return result;
+}
+
+FILE_SCOPE void DqnJobQueueInternal_ThreadJoin(DqnJobQueueInternalWorker *const worker)
+{
+#if defined(DQN_WIN32_PLATFORM)
+	WaitForSingleObject(worker->handle, INFINITE);
+	CloseHandle(worker->handle);
+
+#elif defined(DQN_UNIX_PLATFORM)
+	pthread_join(worker->handle, NULL);
+
+#else
+	#error Unsupported platform
+
+#endif
+}
+
+FILE_SCOPE bool DqnJobQueueInternal_CreateSemaphore(DqnJobQueue *const queue, const u32 initSignalCount, const u32 maxSignalCount)
+{
+	if (!queue) return false;
 
 #if defined(DQN_WIN32_PLATFORM)
 	queue->semaphore = (void *)CreateSemaphore(NULL, initSignalCount, maxSignalCount, NULL);
@@ -6749,9 +7417,10 @@ FILE_SCOPE bool DqnJobQueueInternal_ReleaseSemaphore(DqnJobQueue *const queue)
 {
 	DQN_ASSERT(queue);
 
+	bool result = true;
 #if defined(DQN_WIN32_PLATFORM)
 	DQN_ASSERT(queue->semaphore);
-	ReleaseSemaphore(queue->semaphore, 1, NULL);
+	result = (ReleaseSemaphore(queue->semaphore, 1, NULL) != 0);
 
 #elif defined(DQN_UNIX_PLATFORM)
 	// TODO(doyle): Error handling
@@ -6762,76 +7431,404 @@ FILE_SCOPE bool DqnJobQueueInternal_ReleaseSemaphore(DqnJobQueue *const queue)
 
 #endif
 	
+	return result;
+}
+
+// Signal the semaphore unless maxPending signals are already waiting to be taken. Every signal
+// is taken by one thread waking, so with maxPending at most the number of threads the count never
+// passes the max the semaphore was created with.
+FILE_SCOPE void DqnJobQueueInternal_WakeThread(DqnJobQueue *const queue, const i32 maxPending)
+{
+	for (;;)
+	{
+		i32 numPending = queue->numWakesPending;
+		if (numPending >= maxPending) return;
+		if (DqnAtomic_CompareSwap32(&queue->numWakesPending, numPending + 1, numPending) == numPending) break;
+	}
+
+	DQN_ASSERT(DqnJobQueueInternal_ReleaseSemaphore(queue));
+}
+
+FILE_SCOPE void DqnJobQueueInternal_WaitSemaphore(DqnJobQueue *const queue)
+{
+#if defined(DQN_WIN32_PLATFORM)
+	WaitForSingleObjectEx(queue->semaphore, INFINITE, false);
+
+#elif defined(DQN_UNIX_PLATFORM)
+	sem_wait(&queue->semaphore);
+
+#else
+	#error Unsupported platform
+
+#endif
+}
+
+FILE_SCOPE void DqnJobQueueInternal_DeleteSemaphore(DqnJobQueue *const queue)
+{
+#if defined(DQN_WIN32_PLATFORM)
+	CloseHandle(queue->semaphore);
+
+#elif defined(DQN_UNIX_PLATFORM)
+	sem_destroy(&queue->semaphore);
+
+#else
+	#error Unsupported platform
+
+#endif
+}
+
+FILE_SCOPE void DqnJobQueueInternal_Yield()
+{
+#if defined(DQN_WIN32_PLATFORM)
+	SwitchToThread();
+
+#elif defined(DQN_UNIX_PLATFORM)
+	sched_yield();
+
+#else
+	#error Unsupported platform
+
+#endif
+}
+
+FILE_SCOPE DqnJobDequeInternalArray *DqnJobDequeInternal_AllocArray(const i64 size)
+{
+	size_t allocSize                 = sizeof(DqnJobDequeInternalArray) + (sizeof(DqnJob) * (size_t)(size - 1));
+	DqnJobDequeInternalArray *result = (DqnJobDequeInternalArray *)DqnMem_Calloc(allocSize);
+	if (result) result->size = size;
+
+	return result;
+}
+
+FILE_SCOPE void DqnJobDequeInternal_Free(DqnJobDeque *const deque)
+{
+	DqnMem_Free(deque->array);
+	for (DqnJobDequeInternalArray *array = deque->retired; array;)
+	{
+		DqnJobDequeInternalArray *next = array->next;
+		DqnMem_Free(array);
+		array = next;
+	}
+}
+
+// NOTE: The Chase-Lev deque. Only the owning thread calls Push() and Pop(), which work on the
+// bottom, any thread can Steal() from the top. top and bottom only ever increase and are wrapped
+// into the array when indexing, the jobs in the deque are [top, bottom).
+// NOTE: top, bottom and array are shared with thieves so they're only read and written through
+// DqnAtomic, which also orders them against the job slots like a full barrier.
+FILE_SCOPE DqnJobDequeInternalArray *DqnJobDequeInternal_GetArray(DqnJobDeque *const deque)
+{
+	auto *result = (DqnJobDequeInternalArray *)DqnAtomic_LoadPtr((void *volatile *)&deque->array);
+	return result;
+}
+
+// return: FALSE if the deque was full and could not grow.
+FILE_SCOPE bool DqnJobDequeInternal_Push(DqnJobDeque *const deque, const DqnJob job)
+{
+	i64 bottom                      = DqnAtomic_Load64(&deque->bottom);
+	i64 top                         = DqnAtomic_Load64(&deque->top);
+	DqnJobDequeInternalArray *array = DqnJobDequeInternal_GetArray(deque);
+
+	if (bottom - top >= array->size - 1)
+	{
+		DqnJobDequeInternalArray *newArray = DqnJobDequeInternal_AllocArray(array->size * 2);
+		if (!newArray) return false;
+
+		for (i64 i = top; i < bottom; i++)
+			newArray->jobs[i & (newArray->size - 1)] = array->jobs[i & (array->size - 1)];
+
+		// NOTE: Thieves that read the array before it's swapped may still be using it, keep it
+		// until the queue is freed
+		array->next    = deque->retired;
+		deque->retired = array;
+
+		DqnAtomic_StorePtr((void *volatile *)&deque->array, newArray);
+		array = newArray;
+	}
+
+	// NOTE: The job is visible before the bottom that lets thieves take it, the store is a barrier
+	array->jobs[bottom & (array->size - 1)] = job;
+	DqnAtomic_Store64(&deque->bottom, bottom + 1);
+	return true;
+}
+
+FILE_SCOPE bool DqnJobDequeInternal_Pop(DqnJobDeque *const deque, DqnJob *const job)
+{
+	i64 bottom                      = DqnAtomic_Load64(&deque->bottom) - 1;
+	DqnJobDequeInternalArray *array = DqnJobDequeInternal_GetArray(deque);
+
+	// NOTE: Reserve the bottom job before looking at top, otherwise a thief and the owner can both
+	// take the last job
+	DqnAtomic_Store64(&deque->bottom, bottom);
+	i64 top = DqnAtomic_Load64(&deque->top);
+
+	if (top > bottom)
+	{
+		// Empty
+		DqnAtomic_Store64(&deque->bottom, bottom + 1);
+		return false;
+	}
+
+	bool result = true;
+	*job        = array->jobs[bottom & (array->size - 1)];
+	if (top == bottom)
+	{
+		// Last job, thieves could be racing for it so take it the same way they do
+		result = (DqnAtomic_CompareSwap64(&deque->top, top + 1, top) == top);
+		DqnAtomic_Store64(&deque->bottom, bottom + 1);
+	}
+
+	return result;
+}
+
+FILE_SCOPE bool DqnJobDequeInternal_Steal(DqnJobDeque *const deque, DqnJob *const job)
+{
+	i64 top    = DqnAtomic_Load64(&deque->top);
+	i64 bottom = DqnAtomic_Load64(&deque->bottom);
+	if (top >= bottom) return false;
+
+	DqnJobDequeInternalArray *array = DqnJobDequeInternal_GetArray(deque);
+	DqnJob result                   = array->jobs[top & (array->size - 1)];
+
+	// NOTE: Losing the swap means another thief or the owner took the job
+	if (DqnAtomic_CompareSwap64(&deque->top, top + 1, top) != top) return false;
+
+	*job = result;
 	return true;
 }
 
+// return: The index of the calling thread's deque and scratch stack, -1 if it doesn't belong to the queue.
+FILE_SCOPE i32 DqnJobQueueInternal_GetThreadIndex(DqnJobQueue *const queue)
+{
+	DqnJobQueueInternalThreadContext *thread = &dqnJobQueueInternalThread;
+	if (thread->queue == queue) return (i32)thread->dequeIndex;
+	if (queue->ownerThreadId == DqnJobQueueInternal_GetThreadId()) return 0;
+
+	return -1;
+}
+
+// return: The deque the calling thread pushes to and pops from, NULL if it doesn't belong to the queue.
+FILE_SCOPE DqnJobDeque *DqnJobQueueInternal_GetThreadDeque(DqnJobQueue *const queue)
+{
+	i32 index = DqnJobQueueInternal_GetThreadIndex(queue);
+	if (index == -1) return NULL;
+
+	return &queue->deques[index];
+}
+
+FILE_SCOPE void DqnJobQueueInternal_ExecuteJob(DqnJobQueue *const queue, const DqnJob job)
+{
+	// NOTE: Completing other jobs while waiting is what lets the dependency make progress when every
+	// thread has picked up a job that's waiting on something
+	if (job.dependency) DqnJobQueue_WaitForCounter(queue, job.dependency);
+
+	// NOTE: Jobs a job runs while it waits nest their regions inside its own, so each job only ever
+	// releases what it pushed. A thread that doesn't belong to the queue but steals has no stack.
+	DqnMemStack *scratch                = DqnJobQueue_GetScratch(queue);
+	DqnMemStackTempRegion scratchRegion = {};
+	if (scratch) DqnMemStackTempRegion_Begin(&scratchRegion, scratch);
+
+	DqnJobQueueInternalThreadContext *thread = &dqnJobQueueInternalThread;
+	DqnJobCounter *parentCounter             = thread->counter;
+	thread->counter                          = job.counter;
+	job.callback(queue, job.userData);
+	thread->counter = parentCounter;
+
+	if (scratch) DqnMemStackTempRegion_End(scratchRegion);
+
+	if (job.counter) DqnAtomic_Add32(&job.counter->numJobs, -1);
+	DqnAtomic_Add32(&queue->numJobsToComplete, -1);
+}
+
+FILE_SCOPE void *DqnJobQueueInternal_ThreadCallback(void *threadParam)
+{
+	DqnJobQueueInternalWorker *worker = (DqnJobQueueInternalWorker *)threadParam;
+	DqnJobQueue *queue                = worker->queue;
+
+	DqnJobQueueInternalThreadContext *thread = &dqnJobQueueInternalThread;
+	thread->queue                            = queue;
+	thread->dequeIndex                       = worker->dequeIndex;
+	thread->rngState                         = worker->dequeIndex;
+
+	for (;;)
+	{
+		if (DqnJobQueue_TryExecuteNextJob(queue)) continue;
+		if (queue->isShuttingDown) break;
+
+		// NOTE: Check for jobs again after announcing the thread is going to sleep. A job added
+		// before then is found here, one added after sees the sleeping thread and wakes it.
+		DqnAtomic_Add32(&queue->numThreadsSleeping, 1);
+		if (!DqnJobQueue_TryExecuteNextJob(queue))
+		{
+			DqnJobQueueInternal_WaitSemaphore(queue);
+			DqnAtomic_Add32(&queue->numWakesPending, -1);
+		}
+		DqnAtomic_Add32(&queue->numThreadsSleeping, -1);
+	}
+
+	return NULL;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // XPlatform > #DqnJobQueue Implementation
 ////////////////////////////////////////////////////////////////////////////////
-DQN_FILE_SCOPE bool DqnJobQueue_Init(DqnJobQueue *const queue, DqnJob *const jobList,
-                                     const u32 jobListSize, const u32 numThreads)
+DQN_FILE_SCOPE bool DqnJobQueue_Init(DqnJobQueue *const queue, const u32 numThreads)
 {
-	if (!queue || !jobList || jobListSize == 0 || numThreads == 0) return false;
-	queue->jobList = jobList;
-	queue->size    = jobListSize;
+	if (!queue || numThreads == 0) return false;
+
+	*queue               = {};
+	queue->numDeques     = numThreads + 1;
+	queue->numThreads    = numThreads;
+	queue->ownerThreadId = DqnJobQueueInternal_GetThreadId();
+	queue->deques        = (DqnJobDeque *)DqnMem_Calloc(sizeof(*queue->deques) * queue->numDeques);
+	queue->workers       = (DqnJobQueueInternalWorker *)DqnMem_Calloc(sizeof(*queue->workers) * numThreads);
+	queue->scratch       = (DqnMemStack *)DqnMem_Calloc(sizeof(*queue->scratch) * queue->numDeques);
+
+	bool allocated = (queue->deques && queue->workers && queue->scratch);
+	for (u32 i = 0; allocated && i < queue->numDeques; i++)
+	{
+		queue->deques[i].array = DqnJobDequeInternal_AllocArray(DQN_JOB_DEQUE_INTERNAL_INITIAL_SIZE);
+		allocated              = (queue->deques[i].array != NULL) &&
+		                         DqnMemStack_Init(&queue->scratch[i], DQN_JOB_QUEUE_SCRATCH_SIZE, false, 16);
+	}
+
+	if (!allocated)
+	{
+		for (u32 i = 0; queue->deques && i < queue->numDeques; i++)
+			DqnJobDequeInternal_Free(&queue->deques[i]);
+
+		for (u32 i = 0; queue->scratch && i < queue->numDeques; i++)
+			DqnMemStack_Free(&queue->scratch[i]);
+
+		DqnMem_Free(queue->deques);
+		DqnMem_Free(queue->workers);
+		DqnMem_Free(queue->scratch);
+		*queue = {};
+		return false;
+	}
 
 	DQN_ASSERT(DqnJobQueueInternal_CreateSemaphore(queue, 0, numThreads));
 
 	// Create threads
-	u32 numThreadsCreated = DqnJobQueueInternal_ThreadCreate(
-	    DQN_JOB_QUEUE_INTERNAL_THREAD_DEFAULT_STACK_SIZE, DqnJobQueueInternal_ThreadCallback,
-	    (void *)queue, numThreads);
-	DQN_ASSERT_HARD(numThreads == numThreadsCreated);
+	for (u32 i = 0; i < numThreads; i++)
+	{
+		DqnJobQueueInternalWorker *worker = &queue->workers[i];
+		worker->queue                     = queue;
+		worker->dequeIndex                = i + 1;
+		DQN_ASSERT_HARD(DqnJobQueueInternal_ThreadCreate(worker, DQN_JOB_QUEUE_INTERNAL_THREAD_DEFAULT_STACK_SIZE,
+		                                                 DqnJobQueueInternal_ThreadCallback));
+	}
 
 	return true;
 }
 
+DQN_FILE_SCOPE void DqnJobQueue_Free(DqnJobQueue *const queue)
+{
+	if (!queue || !queue->deques) return;
+
+	DqnJobQueue_BlockAndCompleteAllJobs(queue);
+
+	// Wake every thread so it sees the flag and exits, each takes at most one more signal
+	queue->isShuttingDown = true;
+	DqnAtomic_MemoryBarrier();
+	for (u32 i = 0; i < queue->numThreads; i++)
+		DqnJobQueueInternal_WakeThread(queue, (i32)queue->numThreads);
+
+	for (u32 i = 0; i < queue->numThreads; i++)
+		DqnJobQueueInternal_ThreadJoin(&queue->workers[i]);
+
+	DqnJobQueueInternal_DeleteSemaphore(queue);
+	for (u32 i = 0; i < queue->numDeques; i++)
+	{
+		DqnJobDequeInternal_Free(&queue->deques[i]);
+		DqnMemStack_Free(&queue->scratch[i]);
+	}
+
+	DqnMem_Free(queue->deques);
+	DqnMem_Free(queue->workers);
+	DqnMem_Free(queue->scratch);
+	*queue = {};
+}
+
 DQN_FILE_SCOPE bool DqnJobQueue_AddJob(DqnJobQueue *const queue, const DqnJob job)
 {
-	i32 newJobInsertIndex = (queue->jobInsertIndex + 1) % queue->size;
-	if (newJobInsertIndex == queue->jobToExecuteIndex) return false;
+	if (!queue || !queue->deques) return false;
 
-	queue->jobList[queue->jobInsertIndex] = job;
+	DqnJobDeque *deque = DqnJobQueueInternal_GetThreadDeque(queue);
+	if (!deque) return false;
 
+	if (job.counter) DqnAtomic_Add32(&job.counter->numJobs, 1);
 	DqnAtomic_Add32(&queue->numJobsToComplete, 1);
-	DQN_ASSERT(DqnJobQueueInternal_ReleaseSemaphore(queue));
 
-	queue->jobInsertIndex = newJobInsertIndex;
+	if (DqnJobDequeInternal_Push(deque, job))
+	{
+		// NOTE: The push must be visible before checking for sleeping threads, see ThreadCallback()
+		DqnAtomic_MemoryBarrier();
+		// NOTE: Once every sleeping thread has a signal coming, more would only overflow the semaphore
+		i32 numThreadsSleeping = queue->numThreadsSleeping;
+		if (numThreadsSleeping > 0) DqnJobQueueInternal_WakeThread(queue, numThreadsSleeping);
+	}
+	else
+	{
+		DqnJobQueueInternal_ExecuteJob(queue, job);
+	}
+
 	return true;
 }
 
+DQN_FILE_SCOPE bool DqnJobQueue_AddChildJob(DqnJobQueue *const queue, DqnJob job)
+{
+	job.counter = dqnJobQueueInternalThread.counter;
+	bool result = DqnJobQueue_AddJob(queue, job);
+	return result;
+}
+
 DQN_FILE_SCOPE void DqnJobQueue_BlockAndCompleteAllJobs(DqnJobQueue *const queue)
 {
+	if (!queue) return;
+
 	while (DqnJobQueue_TryExecuteNextJob(queue) || !DqnJobQueue_AllJobsComplete(queue))
 		;
 }
 
+DQN_FILE_SCOPE void DqnJobQueue_WaitForCounter(DqnJobQueue *const queue, DqnJobCounter *const counter)
+{
+	if (!counter) return;
+
+	// NOTE: Nothing left to take means other threads are finishing the last jobs, give up the time
+	// slice rather than spin in case they're waiting for it
+	while (counter->numJobs > 0)
+	{
+		if (!DqnJobQueue_TryExecuteNextJob(queue)) DqnJobQueueInternal_Yield();
+	}
+}
+
 DQN_FILE_SCOPE bool DqnJobQueue_TryExecuteNextJob(DqnJobQueue *const queue)
 {
-	if (!queue) return false;
+	if (!queue || !queue->deques) return false;
 
-	i32 originalJobToExecute = queue->jobToExecuteIndex;
-	if (originalJobToExecute != queue->jobInsertIndex)
+	DqnJob job;
+	DqnJobDeque *ownDeque = DqnJobQueueInternal_GetThreadDeque(queue);
+	bool gotJob           = (ownDeque && DqnJobDequeInternal_Pop(ownDeque, &job));
+	if (!gotJob)
 	{
-		i32 newJobIndexForNextThread = (originalJobToExecute + 1) % queue->size;
-		i32 index = DqnAtomic_CompareSwap32(&queue->jobToExecuteIndex, newJobIndexForNextThread,
-		                                    originalJobToExecute);
+		// NOTE: Start stealing from a random deque so idle threads spread out over the victims
+		// instead of all hitting the same top
+		DqnJobQueueInternalThreadContext *thread = &dqnJobQueueInternalThread;
+		thread->rngState                         = (thread->rngState * 1664525) + 1013904223;
+		u32 firstVictim                          = (thread->rngState >> 16) % queue->numDeques;
 
-		// NOTE: If we weren't successful at the interlock, another thread has
-		// taken the work and we can't know if there's more work or not. So
-		// irrespective of that result, return true to let the thread check
-		// again for more work.
-		if (index == originalJobToExecute)
+		for (u32 i = 0; i < queue->numDeques && !gotJob; i++)
 		{
-			DqnJob job = queue->jobList[index];
-			job.callback(queue, job.userData);
-			DqnAtomic_Add32(&queue->numJobsToComplete, -1);
+			DqnJobDeque *victim = &queue->deques[(firstVictim + i) % queue->numDeques];
+			if (victim != ownDeque) gotJob = DqnJobDequeInternal_Steal(victim, &job);
 		}
-
-		return true;
 	}
 
-	return false;
+	if (!gotJob) return false;
+
+	DqnJobQueueInternal_ExecuteJob(queue, job);
+	return true;
 }
 
 DQN_FILE_SCOPE bool DqnJobQueue_AllJobsComplete(DqnJobQueue *const queue)
@@ -6842,19 +7839,222 @@ DQN_FILE_SCOPE bool DqnJobQueue_AllJobsComplete(DqnJobQueue *const queue)
 	return result;
 }
 
+DQN_FILE_SCOPE DqnMemStack *DqnJobQueue_GetScratch(DqnJobQueue *const queue)
+{
+	if (!queue || !queue->scratch) return NULL;
+
+	i32 index = DqnJobQueueInternal_GetThreadIndex(queue);
+	if (index == -1) return NULL;
+
+	return &queue->scratch[index];
+}
+
 ////////////////////////////////////////////////////////////////////////////////
-// XPlatform > #DqnJobQueue CPP Implementation
+// XPlatform > #DqnJobQueue Parallel Sort Implementation
 ////////////////////////////////////////////////////////////////////////////////
-bool DqnJobQueue::Init(DqnJob *const jobList_, const u32 jobListSize, const u32 numThreads)
+// Below this many pairs a chunk costs more to schedule than sorting it on another thread saves
+#define DQN_JOB_QUEUE_SORT_MIN_CHUNK 16384
+
+// A chunk to radix sort, or part of the output of merging the runs [runStart, runMid) and
+// [runMid, runEnd) of src into dest
+template <typename T>
+struct DqnJobQueueInternal_SortJob
+{
+	T  *src;
+	T  *dest;
+	u32 begin;      // Range of the array the job writes
+	u32 end;
+	u32 runStart;
+	u32 runMid;
+	u32 runEnd;
+	bool copyToDest; // A sorted chunk is copied to dest for the merges to start from
+};
+
+template <typename T>
+FILE_SCOPE void DqnJobQueueInternal_SortChunk(DqnJobQueue *const queue, void *const userData)
 {
-	bool result = DqnJobQueue_Init(this, jobList_, jobListSize, numThreads);
-	return result;
+	(void)queue;
+	DqnJobQueueInternal_SortJob<T> *job = (DqnJobQueueInternal_SortJob<T> *)userData;
+	u32 size                            = job->end - job->begin;
+	DqnInternal_RadixSort(job->src + job->begin, size, job->dest + job->begin);
+	if (job->copyToDest) memcpy(job->dest + job->begin, job->src + job->begin, sizeof(*job->src) * size);
 }
 
-bool DqnJobQueue::AddJob           (const DqnJob job) { return DqnJobQueue_AddJob(this, job);             }
-void DqnJobQueue::BlockAndCompleteAllJobs()           {        DqnJobQueue_BlockAndCompleteAllJobs(this); }
-bool DqnJobQueue::TryExecuteNextJob()                 { return DqnJobQueue_TryExecuteNextJob(this);       }
-bool DqnJobQueue::AllJobsComplete  ()                 { return DqnJobQueue_AllJobsComplete(this);         }
+// return: How many of the first k items of the merge of a and b come from a. Ties go to a so the
+//         merge is stable.
+template <typename T>
+FILE_SCOPE u32 DqnJobQueueInternal_MergeSplit(const T *const a, const u32 aSize, const T *const b, const u32 bSize,
+                                              const u32 k)
+{
+	u32 lo = (k > bSize) ? k - bSize : 0;
+	u32 hi = DQN_MIN(k, aSize);
+	while (lo < hi)
+	{
+		u32 i = lo + ((hi - lo) / 2);
+		u32 j = k - i;
+		if (DqnInternal_SortKeyBits(a[i].key) <= DqnInternal_SortKeyBits(b[j - 1].key)) lo = i + 1;
+		else                                                                             hi = i;
+	}
+
+	return lo;
+}
+
+template <typename T>
+FILE_SCOPE void DqnJobQueueInternal_SortMerge(DqnJobQueue *const queue, void *const userData)
+{
+	(void)queue;
+	DqnJobQueueInternal_SortJob<T> *job = (DqnJobQueueInternal_SortJob<T> *)userData;
+	const T *a      = job->src + job->runStart;
+	const T *b      = job->src + job->runMid;
+	const u32 aSize = job->runMid - job->runStart;
+	const u32 bSize = job->runEnd - job->runMid;
+
+	const u32 kBegin = job->begin - job->runStart;
+	const u32 kEnd   = job->end - job->runStart;
+	u32 i            = DqnJobQueueInternal_MergeSplit(a, aSize, b, bSize, kBegin);
+	u32 iEnd         = DqnJobQueueInternal_MergeSplit(a, aSize, b, bSize, kEnd);
+	u32 j            = kBegin - i;
+	u32 jEnd         = kEnd - iEnd;
+
+	T *out = job->dest + job->begin;
+	while (i < iEnd && j < jEnd)
+	{
+		if (DqnInternal_SortKeyBits(b[j].key) < DqnInternal_SortKeyBits(a[i].key)) *out++ = b[j++];
+		else                                                                       *out++ = a[i++];
+	}
+
+	while (i < iEnd) *out++ = a[i++];
+	while (j < jEnd) *out++ = b[j++];
+}
+
+// Add a job per item of jobs and complete jobs until they're all done
+template <typename T>
+FILE_SCOPE void DqnJobQueueInternal_SortRunJobs(DqnJobQueue *const queue, DqnJob_Callback *const callback,
+                                                DqnJobQueueInternal_SortJob<T> *const jobs, const u32 numJobs)
+{
+	DqnJobCounter counter = {};
+	for (u32 i = 0; i < numJobs; i++)
+	{
+		DqnJob job = {callback, &jobs[i], &counter};
+		if (!DqnJobQueue_AddJob(queue, job)) callback(queue, job.userData);
+	}
+
+	DqnJobQueue_WaitForCounter(queue, &counter);
+}
+
+template <typename T>
+FILE_SCOPE bool DqnJobQueueInternal_ParallelSort(DqnJobQueue *const queue, DqnMemStack *const stack, T *const array,
+                                                 const u32 size)
+{
+	if (!queue || !stack || !array) return false;
+	if (size < 2) return true;
+
+	auto memRegion = stack->TempRegionGuard();
+	T *scratch     = (T *)stack->Push(sizeof(*scratch) * size);
+	if (!scratch) return false;
+
+	// NOTE: A few chunks a thread so threads that finish early take the work of ones that don't
+	const u32 numThreads = queue->numThreads + 1;
+	u32 numChunks        = 1;
+	u32 numRounds        = 0;
+	while (numChunks < numThreads * 4 && size / (numChunks * 2) >= DQN_JOB_QUEUE_SORT_MIN_CHUNK)
+	{
+		numChunks *= 2;
+		numRounds++;
+	}
+
+	if (numChunks == 1)
+	{
+		DqnInternal_RadixSort(array, size, scratch);
+		return true;
+	}
+
+	// NOTE: A round has a job per chunk sized piece of output plus at most one more per merge
+	auto *jobs = (DqnJobQueueInternal_SortJob<T> *)stack->Push(sizeof(DqnJobQueueInternal_SortJob<T>) * numChunks * 2);
+	if (!jobs) return false;
+
+	auto ChunkStart = [size, numChunks](const u32 chunk) { return (u32)(((u64)chunk * size) / numChunks); };
+
+	// NOTE: Merges ping-pong between the array and scratch. After an odd number of rounds the sorted
+	// chunks start in scratch so the last round writes the array.
+	const bool startInScratch = (numRounds & 1);
+	for (u32 chunk = 0; chunk < numChunks; chunk++)
+	{
+		DqnJobQueueInternal_SortJob<T> *job = &jobs[chunk];
+		*job                                = {};
+		job->src                            = array;
+		job->dest                           = scratch;
+		job->begin                          = ChunkStart(chunk);
+		job->end                            = ChunkStart(chunk + 1);
+		job->copyToDest                     = startInScratch;
+	}
+	DqnJobQueueInternal_SortRunJobs(queue, DqnJobQueueInternal_SortChunk<T>, jobs, numChunks);
+
+	T *src            = (startInScratch) ? scratch : array;
+	T *dest           = (startInScratch) ? array : scratch;
+	const u32 jobSize = (size + numChunks - 1) / numChunks;
+	for (u32 width = 1; width < numChunks; width *= 2)
+	{
+		u32 numJobs = 0;
+		for (u32 chunk = 0; chunk < numChunks; chunk += width * 2)
+		{
+			const u32 runStart = ChunkStart(chunk);
+			const u32 runMid   = ChunkStart(chunk + width);
+			const u32 runEnd   = ChunkStart(chunk + (width * 2));
+			for (u32 begin = runStart; begin < runEnd;)
+			{
+				DQN_ASSERT(numJobs < numChunks * 2);
+				DqnJobQueueInternal_SortJob<T> *job = &jobs[numJobs++];
+				*job                                = {};
+				job->src                            = src;
+				job->dest                           = dest;
+				job->begin                          = begin;
+				job->end                            = (runEnd - begin > jobSize) ? begin + jobSize : runEnd;
+				job->runStart                       = runStart;
+				job->runMid                         = runMid;
+				job->runEnd                         = runEnd;
+				begin                               = job->end;
+			}
+		}
+
+		DqnJobQueueInternal_SortRunJobs(queue, DqnJobQueueInternal_SortMerge<T>, jobs, numJobs);
+		DQN_SWAP(T *, src, dest);
+	}
+
+	DQN_ASSERT(src == array);
+	return true;
+}
+
+DQN_FILE_SCOPE bool DqnJobQueue_ParallelSort(DqnJobQueue *const queue, DqnMemStack *const stack,
+                                             DqnSortKeyU32 *const array, const u32 size)
+{
+	return DqnJobQueueInternal_ParallelSort(queue, stack, array, size);
+}
+
+DQN_FILE_SCOPE bool DqnJobQueue_ParallelSort(DqnJobQueue *const queue, DqnMemStack *const stack,
+                                             DqnSortKeyU64 *const array, const u32 size)
+{
+	return DqnJobQueueInternal_ParallelSort(queue, stack, array, size);
+}
+
+DQN_FILE_SCOPE bool DqnJobQueue_ParallelSort(DqnJobQueue *const queue, DqnMemStack *const stack,
+                                             DqnSortKeyF32 *const array, const u32 size)
+{
+	return DqnJobQueueInternal_ParallelSort(queue, stack, array, size);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// XPlatform > #DqnJobQueue CPP Implementation
+////////////////////////////////////////////////////////////////////////////////
+bool DqnJobQueue::Init             (const u32 numThreads) { return DqnJobQueue_Init(this, numThreads);         }
+void DqnJobQueue::Free             ()                     {        DqnJobQueue_Free(this);                     }
+bool DqnJobQueue::AddJob           (const DqnJob job)     { return DqnJobQueue_AddJob(this, job);              }
+bool DqnJobQueue::AddChildJob      (const DqnJob job)     { return DqnJobQueue_AddChildJob(this, job);         }
+void DqnJobQueue::BlockAndCompleteAllJobs()               {        DqnJobQueue_BlockAndCompleteAllJobs(this);  }
+void DqnJobQueue::WaitForCounter   (DqnJobCounter *const counter) { DqnJobQueue_WaitForCounter(this, counter); }
+bool DqnJobQueue::TryExecuteNextJob()                     { return DqnJobQueue_TryExecuteNextJob(this);        }
+bool DqnJobQueue::AllJobsComplete  ()                     { return DqnJobQueue_AllJobsComplete(this);          }
+DqnMemStack *DqnJobQueue::GetScratch()                    { return DqnJobQueue_GetScratch(this);               }
 
 ////////////////////////////////////////////////////////////////////////////////
 // XPlatform > #DqnAtomic Implementation
@@ -6898,6 +8098,262 @@ DQN_FILE_SCOPE i32 DqnAtomic_Add32(i32 volatile *const src, const i32 value)
 	return result;
 }
 
+DQN_FILE_SCOPE i64 DqnAtomic_CompareSwap64(i64 volatile *const dest, const i64 swapVal, const i64 compareVal)
+{
+	i64 result = 0;
+#if defined(DQN_WIN32_PLATFORM)
+	result = (i64)InterlockedCompareExchange64((LONG64 volatile *)dest, (LONG64)swapVal, (LONG64)compareVal);
+
+#elif defined(DQN_UNIX_PLATFORM)
+	result = __sync_val_compare_and_swap(dest, compareVal, swapVal);
+
+#else
+	#error Unsupported platform
+
+#endif
+	return result;
+}
+
+DQN_FILE_SCOPE i64 DqnAtomic_Add64(i64 volatile *const src, const i64 value)
+{
+	i64 result = 0;
+#if defined(DQN_WIN32_PLATFORM)
+	result = (i64)InterlockedAdd64((LONG64 volatile *)src, value);
+
+#elif defined(DQN_UNIX_PLATFORM)
+	result = __sync_add_and_fetch(src, value);
+
+#else
+	#error Unsupported platform
+
+#endif
+
+	return result;
+}
+
+DQN_FILE_SCOPE void *DqnAtomic_CompareSwapPtr(void *volatile *const dest, void *const swapVal, void *const compareVal)
+{
+	void *result = NULL;
+#if defined(DQN_WIN32_PLATFORM)
+	result = InterlockedCompareExchangePointer(dest, swapVal, compareVal);
+
+#elif defined(DQN_UNIX_PLATFORM)
+	result = __sync_val_compare_and_swap(dest, compareVal, swapVal);
+
+#else
+	#error Unsupported platform
+
+#endif
+	return result;
+}
+
+DQN_FILE_SCOPE i64 DqnAtomic_Load64(i64 volatile *const src)
+{
+	i64 result = 0;
+#if defined(DQN_WIN32_PLATFORM)
+	result = (i64)InterlockedCompareExchange64((LONG64 volatile *)src, 0, 0);
+
+#elif defined(DQN_UNIX_PLATFORM)
+	result = __atomic_load_n(src, __ATOMIC_SEQ_CST);
+
+#else
+	#error Unsupported platform
+
+#endif
+	return result;
+}
+
+DQN_FILE_SCOPE void DqnAtomic_Store64(i64 volatile *const dest, const i64 value)
+{
+#if defined(DQN_WIN32_PLATFORM)
+	InterlockedExchange64((LONG64 volatile *)dest, (LONG64)value);
+
+#elif defined(DQN_UNIX_PLATFORM)
+	__atomic_store_n(dest, value, __ATOMIC_SEQ_CST);
+
+#else
+	#error Unsupported platform
+
+#endif
+}
+
+DQN_FILE_SCOPE void *DqnAtomic_LoadPtr(void *volatile *const src)
+{
+	void *result = NULL;
+#if defined(DQN_WIN32_PLATFORM)
+	result = InterlockedCompareExchangePointer(src, NULL, NULL);
+
+#elif defined(DQN_UNIX_PLATFORM)
+	result = __atomic_load_n(src, __ATOMIC_SEQ_CST);
+
+#else
+	#error Unsupported platform
+
+#endif
+	return result;
+}
+
+DQN_FILE_SCOPE void DqnAtomic_StorePtr(void *volatile *const dest, void *const value)
+{
+#if defined(DQN_WIN32_PLATFORM)
+	InterlockedExchangePointer(dest, value);
+
+#elif defined(DQN_UNIX_PLATFORM)
+	__atomic_store_n(dest, value, __ATOMIC_SEQ_CST);
+
+#else
+	#error Unsupported platform
+
+#endif
+}
+
+DQN_FILE_SCOPE void DqnAtomic_MemoryBarrier()
+{
+#if defined(DQN_WIN32_PLATFORM)
+	MemoryBarrier();
+
+#elif defined(DQN_UNIX_PLATFORM)
+	__sync_synchronize();
+
+#else
+	#error Unsupported platform
+
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// XPlatform > #DqnMemStackShared Implementation
+////////////////////////////////////////////////////////////////////////////////
+#if defined(DQN_CPP_MODE)
+bool  DqnMemStackShared::Init (const size_t size, const bool zeroClear, const u32 byteAlignment) { return DqnMemStackShared_Init(this, size, zeroClear, byteAlignment); }
+void *DqnMemStackShared::Push (const size_t size) { return DqnMemStackShared_Push(this, size); }
+void  DqnMemStackShared::Clear()                  {        DqnMemStackShared_Clear(this);      }
+void  DqnMemStackShared::Free ()                  {        DqnMemStackShared_Free(this);       }
+#endif
+
+FILE_SCOPE DqnMemStackSharedBlock *DqnMemStackSharedInternal_AllocateBlock(const DqnMemStackShared *const stack,
+                                                                           const size_t size)
+{
+	// NOTE: Another (byteAlign - 1) so the memory after the header can be aligned, like DqnMemStack
+	size_t alignedSize = DQN_ALIGN_POW_N(size, stack->byteAlign);
+	size_t totalSize   = alignedSize + sizeof(DqnMemStackSharedBlock) + (stack->byteAlign - 1);
+
+	DqnMemStackSharedBlock *result = NULL;
+	if (stack->zeroClear) result = (DqnMemStackSharedBlock *)DqnMem_Calloc(totalSize);
+	else                  result = (DqnMemStackSharedBlock *)DqnMem_Alloc(totalSize);
+
+	if (!result) return NULL;
+
+	result->memory    = (u8 *)DQN_ALIGN_POW_N((u8 *)result + sizeof(*result), stack->byteAlign);
+	result->size      = alignedSize;
+	result->used      = 0;
+	result->prevBlock = NULL;
+	return result;
+}
+
+DQN_FILE_SCOPE bool DqnMemStackShared_Init(DqnMemStackShared *const stack, const size_t size, const bool zeroClear,
+                                           const u32 byteAlign)
+{
+	if (!stack || size == 0 || byteAlign == 0 || (byteAlign & (byteAlign - 1)) != 0) return false;
+	if (!DQN_ASSERT_MSG(!stack->block, "MemStack has pre-existing block already attached")) return false;
+
+	stack->blockSize = DQN_ALIGN_POW_N(size, byteAlign);
+	stack->byteAlign = byteAlign;
+	stack->zeroClear = zeroClear;
+	stack->block     = DqnMemStackSharedInternal_AllocateBlock(stack, stack->blockSize);
+	stack->numBlocks = (stack->block) ? 1 : 0;
+	return (stack->block != NULL);
+}
+
+DQN_FILE_SCOPE void *DqnMemStackShared_Push(DqnMemStackShared *const stack, const size_t size)
+{
+	if (!stack || size == 0 || stack->byteAlign == 0) return NULL;
+
+	const i64 alignedSize = (i64)DQN_ALIGN_POW_N(size, stack->byteAlign);
+	for (;;)
+	{
+		DqnMemStackSharedBlock *block = stack->block;
+		if (block)
+		{
+			i64 used = DqnAtomic_Add64(&block->used, alignedSize);
+			if ((size_t)used <= block->size) return block->memory + (used - alignedSize);
+		}
+
+		// NOTE: Another thread already chained a block since this one read it, push to that instead of
+		// allocating one to throw away
+		if (stack->block != block) continue;
+
+		size_t newBlockSize              = DQN_MAX((size_t)alignedSize, stack->blockSize);
+		DqnMemStackSharedBlock *newBlock = DqnMemStackSharedInternal_AllocateBlock(stack, newBlockSize);
+		if (!newBlock) return NULL;
+
+		// NOTE: The push is taken out of the block before it's published, no other thread can race it
+		newBlock->used      = alignedSize;
+		newBlock->prevBlock = block;
+		if (DqnAtomic_CompareSwapPtr((void *volatile *)&stack->block, newBlock, block) == block)
+		{
+			DqnAtomic_Add32(&stack->numBlocks, 1);
+			return newBlock->memory;
+		}
+
+		DqnMem_Free(newBlock);
+	}
+}
+
+DQN_FILE_SCOPE void DqnMemStackShared_Clear(DqnMemStackShared *const stack)
+{
+	if (!stack || !stack->block) return;
+
+	DqnMemStackSharedBlock *block = stack->block;
+	if (!block->prevBlock)
+	{
+		if (stack->zeroClear) DqnMem_Clear(block->memory, 0, DQN_MIN((size_t)block->used, block->size));
+		block->used = 0;
+		return;
+	}
+
+	size_t totalSize = 0;
+	for (DqnMemStackSharedBlock *it = block; it; it = it->prevBlock)
+		totalSize += it->size;
+
+	// NOTE: Keep the first block if the merged one can't be allocated, it's never bigger than the others
+	DqnMemStackSharedBlock *keptBlock = DqnMemStackSharedInternal_AllocateBlock(stack, totalSize);
+	while (block)
+	{
+		DqnMemStackSharedBlock *prevBlock = block->prevBlock;
+		if (!keptBlock && !prevBlock)
+		{
+			keptBlock = block;
+			if (stack->zeroClear) DqnMem_Clear(block->memory, 0, block->size);
+		}
+		else
+		{
+			DqnMem_Free(block);
+		}
+		block = prevBlock;
+	}
+
+	keptBlock->used      = 0;
+	keptBlock->prevBlock = NULL;
+	stack->block         = keptBlock;
+	stack->numBlocks     = 1;
+}
+
+DQN_FILE_SCOPE void DqnMemStackShared_Free(DqnMemStackShared *const stack)
+{
+	if (!stack) return;
+
+	DqnMemStackSharedBlock *block = stack->block;
+	while (block)
+	{
+		DqnMemStackSharedBlock *prevBlock = block->prevBlock;
+		DqnMem_Free(block);
+		block = prevBlock;
+	}
+
+	*stack = {};
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // XPlatform > #DqnPlatformInternal Implementation
 ////////////////////////////////////////////////////////////////////////////////